@@ -0,0 +1,122 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeASMCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/cmake/macros.cmake"
+  "/root/repo/platforms/linux/CMakeLists.txt"
+  "/root/repo/source/tnn/device/cpu/CMakeLists.txt"
+  "/root/repo/source/tnn/device/x86/CMakeLists.txt"
+  "/root/repo/test/CMakeLists.txt"
+  "/root/repo/test/unit_test/CMakeLists.txt"
+  "/root/repo/test/unit_test/third_party/googletest/CMakeLists.txt"
+  "/root/repo/test/unit_test/third_party/googletest/googlemock/CMakeLists.txt"
+  "/root/repo/test/unit_test/third_party/googletest/googlemock/cmake/gmock.pc.in"
+  "/root/repo/test/unit_test/third_party/googletest/googlemock/cmake/gmock_main.pc.in"
+  "/root/repo/test/unit_test/third_party/googletest/googletest/CMakeLists.txt"
+  "/root/repo/test/unit_test/third_party/googletest/googletest/cmake/Config.cmake.in"
+  "/root/repo/test/unit_test/third_party/googletest/googletest/cmake/gtest.pc.in"
+  "/root/repo/test/unit_test/third_party/googletest/googletest/cmake/gtest_main.pc.in"
+  "/root/repo/test/unit_test/third_party/googletest/googletest/cmake/internal_utils.cmake"
+  "/root/repo/third_party/gflags/CMakeLists.txt"
+  "/root/repo/third_party/gflags/cmake/config.cmake.in"
+  "/root/repo/third_party/gflags/cmake/package.pc.in"
+  "/root/repo/third_party/gflags/cmake/utils.cmake"
+  "/root/repo/third_party/gflags/cmake/version.cmake.in"
+  "/root/repo/third_party/gflags/src/config.h.in"
+  "/root/repo/third_party/gflags/src/gflags.h.in"
+  "/root/repo/third_party/gflags/src/gflags_completions.h.in"
+  "/root/repo/third_party/gflags/src/gflags_declare.h.in"
+  "/usr/share/cmake-3.25/Modules/BasicConfigVersion-AnyNewerVersion.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeASMInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDependentOption.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakePackageConfigHelpers.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSymbolExists.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFileCXX.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckSymbolExists.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckTypeSize.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-ASM.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPythonInterp.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/GNUInstallDirs.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  "/usr/share/cmake-3.25/Modules/WriteBasicConfigVersionFile.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "source/tnn/device/x86/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "source/tnn/device/cpu/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "third_party/gflags/include/gflags/gflags.h"
+  "third_party/gflags/include/gflags/gflags_declare.h"
+  "third_party/gflags/include/gflags/gflags_completions.h"
+  "third_party/gflags/include/gflags/config.h"
+  "third_party/gflags/gflags-config-install.cmake"
+  "third_party/gflags/gflags-config-version.cmake"
+  "third_party/gflags/gflags.pc"
+  "third_party/gflags/gflags-config.cmake"
+  "third_party/gflags/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/unit_test/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/unit_test/third_party/googletest/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/unit_test/third_party/googletest/googletest/generated/gmock.pc"
+  "test/unit_test/third_party/googletest/googletest/generated/gmock_main.pc"
+  "test/unit_test/third_party/googletest/googlemock/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/unit_test/third_party/googletest/googletest/generated/GTestConfigVersion.cmake"
+  "test/unit_test/third_party/googletest/googletest/generated/GTestConfig.cmake"
+  "test/unit_test/third_party/googletest/googletest/generated/gtest.pc"
+  "test/unit_test/third_party/googletest/googletest/generated/gtest_main.pc"
+  "test/unit_test/third_party/googletest/googletest/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/TNN.dir/DependInfo.cmake"
+  "source/tnn/device/x86/CMakeFiles/TNNX86.dir/DependInfo.cmake"
+  "source/tnn/device/cpu/CMakeFiles/TNNCpu.dir/DependInfo.cmake"
+  "third_party/gflags/CMakeFiles/gflags_nothreads_static.dir/DependInfo.cmake"
+  "test/CMakeFiles/TNNTest.dir/DependInfo.cmake"
+  "test/unit_test/CMakeFiles/unit_test.dir/DependInfo.cmake"
+  "test/unit_test/third_party/googletest/googlemock/CMakeFiles/gmock.dir/DependInfo.cmake"
+  "test/unit_test/third_party/googletest/googlemock/CMakeFiles/gmock_main.dir/DependInfo.cmake"
+  "test/unit_test/third_party/googletest/googletest/CMakeFiles/gtest.dir/DependInfo.cmake"
+  "test/unit_test/third_party/googletest/googletest/CMakeFiles/gtest_main.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,24 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/test/flags.cc" "test/CMakeFiles/TNNTest.dir/flags.cc.o" "gcc" "test/CMakeFiles/TNNTest.dir/flags.cc.o.d"
+  "/root/repo/test/test.cc" "test/CMakeFiles/TNNTest.dir/test.cc.o" "gcc" "test/CMakeFiles/TNNTest.dir/test.cc.o.d"
+  "/root/repo/test/test_utils.cc" "test/CMakeFiles/TNNTest.dir/test_utils.cc.o" "gcc" "test/CMakeFiles/TNNTest.dir/test_utils.cc.o.d"
+  "/root/repo/test/timer.cc" "test/CMakeFiles/TNNTest.dir/timer.cc.o" "gcc" "test/CMakeFiles/TNNTest.dir/timer.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_test_build/CMakeFiles/TNN.dir/DependInfo.cmake"
+  "/root/repo/_test_build/third_party/gflags/CMakeFiles/gflags_nothreads_static.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
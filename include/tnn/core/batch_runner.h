@@ -0,0 +1,98 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_INCLUDE_TNN_CORE_BATCH_RUNNER_H_
+#define TNN_INCLUDE_TNN_CORE_BATCH_RUNNER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "tnn/core/instance.h"
+#include "tnn/core/macro.h"
+#include "tnn/core/mat.h"
+#include "tnn/core/status.h"
+
+#pragma warning(push)
+#pragma warning(disable : 4251)
+
+namespace TNN_NS {
+
+struct PUBLIC BatchRunnerConfig {
+    // max number of requests merged into one forward. The instance must be created with
+    // max_inputs_shape allowing this batch.
+    int max_batch = 8;
+
+    // max time in microseconds the oldest request waits for more requests to join its batch
+    int timeout_us = 1000;
+};
+
+struct PUBLIC BatchRunnerStatistics {
+    // upper bounds in microseconds of the time histogram buckets, the last bucket counts the rest
+    std::vector<int> bucket_bounds_us;
+    // number of requests by the time from Forward call to the start of its batch
+    std::vector<int64_t> queue_time_histogram;
+    // number of batches by the time to reshape, forward and convert inputs and outputs
+    std::vector<int64_t> compute_time_histogram;
+    // number of batches by batch size, index 0 is batch 1
+    std::vector<int64_t> batch_size_histogram;
+    int64_t request_count = 0;
+};
+
+// @brief BatchRunner merges concurrent batch 1 requests into one forward of an instance.
+// A batch runs once max_batch requests are queued or the oldest one waited timeout_us.
+// Requests are only merged with requests of the same input shapes.
+class PUBLIC BatchRunner {
+public:
+    BatchRunner(std::shared_ptr<Instance> instance, BatchRunnerConfig config);
+
+    // @brief run the requests still queued, then stop
+    ~BatchRunner();
+
+    // @brief run one request and wait for its outputs, can be called from many threads.
+    // @param inputs NCHW_FLOAT mats of batch 1 on DEVICE_NAIVE for every model input
+    // @param outputs NCHW_FLOAT mats of batch 1 on DEVICE_NAIVE for every model output
+    Status Forward(const MatMap &inputs, MatMap &outputs);
+
+    // @brief get the queue time and compute time histograms
+    BatchRunnerStatistics GetStatistics();
+
+private:
+    struct Request;
+
+    void DispatchLoop();
+    Status RunBatch(std::vector<std::shared_ptr<Request>> &batch);
+    void AddTime(std::vector<int64_t> &histogram, int64_t time_us);
+
+    std::shared_ptr<Instance> instance_;
+    BatchRunnerConfig config_;
+    BatchRunnerStatistics statistics_;
+    InputShapesMap batch_shapes_;
+
+    std::deque<std::shared_ptr<Request>> requests_;
+    bool stop_ = false;
+    std::mutex mutex_;
+    std::condition_variable request_cv_;
+    std::mutex statistics_mutex_;
+    std::thread dispatcher_;
+};
+
+}  // namespace TNN_NS
+
+#pragma warning(pop)
+
+#endif  // TNN_INCLUDE_TNN_CORE_BATCH_RUNNER_H_
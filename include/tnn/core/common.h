@@ -123,6 +123,13 @@ typedef enum {
     SHARE_MEMORY_MODE_SET_FROM_EXTERNAL = 2
 } ShareMemoryMode;
 
+typedef enum {
+    // default, blobs reuse whole blob memory of the nearest size
+    MEMORY_PLAN_MODE_DEFAULT = 0,
+    // blobs are placed at planned offsets of one arena according to their liveness interval
+    MEMORY_PLAN_MODE_OFFSET = 1
+} MemoryPlanMode;
+
 typedef enum {
     MODEL_TYPE_TNN      = 0x0001,
     MODEL_TYPE_NCNN     = 0x0100,
@@ -154,18 +161,45 @@ struct PUBLIC NetworkConfig {
     // raidnet instances not share memory with others
     ShareMemoryMode share_memory_mode = SHARE_MEMORY_MODE_DEFAULT;
 
+    // blob memory plan mode, offset mode usually needs less forward memory
+    MemoryPlanMode memory_plan_mode = MEMORY_PLAN_MODE_DEFAULT;
+
     // dependent library path
     std::vector<std::string> library_path = {};
 
     // compute precision
     Precision precision = PRECISION_AUTO;
 
-    // cache path to store possible cache models or opt kernel
+    // cache path to store possible cache models or opt kernel.
+    // naive and x86 store the optimized net and the packed weights here, keyed by the model md5
     std::string cache_path = "";
 
     // network init or reshape may cost more time to select opt kernel implement if enable tune kernel
     // cache_path can set to store tune kernel info.
     bool enable_tune_kernel = false;
+
+    // number of threads to run independent layers concurrently, cpu devices (naive, x86, arm) only.
+    // The intra-op threads set by SetCpuNumThreads are divided among them.
+    int inter_op_threads = 1;
+
+    // names of the input and output blobs whose memory is bound by Instance::BindExternalMemory, cpu devices
+    // (naive, x86, arm) only. They are left out of the forward memory and must be bound before Forward.
+    std::vector<std::string> external_memory_blobs = {};
+
+    // number of recent input shapes whose reshaped layer accs are kept besides the current one, naive and x86
+    // only. Reshape back to a kept shape swaps its layer accs in instead of reshaping the layers. 0 disables it.
+    int reshape_plan_cache_size = 0;
+
+    // cpu ids the intra-op threads are pinned to, x86 only. Empty means no pinning.
+    std::vector<int> cpu_affinity = {};
+
+    // numa node whose cpus the intra-op threads are pinned to if cpu_affinity is empty, x86 only.
+    // -1 means no numa binding.
+    int numa_node = -1;
+
+    // max number of ForwardAsync jobs queued or running on an instance, cpu devices (naive, x86, arm) only.
+    // ForwardAsync returns TNNERR_INST_BUSY instead of blocking once it is reached.
+    int async_queue_depth = 1;
 };
 
 struct PUBLIC ModelConfig {
@@ -179,6 +213,10 @@ struct PUBLIC ModelConfig {
     // hiai model need two params: order is model name, model_file_path.
     // atlas model need one param: config string.
     std::vector<std::string> params = {};
+
+    // tnn model only, params[1] is the model file path instead of model content.
+    // The model file is memory mapped, and weights are shared with the mapping if possible.
+    bool enable_mmap = false;
 };
 
 typedef enum {
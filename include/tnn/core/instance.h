@@ -64,6 +64,17 @@ public:
     //  will result in undefined behavior.
     Status SetForwardMemory(void* memory);
 
+    //  bind caller owned memory as the storage of an input or output blob for the following forwards,
+    //  cpu devices only. the blob must be listed in NetworkConfig::external_memory_blobs.
+    //  the memory must be 32 bytes aligned, hold the blob in its data type and data format, and size
+    //  need >= the blob bytes at its current dims. the memory must stay valid until the forwards using
+    //  it complete, including the ones queued by ForwardAsync.
+    Status BindExternalMemory(const std::string& blob_name, void* memory, size_t size);
+
+    // @brief reset the states stateful layers keep across forwards, e.g. the hidden state of
+    //  streaming lstm, the next forward starts from the initial state. naive and x86 only.
+    Status ResetLayerStates();
+
     // reshape instance with new input shapes
     Status Reshape(const InputShapesMap& inputs);
 
@@ -89,6 +100,10 @@ public:
 
     // tnn instance network infer async.
     // device gpu, all layer infer complete will call Callback.
+    // device cpu (naive, x86, arm), the forward runs on a worker thread of the instance and
+    // Callback is called on it once the forward completes. Inputs must not be changed and
+    // outputs must not be read until then. Returns TNNERR_INST_BUSY if
+    // NetworkConfig::async_queue_depth forwards are pending.
     Status ForwardAsync(Callback call_back);
 
     // get all input blobs
@@ -61,6 +61,7 @@ enum StatusCode {
     TNNERR_ALLOC_INSTANCE   = 0x5002,
     TNNERR_INVALID_INSTANCE = 0x5003,
     TNNERR_CONTEXT_ERR      = 0x5004,
+    TNNERR_INST_BUSY        = 0x5005,
 
     // common errcode
     TNNERR_COMMON_ERROR     = 0x6000,
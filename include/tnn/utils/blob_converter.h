@@ -23,6 +23,7 @@
 #include "tnn/core/mat.h"
 #include "tnn/core/macro.h"
 #include "tnn/core/status.h"
+#include "tnn/utils/mat_utils.h"
 
 #pragma warning(push)
 #pragma warning(disable : 4251)
@@ -46,6 +47,12 @@ public:
     Status ConvertToMatAsync(Mat& image, MatConvertParam param, void* command_queue);
     Status ConvertFromMatAsync(Mat& image, MatConvertParam param, void* command_queue);
 
+    // @brief resize a N8UC3, N8UC4, NNV12 or NNV21 image to the blob height and width, and convert it
+    // into the blob. NNV12 and NNV21 images are converted to bgr. cpu devices do it in one pass without
+    // intermediate mats.
+    Status ConvertFromMatWithResize(Mat& image, ResizeParam resize_param, MatConvertParam param,
+                                    void* command_queue);
+
 private:
     Blob* blob_ = nullptr;
     std::shared_ptr<BlobConverterAcc> impl_ = nullptr;
@@ -29,6 +29,14 @@ Status AbstractNetwork::ShareCommandQueue(AbstractNetwork *network) {
     return Status(TNNERR_COMMON_ERROR, "Subclass of AbstractNetwork must implement this func ShareCommandQueue");
 }
 
+Status AbstractNetwork::BindExternalMemory(const std::string &blob_name, void *memory, size_t size) {
+    return Status(TNNERR_DEVICE_NOT_SUPPORT, "external memory is not supported by the network");
+}
+
+Status AbstractNetwork::ResetLayerStates() {
+    return Status(TNNERR_DEVICE_NOT_SUPPORT, "layer states are not supported by the network");
+}
+
 Status AbstractNetwork::SetCpuNumThreads(int num_threads) {
     return TNN_OK;
 }
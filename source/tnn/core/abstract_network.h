@@ -61,6 +61,16 @@ public:
     //
     virtual Status SetForwardMemory(void *memory) = 0;
 
+    // @brief bind caller owned memory as the storage of an input or output blob
+    // listed in NetworkConfig::external_memory_blobs
+    // @param blob_name name of the blob
+    // @param memory the memory used by the blob in the following forwards
+    // @param size bytes of the memory
+    virtual Status BindExternalMemory(const std::string &blob_name, void *memory, size_t size);
+
+    // @brief reset the states stateful layers keep across forwards
+    virtual Status ResetLayerStates();
+
     // @brief network infer
     virtual Status Reshape(const InputShapesMap &inputs) = 0;
 
@@ -0,0 +1,103 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/core/async_forward_executor.h"
+
+#include <algorithm>
+
+#include "tnn/core/macro.h"
+
+namespace TNN_NS {
+
+AsyncForwardExecutor::AsyncForwardExecutor(int max_pending) : max_pending_(std::max(max_pending, 1)) {
+    worker_ = std::thread(&AsyncForwardExecutor::WorkerLoop, this);
+}
+
+AsyncForwardExecutor::~AsyncForwardExecutor() {
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        stop_ = true;
+    }
+    task_cv_.notify_all();
+    worker_.join();
+}
+
+Status AsyncForwardExecutor::Submit(Job job, Callback call_back) {
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (stop_) {
+            return Status(TNNERR_INST_ERR, "async forward executor is stopped");
+        }
+        if (pending_ >= max_pending_) {
+            return Status(TNNERR_INST_BUSY, "async forward queue is full");
+        }
+        pending_++;
+        tasks_.push_back({job, call_back});
+    }
+    task_cv_.notify_one();
+    return TNN_OK;
+}
+
+Status AsyncForwardExecutor::Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (std::this_thread::get_id() == worker_.get_id()) {
+        return TNN_OK;
+    }
+    idle_cv_.wait(lock, [this] { return pending_ == 0 && !in_callback_; });
+    Status status = status_;
+    status_       = TNN_OK;
+    return status;
+}
+
+/*
+ * A job is no longer pending when its callback is called, so the callback may
+ * submit the next job of the network.
+ */
+void AsyncForwardExecutor::WorkerLoop() {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            task_cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;
+            }
+            task = tasks_.front();
+            tasks_.pop_front();
+        }
+
+        Status status = task.job();
+        if (status != TNN_OK) {
+            LOGE("AsyncForwardExecutor job failed: %s\n", status.description().c_str());
+        }
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if (status != TNN_OK && status_ == TNN_OK) {
+                status_ = status;
+            }
+            pending_--;
+            in_callback_ = true;
+        }
+        if (task.call_back) {
+            task.call_back();
+        }
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            in_callback_ = false;
+        }
+        idle_cv_.notify_all();
+    }
+}
+
+}  // namespace TNN_NS
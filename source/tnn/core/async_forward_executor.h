@@ -0,0 +1,71 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_CORE_ASYNC_FORWARD_EXECUTOR_H_
+#define TNN_SOURCE_TNN_CORE_ASYNC_FORWARD_EXECUTOR_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "tnn/core/common.h"
+#include "tnn/core/status.h"
+
+namespace TNN_NS {
+
+// @brief AsyncForwardExecutor runs the forward jobs of a network in submission order on
+// its own worker thread, and calls the callback of each job once it completes. At most
+// max_pending jobs are queued or running, Submit fails instead of blocking beyond that.
+class AsyncForwardExecutor {
+public:
+    typedef std::function<Status(void)> Job;
+
+    explicit AsyncForwardExecutor(int max_pending);
+
+    // @brief run the jobs still queued, then stop the worker
+    ~AsyncForwardExecutor();
+
+    // @brief queue a job, returns TNNERR_INST_BUSY if max_pending jobs are pending
+    Status Submit(Job job, Callback call_back);
+
+    // @brief wait until all submitted jobs complete, returns the first failure among them.
+    // It returns at once if called on the worker thread, such as from a callback.
+    Status Wait();
+
+private:
+    struct Task {
+        Job job;
+        Callback call_back;
+    };
+
+    void WorkerLoop();
+
+    int max_pending_ = 1;
+    int pending_     = 0;
+    bool in_callback_ = false;
+    std::deque<Task> tasks_;
+    Status status_;
+    bool stop_ = false;
+
+    std::mutex mutex_;
+    std::condition_variable task_cv_;
+    std::condition_variable idle_cv_;
+    std::thread worker_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_CORE_ASYNC_FORWARD_EXECUTOR_H_
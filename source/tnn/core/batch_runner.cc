@@ -0,0 +1,221 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/core/batch_runner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <future>
+
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+typedef std::chrono::steady_clock Clock;
+
+struct BatchRunner::Request {
+    const MatMap *inputs = nullptr;
+    MatMap outputs;
+    Clock::time_point enqueue_time;
+    std::promise<Status> done;
+};
+
+static const std::vector<int> kTimeBucketBoundsUs = {50, 100, 200, 500, 1000, 2000, 5000, 10000, 20000, 50000, 100000};
+
+static int64_t ElapsedUs(Clock::time_point begin, Clock::time_point end) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+}
+
+static bool IsSameShape(const MatMap &a, const MatMap &b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (const auto &iter : a) {
+        auto other = b.find(iter.first);
+        if (other == b.end() || !DimsVectorUtils::Equal(iter.second->GetDims(), other->second->GetDims())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+BatchRunner::BatchRunner(std::shared_ptr<Instance> instance, BatchRunnerConfig config)
+    : instance_(instance), config_(config) {
+    config_.max_batch                  = std::max(config_.max_batch, 1);
+    statistics_.bucket_bounds_us       = kTimeBucketBoundsUs;
+    statistics_.queue_time_histogram   = std::vector<int64_t>(kTimeBucketBoundsUs.size() + 1, 0);
+    statistics_.compute_time_histogram = std::vector<int64_t>(kTimeBucketBoundsUs.size() + 1, 0);
+    statistics_.batch_size_histogram   = std::vector<int64_t>(config_.max_batch, 0);
+    dispatcher_                        = std::thread(&BatchRunner::DispatchLoop, this);
+}
+
+BatchRunner::~BatchRunner() {
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        stop_ = true;
+    }
+    request_cv_.notify_all();
+    dispatcher_.join();
+}
+
+Status BatchRunner::Forward(const MatMap &inputs, MatMap &outputs) {
+    if (inputs.empty()) {
+        return Status(TNNERR_PARAM_ERR, "BatchRunner inputs are empty");
+    }
+    for (const auto &iter : inputs) {
+        auto mat = iter.second;
+        if (!mat || mat->GetDeviceType() != DEVICE_NAIVE || mat->GetMatType() != NCHW_FLOAT ||
+            mat->GetDims().empty() || mat->GetBatch() != 1) {
+            LOGE("BatchRunner input %s must be NCHW_FLOAT mat of batch 1 on DEVICE_NAIVE\n", iter.first.c_str());
+            return Status(TNNERR_PARAM_ERR, "BatchRunner input must be NCHW_FLOAT mat of batch 1 on DEVICE_NAIVE");
+        }
+    }
+
+    auto request          = std::make_shared<Request>();
+    request->inputs       = &inputs;
+    request->enqueue_time = Clock::now();
+    auto done             = request->done.get_future();
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (stop_) {
+            return Status(TNNERR_INST_ERR, "BatchRunner is stopped");
+        }
+        requests_.push_back(request);
+    }
+    request_cv_.notify_all();
+
+    Status status = done.get();
+    if (status == TNN_OK) {
+        outputs = request->outputs;
+    }
+    return status;
+}
+
+BatchRunnerStatistics BatchRunner::GetStatistics() {
+    std::lock_guard<std::mutex> guard(statistics_mutex_);
+    return statistics_;
+}
+
+void BatchRunner::AddTime(std::vector<int64_t> &histogram, int64_t time_us) {
+    auto bucket = std::lower_bound(kTimeBucketBoundsUs.begin(), kTimeBucketBoundsUs.end(), time_us);
+    histogram[bucket - kTimeBucketBoundsUs.begin()]++;
+}
+
+void BatchRunner::DispatchLoop() {
+    while (true) {
+        std::vector<std::shared_ptr<Request>> batch;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            request_cv_.wait(lock, [this] { return stop_ || !requests_.empty(); });
+            if (requests_.empty()) {
+                return;
+            }
+
+            auto deadline = requests_.front()->enqueue_time + std::chrono::microseconds(config_.timeout_us);
+            request_cv_.wait_until(lock, deadline,
+                                   [this] { return stop_ || (int)requests_.size() >= config_.max_batch; });
+
+            // merge the oldest requests with the same input shapes
+            while (!requests_.empty() && (int)batch.size() < config_.max_batch) {
+                auto request = requests_.front();
+                if (!batch.empty() && !IsSameShape(*batch[0]->inputs, *request->inputs)) {
+                    break;
+                }
+                batch.push_back(request);
+                requests_.pop_front();
+            }
+        }
+
+        Status status = RunBatch(batch);
+        for (auto &request : batch) {
+            request->done.set_value(status);
+        }
+    }
+}
+
+Status BatchRunner::RunBatch(std::vector<std::shared_ptr<Request>> &batch) {
+    auto begin     = Clock::now();
+    int batch_size = (int)batch.size();
+    {
+        std::lock_guard<std::mutex> guard(statistics_mutex_);
+        for (auto &request : batch) {
+            AddTime(statistics_.queue_time_histogram, ElapsedUs(request->enqueue_time, begin));
+        }
+    }
+
+    InputShapesMap shapes;
+    for (const auto &iter : *batch[0]->inputs) {
+        auto dims          = iter.second->GetDims();
+        dims[0]            = batch_size;
+        shapes[iter.first] = dims;
+    }
+    if (shapes != batch_shapes_) {
+        auto status = instance_->Reshape(shapes);
+        if (status != TNN_OK) {
+            batch_shapes_.clear();
+            LOGE("BatchRunner reshape to batch %d failed: %s\n", batch_size, status.description().c_str());
+            return status;
+        }
+        batch_shapes_ = shapes;
+    }
+
+    // gather the inputs of each request into one batch
+    for (const auto &iter : shapes) {
+        std::shared_ptr<Mat> input(new Mat(DEVICE_NAIVE, NCHW_FLOAT, iter.second));
+        size_t sample_bytes = DimsVectorUtils::Count(iter.second, 1) * sizeof(float);
+        for (int i = 0; i < batch_size; ++i) {
+            auto mat = batch[i]->inputs->at(iter.first);
+            memcpy(static_cast<char *>(input->GetData()) + i * sample_bytes, mat->GetData(), sample_bytes);
+        }
+        auto status = instance_->SetInputMat(input, MatConvertParam(), iter.first);
+        RETURN_ON_NEQ(status, TNN_OK);
+    }
+
+    auto status = instance_->Forward();
+    RETURN_ON_NEQ(status, TNN_OK);
+
+    // scatter the outputs back to each request
+    BlobMap output_blobs;
+    status = instance_->GetAllOutputBlobs(output_blobs);
+    RETURN_ON_NEQ(status, TNN_OK);
+    for (const auto &iter : output_blobs) {
+        std::shared_ptr<Mat> output;
+        status = instance_->GetOutputMat(output, MatConvertParam(), iter.first, DEVICE_NAIVE, NCHW_FLOAT);
+        RETURN_ON_NEQ(status, TNN_OK);
+
+        auto dims = output->GetDims();
+        if (dims.empty() || dims[0] != batch_size) {
+            LOGE("BatchRunner output %s is not batched\n", iter.first.c_str());
+            return Status(TNNERR_MODEL_ERR, "BatchRunner output is not batched");
+        }
+        dims[0]             = 1;
+        size_t sample_bytes = DimsVectorUtils::Count(dims) * sizeof(float);
+        for (int i = 0; i < batch_size; ++i) {
+            std::shared_ptr<Mat> mat(new Mat(DEVICE_NAIVE, NCHW_FLOAT, dims));
+            memcpy(mat->GetData(), static_cast<char *>(output->GetData()) + i * sample_bytes, sample_bytes);
+            batch[i]->outputs[iter.first] = mat;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(statistics_mutex_);
+        AddTime(statistics_.compute_time_histogram, ElapsedUs(begin, Clock::now()));
+        statistics_.batch_size_histogram[batch_size - 1]++;
+        statistics_.request_count += batch_size;
+    }
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
@@ -14,6 +14,8 @@
 
 #include "tnn/core/blob_manager.h"
 
+#include <limits.h>
+
 #include <algorithm>
 #include <cstring>
 #include <set>
@@ -21,6 +23,7 @@
 #include "tnn/memory_manager/blob_memory_pool_factory.h"
 #include "tnn/memory_manager/blob_memory_size_info.h"
 #include "tnn/memory_manager/memory_mode_state_factory.h"
+#include "tnn/memory_manager/memory_offset_assign_strategy.h"
 #include "tnn/memory_manager/memory_seperate_assign_strategy.h"
 #include "tnn/memory_manager/memory_unify_assign_strategy.h"
 #include "tnn/utils/dims_utils.h"
@@ -28,6 +31,9 @@
 
 namespace TNN_NS {
 
+// external memory is accessed by the aligned vector loads of cpu kernels
+static const int g_external_memory_alignment = 32;
+
 BlobManager::BlobManager(AbstractDevice *device) {
     device_            = device;
     // create 1d memory pool
@@ -36,8 +42,9 @@ BlobManager::BlobManager(AbstractDevice *device) {
         // create 2d memory pool
         blob_memory_pool_map_[2] = BlobMemoryPoolFactory::CreateBlobMemoryPool(device, 2);
     }
-    net_structure_     = nullptr;
-    memory_mode_state_ = nullptr;
+    net_structure_          = nullptr;
+    memory_mode_state_      = nullptr;
+    planned_forward_memory_ = nullptr;
 }
 
 BlobManager::~BlobManager() {
@@ -86,6 +93,8 @@ Status BlobManager::Init(NetworkConfig &config, NetStructure *net_structure, Inp
     config_            = config;
     init_thread_id_    = std::this_thread::get_id();
     memory_mode_state_ = MemoryModeStateFactory::CreateMemoryModeState(config.share_memory_mode);
+    // only 1d blob memory can be placed at bytes offset of one arena
+    blob_memory_pool_map_[1]->SetMemoryPlanMode(config.memory_plan_mode);
 
     // get the maximum dimension of all inputs
     int input_dims = 0;
@@ -136,6 +145,16 @@ Status BlobManager::Init(NetworkConfig &config, NetStructure *net_structure, Inp
         output_blobs_[name] = blob;
     }
 
+    // external memory blobs are bound by the caller instead of taken from the forward memory
+    external_memory_size_.clear();
+    for (const auto &name : config.external_memory_blobs) {
+        if (input_blobs_.count(name) == 0 && output_blobs_.count(name) == 0) {
+            LOGE("external memory blob %s is not an input or output\n", name.c_str());
+            return Status(TNNERR_PARAM_ERR, "external memory blob is not an input or output");
+        }
+        external_memory_size_[name] = 0;
+    }
+
     return TNN_OK;
 }
 
@@ -151,7 +170,7 @@ Status BlobManager::AllocateBlobMemory(int flag) {
     for (auto iter : input_shapes_map) {
         std::string current_blob_name = iter.first;
         Blob *current_blob            = blobs_[current_blob_name];
-        if (current_blob->NeedAllocateInForward() ||
+        if (current_blob->NeedAllocateInForward() || IsExternalMemoryBlob(current_blob_name) ||
             DataFlagUtils::ChangeStatus(current_blob->GetFlag()) != DataFlagUtils::ChangeStatus(flag)) {
             continue;
         }
@@ -163,6 +182,7 @@ Status BlobManager::AllocateBlobMemory(int flag) {
         int use_count           = 1;
         BlobMemory *blob_memory = NULL;
         blob_memory             = blob_memory_pool_map_[info.dims.size()]->BorrowBlobMemory(use_count, info, true);
+        blob_memory->SetLiveInterval(-1, INT_MAX);
         blob_memory_mapping_.insert(std::make_pair(current_blob, blob_memory));
     }
 
@@ -175,7 +195,7 @@ Status BlobManager::AllocateBlobMemory(int flag) {
         // allocating blob memory for every out nodes of this layer
         for (auto current_blob_name : layer_info->outputs) {
             Blob *current_blob = blobs_[current_blob_name];
-            if (current_blob->NeedAllocateInForward() ||
+            if (current_blob->NeedAllocateInForward() || IsExternalMemoryBlob(current_blob_name) ||
                 DataFlagUtils::ChangeStatus(current_blob->GetFlag()) != DataFlagUtils::ChangeStatus(flag)) {
                 continue;
             }
@@ -193,6 +213,7 @@ Status BlobManager::AllocateBlobMemory(int flag) {
                 BlobMemorySizeInfo info = device_->Calculate(current_blob->GetBlobDesc());
                 // find an available BlobMemory
                 BlobMemory *blob_memory = blob_memory_pool_map_[info.dims.size()]->BorrowBlobMemory(use_count, info, false);
+                blob_memory->SetLiveInterval(layer_index, INT_MAX);
                 blob_memory_mapping_.insert(std::make_pair(current_blob, blob_memory));
             }
         }
@@ -200,7 +221,7 @@ Status BlobManager::AllocateBlobMemory(int flag) {
         // refund the input blob memory
         for (auto current_blob_name : layer_info->inputs) {
             Blob *current_blob = blobs_[current_blob_name];
-            if (current_blob->NeedAllocateInForward() ||
+            if (current_blob->NeedAllocateInForward() || IsExternalMemoryBlob(current_blob_name) ||
                 DataFlagUtils::ChangeStatus(current_blob->GetFlag()) != DataFlagUtils::ChangeStatus(flag)) {
                 continue;
             }
@@ -211,6 +232,7 @@ Status BlobManager::AllocateBlobMemory(int flag) {
                 ASSERT(blob_memory_iter->second->GetUseCount() > 0);
                 blob_memory_iter->second->DecrementUseCount();
                 if (blob_memory_iter->second->GetUseCount() == 0) {
+                    blob_memory_iter->second->SetLiveInterval(blob_memory_iter->second->GetFirstUse(), layer_index);
                     int dimensions = blob_memory_iter->second->GetBlobMemorySizeInfo().dims.size();
                     blob_memory_pool_map_[dimensions]->RefundBlobMemory(blob_memory_iter->second);
                 }
@@ -223,9 +245,24 @@ Status BlobManager::AllocateBlobMemory(int flag) {
     do {
         if (config_.share_memory_mode == SHARE_MEMORY_MODE_DEFAULT) {
             // The default strategy allocated the blob memory seperately.
+            // In offset plan mode, all blob memory is placed in one arena owned by the blob manager.
             MemorySeperateAssignStrategy strategy;
             for (auto blob_memory_pool_iter : blob_memory_pool_map_) {
-                status = blob_memory_pool_iter.second->AssignAllBlobMemory(strategy);
+                auto blob_memory_pool = blob_memory_pool_iter.second;
+                if (blob_memory_pool->GetMemoryPlanMode() == MEMORY_PLAN_MODE_OFFSET) {
+                    BlobMemorySizeInfo info;
+                    info.data_type = DATA_TYPE_INT8;
+                    info.dims.push_back(std::max(blob_memory_pool->GetAllBlobMemorySize(), 1));
+                    if (planned_forward_memory_ != nullptr) {
+                        device_->Free(planned_forward_memory_);
+                        planned_forward_memory_ = nullptr;
+                    }
+                    status = device_->Allocate(&planned_forward_memory_, info);
+                    BREAK_IF(status != TNN_OK);
+                    status = AssignUnifyBlobMemory(blob_memory_pool, planned_forward_memory_);
+                } else {
+                    status = blob_memory_pool->AssignAllBlobMemory(strategy);
+                }
                 BREAK_IF(status != TNN_OK);
             }
             BREAK_IF(status != TNN_OK);
@@ -239,8 +276,7 @@ Status BlobManager::AllocateBlobMemory(int flag) {
                         forward_memory_size, init_thread_id_, device_,
                         config_.device_id, this, status);
                 BREAK_IF(status != TNN_OK);
-                MemoryUnifyAssignStrategy strategy(share_memory.shared_memory_data);
-                status = blob_memory_pool_iter.second->AssignAllBlobMemory(strategy);
+                status = AssignUnifyBlobMemory(blob_memory_pool_iter.second, share_memory.shared_memory_data);
                 BREAK_IF(status != TNN_OK);
             }
             BREAK_IF(status != TNN_OK);
@@ -251,6 +287,20 @@ Status BlobManager::AllocateBlobMemory(int flag) {
     return status;
 }
 
+/*
+ * Blob memory is laid end to end in the given memory, or placed at the planned
+ * offsets if the pool works in offset plan mode.
+ */
+Status BlobManager::AssignUnifyBlobMemory(BlobMemoryPool *blob_memory_pool, void *memory) {
+    if (blob_memory_pool->GetMemoryPlanMode() == MEMORY_PLAN_MODE_OFFSET) {
+        MemoryOffsetAssignStrategy strategy(memory);
+        return blob_memory_pool->AssignAllBlobMemory(strategy);
+    } else {
+        MemoryUnifyAssignStrategy strategy(memory);
+        return blob_memory_pool->AssignAllBlobMemory(strategy);
+    }
+}
+
 /*
  * This function calculate the use count of the given blob.
  * output layer is regarded as an additional reference.
@@ -279,6 +329,11 @@ Status BlobManager::DeInit() {
         SharedMemoryManager::ReleaseSharedMemory(init_thread_id_, device_, config_.device_id, this);
     }
 
+    if (planned_forward_memory_ != nullptr) {
+        device_->Free(planned_forward_memory_);
+        planned_forward_memory_ = nullptr;
+    }
+
     for (auto blob : blobs_) {
         delete blob.second;
     }
@@ -291,9 +346,8 @@ Status BlobManager::DeInit() {
 }
 
 void BlobManager::OnSharedForwardMemoryChanged(void *memory) {
-    MemoryUnifyAssignStrategy strategy(memory);
     for (auto blob_memory_pool_iter : blob_memory_pool_map_) {
-        blob_memory_pool_iter.second->AssignAllBlobMemory(strategy);
+        AssignUnifyBlobMemory(blob_memory_pool_iter.second, memory);
     }
     BindBlobMemory();
 }
@@ -306,10 +360,9 @@ Status BlobManager::SetForwardMemory(void *memory) {
     if (config_.share_memory_mode != SHARE_MEMORY_MODE_SET_FROM_EXTERNAL) {
         return Status(TNNERR_NOT_SUPPORT_SET_FORWARD_MEM, "set memory from external is unsupported");
     }
-    MemoryUnifyAssignStrategy strategy(memory);
     Status status = TNN_OK;
     for (auto blob_memory_pool_iter : blob_memory_pool_map_) {
-        status = blob_memory_pool_iter.second->AssignAllBlobMemory(strategy);
+        status = AssignUnifyBlobMemory(blob_memory_pool_iter.second, memory);
     }
     if (status == TNN_OK) {
         BindBlobMemory();
@@ -375,7 +428,45 @@ void BlobManager::ReplaceBlob(std::string name, Blob *new_blob) {
 }
 
 Status BlobManager::CheckBlobMemoryState() {
-    return memory_mode_state_->GetStatus();
+    RETURN_ON_NEQ(memory_mode_state_->GetStatus(), TNN_OK);
+
+    // external memory blobs must be bound with enough memory for their current dims
+    for (const auto &iter : external_memory_size_) {
+        Blob *blob              = blobs_[iter.first];
+        BlobMemorySizeInfo info = device_->Calculate(blob->GetBlobDesc());
+        if (blob->GetHandle().base == nullptr || (int64_t)iter.second < GetBlobMemoryBytesSize(info)) {
+            LOGE("external memory of blob %s is not bound or smaller than the blob\n", iter.first.c_str());
+            return Status(TNNERR_PARAM_ERR, "external memory is not bound or smaller than the blob");
+        }
+    }
+    return TNN_OK;
+}
+
+Status BlobManager::BindExternalMemory(const std::string &name, void *memory, size_t size) {
+    auto iter = external_memory_size_.find(name);
+    if (iter == external_memory_size_.end()) {
+        LOGE("blob %s is not listed in external_memory_blobs\n", name.c_str());
+        return Status(TNNERR_PARAM_ERR, "blob is not listed in external_memory_blobs");
+    }
+    if (memory == nullptr || reinterpret_cast<uintptr_t>(memory) % g_external_memory_alignment != 0) {
+        return Status(TNNERR_PARAM_ERR, "external memory must be 32 bytes aligned");
+    }
+
+    Blob *blob              = blobs_[name];
+    BlobMemorySizeInfo info = device_->Calculate(blob->GetBlobDesc());
+    if ((int64_t)size < GetBlobMemoryBytesSize(info)) {
+        return Status(TNNERR_PARAM_ERR, "external memory is smaller than the blob");
+    }
+
+    BlobHandle handle;
+    handle.base = memory;
+    blob->SetHandle(handle);
+    iter->second = size;
+    return TNN_OK;
+}
+
+bool BlobManager::IsExternalMemoryBlob(const std::string &name) {
+    return external_memory_size_.count(name) > 0;
 }
 
 }  // namespace TNN_NS
@@ -59,6 +59,12 @@ public:
     // @brief set blob forward memory
     virtual Status SetForwardMemory(void *memory);
 
+    // @brief bind caller owned memory as the storage of a blob listed in external_memory_blobs
+    // @param name blob name
+    // @param memory 32 bytes aligned memory
+    // @param size bytes of the memory, not less than the blob bytes
+    Status BindExternalMemory(const std::string &name, void *memory, size_t size);
+
     // @brief get all input blobs
     // @param blobs blob map
     virtual Status GetAllInputBlobs(BlobMap &blobs);
@@ -81,7 +87,9 @@ public:
 
 protected:
     void BindBlobMemory();
+    Status AssignUnifyBlobMemory(BlobMemoryPool *blob_memory_pool, void *memory);
     int GetBlobUseCount(int layer_index, std::string current_blob_name);
+    bool IsExternalMemoryBlob(const std::string &name);
 
     NetworkConfig config_;
     NetStructure *net_structure_;
@@ -93,9 +101,13 @@ protected:
     std::shared_ptr<MemoryAssignStrategy> strategy_;
     std::map<std::string, Blob *> blobs_;
     std::map<Blob *, BlobMemory *> blob_memory_mapping_;
+    // bytes of the memory bound to the external memory blobs, 0 if not bound yet
+    std::map<std::string, size_t> external_memory_size_;
 
     std::thread::id init_thread_id_;
     MemoryModeState *memory_mode_state_;
+    // arena allocated for offset plan mode with default share memory mode
+    void *planned_forward_memory_;
 };
 
 }  // namespace TNN_NS
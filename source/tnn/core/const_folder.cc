@@ -47,6 +47,8 @@ Status ConstFolder::Init(NetworkConfig &net_config, ModelConfig &model_config, A
                             InputShapesMap min_inputs_shape, InputShapesMap max_inputs_shape) {
     config_ = net_config;
     config_.device_type = DEVICE_NAIVE;
+    // the const folder runs on its own blobs
+    config_.external_memory_blobs.clear();
     runtime_blob_pool_ = BlobMemoryPoolFactory::CreateBlobMemoryPool(GetDevice(DEVICE_NAIVE));
     
     runtime_model_ = RUNTIME_MODE_CONST_FOLD;
@@ -18,6 +18,8 @@
 
 namespace TNN_NS {
 
+static thread_local int g_worker_index = 0;
+
 // this function is called before forward by Network.
 Status Context::OnInstanceForwardBegin() {
     return TNN_OK;
@@ -46,6 +48,14 @@ Status Context::SetNumThreads(int num_threads) {
     return TNN_OK;
 }
 
+/*
+ * Implement by the actual context such as X86Context etc.
+ * Not implemented for this default context.
+ */
+Status Context::SetCpuAffinity(const std::vector<int> &cpu_list, int numa_node) {
+    return TNN_OK;
+}
+
 void Context::SetPrecision(Precision precision) {
     precision_ = precision;
 }
@@ -78,6 +88,29 @@ std::string Context::GetCacheFilePath() {
     return cache_file_path_;
 }
 
+void Context::SetWeightCacheFile(std::shared_ptr<WeightCacheFile> weight_cache_file) {
+    weight_cache_file_ = weight_cache_file;
+}
+
+std::shared_ptr<WeightCacheFile> Context::GetWeightCacheFile() {
+    return weight_cache_file_;
+}
+
+void* Context::GetLayerState(const std::string &name, size_t bytes_size, bool *created) {
+    std::lock_guard<std::mutex> guard(layer_states_mutex_);
+    auto &state = layer_states_[name];
+    *created    = state.size() != bytes_size;
+    if (*created) {
+        state.assign(bytes_size, 0);
+    }
+    return state.data();
+}
+
+void Context::ResetLayerStates() {
+    std::lock_guard<std::mutex> guard(layer_states_mutex_);
+    layer_states_.clear();
+}
+
 #if TNN_PROFILE
 void Context::StartProfile() {
     profile_layer     = true;
@@ -96,4 +129,12 @@ void Context::AddProfilingData(std::shared_ptr<ProfilingData> pdata) {
 }
 #endif
 
+void Context::SetWorkerIndex(int index) {
+    g_worker_index = index;
+}
+
+int Context::GetWorkerIndex() {
+    return g_worker_index;
+}
+
 }  // namespace TNN_NS
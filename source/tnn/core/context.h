@@ -15,7 +15,9 @@
 #ifndef TNN_SOURCE_TNN_CORE_CONTEXT_H_
 #define TNN_SOURCE_TNN_CORE_CONTEXT_H_
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -26,6 +28,8 @@
 
 namespace TNN_NS {
 
+class WeightCacheFile;
+
 class Context {
 public:
     // @brief virtual destructor
@@ -59,6 +63,11 @@ public:
     // @brief set threads run on device
     virtual Status SetNumThreads(int num_threads);
 
+    // @brief pin the threads run on device to cpus
+    // @param cpu_list cpu ids, the cpus of numa_node are used if empty
+    // @param numa_node numa node id, -1 means no pinning if cpu_list is empty
+    virtual Status SetCpuAffinity(const std::vector<int> &cpu_list, int numa_node);
+
     void SetPrecision(Precision precision);
 
     Precision GetPrecision();
@@ -75,6 +84,26 @@ public:
 
     std::string GetCacheFilePath();
 
+    // @brief set the file caching the weights transformed by layer accs, nullptr if no cache
+    void SetWeightCacheFile(std::shared_ptr<WeightCacheFile> weight_cache_file);
+
+    std::shared_ptr<WeightCacheFile> GetWeightCacheFile();
+
+    // @brief get the state a stateful layer keeps across forwards of the instance, e.g. the hidden
+    // state of streaming rnn. The state is created zeroed on the first call and when bytes_size
+    // changes, created is set to true then.
+    void* GetLayerState(const std::string &name, size_t bytes_size, bool *created);
+
+    // @brief release the states of stateful layers, they start from the initial state on the next forward
+    void ResetLayerStates();
+
+    // @brief set the index of the inter-op worker running layers on the current thread,
+    // layers running on different workers must not share work space
+    static void SetWorkerIndex(int index);
+
+    // @brief get the index of the inter-op worker on the current thread, 0 by default
+    static int GetWorkerIndex();
+
 #if TNN_PROFILE
 public:
     virtual void StartProfile();
@@ -92,6 +121,10 @@ protected:
     bool enable_tune_kernel_ = true;
     std::string cache_path_ = ""; // dir to save cache files
     std::string cache_file_path_ = "";
+    std::shared_ptr<WeightCacheFile> weight_cache_file_ = nullptr;
+
+    std::mutex layer_states_mutex_;
+    std::map<std::string, std::vector<char>> layer_states_;
 };
 
 }  // namespace TNN_NS
@@ -16,11 +16,17 @@
 
 #include <string.h>
 
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+
 #include "tnn/core/blob_int8.h"
 #include "tnn/core/profile.h"
 #include "tnn/interpreter/default_model_interpreter.h"
 #include "tnn/interpreter/layer_param.h"
 #include "tnn/interpreter/layer_resource_generator.h"
+#include "tnn/interpreter/tnn/model_packer.h"
 #include "tnn/memory_manager/blob_memory_pool_factory.h"
 #include "tnn/optimizer/net_optimizer_manager.h"
 #include "tnn/utils/blob_dump_utils.h"
@@ -30,6 +36,7 @@
 #include "tnn/utils/dims_utils.h"
 #include "tnn/utils/md5.h"
 #include "tnn/utils/string_utils_inner.h"
+#include "tnn/utils/weight_cache_file.h"
 
 namespace TNN_NS {
 
@@ -49,12 +56,43 @@ DefaultNetwork::~DefaultNetwork() {
 }
 
 Status DefaultNetwork::SetCpuNumThreads(int num_threads) {
+    if (fallback_context_) {
+        fallback_context_->SetNumThreads(num_threads);
+    }
     if (context_)
         return context_->SetNumThreads(num_threads);
     else
         return Status(TNNERR_CONTEXT_ERR, "context is nil");
 }
 
+static inline bool IsCpuDevice(DeviceType device_type) {
+    return device_type == DEVICE_NAIVE || device_type == DEVICE_X86 || device_type == DEVICE_ARM;
+}
+
+// the optimized net and the packed weights of naive and x86 are cached under the cache path.
+// nets with constants are not cached, their optimized net depends on the constant folding
+static inline bool UseCpuCache(NetworkConfig &net_config, NetResource *net_resource) {
+    return (net_config.device_type == DEVICE_NAIVE || net_config.device_type == DEVICE_X86) &&
+           !net_config.cache_path.empty() && net_resource->constant_map.empty() &&
+           net_resource->blob_shapes_map.empty();
+}
+
+// the layer accs of naive and x86 are kept per input shape if the reshape plan cache is set.
+// layers with constant inputs change their params when reshaped, their nets are not cached
+static inline bool UseReshapePlanCache(NetworkConfig &net_config, NetResource *net_resource,
+                                       const std::vector<BaseLayer *> &layers) {
+    if ((net_config.device_type != DEVICE_NAIVE && net_config.device_type != DEVICE_X86) ||
+        net_config.reshape_plan_cache_size <= 0 || !net_resource->constant_map.empty()) {
+        return false;
+    }
+    for (auto layer : layers) {
+        if (layer->IsOutputConstant()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 /*
  * The Network holds blob, blobmanager, layers etc.
  * Those object is initialized in this function.
@@ -77,6 +115,10 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
     device_ = GetDevice(net_config.device_type);
     RETURN_VALUE_ON_NEQ(device_ != NULL, true, TNNERR_DEVICE_NOT_SUPPORT);
 
+    if (!net_config.external_memory_blobs.empty() && !IsCpuDevice(net_config.device_type)) {
+        return Status(TNNERR_DEVICE_NOT_SUPPORT, "external memory blobs are supported on cpu devices only");
+    }
+
     context_ = device_->CreateContext(net_config.device_id);
     RETURN_VALUE_ON_NEQ(context_ != NULL, true, TNNERR_DEVICE_CONTEXT_CREATE);
 
@@ -89,6 +131,9 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
     context_->SetPrecision(net_config.precision);
     context_->SetEnableTuneKernel(net_config.enable_tune_kernel);
 
+    ret = context_->SetCpuAffinity(net_config.cpu_affinity, net_config.numa_node);
+    RETURN_ON_NEQ(ret, TNN_OK);
+
     if(!net_config.cache_path.empty()) {
         auto params_md5 = default_interpreter->GetParamsMd5();
         if (params_md5.size() < 1) {
@@ -98,6 +143,19 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
         context_->SetCacheFilePath(GenerateCacheFileName(model_config, params_md5[0]));
     }
 
+    // the cpu cache depends on the weights too, it is keyed by the md5 of all model params
+    std::string cpu_cache_prefix = "";
+    if (runtime_model_ == RUNTIME_MODE_NORMAL && UseCpuCache(net_config, net_resource)) {
+        std::string params_md5 = "";
+        for (const auto &item : default_interpreter->GetParamsMd5()) {
+            params_md5 += item;
+        }
+        params_md5       = md5(params_md5);
+        cpu_cache_prefix = net_config.cache_path + "/" + GenerateCacheFileName(model_config, params_md5) + "_" +
+                           ToString(net_config.data_format);
+        context_->SetWeightCacheFile(WeightCacheFile::Open(cpu_cache_prefix + ".weights"));
+    }
+
     ret = context_->LoadLibrary(net_config.library_path);
     RETURN_ON_NEQ(ret, TNN_OK);
 
@@ -109,8 +167,17 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
     if (runtime_model_ == RUNTIME_MODE_NORMAL) {
         // use mutex to protect net_resource and net_structure in multi-thread
         std::unique_lock<std::mutex> lck(optimize_mtx_);
-        ret = optimizer::NetOptimizerManager::Optimize(net_structure, net_resource, net_config);
-        RETURN_ON_NEQ(ret, TNN_OK);
+        if (cpu_cache_prefix.empty() || LoadNetCache(cpu_cache_prefix, &net_structure, &net_resource) != TNN_OK) {
+            ret = optimizer::NetOptimizerManager::Optimize(net_structure, net_resource, net_config);
+            RETURN_ON_NEQ(ret, TNN_OK);
+
+            if (!cpu_cache_prefix.empty()) {
+                auto status = SaveNetCache(cpu_cache_prefix, net_structure, net_resource);
+                if (status != TNN_OK) {
+                    LOGE("save net cache failed: %s\n", status.description().c_str());
+                }
+            }
+        }
     }
 
     blob_manager_ = new BlobManager(device_);
@@ -134,6 +201,30 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
     RETURN_ON_NEQ(ret, TNN_OK);
 
     ret = context_->OnInstanceReshapeEnd();
+    RETURN_ON_NEQ(ret, TNN_OK);
+
+    if (runtime_model_ == RUNTIME_MODE_NORMAL && UseReshapePlanCache(net_config, net_resource, layers_)) {
+        BlobMap input_blobs;
+        blob_manager_->GetAllInputBlobs(input_blobs);
+        reshape_plan_cache_ = std::make_shared<ReshapePlanCache>(net_config.reshape_plan_cache_size);
+        reshape_plan_key_   = ReshapePlanCache::GetKey(input_blobs);
+    }
+
+    // the weights packed by the layers are saved for later processes
+    if (context_->GetWeightCacheFile()) {
+        auto status = context_->GetWeightCacheFile()->Save();
+        if (status != TNN_OK) {
+            LOGE("save weight cache failed: %s\n", status.description().c_str());
+        }
+    }
+
+    // layer profiling and blob dump rely on the forward order of layers
+#if !(TNN_PROFILE || DUMP_INPUT_BLOB || DUMP_OUTPUT_BLOB)
+    if (net_config.inter_op_threads > 1 && IsCpuDevice(net_config.device_type)) {
+        inter_op_executor_      = std::make_shared<InterOpExecutor>(net_config.inter_op_threads);
+        inter_op_graph_changed_ = true;
+    }
+#endif
     return ret;
 }
 
@@ -311,10 +402,18 @@ Status DefaultNetwork::InitLayers(NetStructure *net_structure, NetResource *net_
             layer_resource = net_resource->resource_map[layer_name].get();
         }
         
+        AbstractDevice *layer_device = device_;
+        Context *layer_context       = context_;
+        ret = SelectLayerDevice(layer_info, &layer_device, &layer_context);
+        if (ret != TNN_OK) {
+            delete cur_layer;
+            return ret;
+        }
+
         cur_layer->SetRuntimeMode(runtime_model_);
         cur_layer->SetConstantResource(&net_resource->constant_map);
         cur_layer->SetConstantResourceFlag(&net_resource->constant_blob_flags);
-        ret = cur_layer->Init(context_, layer_info->param.get(), layer_resource, inputs, outputs, device_);
+        ret = cur_layer->Init(layer_context, layer_info->param.get(), layer_resource, inputs, outputs, layer_device);
         if (ret != TNN_OK) {
             LOGE("Error Init layer %s (err: %d or 0x%X)\n", cur_layer->GetLayerName().c_str(), (int)ret, (int)ret);
             // release layer if Init failed
@@ -325,9 +424,57 @@ Status DefaultNetwork::InitLayers(NetStructure *net_structure, NetResource *net_
 
         layers_.push_back(cur_layer);
     }
+
+    if (!fallback_layers_.empty()) {
+        std::string names;
+        for (const auto &name : fallback_layers_) {
+            names += (names.empty() ? "" : ", ") + name;
+        }
+        LOGI("DefaultNetwork::InitLayers %d of %d layers fall back to naive device: %s\n",
+             (int)fallback_layers_.size(), (int)layers_.size(), names.c_str());
+    }
     return ret;
 }
 
+/*
+ * Layers not implemented on x86 run on the naive device instead of failing the
+ * whole network. Both devices keep blobs in host memory with NCHW layout and the
+ * same data types, so the blobs are shared across the boundary and the reformat
+ * between the two devices is an identity, no reformat layer is inserted.
+ */
+Status DefaultNetwork::SelectLayerDevice(std::shared_ptr<LayerInfo> layer_info, AbstractDevice **device,
+                                         Context **context) {
+    *device  = device_;
+    *context = context_;
+    if (device_->GetDeviceType() != DEVICE_X86) {
+        return TNN_OK;
+    }
+
+    auto layouts = device_->GetImplementedLayout(layer_info->type);
+    if (layouts && layouts->layouts.size() > 0) {
+        return TNN_OK;
+    }
+
+    // layer init reports the missing layer acc if the naive device is not built
+    auto fallback_device = GetDevice(DEVICE_NAIVE);
+    if (fallback_device == nullptr) {
+        return TNN_OK;
+    }
+
+    if (fallback_context_ == nullptr) {
+        fallback_context_ = fallback_device->CreateContext(config_.device_id);
+        RETURN_VALUE_ON_NEQ(fallback_context_ != NULL, true, TNNERR_DEVICE_CONTEXT_CREATE);
+        fallback_context_->SetPrecision(config_.precision);
+    }
+
+    LOGD("DefaultNetwork::SelectLayerDevice layer %s (type: %d) is not implemented on x86, run on naive device\n",
+         layer_info->name.c_str(), layer_info->type);
+    fallback_layers_.push_back(layer_info->name);
+    *device  = fallback_device;
+    *context = fallback_context_;
+    return TNN_OK;
+}
+
 Status DefaultNetwork::AllocateBlobMemory() {
     return blob_manager_->AllocateBlobMemory(DATA_FLAG_CHANGE_ALWAYS);
 }
@@ -429,9 +576,28 @@ Status DefaultNetwork::GetForwardMemorySize(int &memory_size) {
 }
 
 Status DefaultNetwork::SetForwardMemory(void *memory) {
+    WaitAsyncForward();
+    inter_op_graph_changed_ = true;
     return blob_manager_->SetForwardMemory(memory);
 }
 
+Status DefaultNetwork::BindExternalMemory(const std::string &blob_name, void *memory, size_t size) {
+    // the forwards queued by ForwardAsync run with the memory bound before
+    WaitAsyncForward();
+    inter_op_graph_changed_ = true;
+    return blob_manager_->BindExternalMemory(blob_name, memory, size);
+}
+
+Status DefaultNetwork::ResetLayerStates() {
+    // the forwards queued by ForwardAsync run with the states before
+    WaitAsyncForward();
+    context_->ResetLayerStates();
+    if (fallback_context_) {
+        fallback_context_->ResetLayerStates();
+    }
+    return TNN_OK;
+}
+
 Status DefaultNetwork::GetAllInputBlobs(BlobMap &blobs) {
     blob_manager_->GetAllInputBlobs(blobs);
     return TNN_OK;
@@ -451,6 +617,7 @@ Status DefaultNetwork::GetAllOutputBlobs(BlobMap &blobs) {
  * Memory allocation may be involved in Reshape function.
  */
 Status DefaultNetwork::Reshape(const InputShapesMap &inputs) {
+    WaitAsyncForward();
     Status ret = TNN_OK;
     bool do_reshape = false;
     for (auto iter : inputs) {
@@ -466,12 +633,13 @@ Status DefaultNetwork::Reshape(const InputShapesMap &inputs) {
     }
 
     if(do_reshape) {
+        inter_op_graph_changed_ = true;
         ret = context_->OnInstanceReshapeBegin();
         if (ret != TNN_OK) {
             return ret;
         }
 
-        ret = ReshapeLayers();
+        ret = reshape_plan_cache_ ? ReshapeLayersWithPlanCache() : ReshapeLayers();
         if (ret != TNN_OK) {
             return ret;
         }
@@ -482,6 +650,13 @@ Status DefaultNetwork::Reshape(const InputShapesMap &inputs) {
 }
 
 Status DefaultNetwork::DeInit() {
+    // run the async forward jobs still queued before releasing layers and blobs
+    async_executor_    = nullptr;
+    inter_op_executor_ = nullptr;
+    // the cached layer accs are released with the layers
+    reshape_plan_cache_ = nullptr;
+    reshape_plan_key_   = "";
+
     for (size_t i = 0; i < layers_.size(); i++) {
         if (layers_[i] != NULL) {
             delete layers_[i];
@@ -504,6 +679,13 @@ Status DefaultNetwork::DeInit() {
         context_ = NULL;
     }
 
+    if (fallback_context_ != NULL) {
+        delete fallback_context_;
+        fallback_context_ = NULL;
+    }
+    fallback_layers_.clear();
+    cache_interpreter_ = nullptr;
+
     return TNN_OK;
 }
 /*
@@ -538,6 +720,7 @@ Context* DefaultNetwork::GetContext() {
 }
 
 Status DefaultNetwork::Forward() {
+    WaitAsyncForward();
     auto status = blob_manager_->CheckBlobMemoryState();
     RETURN_ON_NEQ(status, TNN_OK);
     
@@ -548,6 +731,20 @@ Status DefaultNetwork::Forward() {
     
     status = context_->OnInstanceForwardBegin();
     RETURN_ON_NEQ(status, TNN_OK);
+
+    if (inter_op_executor_) {
+        // blob memory or shapes may change after the dependency graph is built
+        if (inter_op_graph_changed_) {
+            status = inter_op_executor_->Init(layers_, device_);
+            RETURN_ON_NEQ(status, TNN_OK);
+            inter_op_graph_changed_ = false;
+        }
+        status = inter_op_executor_->Forward();
+        RETURN_ON_NEQ(status, TNN_OK);
+        context_->OnInstanceForwardEnd();
+        context_->Synchronize();
+        return status;
+    }
     
     int cnt = 0;
     for (auto layer : layers_) {
@@ -618,6 +815,7 @@ Status DefaultNetwork::Forward() {
 
 #ifdef FORWARD_CALLBACK_ENABLE
 Status DefaultNetwork::ForwardWithCallback(BlobStatisticCallback before, BlobStatisticCallback after) {
+    WaitAsyncForward();
     Status result = TNN_OK;
     result        = blob_manager_->CheckBlobMemoryState();
     if (result != TNN_OK) {
@@ -653,7 +851,19 @@ Status DefaultNetwork::ForwardWithCallback(BlobStatisticCallback before, BlobSta
 
 // @brief tnn instance network infer, it will not wait
 // blob dump is not implement in this funciton.
+/*
+ * On cpu devices the forward job is queued and run on the worker thread of the
+ * network, call_back is called once it completes. Input blobs must not be changed
+ * and output blobs must not be read until then.
+ */
 Status DefaultNetwork::ForwardAsync(Callback call_back) {
+    if (IsCpuDevice(config_.device_type)) {
+        if (!async_executor_) {
+            async_executor_ = std::make_shared<AsyncForwardExecutor>(config_.async_queue_depth);
+        }
+        return async_executor_->Submit([this]() { return Forward(); }, call_back);
+    }
+
     Status result = TNN_OK;
     result        = blob_manager_->CheckBlobMemoryState();
     if (result != TNN_OK) {
@@ -669,6 +879,12 @@ Status DefaultNetwork::ForwardAsync(Callback call_back) {
     return result;
 }
 
+void DefaultNetwork::WaitAsyncForward() {
+    if (async_executor_) {
+        async_executor_->Wait();
+    }
+}
+
 #if TNN_PROFILE
 void DefaultNetwork::StartProfile() {
     context_->StartProfile();
@@ -685,6 +901,78 @@ std::string DefaultNetwork::GenerateCacheFileName(ModelConfig &model_config, std
         "_" + md5_str;
 }
 
+// replace the file of to_path with the file of from_path
+static Status ReplaceFile(const std::string &from_path, const std::string &to_path) {
+#if defined _WIN32
+    std::remove(to_path.c_str());
+#endif
+    if (std::rename(from_path.c_str(), to_path.c_str()) != 0) {
+        std::remove(from_path.c_str());
+        return Status(TNNERR_OPEN_FILE, "cache file rename failed");
+    }
+    return TNN_OK;
+}
+
+/*
+ * The optimized net is saved as a v3 model, the model file is mapped when loaded and
+ * the layer resources share the mapping.
+ */
+Status DefaultNetwork::LoadNetCache(const std::string &cache_prefix, NetStructure **net_structure,
+                                    NetResource **net_resource) {
+    std::ifstream proto_stream(cache_prefix + ".tnnproto");
+    if (!proto_stream.is_open()) {
+        return Status(TNNERR_OPEN_FILE, "net cache file not found");
+    }
+    std::string proto_content((std::istreambuf_iterator<char>(proto_stream)), std::istreambuf_iterator<char>());
+
+    ModelConfig cache_config;
+    cache_config.model_type  = MODEL_TYPE_TNN;
+    cache_config.params      = {proto_content, cache_prefix + ".tnnmodel"};
+    cache_config.enable_mmap = true;
+
+    std::shared_ptr<AbstractModelInterpreter> interpreter(CreateModelInterpreter(MODEL_TYPE_TNN));
+    auto default_interpreter = dynamic_cast<DefaultModelInterpreter *>(interpreter.get());
+    CHECK_PARAM_NULL(default_interpreter);
+    auto status = interpreter->Interpret(cache_config);
+    if (status != TNN_OK) {
+        LOGE("load net cache %s failed: %s\n", cache_prefix.c_str(), status.description().c_str());
+        return status;
+    }
+
+    cache_interpreter_ = interpreter;
+    *net_structure     = default_interpreter->GetNetStructure();
+    *net_resource      = default_interpreter->GetNetResource();
+    LOGD("load net cache %s\n", cache_prefix.c_str());
+    return TNN_OK;
+}
+
+/*
+ * The files are written to temporary files and renamed, the proto is renamed last as the
+ * net cache is loaded only if the proto exists.
+ */
+Status DefaultNetwork::SaveNetCache(const std::string &cache_prefix, NetStructure *net_structure,
+                                    NetResource *net_resource) {
+    const std::string temp_suffix = "." + std::to_string(std::random_device()()) + ".tmp";
+    const std::string proto_path  = cache_prefix + ".tnnproto";
+    const std::string model_path  = cache_prefix + ".tnnmodel";
+
+    ModelPacker packer(net_structure, net_resource);
+    packer.SetVersion(3);
+    auto status = packer.Pack(proto_path + temp_suffix, model_path + temp_suffix);
+    if (status != TNN_OK) {
+        std::remove((proto_path + temp_suffix).c_str());
+        std::remove((model_path + temp_suffix).c_str());
+        return status;
+    }
+
+    status = ReplaceFile(model_path + temp_suffix, model_path);
+    if (status != TNN_OK) {
+        std::remove((proto_path + temp_suffix).c_str());
+        return status;
+    }
+    return ReplaceFile(proto_path + temp_suffix, proto_path);
+}
+
 Status DefaultNetwork::ReshapeLayers() {
     for (auto cur_layer : layers_) {
         auto status = cur_layer->Reshape();
@@ -695,4 +983,48 @@ Status DefaultNetwork::ReshapeLayers() {
     return TNN_OK;
 }
 
+/*
+ * The layer accs in use are kept in the plan cache under the key of the input shapes they are
+ * reshaped for. The output dims are always inferred again, they are cheap and some layers keep
+ * shape dependent params. Only the layer accs, which derive gemm blocking, workspace sizes and
+ * transformed data from the dims, are swapped. A shape not cached gets new layer accs, packed
+ * weights are shared with the cached ones by the weight cache of the device.
+ */
+Status DefaultNetwork::ReshapeLayersWithPlanCache() {
+    BlobMap input_blobs;
+    blob_manager_->GetAllInputBlobs(input_blobs);
+    const std::string key = ReshapePlanCache::GetKey(input_blobs);
+
+    for (auto cur_layer : layers_) {
+        auto status = cur_layer->InferShape();
+        RETURN_ON_NEQ(status, TNN_OK);
+    }
+    if (key == reshape_plan_key_) {
+        return TNN_OK;
+    }
+
+    ReshapePlanCache::LayerAccs layer_accs;
+    if (!reshape_plan_cache_->Take(key, layer_accs)) {
+        for (auto cur_layer : layers_) {
+            AbstractLayerAcc *layer_acc = nullptr;
+            auto status                 = cur_layer->CreateLayerAcc(&layer_acc);
+            layer_accs.push_back(layer_acc);
+            if (status != TNN_OK) {
+                for (auto created_acc : layer_accs) {
+                    delete created_acc;
+                }
+                return status;
+            }
+        }
+    }
+
+    ReshapePlanCache::LayerAccs used_layer_accs;
+    for (size_t i = 0; i < layers_.size(); i++) {
+        used_layer_accs.push_back(layers_[i]->SwapLayerAcc(layer_accs[i]));
+    }
+    reshape_plan_cache_->Put(reshape_plan_key_, used_layer_accs);
+    reshape_plan_key_ = key;
+    return TNN_OK;
+}
+
 }  // namespace TNN_NS
@@ -19,12 +19,15 @@
 
 #include "tnn/core/abstract_device.h"
 #include "tnn/core/abstract_network.h"
+#include "tnn/core/async_forward_executor.h"
 #include "tnn/core/blob.h"
 #include "tnn/core/blob_manager.h"
 #include "tnn/core/common.h"
 #include "tnn/core/context.h"
+#include "tnn/core/inter_op_executor.h"
 #include "tnn/core/macro.h"
 #include "tnn/core/profile.h"
+#include "tnn/core/reshape_plan_cache.h"
 #include "tnn/core/status.h"
 #include "tnn/interpreter/abstract_model_interpreter.h"
 #include "tnn/interpreter/layer_resource.h"
@@ -71,7 +74,8 @@ public:
     virtual Status ForwardWithCallback(BlobStatisticCallback before, BlobStatisticCallback after);
 #endif  // end of FORWARD_CALLBACK_ENABLE
 
-    // @brief tnn instance network infer, it will not wait
+    // @brief tnn instance network infer, it will not wait. On cpu devices call_back is
+    // called on the worker thread of the network once the forward completes
     virtual Status ForwardAsync(Callback call_back);
 
     // @brief network deinit to release init create resource
@@ -83,6 +87,13 @@ public:
     // @brief set forward memory when share memory mode is set from external
     virtual Status SetForwardMemory(void *memory);
 
+    // @brief bind caller owned memory as the storage of an input or output blob
+    // listed in NetworkConfig::external_memory_blobs
+    virtual Status BindExternalMemory(const std::string &blob_name, void *memory, size_t size);
+
+    // @brief reset the states stateful layers keep in the contexts across forwards
+    virtual Status ResetLayerStates();
+
     // @brief get all input blobs
     virtual Status GetAllInputBlobs(BlobMap &blobs);
 
@@ -109,17 +120,47 @@ protected:
 
     std::string GenerateCacheFileName(ModelConfig &model_config, std::string& md5_str);
 
+    // @brief load the optimized net of cpu devices saved under the cache path
+    Status LoadNetCache(const std::string &cache_prefix, NetStructure **net_structure, NetResource **net_resource);
+    // @brief save the optimized net of cpu devices under the cache path
+    Status SaveNetCache(const std::string &cache_prefix, NetStructure *net_structure, NetResource *net_resource);
+
+    // @brief select the device and context a layer runs on, layers not implemented
+    // on x86 fall back to the naive device
+    Status SelectLayerDevice(std::shared_ptr<LayerInfo> layer_info, AbstractDevice **device, Context **context);
+
     AbstractDevice *device_ = nullptr;
     Context *context_       = nullptr;
     Context *GetContext();
 
+    // context of the fallback device, created when the first layer falls back
+    Context *fallback_context_ = nullptr;
+    // names of the layers placed on the fallback device
+    std::vector<std::string> fallback_layers_;
+
     std::vector<BaseLayer *> layers_;
 
     BlobManager *blob_manager_ = nullptr;
     BlobMemoryPool *runtime_blob_pool_ = nullptr;
 
+    // run independent layers concurrently if inter_op_threads is set
+    std::shared_ptr<InterOpExecutor> inter_op_executor_ = nullptr;
+    bool inter_op_graph_changed_ = true;
+
+    // run ForwardAsync jobs on cpu devices, created on the first ForwardAsync
+    std::shared_ptr<AsyncForwardExecutor> async_executor_ = nullptr;
+    // @brief wait for the queued ForwardAsync jobs to complete
+    void WaitAsyncForward();
+
+    // keeps the layer accs reshaped for recent input shapes if reshape_plan_cache_size is set
+    std::shared_ptr<ReshapePlanCache> reshape_plan_cache_ = nullptr;
+    // key of the input shapes the layer accs in use are reshaped for
+    std::string reshape_plan_key_ = "";
+
     NetStructure *net_structure_ = nullptr;
     NetResource *net_resource_ = nullptr;
+    // holds the optimized net loaded from the cache path, released after the layers
+    std::shared_ptr<AbstractModelInterpreter> cache_interpreter_ = nullptr;
 
     NetworkConfig config_;
 
@@ -128,6 +169,7 @@ protected:
 private:
 
    Status ReshapeLayers();
+   Status ReshapeLayersWithPlanCache();
 
 };
 
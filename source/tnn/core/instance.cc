@@ -116,6 +116,14 @@ Status Instance::SetForwardMemory(void *memory) {
     return network_->SetForwardMemory(memory);
 }
 
+Status Instance::BindExternalMemory(const std::string &blob_name, void *memory, size_t size) {
+    return network_->BindExternalMemory(blob_name, memory, size);
+}
+
+Status Instance::ResetLayerStates() {
+    return network_->ResetLayerStates();
+}
+
 Status Instance::Reshape(const InputShapesMap &inputs) {
     Status status = TNN_OK;
     if (const_folder_) {
@@ -0,0 +1,251 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/core/inter_op_executor.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+#include "tnn/core/context.h"
+#include "tnn/memory_manager/blob_memory_size_info.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+struct BlobMemoryRange {
+    char *begin = nullptr;
+    char *end   = nullptr;
+};
+
+static BlobMemoryRange GetBlobMemoryRange(Blob *blob, AbstractDevice *device) {
+    BlobMemoryRange range;
+    auto handle = blob->GetHandle();
+    auto info   = device->Calculate(blob->GetBlobDesc());
+    range.begin = reinterpret_cast<char *>(handle.base) + handle.bytes_offset;
+    range.end   = range.begin + GetBlobMemoryBytesSize(info);
+    return range;
+}
+
+static bool IsOverlapped(const BlobMemoryRange &a, const BlobMemoryRange &b) {
+    return a.begin < b.end && b.begin < a.end;
+}
+
+InterOpExecutor::InterOpExecutor(int num_workers)
+    : num_workers_(std::max(num_workers, 1)), queued_tasks_(0), remaining_tasks_(0), failed_(false) {
+    for (int i = 0; i < num_workers_; ++i) {
+        queues_.emplace_back(new WorkerQueue());
+    }
+    for (int i = 1; i < num_workers_; ++i) {
+        workers_.emplace_back(&InterOpExecutor::WorkerLoop, this, i);
+    }
+}
+
+InterOpExecutor::~InterOpExecutor() {
+    {
+        std::lock_guard<std::mutex> guard(wait_mutex_);
+        stop_ = true;
+    }
+    wait_cv_.notify_all();
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+}
+
+/*
+ * A layer depends on the producers of its inputs. As blob memory is reused, a layer
+ * also depends on every earlier layer reading or writing a blob whose memory overlaps
+ * its outputs, so that memory is never overwritten while another branch still uses it.
+ */
+Status InterOpExecutor::Init(const std::vector<BaseLayer *> &layers, AbstractDevice *device) {
+    nodes_.clear();
+    roots_.clear();
+
+    std::map<Blob *, int> producers;
+    std::map<Blob *, BlobMemoryRange> ranges;
+    // layers reading or writing each blob in forward order
+    std::vector<std::pair<Blob *, std::vector<int>>> accessors;
+    std::map<Blob *, int> accessor_index;
+
+    auto add_accessor = [&](Blob *blob, int layer_index) {
+        if (accessor_index.find(blob) == accessor_index.end()) {
+            accessor_index[blob] = (int)accessors.size();
+            accessors.push_back(std::make_pair(blob, std::vector<int>()));
+            ranges[blob] = GetBlobMemoryRange(blob, device);
+        }
+        accessors[accessor_index[blob]].second.push_back(layer_index);
+    };
+
+    for (int index = 0; index < (int)layers.size(); ++index) {
+        auto layer = layers[index];
+        std::set<int> predecessors;
+        for (auto blob : layer->GetInputBlobs()) {
+            if (producers.find(blob) != producers.end()) {
+                predecessors.insert(producers[blob]);
+            }
+        }
+        for (auto blob : layer->GetOutputBlobs()) {
+            auto range = GetBlobMemoryRange(blob, device);
+            for (const auto &accessor : accessors) {
+                if (accessor.first == blob || !IsOverlapped(range, ranges[accessor.first])) {
+                    continue;
+                }
+                predecessors.insert(accessor.second.begin(), accessor.second.end());
+            }
+        }
+        predecessors.erase(index);
+
+        std::unique_ptr<LayerNode> node(new LayerNode());
+        node->layer        = layer;
+        node->predecessors = std::vector<int>(predecessors.begin(), predecessors.end());
+        node->pending      = 0;
+        for (auto predecessor : predecessors) {
+            nodes_[predecessor]->successors.push_back(index);
+        }
+        if (predecessors.empty()) {
+            roots_.push_back(index);
+        }
+        nodes_.push_back(std::move(node));
+
+        for (auto blob : layer->GetInputBlobs()) {
+            add_accessor(blob, index);
+        }
+        for (auto blob : layer->GetOutputBlobs()) {
+            add_accessor(blob, index);
+            producers[blob] = index;
+        }
+    }
+    return TNN_OK;
+}
+
+std::vector<std::vector<int>> InterOpExecutor::GetDependencies() {
+    std::vector<std::vector<int>> dependencies;
+    for (const auto &node : nodes_) {
+        dependencies.push_back(node->predecessors);
+    }
+    return dependencies;
+}
+
+Status InterOpExecutor::Forward() {
+    if (nodes_.empty()) {
+        return TNN_OK;
+    }
+
+    const int total_threads = OMP_MAX_THREADS_NUM_;
+    intra_op_threads_       = std::max(total_threads / num_workers_, 1);
+    OMP_SET_THREADS_(intra_op_threads_);
+
+    for (auto &node : nodes_) {
+        node->pending = (int)node->predecessors.size();
+    }
+    status_          = TNN_OK;
+    failed_          = false;
+    remaining_tasks_ = (int)nodes_.size();
+    for (size_t i = 0; i < roots_.size(); ++i) {
+        PushTask((int)(i % num_workers_), roots_[i]);
+    }
+
+    while (true) {
+        RunTasks(0);
+        std::unique_lock<std::mutex> lock(wait_mutex_);
+        wait_cv_.wait(lock, [this] { return remaining_tasks_ == 0 || queued_tasks_ > 0; });
+        if (remaining_tasks_ == 0) {
+            break;
+        }
+    }
+
+    OMP_SET_THREADS_(total_threads);
+    return status_;
+}
+
+void InterOpExecutor::WorkerLoop(int worker_index) {
+    Context::SetWorkerIndex(worker_index);
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(wait_mutex_);
+            wait_cv_.wait(lock, [this] { return stop_ || queued_tasks_ > 0; });
+            if (stop_) {
+                return;
+            }
+        }
+        OMP_SET_THREADS_(intra_op_threads_);
+        RunTasks(worker_index);
+    }
+}
+
+void InterOpExecutor::RunTasks(int worker_index) {
+    int task = 0;
+    while (PopTask(worker_index, task)) {
+        RunLayer(worker_index, task);
+    }
+}
+
+// pop from the back of its own queue, or steal from the front of others
+bool InterOpExecutor::PopTask(int worker_index, int &task) {
+    for (int i = 0; i < num_workers_; ++i) {
+        auto &queue = queues_[(worker_index + i) % num_workers_];
+        std::lock_guard<std::mutex> guard(queue->mutex);
+        if (queue->tasks.empty()) {
+            continue;
+        }
+        if (i == 0) {
+            task = queue->tasks.back();
+            queue->tasks.pop_back();
+        } else {
+            task = queue->tasks.front();
+            queue->tasks.pop_front();
+        }
+        queued_tasks_--;
+        return true;
+    }
+    return false;
+}
+
+void InterOpExecutor::PushTask(int worker_index, int task) {
+    {
+        std::lock_guard<std::mutex> guard(queues_[worker_index]->mutex);
+        queues_[worker_index]->tasks.push_back(task);
+        queued_tasks_++;
+    }
+    std::lock_guard<std::mutex> guard(wait_mutex_);
+    wait_cv_.notify_one();
+}
+
+void InterOpExecutor::RunLayer(int worker_index, int task) {
+    auto &node = nodes_[task];
+    // layers after a failure are skipped, but still counted to finish the forward
+    if (!failed_) {
+        Status status = node->layer->Forward();
+        if (status != TNN_OK) {
+            std::lock_guard<std::mutex> guard(wait_mutex_);
+            if (!failed_) {
+                LOGE("Forward error %s, exit\n", status.description().c_str());
+                status_ = status;
+                failed_ = true;
+            }
+        }
+    }
+
+    for (auto successor : node->successors) {
+        if (--nodes_[successor]->pending == 0) {
+            PushTask(worker_index, successor);
+        }
+    }
+    if (--remaining_tasks_ == 0) {
+        std::lock_guard<std::mutex> guard(wait_mutex_);
+        wait_cv_.notify_all();
+    }
+}
+
+}  // namespace TNN_NS
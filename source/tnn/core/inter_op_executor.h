@@ -0,0 +1,89 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_CORE_INTER_OP_EXECUTOR_H_
+#define TNN_SOURCE_TNN_CORE_INTER_OP_EXECUTOR_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "tnn/core/abstract_device.h"
+#include "tnn/core/status.h"
+#include "tnn/layer/base_layer.h"
+
+namespace TNN_NS {
+
+// @brief InterOpExecutor runs the layers of a network concurrently. A layer depends on
+// the layers producing its inputs, and on the earlier layers accessing memory its outputs
+// reuse. Ready layers are dispatched to per worker queues, idle workers steal from others.
+class InterOpExecutor {
+public:
+    // @brief the calling thread of Forward works as worker 0
+    explicit InterOpExecutor(int num_workers);
+
+    ~InterOpExecutor();
+
+    // @brief build the dependency graph of layers, must be called again after
+    // blob memory or shapes change
+    Status Init(const std::vector<BaseLayer *> &layers, AbstractDevice *device);
+
+    // @brief run all layers, the intra-op threads of the calling thread are divided among workers
+    Status Forward();
+
+    // @brief get the predecessors of each layer in the dependency graph
+    std::vector<std::vector<int>> GetDependencies();
+
+private:
+    struct LayerNode {
+        BaseLayer *layer = nullptr;
+        std::vector<int> predecessors;
+        std::vector<int> successors;
+        std::atomic<int> pending;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<int> tasks;
+    };
+
+    void WorkerLoop(int worker_index);
+    void RunTasks(int worker_index);
+    bool PopTask(int worker_index, int &task);
+    void PushTask(int worker_index, int task);
+    void RunLayer(int worker_index, int task);
+
+    int num_workers_      = 1;
+    int intra_op_threads_ = 1;
+    std::vector<std::unique_ptr<LayerNode>> nodes_;
+    std::vector<int> roots_;
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> workers_;
+    std::mutex wait_mutex_;
+    std::condition_variable wait_cv_;
+    std::atomic<int> queued_tasks_;
+    std::atomic<int> remaining_tasks_;
+    std::atomic<bool> failed_;
+    Status status_;
+    bool stop_ = false;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_CORE_INTER_OP_EXECUTOR_H_
@@ -241,6 +241,7 @@ static std::map<std::string, LayerType> global_layer_type_map = {
     {"OneHot", LAYER_ONEHOT},
     {"CbamFusedReduce", LAYER_CBAM_FUSED_REDUCE},
     {"CbamFusedPooling", LAYER_CBAM_FUSED_POOLING},
+    {"FusedAttention", LAYER_FUSED_ATTENTION},
     {"Softsign", LAYER_SOFTSIGN}
 };
 
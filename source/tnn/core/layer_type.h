@@ -222,7 +222,8 @@ enum LayerType {
     LAYER_TRT_ENGINE                                        = 701,
 
     LAYER_CBAM_FUSED_REDUCE                                 = 800,
-    LAYER_CBAM_FUSED_POOLING                                = 801
+    LAYER_CBAM_FUSED_POOLING                                = 801,
+    LAYER_FUSED_ATTENTION                                   = 802
 };
 
 LayerType GlobalConvertLayerType(std::string layer_type_str);
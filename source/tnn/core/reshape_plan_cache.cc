@@ -0,0 +1,79 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/core/reshape_plan_cache.h"
+
+#include <sstream>
+
+namespace TNN_NS {
+
+ReshapePlanCache::ReshapePlanCache(int capacity) : capacity_(capacity) {}
+
+ReshapePlanCache::~ReshapePlanCache() {
+    for (auto &plan : plans_) {
+        Release(plan.second);
+    }
+    plans_.clear();
+}
+
+std::string ReshapePlanCache::GetKey(const BlobMap &input_blobs) {
+    std::ostringstream key;
+    for (const auto &iter : input_blobs) {
+        key << iter.first << ":";
+        for (auto dim : iter.second->GetBlobDesc().dims) {
+            key << dim << ",";
+        }
+        key << ";";
+    }
+    return key.str();
+}
+
+bool ReshapePlanCache::Take(const std::string &key, LayerAccs &layer_accs) {
+    for (auto iter = plans_.begin(); iter != plans_.end(); ++iter) {
+        if (iter->first == key) {
+            layer_accs = iter->second;
+            plans_.erase(iter);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ReshapePlanCache::Put(const std::string &key, const LayerAccs &layer_accs) {
+    for (auto iter = plans_.begin(); iter != plans_.end(); ++iter) {
+        if (iter->first == key) {
+            Release(iter->second);
+            plans_.erase(iter);
+            break;
+        }
+    }
+    plans_.emplace_front(key, layer_accs);
+    while ((int)plans_.size() > capacity_) {
+        Release(plans_.back().second);
+        plans_.pop_back();
+    }
+}
+
+int ReshapePlanCache::GetCount() {
+    return (int)plans_.size();
+}
+
+void ReshapePlanCache::Release(LayerAccs &layer_accs) {
+    for (auto layer_acc : layer_accs) {
+        delete layer_acc;
+    }
+    layer_accs.clear();
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,63 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_CORE_RESHAPE_PLAN_CACHE_H_
+#define TNN_SOURCE_TNN_CORE_RESHAPE_PLAN_CACHE_H_
+
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tnn/core/abstract_layer_acc.h"
+#include "tnn/core/blob.h"
+
+namespace TNN_NS {
+
+// @brief ReshapePlanCache keeps the layer accs of a network reshaped for the recently
+// used input shapes, least recently used first out. Switching back to a cached shape
+// swaps the accs into the layers instead of reshaping them again.
+class ReshapePlanCache {
+public:
+    typedef std::vector<AbstractLayerAcc *> LayerAccs;
+
+    // @brief capacity is the number of plans kept besides the one in use
+    explicit ReshapePlanCache(int capacity);
+
+    // @brief release the layer accs of all plans
+    ~ReshapePlanCache();
+
+    // @brief the key of a plan, made of the dims of the input blobs
+    static std::string GetKey(const BlobMap &input_blobs);
+
+    // @brief take the layer accs of key out of the cache, return false if not cached
+    bool Take(const std::string &key, LayerAccs &layer_accs);
+
+    // @brief put the layer accs of key into the cache as the most recent plan, the cache
+    // owns them until they are taken. Plans over the capacity are released.
+    void Put(const std::string &key, const LayerAccs &layer_accs);
+
+    // @brief number of plans kept
+    int GetCount();
+
+private:
+    static void Release(LayerAccs &layer_accs);
+
+    int capacity_ = 0;
+    std::list<std::pair<std::string, LayerAccs>> plans_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_CORE_RESHAPE_PLAN_CACHE_H_
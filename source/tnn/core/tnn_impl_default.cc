@@ -38,7 +38,7 @@ Status TNNImplDefault::Init(ModelConfig& config) {
         return Status(TNNERR_NET_ERR, "interpreter is nil");
     }
     interpreter_ = std::shared_ptr<AbstractModelInterpreter>(interpreter);
-    return interpreter_->Interpret(config.params);
+    return interpreter_->Interpret(config);
 }
 
 Status TNNImplDefault::DeInit() {
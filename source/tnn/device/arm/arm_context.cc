@@ -59,13 +59,15 @@ void* ArmContext::GetSharedWorkSpace(size_t size) {
 }
 
 void* ArmContext::GetSharedWorkSpace(size_t size, int index) {
-    while(work_space_.size() < index + 1) {
-        work_space_.push_back(RawBuffer(ROUND_UP(size, 64)));
+    std::lock_guard<std::mutex> guard(work_space_mutex_);
+    auto &work_space = work_space_[GetWorkerIndex()];
+    while(work_space.size() < index + 1) {
+        work_space.push_back(RawBuffer(ROUND_UP(size, 64)));
     }
-    if (work_space_[index].GetBytesSize() < size) {
-        work_space_[index] = RawBuffer(ROUND_UP(size, 64));
+    if (work_space[index].GetBytesSize() < size) {
+        work_space[index] = RawBuffer(ROUND_UP(size, 64));
     }
-    return work_space_[index].force_to<void*>();
+    return work_space[index].force_to<void*>();
 }
 
 }  // namespace TNN_NS
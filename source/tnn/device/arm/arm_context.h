@@ -15,6 +15,9 @@
 #ifndef TNN_SOURCE_TNN_DEVICE_CPU_CPU_CONTEXT_H_
 #define TNN_SOURCE_TNN_DEVICE_CPU_CPU_CONTEXT_H_
 
+#include <map>
+#include <mutex>
+
 #include "tnn/core/context.h"
 #include "tnn/interpreter/raw_buffer.h"
 namespace TNN_NS {
@@ -51,7 +54,9 @@ public:
 
 private:
     int num_threads_ = 1;
-    std::vector<RawBuffer> work_space_;
+    // work space of each inter-op worker
+    std::map<int, std::vector<RawBuffer>> work_space_;
+    std::mutex work_space_mutex_;
 };
 
 }  // namespace TNN_NS
@@ -0,0 +1,119 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "tnn/device/cpu/acc/cpu_layer_acc.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+DECLARE_CPU_ACC(FusedAttention, LAYER_FUSED_ATTENTION);
+
+Status CpuFusedAttentionLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return TNN_OK;
+}
+
+Status CpuFusedAttentionLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto layer_param = dynamic_cast<FusedAttentionLayerParam *>(param_);
+    CHECK_PARAM_NULL(layer_param);
+    if (outputs[0]->GetBlobDesc().data_type != DATA_TYPE_FLOAT) {
+        return Status(TNNERR_LAYER_ERR, "FusedAttention only supports float");
+    }
+
+    auto q_dims      = inputs[0]->GetBlobDesc().dims;
+    auto kt_dims     = inputs[1]->GetBlobDesc().dims;
+    auto v_dims      = inputs[2]->GetBlobDesc().dims;
+    auto output_dims = outputs[0]->GetBlobDesc().dims;
+    const int seq_q   = q_dims[q_dims.size() - 2];
+    const int depth   = q_dims.back();
+    const int seq_k   = kt_dims.back();
+    const int depth_v = v_dims.back();
+
+    DimsVector batch_dims(output_dims.begin(), output_dims.end() - 2);
+    DimsVector q_batch_dims(q_dims.begin(), q_dims.end() - 2);
+    DimsVector kt_batch_dims(kt_dims.begin(), kt_dims.end() - 2);
+    DimsVector v_batch_dims(v_dims.begin(), v_dims.end() - 2);
+    const int batch = DimsVectorUtils::Count(batch_dims);
+
+    float *q      = static_cast<float *>(inputs[0]->GetHandle().base);
+    float *kt     = static_cast<float *>(inputs[1]->GetHandle().base);
+    float *v      = static_cast<float *>(inputs[2]->GetHandle().base);
+    float *output = static_cast<float *>(outputs[0]->GetHandle().base);
+
+    // the mask is broadcast to the scores [batch, seq_q, seq_k]
+    float *mask = nullptr;
+    DimsVector mask_dims, mask_batch_dims;
+    int mask_row_stride = 0, mask_col_stride = 0;
+    if (inputs.size() >= 4) {
+        mask      = static_cast<float *>(inputs[3]->GetHandle().base);
+        mask_dims = inputs[3]->GetBlobDesc().dims;
+        while (mask_dims.size() < 2) {
+            mask_dims.insert(mask_dims.begin(), 1);
+        }
+        mask_batch_dims = DimsVector(mask_dims.begin(), mask_dims.end() - 2);
+        mask_col_stride = mask_dims.back() == 1 ? 0 : 1;
+        mask_row_stride = mask_dims[mask_dims.size() - 2] == 1 ? 0 : mask_dims.back();
+    }
+
+    std::vector<float> scores(seq_k);
+    for (int b = 0; b < batch; ++b) {
+        auto q_b  = q + DimsFunctionUtils::GetBroadcastOffset(batch_dims, q_batch_dims, b) * seq_q * depth;
+        auto kt_b = kt + DimsFunctionUtils::GetBroadcastOffset(batch_dims, kt_batch_dims, b) * depth * seq_k;
+        auto v_b  = v + DimsFunctionUtils::GetBroadcastOffset(batch_dims, v_batch_dims, b) * seq_k * depth_v;
+        auto mask_b = mask ? mask + DimsFunctionUtils::GetBroadcastOffset(batch_dims, mask_batch_dims, b) *
+                                        mask_dims[mask_dims.size() - 2] * mask_dims.back()
+                           : nullptr;
+        auto output_b = output + b * seq_q * depth_v;
+
+        for (int i = 0; i < seq_q; ++i) {
+            float max_score = -FLT_MAX;
+            for (int j = 0; j < seq_k; ++j) {
+                float score = 0;
+                for (int d = 0; d < depth; ++d) {
+                    score += q_b[i * depth + d] * kt_b[d * seq_k + j];
+                }
+                score *= layer_param->scale;
+                if (mask_b) {
+                    score += mask_b[i * mask_row_stride + j * mask_col_stride];
+                }
+                scores[j] = score;
+                max_score = std::max(max_score, score);
+            }
+
+            float sum = 0;
+            for (int j = 0; j < seq_k; ++j) {
+                scores[j] = expf(scores[j] - max_score);
+                sum += scores[j];
+            }
+
+            auto output_row = output_b + i * depth_v;
+            for (int d = 0; d < depth_v; ++d) {
+                float value = 0;
+                for (int j = 0; j < seq_k; ++j) {
+                    value += scores[j] * v_b[j * depth_v + d];
+                }
+                output_row[d] = value / sum;
+            }
+        }
+    }
+
+    return TNN_OK;
+}
+
+REGISTER_CPU_ACC(FusedAttention, LAYER_FUSED_ATTENTION);
+
+}  // namespace TNN_NS
@@ -21,6 +21,7 @@ CpuLayerAcc::~CpuLayerAcc() {}
 
 Status CpuLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
                          const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    context_  = context;
     param_    = param;
     resource_ = resource;
     
@@ -47,6 +47,7 @@ public:
     virtual Status ReloadConstantBlobs(const std::vector<Blob *> &inputs, bool only_reload_shape_differ_blob = false);
 
 protected:
+    Context *context_        = nullptr;
     LayerParam *param_       = nullptr;
     LayerResource *resource_ = nullptr;
 
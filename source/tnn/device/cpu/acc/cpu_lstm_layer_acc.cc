@@ -182,9 +182,19 @@ Status CpuLSTMONNXLayerAcc::Forward(const std::vector<Blob *> &inputs, const std
     //B[iofc] Concatenation of [Wb[iofc], Rb[iofc]], [num_directions, 8*hidden_size]
     float *b = (float *)((char*)(blob_B->GetHandle().base) + blob_B->GetHandle().bytes_offset);
     
+    //stateful lstm starts from h and c of the last forward, the initial values are used after reset only
+    const int state_count = num_directions * batch * hidden_size;
+    float *state          = nullptr;
+    bool state_created    = true;
+    if (layer_param->stateful) {
+        state = (float *)context_->GetLayerState(layer_param->name, 2 * state_count * sizeof(float), &state_created);
+    }
+
     //initial_h, initial value of the hidden, If not specified - assumed to be 0. shape [num_directions, batch_size, hidden_size]
     auto h_t = (float *)((char*)(outputs[1]->GetHandle().base) + outputs[1]->GetHandle().bytes_offset);
-    if (blob_h0 != nullptr){
+    if (!state_created) {
+        memcpy(h_t, state, state_count * sizeof(float));
+    } else if (blob_h0 != nullptr){
         auto h_0 = (float *)((char*)(blob_h0->GetHandle().base) + blob_h0->GetHandle().bytes_offset);
         if (h_0) {
             memcpy((void *)h_t, h_0, num_directions * batch * hidden_size * sizeof(float));
@@ -195,7 +205,9 @@ Status CpuLSTMONNXLayerAcc::Forward(const std::vector<Blob *> &inputs, const std
     
     //initial_c, initial value of the cell, If not specified - assumed to be 0. shape [num_directions, batch_size, hidden_size]
     auto c_t = (float *)((char*)(outputs[2]->GetHandle().base) + outputs[2]->GetHandle().bytes_offset);
-    if (blob_c0 != nullptr){
+    if (!state_created) {
+        memcpy(c_t, state + state_count, state_count * sizeof(float));
+    } else if (blob_c0 != nullptr){
         auto c_0 = (float *)((char*)(blob_c0->GetHandle().base) + blob_c0->GetHandle().bytes_offset);
         if (c_0) {
             memcpy((void *)c_t, c_0, num_directions * batch * hidden_size * sizeof(float));
@@ -205,7 +217,7 @@ Status CpuLSTMONNXLayerAcc::Forward(const std::vector<Blob *> &inputs, const std
     }
     
     if (layer_param->direction == 0 || layer_param->direction == 1) {
-        return LSTM_Single(x, y, w, r, b, h_t, c_t, T, batch, input_size, hidden_size, layer_param->direction);
+        LSTM_Single(x, y, w, r, b, h_t, c_t, T, batch, input_size, hidden_size, layer_param->direction);
     } else if (layer_param->direction == 2) {
         //Y shape [num_directions sequence batch_size hidden_size]
         auto y_temp = std::shared_ptr<float>(new float[num_directions*T*batch*hidden_size], [](float* p) { delete[] p; });
@@ -233,7 +245,10 @@ Status CpuLSTMONNXLayerAcc::Forward(const std::vector<Blob *> &inputs, const std
         return Status(TNNERR_PARAM_ERR, "LSTMONNX has invalid direction param");
     }
 
-  
+    if (state) {
+        memcpy(state, h_t, state_count * sizeof(float));
+        memcpy(state + state_count, c_t, state_count * sizeof(float));
+    }
     return TNN_OK;
 }
 
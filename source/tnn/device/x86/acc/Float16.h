@@ -0,0 +1,155 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef Float16_hpp
+#define Float16_hpp
+#include <utility>
+
+#include "tnn/core/macro.h"
+#include "tnn/device/x86/x86_common.h"
+
+// Float16 holds 16 floats in a zmm register, it is only usable in code compiled for avx512,
+// see X86_AVX512_BEGIN. Transcendental functions are not provided, use Float8 for them.
+X86_AVX512_BEGIN
+
+namespace TNN_NS {
+struct Float16 {
+    __m512 value;
+    Float16() {}
+    Float16(const float v) {
+        value = _mm512_set1_ps(v);
+    }
+    Float16(const float *addr) {
+        value = _mm512_set1_ps(*addr);
+    }
+    Float16(const __m512& v) {
+        value = v;
+    }
+    Float16(const __m512&& v) {
+        value = std::move(v);
+    }
+    Float16(const Float16& lr) {
+        value = lr.value;
+    }
+    Float16(const Float16&& lr) {
+        value = std::move(lr.value);
+    }
+
+    static Float16 load(const float* addr) {
+        Float16 v;
+        v.value = _mm512_load_ps(addr);
+        return v;
+    }
+    static Float16 loadu(const float* addr) {
+        Float16 v;
+        v.value = _mm512_loadu_ps(addr);
+        return v;
+    }
+    static void save(float* addr, const Float16& v) {
+        _mm512_store_ps(addr, v.value);
+    }
+    static void saveu(float* addr, const Float16& v) {
+        _mm512_storeu_ps(addr, v.value);
+    }
+    static void mla(Float16& v1, const Float16& v2, const Float16& v3) {
+        v1.value = _mm512_fmadd_ps(v2.value, v3.value, v1.value);
+    }
+    static void mls(Float16& v1, const Float16& v2, const Float16& v3) {
+        v1.value = _mm512_fmsub_ps(v2.value, v3.value, v1.value);
+    }
+    static Float16 max(const Float16& v1, const Float16& v2) {
+        Float16 dst;
+        dst.value = _mm512_max_ps(v1.value, v2.value);
+        return dst;
+    }
+    static Float16 min(const Float16& v1, const Float16& v2) {
+        Float16 dst;
+        dst.value = _mm512_min_ps(v1.value, v2.value);
+        return dst;
+    }
+    static Float16 add(const Float16& v1, const Float16& v2) {
+        Float16 dst;
+        dst.value = _mm512_add_ps(v1.value, v2.value);
+        return dst;
+    }
+    static Float16 sub(const Float16& v1, const Float16& v2) {
+        Float16 dst;
+        dst.value = _mm512_sub_ps(v1.value, v2.value);
+        return dst;
+    }
+    static Float16 mul(const Float16& v1, const Float16& v2) {
+        Float16 dst;
+        dst.value = _mm512_mul_ps(v1.value, v2.value);
+        return dst;
+    }
+    static Float16 div(const Float16& v1, const Float16& v2) {
+        Float16 dst;
+        dst.value = _mm512_div_ps(v1.value, v2.value);
+        return dst;
+    }
+    static Float16 neg(const Float16 &v) {
+        Float16 dst;
+        dst.value = _mm512_sub_ps(_mm512_setzero_ps(), v.value);
+        return dst;
+    }
+    static Float16 abs(const Float16 &v) {
+        Float16 dst;
+        dst.value = _mm512_abs_ps(v.value);
+        return dst;
+    }
+    static Float16 sqrt(const Float16 &v) {
+        Float16 dst;
+        dst.value = _mm512_sqrt_ps(v.value);
+        return dst;
+    }
+    Float16 operator+(const Float16& lr) const {
+        Float16 dst;
+        dst.value = _mm512_add_ps(value, lr.value);
+        return dst;
+    }
+    Float16 operator-(const Float16& lr) const {
+        Float16 dst;
+        dst.value = _mm512_sub_ps(value, lr.value);
+        return dst;
+    }
+    Float16 operator*(float lr) const {
+        Float16 dst;
+        __m512 tmp = _mm512_set1_ps(lr);
+        dst.value = _mm512_mul_ps(value, tmp);
+        return dst;
+    }
+    Float16 operator*(const Float16& lr) const {
+        Float16 dst;
+        dst.value = _mm512_mul_ps(value, lr.value);
+        return dst;
+    }
+    Float16& operator=(const Float16& lr) {
+        value = lr.value;
+        return *this;
+    }
+    Float16& operator=(const Float16&& lr) {
+        value = std::move(lr.value);
+        return *this;
+    }
+    Float16 operator-() const {
+        Float16 dst;
+        dst.value = _mm512_sub_ps(_mm512_setzero_ps(), value);
+        return dst;
+    }
+};
+}  // namespace TNN_NS
+
+X86_AVX512_END
+
+#endif /* Float16_hpp */
@@ -14,6 +14,8 @@
 
 #ifndef Float4_hpp
 #define Float4_hpp
+#include <utility>
+
 #include "tnn/core/macro.h"
 #include "tnn/device/x86/x86_common.h"
 #include "tnn/device/x86/acc/sse_mathfun.h"
@@ -14,19 +14,17 @@
 
 #ifndef Float8_hpp
 #define Float8_hpp
+#include <utility>
+
 #include "tnn/core/macro.h"
 #include "tnn/device/x86/x86_common.h"
-#ifdef __AVX2__
-#include "tnn/device/x86/acc/avx_mathfun.h"
 #include "tnn/device/x86/acc/sse_mathfun.h"
-#else
-#include "tnn/device/arm/acc/TNNVector.h"
-#endif
+
+// Float8 is only usable in code compiled for avx2, see X86_AVX2_BEGIN
+X86_AVX2_BEGIN
+#include "tnn/device/x86/acc/avx_mathfun.h"
 
 namespace TNN_NS {
-#ifndef __AVX2__
-using Float8 = TNNVector<float, 8>;
-#else
 struct Float8 {
     __m256 value;
     Float8() {}
@@ -205,7 +203,7 @@ struct Float8 {
         return dst;
     }
 };
-#endif
 }  // namespace TNN_NS
+X86_AVX2_END
 
 #endif /* Float8_hpp */
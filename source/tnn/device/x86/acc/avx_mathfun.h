@@ -91,78 +91,6 @@ _PS256_CONST(cephes_log_p8, +3.3333331174E-1f);
 _PS256_CONST(cephes_log_q1, -2.12194440e-4f);
 _PS256_CONST(cephes_log_q2, 0.693359375f);
 
-#ifndef __AVX2__
-
-typedef union imm_xmm_union
-{
-    __m256i imm;
-    __m128i xmm[2];
-} imm_xmm_union;
-
-#define COPY_IMM_TO_XMM(imm_, xmm0_, xmm1_)      \
-    {                                            \
-        ALIGN32_BEG imm_xmm_union u ALIGN32_END; \
-        u.imm = imm_;                            \
-        xmm0_ = u.xmm[0];                        \
-        xmm1_ = u.xmm[1];                        \
-    }
-
-#define COPY_XMM_TO_IMM(xmm0_, xmm1_, imm_)      \
-    {                                            \
-        ALIGN32_BEG imm_xmm_union u ALIGN32_END; \
-        u.xmm[0] = xmm0_;                        \
-        u.xmm[1] = xmm1_;                        \
-        imm_ = u.imm;                            \
-    }
-
-#define AVX2_BITOP_USING_SSE2(fn)                            \
-    static inline __m256i _mm256_##fn(__m256i x, int a)      \
-    {                                                        \
-        /* use SSE2 instruction to perform the bitop AVX2 */ \
-        __m128i x1, x2;                                      \
-        __m256i ret;                                         \
-        COPY_IMM_TO_XMM(x, x1, x2);                          \
-        x1 = _mm_##fn(x1, a);                                \
-        x2 = _mm_##fn(x2, a);                                \
-        COPY_XMM_TO_IMM(x1, x2, ret);                        \
-        return (ret);                                        \
-    }
-
-#if _MSC_VER
-#pragma WARNING(Using SSE2 to perform AVX2 bitshift ops)
-#else
-#warning "Using SSE2 to perform AVX2 bitshift ops"
-#endif
-AVX2_BITOP_USING_SSE2(slli_epi32)
-AVX2_BITOP_USING_SSE2(srli_epi32)
-
-#define AVX2_INTOP_USING_SSE2(fn)                                         \
-    static inline __m256i _mm256_##fn(__m256i x, __m256i y)               \
-    {                                                                     \
-        /* use SSE2 instructions to perform the AVX2 integer operation */ \
-        __m128i x1, x2;                                                   \
-        __m128i y1, y2;                                                   \
-        __m256i ret;                                                      \
-        COPY_IMM_TO_XMM(x, x1, x2);                                       \
-        COPY_IMM_TO_XMM(y, y1, y2);                                       \
-        x1 = _mm_##fn(x1, y1);                                            \
-        x2 = _mm_##fn(x2, y2);                                            \
-        COPY_XMM_TO_IMM(x1, x2, ret);                                     \
-        return (ret);                                                     \
-    }
-
-#if _MSC_VER
-#pragma WARNING(Using SSE2 to perform AVX2 bitshift ops)
-#else
-#warning "Using SSE2 to perform AVX2 integer ops"
-#endif
-AVX2_INTOP_USING_SSE2(and_si128)
-AVX2_INTOP_USING_SSE2(andnot_si128)
-AVX2_INTOP_USING_SSE2(cmpeq_epi32)
-AVX2_INTOP_USING_SSE2(sub_epi32)
-AVX2_INTOP_USING_SSE2(add_epi32)
-
-#endif /* __AVX2__ */
 
 /* natural logarithm computed for 8 simultaneous float
    return NaN for x <= 0
@@ -338,10 +266,6 @@ static inline __m256 sin256_ps(__m256 x)
     __m256 xmm1, xmm2 = _mm256_setzero_ps(), xmm3, sign_bit, y;
     __m256i imm0, imm2;
 
-#ifndef __AVX2__
-    __m128i imm0_1, imm0_2;
-    __m128i imm2_1, imm2_2;
-#endif
 
     sign_bit = x;
     /* take the absolute value */
@@ -358,7 +282,6 @@ static inline __m256 sin256_ps(__m256 x)
       If we don't have AVX, let's perform them using SSE2 directives
     */
 
-#ifdef __AVX2__
     /* store the integer part of y in mm0 */
     imm2 = _mm256_cvttps_epi32(y);
     /* j=(j+1) & (~1) (see the cephes sources) */
@@ -378,35 +301,6 @@ static inline __m256 sin256_ps(__m256 x)
     */
     imm2 = _mm256_and_si256(imm2, *(__m256i*)_pi32_256_2);
     imm2 = _mm256_cmpeq_epi32(imm2, *(__m256i*)_pi32_256_0);
-#else
-    /* we use SSE2 routines to perform the integer ops */
-    COPY_IMM_TO_XMM(_mm256_cvttps_epi32(y), imm2_1, imm2_2);
-
-    imm2_1 = _mm_add_epi32(imm2_1, *(__m128i*)_pi32avx_1);
-    imm2_2 = _mm_add_epi32(imm2_2, *(__m128i*)_pi32avx_1);
-
-    imm2_1 = _mm_and_si128(imm2_1, *(__m128i*)_pi32avx_inv1);
-    imm2_2 = _mm_and_si128(imm2_2, *(__m128i*)_pi32avx_inv1);
-
-    COPY_XMM_TO_IMM(imm2_1, imm2_2, imm2);
-    y = _mm256_cvtepi32_ps(imm2);
-
-    imm0_1 = _mm_and_si128(imm2_1, *(__m128i*)_pi32avx_4);
-    imm0_2 = _mm_and_si128(imm2_2, *(__m128i*)_pi32avx_4);
-
-    imm0_1 = _mm_slli_epi32(imm0_1, 29);
-    imm0_2 = _mm_slli_epi32(imm0_2, 29);
-
-    COPY_XMM_TO_IMM(imm0_1, imm0_2, imm0);
-
-    imm2_1 = _mm_and_si128(imm2_1, *(__m128i*)_pi32avx_2);
-    imm2_2 = _mm_and_si128(imm2_2, *(__m128i*)_pi32avx_2);
-
-    imm2_1 = _mm_cmpeq_epi32(imm2_1, _mm_setzero_si128());
-    imm2_2 = _mm_cmpeq_epi32(imm2_2, _mm_setzero_si128());
-
-    COPY_XMM_TO_IMM(imm2_1, imm2_2, imm2);
-#endif
 
     __m256 swap_sign_bit = _mm256_castsi256_ps(imm0);
     __m256 poly_mask = _mm256_castsi256_ps(imm2);
@@ -466,10 +360,6 @@ static inline __m256 cos256_ps(__m256 x)
     __m256 xmm1, xmm2 = _mm256_setzero_ps(), xmm3, y;
     __m256i imm0, imm2;
 
-#ifndef __AVX2__
-    __m128i imm0_1, imm0_2;
-    __m128i imm2_1, imm2_2;
-#endif
 
     /* take the absolute value */
     x = _mm256_and_ps(x, *(__m256*)_ps256_inv_sign_mask);
@@ -477,7 +367,6 @@ static inline __m256 cos256_ps(__m256 x)
     /* scale by 4/Pi */
     y = _mm256_mul_ps(x, *(__m256*)_ps256_cephes_FOPI);
 
-#ifdef __AVX2__
     /* store the integer part of y in mm0 */
     imm2 = _mm256_cvttps_epi32(y);
     /* j=(j+1) & (~1) (see the cephes sources) */
@@ -492,39 +381,6 @@ static inline __m256 cos256_ps(__m256 x)
     /* get the polynom selection mask */
     imm2 = _mm256_and_si256(imm2, *(__m256i*)_pi32_256_2);
     imm2 = _mm256_cmpeq_epi32(imm2, *(__m256i*)_pi32_256_0);
-#else
-
-    /* we use SSE2 routines to perform the integer ops */
-    COPY_IMM_TO_XMM(_mm256_cvttps_epi32(y), imm2_1, imm2_2);
-
-    imm2_1 = _mm_add_epi32(imm2_1, *(__m128i*)_pi32avx_1);
-    imm2_2 = _mm_add_epi32(imm2_2, *(__m128i*)_pi32avx_1);
-
-    imm2_1 = _mm_and_si128(imm2_1, *(__m128i*)_pi32avx_inv1);
-    imm2_2 = _mm_and_si128(imm2_2, *(__m128i*)_pi32avx_inv1);
-
-    COPY_XMM_TO_IMM(imm2_1, imm2_2, imm2);
-    y = _mm256_cvtepi32_ps(imm2);
-
-    imm2_1 = _mm_sub_epi32(imm2_1, *(__m128i*)_pi32avx_2);
-    imm2_2 = _mm_sub_epi32(imm2_2, *(__m128i*)_pi32avx_2);
-
-    imm0_1 = _mm_andnot_si128(imm2_1, *(__m128i*)_pi32avx_4);
-    imm0_2 = _mm_andnot_si128(imm2_2, *(__m128i*)_pi32avx_4);
-
-    imm0_1 = _mm_slli_epi32(imm0_1, 29);
-    imm0_2 = _mm_slli_epi32(imm0_2, 29);
-
-    COPY_XMM_TO_IMM(imm0_1, imm0_2, imm0);
-
-    imm2_1 = _mm_and_si128(imm2_1, *(__m128i*)_pi32avx_2);
-    imm2_2 = _mm_and_si128(imm2_2, *(__m128i*)_pi32avx_2);
-
-    imm2_1 = _mm_cmpeq_epi32(imm2_1, _mm_setzero_si128());
-    imm2_2 = _mm_cmpeq_epi32(imm2_2, _mm_setzero_si128());
-
-    COPY_XMM_TO_IMM(imm2_1, imm2_2, imm2);
-#endif
 
     __m256 sign_bit = _mm256_castsi256_ps(imm0);
     __m256 poly_mask = _mm256_castsi256_ps(imm2);
@@ -584,11 +440,6 @@ static inline void sincos256_ps(__m256 x, __m256* s, __m256* c)
     __m256 xmm1, xmm2, xmm3 = _mm256_setzero_ps(), sign_bit_sin, y;
     __m256i imm0, imm2, imm4;
 
-#ifndef __AVX2__
-    __m128i imm0_1, imm0_2;
-    __m128i imm2_1, imm2_2;
-    __m128i imm4_1, imm4_2;
-#endif
 
     sign_bit_sin = x;
     /* take the absolute value */
@@ -599,7 +450,6 @@ static inline void sincos256_ps(__m256 x, __m256* s, __m256* c)
     /* scale by 4/Pi */
     y = _mm256_mul_ps(x, *(__m256*)_ps256_cephes_FOPI);
 
-#ifdef __AVX2__
     /* store the integer part of y in imm2 */
     imm2 = _mm256_cvttps_epi32(y);
 
@@ -619,38 +469,6 @@ static inline void sincos256_ps(__m256 x, __m256* s, __m256* c)
     imm2 = _mm256_and_si256(imm2, *(__m256i*)_pi32_256_2);
     imm2 = _mm256_cmpeq_epi32(imm2, *(__m256i*)_pi32_256_0);
     //__m256 poly_mask = _mm256_castsi256_ps(imm2);
-#else
-    /* we use SSE2 routines to perform the integer ops */
-    COPY_IMM_TO_XMM(_mm256_cvttps_epi32(y), imm2_1, imm2_2);
-
-    imm2_1 = _mm_add_epi32(imm2_1, *(__m128i*)_pi32avx_1);
-    imm2_2 = _mm_add_epi32(imm2_2, *(__m128i*)_pi32avx_1);
-
-    imm2_1 = _mm_and_si128(imm2_1, *(__m128i*)_pi32avx_inv1);
-    imm2_2 = _mm_and_si128(imm2_2, *(__m128i*)_pi32avx_inv1);
-
-    COPY_XMM_TO_IMM(imm2_1, imm2_2, imm2);
-    y = _mm256_cvtepi32_ps(imm2);
-
-    imm4_1 = imm2_1;
-    imm4_2 = imm2_2;
-
-    imm0_1 = _mm_and_si128(imm2_1, *(__m128i*)_pi32avx_4);
-    imm0_2 = _mm_and_si128(imm2_2, *(__m128i*)_pi32avx_4);
-
-    imm0_1 = _mm_slli_epi32(imm0_1, 29);
-    imm0_2 = _mm_slli_epi32(imm0_2, 29);
-
-    COPY_XMM_TO_IMM(imm0_1, imm0_2, imm0);
-
-    imm2_1 = _mm_and_si128(imm2_1, *(__m128i*)_pi32avx_2);
-    imm2_2 = _mm_and_si128(imm2_2, *(__m128i*)_pi32avx_2);
-
-    imm2_1 = _mm_cmpeq_epi32(imm2_1, _mm_setzero_si128());
-    imm2_2 = _mm_cmpeq_epi32(imm2_2, _mm_setzero_si128());
-
-    COPY_XMM_TO_IMM(imm2_1, imm2_2, imm2);
-#endif
     __m256 swap_sign_bit_sin = _mm256_castsi256_ps(imm0);
     __m256 poly_mask = _mm256_castsi256_ps(imm2);
 
@@ -666,22 +484,9 @@ static inline void sincos256_ps(__m256 x, __m256* s, __m256* c)
     x = _mm256_add_ps(x, xmm2);
     x = _mm256_add_ps(x, xmm3);
 
-#ifdef __AVX2__
     imm4 = _mm256_sub_epi32(imm4, *(__m256i*)_pi32_256_2);
     imm4 = _mm256_andnot_si256(imm4, *(__m256i*)_pi32_256_4);
     imm4 = _mm256_slli_epi32(imm4, 29);
-#else
-    imm4_1 = _mm_sub_epi32(imm4_1, *(__m128i*)_pi32avx_2);
-    imm4_2 = _mm_sub_epi32(imm4_2, *(__m128i*)_pi32avx_2);
-
-    imm4_1 = _mm_andnot_si128(imm4_1, *(__m128i*)_pi32avx_4);
-    imm4_2 = _mm_andnot_si128(imm4_2, *(__m128i*)_pi32avx_4);
-
-    imm4_1 = _mm_slli_epi32(imm4_1, 29);
-    imm4_2 = _mm_slli_epi32(imm4_2, 29);
-
-    COPY_XMM_TO_IMM(imm4_1, imm4_2, imm4);
-#endif
 
     __m256 sign_bit_cos = _mm256_castsi256_ps(imm4);
 
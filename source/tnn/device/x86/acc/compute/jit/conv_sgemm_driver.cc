@@ -73,8 +73,13 @@ void conv_sgemm_block_n(
                 i+=8;
                 break;
             default:
-                conv_gemm_conf.kernels_[16][N](K, cur_a, lda, cur_b, ldb, cur_c, ldc, bias, first, act_type);
-                i+=16;
+                if (cur_m < 32) {
+                    conv_gemm_conf.kernels_[16][N](K, cur_a, lda, cur_b, ldb, cur_c, ldc, bias, first, act_type);
+                    i+=16;
+                } else {
+                    conv_gemm_conf.kernels_[32][N](K, cur_a, lda, cur_b, ldb, cur_c, ldc, bias, first, act_type);
+                    i+=32;
+                }
                 break;
         }
     }
@@ -206,6 +211,24 @@ void conv_sgemm_nn_col_major_prepack_b(
     }
 }
 
+// sgemm col_major a no_trans, b no_trans
+// src_a: M * K, lda = M, prepacked by conv_pack_col_a_n
+// src_b: K * N, ldb = K
+// dst  : M * N, ldc = M
+void conv_sgemm_nn_col_major_prepack_a(
+        dim_t M, dim_t N, dim_t K,
+        const float * src_a, dim_t lda,
+        const float * src_b, dim_t ldb,
+        float * dst, dim_t ldc,
+        const float * bias, dim_t act_type,
+        float *pack_b_buf,
+        conv_gemm_config<float, float, float> &conv_gemm_conf)
+{
+    // packed a has the same layout for trans and no_trans
+    conv_sgemm_tn_col_major_prepack_a(M, N, K, src_a, lda, src_b, ldb, dst, ldc,
+        bias, act_type, pack_b_buf, conv_gemm_conf);
+}
+
 // sgemm col_major a trans, b no_trans
 // src_a: K * M, lda = K
 // src_b: K * N, ldb = K, prepacked
@@ -346,6 +369,33 @@ void conv_pack_col_b_n(
     }
 }
 
+// pack col major A no_trans [M x K]
+void conv_pack_col_a_n(
+    dim_t M, dim_t K,
+    const float * src, dim_t lda,
+    float * dst,
+    conv_gemm_config<float, float, float> &conv_gemm_conf)
+{
+    dim_t M_c = conv_gemm_conf.M_c_;
+    dim_t K_c = conv_gemm_conf.K_c_;
+    dim_t m_block = conv_gemm_conf.m_block_;
+
+    dim_t i, k;
+    i = k = 0;
+
+    for (k = 0; k < K; k += K_c)  {
+        dim_t cur_k = MIN(K - k, K_c);
+        auto src_k = src + k * lda;
+        auto dst_k = dst + k * divUp(M, m_block);
+
+        for (i = 0; i < M; i += M_c)  {
+            dim_t cur_m = MIN(M - i, M_c);
+            // pack a -> M_c * K_c;
+            pack_col_a_n(src_k + i, lda, dst_k + i * K_c, K_c, cur_k, cur_m, conv_gemm_conf);
+        }
+    }
+}
+
 // pack col major A trans [K x M]
 void conv_pack_col_a_t(
     dim_t M, dim_t K,
@@ -41,6 +41,16 @@ void conv_sgemm_nn_col_major_prepack_b(
         float * src_buf,
         conv_gemm_config<float, float, float> &conv_gemm_conf);
 
+// sgemm col_major a no_trans prepacked, b no_trans
+void conv_sgemm_nn_col_major_prepack_a(
+        dim_t M, dim_t N, dim_t K,
+        const float * src_a, dim_t lda,
+        const float * src_b, dim_t ldb,
+        float * dst, dim_t ldc,
+        const float * bias, dim_t act_type,
+        float *src_trans_buf,
+        conv_gemm_config<float, float, float> &conv_gemm_conf);
+
 // sgemm col_major a trans, b no_trans prepacked
 void conv_sgemm_tn_col_major_prepack_b(
         dim_t M, dim_t N, dim_t K,
@@ -68,6 +78,13 @@ void conv_pack_col_b_n(
         float * dst,
         conv_gemm_config<float, float, float> &conv_gemm_conf);
 
+// sgemm col_major pack a no_trans
+void conv_pack_col_a_n(
+    dim_t M, dim_t K,
+    const float * src, dim_t lda,
+    float * dst,
+    conv_gemm_config<float, float, float> &conv_gemm_conf);
+
 // sgemm col_major pack a trans
 void conv_pack_col_a_t(
     dim_t M, dim_t K,
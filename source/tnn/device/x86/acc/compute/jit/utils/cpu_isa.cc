@@ -23,9 +23,14 @@ namespace TNN_NS {
 
 using namespace Xbyak::util;
 
-static Xbyak::util::Cpu cpu;
+// function static, cpu_with_isa can be called during static initialization
+static Cpu &GetCpu() {
+    static Cpu cpu;
+    return cpu;
+}
 
 bool cpu_with_isa(x86_isa_t arch) {
+    const Cpu &cpu = GetCpu();
     switch (arch) {
         case sse42:
             return cpu.has(Cpu::tSSE42);
@@ -46,4 +51,12 @@ bool cpu_with_isa(x86_isa_t arch) {
     return false;
 }
 
+size_t cpu_data_cache_size(int level) {
+    const Cpu &cpu = GetCpu();
+    if (level < 1 || level > (int)cpu.getDataCacheLevels()) {
+        return 0;
+    }
+    return cpu.getDataCacheSize(level - 1);
+}
+
 }
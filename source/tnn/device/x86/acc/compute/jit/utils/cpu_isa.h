@@ -42,6 +42,9 @@ typedef enum {
 
 bool cpu_with_isa(x86_isa_t arch);
 
+// @brief size in bytes of the level-th data cache of one core (1 for L1d), 0 if cpuid does not report it
+size_t cpu_data_cache_size(int level);
+
 } // namespace tnn
 
 #endif // TNN_DEVICE_X86_ACC_COMPUTE_JIT_UTILS_CPU_ISA_HPP_
@@ -13,7 +13,6 @@
 // specific language governing permissions and limitations under the License.
 
 #include "tnn/device/x86/acc/compute/x86_compute.h"
-#include "tnn/device/x86/acc/Float8.h"
 #include "tnn/device/x86/acc/Float4.h"
 
 #include <algorithm>
@@ -23,6 +22,8 @@
 #include <immintrin.h>
 
 #include "jit/cblas.h"
+#include "tnn/device/x86/acc/compute/x86_compute_vec.h"
+#include "tnn/device/x86/x86_device.h"
 
 namespace TNN_NS {
 
@@ -203,261 +204,38 @@ Status X86_AVERAGE_POOLING(float *input, float *output, DimsVector input_dim, Di
     return TNN_OK;
 }
 
-/*
-max pooling corner func, left/right/top/bottom
-*/
-template <class T, int pack_c>
-void X86MaxPoolingCorner(const float* src, long iw, long ih, float* dst, long ow, long kw, long kh, long stride_w, long stride_h,
-                      long pad_w, long pad_h, long l, long r, long t, long b) {
-    for (long oy = t; oy < b; ++oy) {
-        for (long ox = l; ox < r; ++ox) {
-            T vmax(-FLT_MAX);
-
-            const long srcOriginX = ox * stride_w - pad_w;
-            const long srcOriginY = oy * stride_h - pad_h;
-            const long kxs        = MAX(0, -srcOriginX);
-            const long kxe        = MIN(kw, iw - srcOriginX);
-            const long kys        = MAX(0, -srcOriginY);
-            const long kye        = MIN(kh, ih - srcOriginY);
-            const auto src_ptr    = src + (srcOriginY * iw + srcOriginX) * pack_c;
-            auto dst_ptr          = dst + (oy * ow + ox) * pack_c;
-
-            for (long ky = kys; ky < kye; ++ky) {
-                const auto src_ptr_h = src_ptr + (ky * iw) * pack_c;
-                for (long kx = kxs; kx < kxe; kx++) {
-                    vmax = T::max(vmax, T::load(src_ptr_h + kx * pack_c));
-                }
-            }
-
-            T::save(dst_ptr, vmax);
-        }
-    }
-}
-
-/*
-max pooling 3x3s2 kernel
-*/
-template <class T, int pack_c>
-void X86MaxPoolingCenter3x3s2(const float* src, long iw, long ih, float* dst, long ow, long oh, long pad_w, long pad_h, long l,
-                           long r, long t, long b) {
-    for (long oy = t; oy < b; ++oy) {
-        for (long ox = l; ox < r; ++ox) {
-            T vmax(-FLT_MAX);
-
-            const long src_offset_x = ox * 2 - pad_w;
-            const long src_offset_y = oy * 2 - pad_h;
-            const auto src_ptr      = src + (src_offset_y * iw + src_offset_x) * pack_c;
-            auto dst_ptr            = dst + (oy * ow + ox) * pack_c;
-
-            for (long ky = 0; ky < 3; ++ky) {
-                const auto src_ptr_h = src_ptr + (ky * iw) * pack_c;
-                vmax                 = T::max(vmax, T::load(src_ptr_h + 0 * pack_c));
-                vmax                 = T::max(vmax, T::load(src_ptr_h + 1 * pack_c));
-                vmax                 = T::max(vmax, T::load(src_ptr_h + 2 * pack_c));
-            }
-            T::save(dst_ptr, vmax);
-        }
-    }
-}
-
-/*
-general max pooling center kernel
-*/
-template <class T, int pack_c>
-void X86MaxPoolingCenter(const float* src, long iw, long ih, float* dst, long ow, long oh, long kw, long kh, long stride_w,
-                      long stride_h, long pad_w, long pad_h, long l, long r, long t, long b) {
-    for (long oy = t; oy < b; ++oy) {
-        for (long ox = l; ox < r; ++ox) {
-            T vmax(-FLT_MAX);
-
-            const long src_offset_x = ox * stride_w - pad_w;
-            const long src_offset_y = oy * stride_h - pad_h;
-            const auto src_ptr      = src + (src_offset_y * iw + src_offset_x) * pack_c;
-            auto dst_ptr            = dst + (oy * ow + ox) * pack_c;
-
-            for (long ky = 0; ky < kh; ++ky) {
-                const auto src_ptr_h = src_ptr + (ky * iw) * pack_c;
-                for (long kx = 0; kx < kw; kx++) {
-                    vmax = T::max(vmax, T::load(src_ptr_h + kx * pack_c));
-                }
-            }
-
-            T::save(dst_ptr, vmax);
-        }
-    }
-}
-
-/*
-max pooling func, process four corners and center
-*/
-template <class T, int pack_c>
-void X86MaxPooling(const float* src, long iw, long ih, float* dst, long ow, long oh, long kw, long kh, long stride_w,
-                long stride_h, long pad_w, long pad_h, long l, long r, long t, long b) {
-    // top corner
-    X86MaxPoolingCorner<T, pack_c>(src, iw, ih, dst, ow, kw, kh, stride_w, stride_h, pad_w, pad_h, 0, ow, 0, t);
-    if (kw == 3 && kh == 3 && stride_h == 2 && stride_w == 2) {
-        X86MaxPoolingCenter3x3s2<T, pack_c>(src, iw, ih, dst, ow, oh, pad_w, pad_h, l, r, t, b);
-    } else {
-        X86MaxPoolingCenter<T, pack_c>(src, iw, ih, dst, ow, oh, kw, kh, stride_w, stride_h, pad_w, pad_h, l, r, t, b);
-    }
-
-    // bottom corner
-    X86MaxPoolingCorner<T, pack_c>(src, iw, ih, dst, ow, kw, kh, stride_w, stride_h, pad_w, pad_h, 0, ow, b, oh);
-    // left corner
-    X86MaxPoolingCorner<T, pack_c>(src, iw, ih, dst, ow, kw, kh, stride_w, stride_h, pad_w, pad_h, 0, l, t, b);
-    // right corner
-    X86MaxPoolingCorner<T, pack_c>(src, iw, ih, dst, ow, kw, kh, stride_w, stride_h, pad_w, pad_h, r, ow, t, b);
-}
-
-template void X86MaxPooling<Float8, 8>(const float* src, long iw, long ih, float* dst, long ow, long oh, long kw, long kh, long stride_w,
-                long stride_h, long pad_w, long pad_h, long l, long r, long t, long b);
-template void X86MaxPooling<Float4, 4>(const float* src, long iw, long ih, float* dst, long ow, long oh, long kw, long kh, long stride_w,
-                long stride_h, long pad_w, long pad_h, long l, long r, long t, long b);
-
-/*
-general avg pooling func
-*/
-template <class T, int pack_c>
-void X86AvgPooling(const float* src, long iw, long ih, float* dst, long ow, long oh, long kw, long kh, long stride_w,
-                long stride_h, long pad_w, long pad_h) {
-    for (long oy = 0; oy < oh; ++oy) {
-        for (long ox = 0; ox < ow; ++ox) {
-            T vavg(0.f);
-
-            const long srcOriginX    = ox * stride_w - pad_w;
-            const long srcOriginY    = oy * stride_h - pad_h;
-            const long kxs           = MAX(0, -srcOriginX);
-            const long kxe           = MIN(kw, iw - srcOriginX);
-            const long kys           = MAX(0, -srcOriginY);
-            const long kye           = MIN(kh, ih - srcOriginY);
-            const float kernel_count = 1.0 / ((kxe - kxs) * (kye - kys));
-            const auto src_ptr       = src + (srcOriginY * iw + srcOriginX) * pack_c;
-            auto dst_ptr             = dst + (oy * ow + ox) * pack_c;
-
-            for (long ky = kys; ky < kye; ++ky) {
-                const auto src_ptr_h = src_ptr + (ky * iw) * pack_c;
-                for (long kx = kxs; kx < kxe; kx++) {
-                    vavg = vavg + T::load(src_ptr_h + kx * pack_c);
-                }
-            }
-
-            vavg = vavg * T(kernel_count);
-            T::save(dst_ptr, vavg);
-        }
-    }
-}
-
-template void X86AvgPooling<Float8, 8>(const float* src, long iw, long ih, float* dst, long ow, long oh, long kw, long kh, long stride_w,
-                long stride_h, long pad_w, long pad_h);
-template void X86AvgPooling<Float4, 4>(const float* src, long iw, long ih, float* dst, long ow, long oh, long kw, long kh, long stride_w,
-                long stride_h, long pad_w, long pad_h);
+// built in x86_compute_avx2.cc and x86_compute_avx512.cc, must not be instantiated for sse4.2 here
+extern template void X86_FMA_Kernel<Float8, 8>(float *input_data, float *output_data, float *scale_data,
+                                               float *bias_data, bool shared_channel, bool has_bias,
+                                               DimsVector output_dim);
+extern template void X86_FMA_Kernel<Float16, 16>(float *input_data, float *output_data, float *scale_data,
+                                                 float *bias_data, bool shared_channel, bool has_bias,
+                                                 DimsVector output_dim);
+extern template void X86_FMA_NC8HW8_Kernel<Float8, 8>(float *input_data, float *output_data, float *scale_data,
+                                                      float *bias_data, bool shared_channel, bool has_bias,
+                                                      DimsVector output_dim);
 
 Status X86_FMA(float *input_data, float *output_data, float *scale_data, float *bias_data,
                bool shared_channel, bool has_bias, DimsVector output_dim) {
-    
-    int channel = output_dim[1];
-    int cal_count;
-    if (shared_channel)
-        cal_count = DimsVectorUtils::Count(output_dim);
-    else
-        cal_count = DimsVectorUtils::Count(output_dim, 2);
-    
-    if (shared_channel) {
-#ifdef __AVX2__
-        int tail = cal_count - cal_count % 8;
-        if (has_bias) {     // has bias
-            // register __m256 src, scale, bias;
-            __m256 src, scale, bias;
-            scale = _mm256_broadcast_ss(&scale_data[0]);
-            bias  = _mm256_broadcast_ss(&bias_data[0]);
-            for (size_t i = 0; i < tail; i += 8) {
-                src = _mm256_loadu_ps(input_data + i);
-                src = _mm256_fmadd_ps(src, scale, bias);
-                _mm256_storeu_ps(output_data + i, src);
-            }
-            for (size_t i = tail; i < cal_count; i++) {
-                output_data[i] = input_data[i] * scale_data[0] + bias_data[0];
-            }
-        } else {        // no bias
-            // register __m256 src, scale;
-            __m256 src, scale;
-            scale = _mm256_broadcast_ss(&scale_data[0]);
-            for (size_t i = 0; i < tail; i += 8) {
-                src = _mm256_loadu_ps(input_data + i);
-                src = _mm256_mul_ps(src, scale);
-                _mm256_storeu_ps(output_data + i, src);
-            }
-            for (size_t i = tail; i < cal_count; i++) {
-                output_data[i] = input_data[i] * scale_data[0];
-            }
-        }  
-#else
-        const float scale = scale_data[0];
-        float bias = 0.f;
-        if (has_bias) bias = bias_data[0];
-        for (int index = 0; index < cal_count; index++) {
-            if (has_bias)
-                output_data[index] = input_data[index] * scale + bias;
-            else 
-                output_data[index] = input_data[index] * scale;
-        }
-#endif
-    } else {
-#ifdef __AVX2__
-        int tail = cal_count - cal_count % 8;
-        for (int b = 0; b < output_dim[0]; b++) {
-            for (int c = 0; c < channel; c++) {
-                if (has_bias) {
-                    // register __m256 src, scale, bias;
-                    __m256 src, scale, bias;
-                    scale = _mm256_broadcast_ss(&scale_data[c]);
-                    bias  = _mm256_broadcast_ss(&bias_data[c]);
-                    float *input  = input_data + (b * channel + c) * cal_count;
-                    float *output = output_data + (b * channel + c) * cal_count;
-                    for (size_t index = 0; index < tail; index += 8) {
-                        src = _mm256_loadu_ps(input + index);
-                        src = _mm256_fmadd_ps(src, scale, bias);
-                        _mm256_storeu_ps(output + index, src);
-                    }
-                    for (size_t index = tail; index < cal_count; index++)
-                        output[index] = input[index] * scale_data[c] + bias_data[c];
-                } else {
-                    // register __m256 src, scale;
-                    __m256 src, scale;
-                    scale = _mm256_broadcast_ss(&scale_data[c]);
-                    float *input  = input_data + (b * channel + c) * cal_count;
-                    float *output = output_data + (b * channel + c) * cal_count;
-                    for (size_t index = 0; index < tail; index += 8) {
-                        src = _mm256_loadu_ps(input + index);
-                        src = _mm256_mul_ps(src, scale);
-                        _mm256_storeu_ps(output + index, src);
-                    }
-                    for (size_t index = tail; index < cal_count; index++)
-                        output[index] = input[index] * scale_data[c];
-                }
-            }
-        }
-#else
-        for (int b = 0; b < output_dim[0]; b++) {
-            for (int c = 0; c < channel; c++) {
-                float *input  = input_data + (b * channel + c) * cal_count;
-                float *output = output_data + (b * channel + c) * cal_count;
-                const float scale = scale_data[c];
-                float bias = 0.f;
-                if (has_bias) bias = bias_data[c];
-                for (int index = 0; index < cal_count; index++) {
-                    if (has_bias)
-                        output[index] = input[index] * scale + bias;
-                    else
-                        output[index] = input[index] * scale;
-                }
-            }
-        }
-#endif
+    auto fma_func = X86_FMA_Kernel<Float4, 4>;
+    if (X86Device::GetIsa() >= avx512) {
+        fma_func = X86_FMA_Kernel<Float16, 16>;
+    } else if (X86Device::GetIsa() >= avx2) {
+        fma_func = X86_FMA_Kernel<Float8, 8>;
     }
+    fma_func(input_data, output_data, scale_data, bias_data, shared_channel, has_bias, output_dim);
     return TNN_OK;
 }
 
+Status X86_FMA_NC8HW8(float *input_data, float *output_data, float *scale_data, float *bias_data,
+                      bool shared_channel, bool has_bias, DimsVector output_dim) {
+    if (X86Device::GetIsa() < avx2) {
+        return Status(TNNERR_DEVICE_NOT_SUPPORT, "X86_FMA_NC8HW8 needs avx2");
+    }
+    X86_FMA_NC8HW8_Kernel<Float8, 8>(input_data, output_data, scale_data, bias_data, shared_channel, has_bias,
+                                     output_dim);
+    return TNN_OK;
+}
 
 template<X86ReduceOpType type>
 float reduce_iter_op(const float acc, const float v) {
@@ -672,255 +450,38 @@ Status X86_NORMALIZE_CALCULATE(float *input, float *output, int axis,
     return TNN_OK;
 }
 
-template <int activation_type, typename VEC, int pack>
-void DepthwiseConv(float* dst, const float* src, const float* weight, const float* bias, long width, long src_w_step, long fw, long fh,
-                   long dilate_x_step, long dilate_y_step, long height, long srcHStep, long dstHStep) {
-    long dx, fx, fy;
-    VEC bias_v = VEC::loadu(bias);
-    VEC v_zero = VEC(0.f);
-    VEC v_6    = VEC(6.f);
-    for (long y = 0; y < height; ++y) {
-        auto srcY = src + y * srcHStep;
-        auto dstY = dst + y * dstHStep;
-        dx        = 0;
-        for (; dx + 3 < width; dx += 4) {
-            VEC dst_v[4];
-            for (long i = 0; i < 4; i++)
-                dst_v[i] = bias_v;
-            const auto* src_z    = srcY + src_w_step * dx;
-            const auto* weight_z = weight;
-            for (fy = 0; fy < fh; ++fy) {
-                const auto* src_y    = src_z + fy * dilate_y_step;
-                const auto* weight_y = weight_z + fy * fw * pack;
-                for (fx = 0; fx < fw; ++fx) {
-                    VEC weight_v = VEC::loadu(weight_y + pack * fx);
-                    VEC src_v0   = VEC::load(src_y + fx * dilate_x_step);
-                    VEC src_v1   = VEC::load(src_y + fx * dilate_x_step + src_w_step);
-                    VEC src_v2   = VEC::load(src_y + fx * dilate_x_step + 2 * src_w_step);
-                    VEC src_v3   = VEC::load(src_y + fx * dilate_x_step + 3 * src_w_step);
-                    VEC::mla(dst_v[0], src_v0, weight_v);
-                    VEC::mla(dst_v[1], src_v1, weight_v);
-                    VEC::mla(dst_v[2], src_v2, weight_v);
-                    VEC::mla(dst_v[3], src_v3, weight_v);
-                }
-            }
-            if (activation_type == ActivationType_ReLU || 
-                activation_type == ActivationType_ReLU6) {
-                dst_v[0] = VEC::max(dst_v[0], v_zero);
-                dst_v[1] = VEC::max(dst_v[1], v_zero);
-                dst_v[2] = VEC::max(dst_v[2], v_zero);
-                dst_v[3] = VEC::max(dst_v[3], v_zero);
-            }
-            if (activation_type == ActivationType_ReLU6) {
-                dst_v[0] = VEC::min(dst_v[0], v_6);
-                dst_v[1] = VEC::min(dst_v[1], v_6);
-                dst_v[2] = VEC::min(dst_v[2], v_6);
-                dst_v[3] = VEC::min(dst_v[3], v_6);
-            }
-            VEC::save(dstY + (dx + 0) * pack, dst_v[0]);
-            VEC::save(dstY + (dx + 1) * pack, dst_v[1]);
-            VEC::save(dstY + (dx + 2) * pack, dst_v[2]);
-            VEC::save(dstY + (dx + 3) * pack, dst_v[3]);
-        }
-        for (; dx < width; ++dx) {
-            VEC dst_v = bias_v;
-            const auto* src_z    = srcY + src_w_step * dx;
-            const auto* weight_z = weight;
-            for (fy = 0; fy < fh; ++fy) {
-                const auto* src_y    = src_z + fy * dilate_y_step;
-                const auto* weight_y = weight_z + fy * fw * pack;
-                for (fx = 0; fx < fw; ++fx) {
-                    VEC src_v    = VEC::load(src_y + fx * dilate_x_step);
-                    VEC weight_v = VEC::loadu(weight_y + pack * fx);
-                    VEC::mla(dst_v, src_v, weight_v);
-                }
-            }
-            if (activation_type == ActivationType_ReLU || 
-                activation_type == ActivationType_ReLU6) {
-                dst_v = VEC::max(dst_v, v_zero);
-            }
-            if (activation_type == ActivationType_ReLU6) {
-                dst_v = VEC::min(dst_v, v_6);
-            }
-            VEC::save(dstY + dx * pack, dst_v);
-        }
-    }
-}
+// sse4.2 variants of the vector kernels, the avx2 and avx512 variants are built from
+// x86_compute_vec.h in x86_compute_avx2.cc and x86_compute_avx512.cc
+template void X86MaxPooling<Float4, 4>(const float* src, long iw, long ih, float* dst, long ow, long oh, long kw, long kh, long stride_w,
+                long stride_h, long pad_w, long pad_h, long l, long r, long t, long b);
+template void X86AvgPooling<Float4, 4>(const float* src, long iw, long ih, float* dst, long ow, long oh, long kw, long kh, long stride_w,
+                long stride_h, long pad_w, long pad_h);
+template void X86_FMA_Kernel<Float4, 4>(float *input_data, float *output_data, float *scale_data, float *bias_data,
+                                        bool shared_channel, bool has_bias, DimsVector output_dim);
 
 template void DepthwiseConv<ActivationType_None, Float4, 4>(
     float* dst, const float* src, const float* weight, const float* bias, long width, long src_w_step, long fw, long fh,
     long dilate_x_step, long dilate_y_step, long height, long srcHStep, long dstHStep);
-
 template void DepthwiseConv<ActivationType_ReLU, Float4, 4>(
     float* dst, const float* src, const float* weight, const float* bias, long width, long src_w_step, long fw, long fh,
     long dilate_x_step, long dilate_y_step, long height, long srcHStep, long dstHStep);
-
 template void DepthwiseConv<ActivationType_ReLU6, Float4, 4>(
     float* dst, const float* src, const float* weight, const float* bias, long width, long src_w_step, long fw, long fh,
     long dilate_x_step, long dilate_y_step, long height, long srcHStep, long dstHStep);
 
-template void DepthwiseConv<ActivationType_None, Float8, 8>(
-    float* dst, const float* src, const float* weight, const float* bias, long width, long src_w_step, long fw, long fh,
-    long dilate_x_step, long dilate_y_step, long height, long srcHStep, long dstHStep);
-
-template void DepthwiseConv<ActivationType_ReLU, Float8, 8>(
-    float* dst, const float* src, const float* weight, const float* bias, long width, long src_w_step, long fw, long fh,
-    long dilate_x_step, long dilate_y_step, long height, long srcHStep, long dstHStep);
-
-template void DepthwiseConv<ActivationType_ReLU6, Float8, 8>(
-    float* dst, const float* src, const float* weight, const float* bias, long width, long src_w_step, long fw, long fh,
-    long dilate_x_step, long dilate_y_step, long height, long srcHStep, long dstHStep);
-
-template <int left, int oc_>
-void X86SgemvLeft(float* dst, const float* src, const float* weight, float *bias, size_t batch_stride) {
-    float acc[8];
-    for (int i = 0; i < left; i++) {
-        acc[i] = bias[i];
-    }
-    for (size_t ic = 0; ic < batch_stride; ic++) {
-        auto weight_ic = weight + ic * oc_;
-        for (int i = 0; i < left; i++) {
-            acc[i] += weight_ic[i] * src[ic];
-        }
-    }
-    for (int i = 0; i < left; i++) {
-        dst[i] = acc[i];
-    }
-}
-
-template <typename VEC, int pack>
-void X86Sgemv(float* dst, const float* src, const float* weight, float *bias, DimsVector dims_input, DimsVector dims_output) {
-    size_t batch_stride = DimsVectorUtils::Count(dims_input, 1);
-    for (int b = 0; b < dims_output[0]; ++b) {
-        const float *src_batch = src + b * batch_stride;
-        float *dst_batch = dst + b * dims_output[1];
-
-        int oc = 0;
-        for (; oc + pack - 1 < dims_output[1]; oc += pack) {
-            auto weight_oc = weight + oc * batch_stride;
-            VEC acc = VEC::loadu(bias + oc);
-            size_t ic = 0;
-            for (; ic + 3 < batch_stride; ic += 4) {
-                auto weight_ic   = weight_oc + ic * pack;
-                VEC src_v0    = VEC(src_batch[ic]);
-                VEC src_v1    = VEC(src_batch[ic + 1]);
-                VEC src_v2    = VEC(src_batch[ic + 2]);
-                VEC src_v3    = VEC(src_batch[ic + 3]);
-                VEC weight_v0 = VEC::load(weight_ic);
-                VEC weight_v1 = VEC::load(weight_ic + pack * 1);
-                VEC weight_v2 = VEC::load(weight_ic + pack * 2);
-                VEC weight_v3 = VEC::load(weight_ic + pack * 3);
-                VEC::mla(acc, weight_v0, src_v0);
-                VEC::mla(acc, weight_v1, src_v1);
-                VEC::mla(acc, weight_v2, src_v2);
-                VEC::mla(acc, weight_v3, src_v3);
-            }
-            for (; ic < batch_stride; ic++) {
-                VEC src_v    = VEC(src_batch[ic]);
-                VEC weight_v = VEC::load(weight_oc + ic * pack);
-                VEC::mla(acc, weight_v, src_v);
-            }
-            VEC::saveu(dst_batch + oc, acc);
-        }
-        int left = dims_output[1] - oc;
-        if (pack == 8) {
-            if (left == 7) {
-                X86SgemvLeft<7, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
-            } else if (left == 6) {
-                X86SgemvLeft<6, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
-            } else if (left == 5) {
-                X86SgemvLeft<5, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
-            } else if (left == 4) {
-                X86SgemvLeft<4, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
-            }
-        }
-        if (left == 3) {
-            X86SgemvLeft<3, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
-        } else if (left == 2) {
-            X86SgemvLeft<2, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
-        } else if (left == 1) {
-            X86SgemvLeft<1, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
-        }
-    }
-}
 template void X86Sgemv<Float4, 4>(float* dst, const float* src, const float* weight, float *bias, DimsVector dims_input, DimsVector dims_output);
-template void X86Sgemv<Float8, 8>(float* dst, const float* src, const float* weight, float *bias, DimsVector dims_input, DimsVector dims_output);
-
-template <int activation_type, typename VEC, int pack>
-void X86_Post_Exec(float *dst, const float *bias, long channel, long area) {
-    for (long c = 0; c < channel; c++) {
-        auto dst_c = dst + c * area;
-        VEC bias_v = VEC(bias + c);
-        VEC zero_v = VEC(0.f);
-        VEC six_v = VEC(6.f);
-        long i = 0;
-        for (; i + pack - 1 < area; i += pack) {
-            VEC src_v = VEC::loadu(dst_c + i);
-            VEC dst_v = VEC::add(src_v, bias_v);
-
-            if (activation_type == ActivationType_ReLU || 
-                activation_type == ActivationType_ReLU6) {
-                dst_v = VEC::max(dst_v, zero_v);
-            }
-            if (activation_type == ActivationType_ReLU6) {
-                dst_v = VEC::min(dst_v, six_v);
-            }
-            VEC::saveu(dst_c + i, dst_v);
-        }
 
-        for (; i < area; i++) {
-            float dst_value = dst_c[i] + bias[c];
-            if (activation_type == ActivationType_ReLU || 
-                activation_type == ActivationType_ReLU6) {
-                dst_value = std::max(dst_value, 0.f);
-            }
-            if (activation_type == ActivationType_ReLU6) {
-                dst_value = std::min(dst_value, 6.f);
-            }
-            dst_c[i] = dst_value;
-        }
-    }
-}
 template void X86_Post_Exec<ActivationType_None, Float4, 4>(float *dst, const float *bias, long channel, long area);
 template void X86_Post_Exec<ActivationType_ReLU, Float4, 4>(float *dst, const float *bias, long channel, long area);
 template void X86_Post_Exec<ActivationType_ReLU6, Float4, 4>(float *dst, const float *bias, long channel, long area);
-template void X86_Post_Exec<ActivationType_None, Float8, 8>(float *dst, const float *bias, long channel, long area);
-template void X86_Post_Exec<ActivationType_ReLU, Float8, 8>(float *dst, const float *bias, long channel, long area);
-template void X86_Post_Exec<ActivationType_ReLU6, Float8, 8>(float *dst, const float *bias, long channel, long area);
-
-//ActivationType_SIGMOID_MUL TBD
-
-template <typename VEC, int pack>
-void X86_VectorAdd(float *dst, const float *src_a, const float *src_b, long len) {
-    long i = 0;
-    for (; i + pack - 1 < len; i += pack) {
-        VEC a_vec = VEC::loadu(src_a + i);
-        VEC b_vec = VEC::loadu(src_b + i);
-        VEC c_vec = VEC::add(a_vec, b_vec);
-        VEC::saveu(dst + i, c_vec);
-    }
-    for (; i < len; i++) {
-        dst[i] = src_a[i] + src_b[i];
-    }
-}
+
 template void X86_VectorAdd<Float4, 4>(float *dst, const float *src_a, const float *src_b, long len);
-template void X86_VectorAdd<Float8, 8>(float *dst, const float *src_a, const float *src_b, long len);
-
-template <typename VEC, int pack>
-void X86_VectorAdd(float *dst, const float *src, long len) {
-    long i = 0;
-    for (; i + pack - 1 < len; i += pack) {
-        VEC a_vec = VEC::loadu(src + i);
-        VEC b_vec = VEC::loadu(dst + i);
-        VEC c_vec = VEC::add(a_vec, b_vec);
-        VEC::saveu(dst + i, c_vec);
-    }
-    for (; i < len; i++) {
-        dst[i] += src[i];
-    }
-}
 template void X86_VectorAdd<Float4, 4>(float *dst, const float *src, long len);
-template void X86_VectorAdd<Float8, 8>(float *dst, const float *src, long len);
+
+template void X86FlashAttention<Float4, 4>(const float *q, const float *kt, const float *v, const float *mask,
+                                           long mask_row_stride, long mask_col_stride, float *dst, long rows,
+                                           long seq_k, long depth, long depth_v, float scale, long block_k,
+                                           float *workspace);
 
 void X86StrideSliceImpl(DimsVector begins, DimsVector strides, DimsVector dims_output,
                         DimsVector input_strides, DimsVector output_strides,
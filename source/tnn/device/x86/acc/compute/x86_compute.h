@@ -23,6 +23,7 @@
 #include "tnn/interpreter/layer_param.h"
 #include "tnn/device/x86/acc/Float4.h"
 #include "tnn/device/x86/acc/Float8.h"
+#include "tnn/device/x86/acc/Float16.h"
 
 namespace TNN_NS {
 
@@ -46,6 +47,10 @@ Status X86_AVERAGE_POOLING(float *input, float *output, DimsVector input_dim, Di
 Status X86_FMA(float *input, float *output, float *scale, float *bias,
                bool shared_channel, bool has_bias, DimsVector output_dim);
 
+// @brief X86_FMA of NC8HW8 data, only call it when X86Device::GetIsa() >= avx2
+Status X86_FMA_NC8HW8(float *input, float *output, float *scale, float *bias,
+                      bool shared_channel, bool has_bias, DimsVector output_dim);
+
 Status X86_REDUCE_CALCULATE(float *input, float *output, float *workspace,
                             std::vector<std::tuple<int, int, int>> &reduce_dims,
                             DimsVector input_dim, DimsVector output_dim, X86ReduceOpType op_type);
@@ -74,6 +79,19 @@ void X86_VectorAdd(float *dst, const float *src_a, const float *src_b, long len)
 template <typename VEC, int pack>
 void X86_VectorAdd(float *dst, const float *src, long len);
 
+template <typename VEC, int pack>
+void X86_FMA_Kernel(float *input, float *output, float *scale, float *bias,
+                    bool shared_channel, bool has_bias, DimsVector output_dim);
+
+template <typename VEC, int pack>
+void X86_FMA_NC8HW8_Kernel(float *input, float *output, float *scale, float *bias,
+                           bool shared_channel, bool has_bias, DimsVector output_dim);
+
+template <typename VEC, int pack>
+void X86FlashAttention(const float *q, const float *kt, const float *v, const float *mask, long mask_row_stride,
+                       long mask_col_stride, float *dst, long rows, long seq_k, long depth, long depth_v, float scale,
+                       long block_k, float *workspace);
+
 void X86StrideSliceImpl(DimsVector begins, DimsVector strides, DimsVector dims_output,
                         DimsVector input_strides, DimsVector output_strides,
                         const float* input_data, float* output_data);
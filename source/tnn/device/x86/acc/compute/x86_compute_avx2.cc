@@ -0,0 +1,69 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#include "tnn/core/common.h"
+#include "tnn/device/x86/acc/Float16.h"
+#include "tnn/device/x86/acc/Float4.h"
+#include "tnn/device/x86/acc/Float8.h"
+#include "tnn/device/x86/acc/compute/x86_compute.h"
+#include "tnn/utils/dims_utils.h"
+
+// avx2 variants of the vector kernels, only called when X86Device::GetIsa() >= avx2
+X86_AVX2_BEGIN
+#include "tnn/device/x86/acc/compute/x86_compute_vec.h"
+
+namespace TNN_NS {
+
+template void X86MaxPooling<Float8, 8>(const float* src, long iw, long ih, float* dst, long ow, long oh, long kw, long kh, long stride_w,
+                long stride_h, long pad_w, long pad_h, long l, long r, long t, long b);
+template void X86AvgPooling<Float8, 8>(const float* src, long iw, long ih, float* dst, long ow, long oh, long kw, long kh, long stride_w,
+                long stride_h, long pad_w, long pad_h);
+template void X86_FMA_Kernel<Float8, 8>(float *input_data, float *output_data, float *scale_data, float *bias_data,
+                                        bool shared_channel, bool has_bias, DimsVector output_dim);
+template void X86_FMA_NC8HW8_Kernel<Float8, 8>(float *input_data, float *output_data, float *scale_data,
+                                               float *bias_data, bool shared_channel, bool has_bias,
+                                               DimsVector output_dim);
+
+template void DepthwiseConv<ActivationType_None, Float8, 8>(
+    float* dst, const float* src, const float* weight, const float* bias, long width, long src_w_step, long fw, long fh,
+    long dilate_x_step, long dilate_y_step, long height, long srcHStep, long dstHStep);
+template void DepthwiseConv<ActivationType_ReLU, Float8, 8>(
+    float* dst, const float* src, const float* weight, const float* bias, long width, long src_w_step, long fw, long fh,
+    long dilate_x_step, long dilate_y_step, long height, long srcHStep, long dstHStep);
+template void DepthwiseConv<ActivationType_ReLU6, Float8, 8>(
+    float* dst, const float* src, const float* weight, const float* bias, long width, long src_w_step, long fw, long fh,
+    long dilate_x_step, long dilate_y_step, long height, long srcHStep, long dstHStep);
+
+template void X86Sgemv<Float8, 8>(float* dst, const float* src, const float* weight, float *bias, DimsVector dims_input, DimsVector dims_output);
+
+template void X86_Post_Exec<ActivationType_None, Float8, 8>(float *dst, const float *bias, long channel, long area);
+template void X86_Post_Exec<ActivationType_ReLU, Float8, 8>(float *dst, const float *bias, long channel, long area);
+template void X86_Post_Exec<ActivationType_ReLU6, Float8, 8>(float *dst, const float *bias, long channel, long area);
+
+template void X86_VectorAdd<Float8, 8>(float *dst, const float *src_a, const float *src_b, long len);
+template void X86_VectorAdd<Float8, 8>(float *dst, const float *src, long len);
+
+template void X86FlashAttention<Float8, 8>(const float *q, const float *kt, const float *v, const float *mask,
+                                           long mask_row_stride, long mask_col_stride, float *dst, long rows,
+                                           long seq_k, long depth, long depth_v, float scale, long block_k,
+                                           float *workspace);
+
+}  // namespace TNN_NS
+
+X86_AVX2_END
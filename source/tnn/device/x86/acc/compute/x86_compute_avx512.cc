@@ -0,0 +1,46 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#include "tnn/core/common.h"
+#include "tnn/device/x86/acc/Float16.h"
+#include "tnn/device/x86/acc/Float4.h"
+#include "tnn/device/x86/acc/Float8.h"
+#include "tnn/device/x86/acc/compute/x86_compute.h"
+#include "tnn/utils/dims_utils.h"
+
+// avx512 variants of the layout agnostic vector kernels, only called when X86Device::GetIsa() >= avx512.
+// Kernels working on packed channels keep the avx2 variants, as their data is packed by 8.
+X86_AVX512_BEGIN
+#include "tnn/device/x86/acc/compute/x86_compute_vec.h"
+
+namespace TNN_NS {
+
+template void X86_FMA_Kernel<Float16, 16>(float *input_data, float *output_data, float *scale_data, float *bias_data,
+                                          bool shared_channel, bool has_bias, DimsVector output_dim);
+
+template void X86_Post_Exec<ActivationType_None, Float16, 16>(float *dst, const float *bias, long channel, long area);
+template void X86_Post_Exec<ActivationType_ReLU, Float16, 16>(float *dst, const float *bias, long channel, long area);
+template void X86_Post_Exec<ActivationType_ReLU6, Float16, 16>(float *dst, const float *bias, long channel, long area);
+
+template void X86_VectorAdd<Float16, 16>(float *dst, const float *src_a, const float *src_b, long len);
+template void X86_VectorAdd<Float16, 16>(float *dst, const float *src, long len);
+
+}  // namespace TNN_NS
+
+X86_AVX512_END
@@ -0,0 +1,548 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/acc/compute/x86_compute_int8.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "tnn/core/macro.h"
+#include "tnn/device/x86/x86_common.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+void X86Int8PackWeight(int8_t *dst, int32_t *comp, const int8_t *src, long m, long k, long k_pad) {
+    for (long i = 0; i < m; i++) {
+        auto src_i = src + i * k;
+        auto dst_i = dst + i * k_pad;
+        int32_t sum = 0;
+        for (long j = 0; j < k; j++) {
+            dst_i[j] = std::max(src_i[j], (int8_t)-127);
+            sum += dst_i[j];
+        }
+        memset(dst_i + k, 0, k_pad - k);
+        comp[i] = 128 * sum;
+    }
+}
+
+void X86Int8Im2Col(int8_t *dst, const int8_t *src, long channel, long height, long width, long kernel_h,
+                   long kernel_w, long pad_t, long pad_l, long stride_h, long stride_w, long dilation_h,
+                   long dilation_w, long out_height, long out_width, long k_pad) {
+    const long out_hw = out_height * out_width;
+    const long k      = channel * kernel_h * kernel_w;
+
+    if (kernel_h == 1 && kernel_w == 1 && stride_h == 1 && stride_w == 1 && pad_t == 0 && pad_l == 0) {
+        // 1x1 conv only transposes the input, by tiles of 16 pixels
+        const long tile = 16;
+        OMP_PARALLEL_FOR_
+        for (long p = 0; p < out_hw; p += tile) {
+            long p_end = MIN(p + tile, out_hw);
+            for (long c = 0; c < channel; c++) {
+                auto src_c = src + c * out_hw;
+                for (long i = p; i < p_end; i++) {
+                    dst[i * k_pad + c] = src_c[i];
+                }
+            }
+            for (long i = p; i < p_end; i++) {
+                memset(dst + i * k_pad + k, 0, k_pad - k);
+            }
+        }
+        return;
+    }
+
+    OMP_PARALLEL_FOR_
+    for (long p = 0; p < out_hw; p++) {
+        long oy    = p / out_width;
+        long ox    = p % out_width;
+        auto dst_p = dst + p * k_pad;
+        for (long c = 0; c < channel; c++) {
+            auto src_c = src + c * height * width;
+            for (long ky = 0; ky < kernel_h; ky++) {
+                long iy = oy * stride_h - pad_t + ky * dilation_h;
+                if (iy < 0 || iy >= height) {
+                    memset(dst_p, 0, kernel_w);
+                    dst_p += kernel_w;
+                    continue;
+                }
+                for (long kx = 0; kx < kernel_w; kx++) {
+                    long ix  = ox * stride_w - pad_l + kx * dilation_w;
+                    *dst_p++ = (ix >= 0 && ix < width) ? src_c[iy * width + ix] : 0;
+                }
+            }
+        }
+        memset(dst_p, 0, k_pad - k);
+    }
+}
+
+/*
+The sse and avx2 kernels multiply with vpmaddubsw, which takes uint8 * int8. The input b goes to the
+unsigned operand as |b|, and the sign of b is moved to the weights a by vpsignb. As weights are in
+[-127, 127], the int16 sums of pairs never saturate. vpmaddwd with ones widens the sums to int32.
+The vnni kernel shifts b to uint8 by adding 128, and subtracts 128 * sum(a) at the end.
+*/
+// vb_abs is |vb|, computed once for all rows
+static X86_INLINE __m128i DotInt8SSE(__m128i acc, __m128i va, __m128i vb, __m128i vb_abs, __m128i ones) {
+    __m128i prod = _mm_maddubs_epi16(vb_abs, _mm_sign_epi8(va, vb));
+    return _mm_add_epi32(acc, _mm_madd_epi16(prod, ones));
+}
+
+// the sums of v0, v1 for row 0 and v2, v3 for row 1, stored as 2x2 int32
+static X86_INLINE void Store2x2SSE(int32_t *c, long ldc, __m128i v0, __m128i v1, __m128i v2, __m128i v3) {
+    __m128i sum = _mm_hadd_epi32(_mm_hadd_epi32(v0, v1), _mm_hadd_epi32(v2, v3));
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(c), sum);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(c + ldc), _mm_unpackhi_epi64(sum, sum));
+}
+
+struct Int8KernelSSE {
+    static const int mr = 4;
+    static const int nr = 2;
+
+    static void Tile(int32_t *c, const int8_t *a, const int8_t *b, const int32_t *comp, long k_pad, long ldc) {
+        const __m128i ones = _mm_set1_epi16(1);
+        __m128i c00 = _mm_setzero_si128(), c01 = _mm_setzero_si128();
+        __m128i c10 = _mm_setzero_si128(), c11 = _mm_setzero_si128();
+        __m128i c20 = _mm_setzero_si128(), c21 = _mm_setzero_si128();
+        __m128i c30 = _mm_setzero_si128(), c31 = _mm_setzero_si128();
+        for (long k = 0; k < k_pad; k += 16) {
+            __m128i vb0     = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + k));
+            __m128i vb1     = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + k_pad + k));
+            __m128i vb0_abs = _mm_abs_epi8(vb0);
+            __m128i vb1_abs = _mm_abs_epi8(vb1);
+            __m128i va      = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + k));
+            c00             = DotInt8SSE(c00, va, vb0, vb0_abs, ones);
+            c01             = DotInt8SSE(c01, va, vb1, vb1_abs, ones);
+            va              = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + k_pad + k));
+            c10             = DotInt8SSE(c10, va, vb0, vb0_abs, ones);
+            c11             = DotInt8SSE(c11, va, vb1, vb1_abs, ones);
+            va              = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + 2 * k_pad + k));
+            c20             = DotInt8SSE(c20, va, vb0, vb0_abs, ones);
+            c21             = DotInt8SSE(c21, va, vb1, vb1_abs, ones);
+            va              = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + 3 * k_pad + k));
+            c30             = DotInt8SSE(c30, va, vb0, vb0_abs, ones);
+            c31             = DotInt8SSE(c31, va, vb1, vb1_abs, ones);
+        }
+        Store2x2SSE(c, ldc, c00, c01, c10, c11);
+        Store2x2SSE(c + 2 * ldc, ldc, c20, c21, c30, c31);
+    }
+
+    static int32_t Dot(const int8_t *a, const int8_t *b, const int32_t *comp, long k_pad) {
+        const __m128i ones = _mm_set1_epi16(1);
+        __m128i acc        = _mm_setzero_si128();
+        for (long k = 0; k < k_pad; k += 16) {
+            __m128i vb     = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + k));
+            __m128i vb_abs = _mm_abs_epi8(vb);
+            __m128i va     = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + k));
+            acc            = DotInt8SSE(acc, va, vb, vb_abs, ones);
+        }
+        acc = _mm_hadd_epi32(acc, acc);
+        acc = _mm_hadd_epi32(acc, acc);
+        return _mm_cvtsi128_si32(acc);
+    }
+};
+
+X86_AVX2_BEGIN
+
+// vb_abs is |vb|, computed once for all rows
+static X86_INLINE __m256i DotInt8AVX2(__m256i acc, __m256i va, __m256i vb, __m256i vb_abs, __m256i ones) {
+    __m256i prod = _mm256_maddubs_epi16(vb_abs, _mm256_sign_epi8(va, vb));
+    return _mm256_add_epi32(acc, _mm256_madd_epi16(prod, ones));
+}
+
+static X86_INLINE void Store2x2AVX2(int32_t *c, long ldc, __m256i v0, __m256i v1, __m256i v2, __m256i v3) {
+    __m256i sum = _mm256_hadd_epi32(_mm256_hadd_epi32(v0, v1), _mm256_hadd_epi32(v2, v3));
+    __m128i res = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(c), res);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(c + ldc), _mm_unpackhi_epi64(res, res));
+}
+
+struct Int8KernelAVX2 {
+    static const int mr = 4;
+    static const int nr = 2;
+
+    static void Tile(int32_t *c, const int8_t *a, const int8_t *b, const int32_t *comp, long k_pad, long ldc) {
+        const __m256i ones = _mm256_set1_epi16(1);
+        __m256i c00 = _mm256_setzero_si256(), c01 = _mm256_setzero_si256();
+        __m256i c10 = _mm256_setzero_si256(), c11 = _mm256_setzero_si256();
+        __m256i c20 = _mm256_setzero_si256(), c21 = _mm256_setzero_si256();
+        __m256i c30 = _mm256_setzero_si256(), c31 = _mm256_setzero_si256();
+        for (long k = 0; k < k_pad; k += 32) {
+            __m256i vb0     = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + k));
+            __m256i vb1     = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + k_pad + k));
+            __m256i vb0_abs = _mm256_abs_epi8(vb0);
+            __m256i vb1_abs = _mm256_abs_epi8(vb1);
+            __m256i va      = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + k));
+            c00             = DotInt8AVX2(c00, va, vb0, vb0_abs, ones);
+            c01             = DotInt8AVX2(c01, va, vb1, vb1_abs, ones);
+            va              = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + k_pad + k));
+            c10             = DotInt8AVX2(c10, va, vb0, vb0_abs, ones);
+            c11             = DotInt8AVX2(c11, va, vb1, vb1_abs, ones);
+            va              = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + 2 * k_pad + k));
+            c20             = DotInt8AVX2(c20, va, vb0, vb0_abs, ones);
+            c21             = DotInt8AVX2(c21, va, vb1, vb1_abs, ones);
+            va              = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + 3 * k_pad + k));
+            c30             = DotInt8AVX2(c30, va, vb0, vb0_abs, ones);
+            c31             = DotInt8AVX2(c31, va, vb1, vb1_abs, ones);
+        }
+        Store2x2AVX2(c, ldc, c00, c01, c10, c11);
+        Store2x2AVX2(c + 2 * ldc, ldc, c20, c21, c30, c31);
+    }
+
+    static int32_t Dot(const int8_t *a, const int8_t *b, const int32_t *comp, long k_pad) {
+        const __m256i ones = _mm256_set1_epi16(1);
+        __m256i acc        = _mm256_setzero_si256();
+        for (long k = 0; k < k_pad; k += 32) {
+            __m256i vb     = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + k));
+            __m256i vb_abs = _mm256_abs_epi8(vb);
+            __m256i va     = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + k));
+            acc            = DotInt8AVX2(acc, va, vb, vb_abs, ones);
+        }
+        __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+        sum         = _mm_hadd_epi32(sum, sum);
+        sum         = _mm_hadd_epi32(sum, sum);
+        return _mm_cvtsi128_si32(sum);
+    }
+};
+
+X86_AVX2_END
+
+// the sums of 4 vectors of one row minus the compensation
+#define INT8_VNNI_STORE_ROW(c, v0, v1, v2, v3, comp)                                                            \
+    {                                                                                                           \
+        __m256i y0  = _mm256_add_epi32(_mm512_castsi512_si256(v0), _mm512_extracti64x4_epi64(v0, 1));           \
+        __m256i y1  = _mm256_add_epi32(_mm512_castsi512_si256(v1), _mm512_extracti64x4_epi64(v1, 1));           \
+        __m256i y2  = _mm256_add_epi32(_mm512_castsi512_si256(v2), _mm512_extracti64x4_epi64(v2, 1));           \
+        __m256i y3  = _mm256_add_epi32(_mm512_castsi512_si256(v3), _mm512_extracti64x4_epi64(v3, 1));           \
+        __m256i sum = _mm256_hadd_epi32(_mm256_hadd_epi32(y0, y1), _mm256_hadd_epi32(y2, y3));                 \
+        __m128i res = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));            \
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(c), _mm_sub_epi32(res, _mm_set1_epi32(comp)));            \
+    }
+
+#define INT8_VNNI_ROW(i)                                                                                        \
+    va      = _mm512_loadu_si512(a + i * k_pad + k);                                                            \
+    c##i##0 = _mm512_dpbusd_epi32(c##i##0, vb0, va);                                                            \
+    c##i##1 = _mm512_dpbusd_epi32(c##i##1, vb1, va);                                                            \
+    c##i##2 = _mm512_dpbusd_epi32(c##i##2, vb2, va);                                                            \
+    c##i##3 = _mm512_dpbusd_epi32(c##i##3, vb3, va);
+
+struct Int8KernelVNNI {
+    static const int mr = 4;
+    static const int nr = 4;
+
+    static X86_AVX512_VNNI_TARGET void Tile(int32_t *c, const int8_t *a, const int8_t *b, const int32_t *comp,
+                                            long k_pad, long ldc) {
+        const __m512i shift = _mm512_set1_epi8((char)0x80);
+        __m512i c00 = _mm512_setzero_si512(), c01 = _mm512_setzero_si512();
+        __m512i c02 = _mm512_setzero_si512(), c03 = _mm512_setzero_si512();
+        __m512i c10 = _mm512_setzero_si512(), c11 = _mm512_setzero_si512();
+        __m512i c12 = _mm512_setzero_si512(), c13 = _mm512_setzero_si512();
+        __m512i c20 = _mm512_setzero_si512(), c21 = _mm512_setzero_si512();
+        __m512i c22 = _mm512_setzero_si512(), c23 = _mm512_setzero_si512();
+        __m512i c30 = _mm512_setzero_si512(), c31 = _mm512_setzero_si512();
+        __m512i c32 = _mm512_setzero_si512(), c33 = _mm512_setzero_si512();
+        for (long k = 0; k < k_pad; k += 64) {
+            __m512i vb0 = _mm512_xor_si512(_mm512_loadu_si512(b + k), shift);
+            __m512i vb1 = _mm512_xor_si512(_mm512_loadu_si512(b + k_pad + k), shift);
+            __m512i vb2 = _mm512_xor_si512(_mm512_loadu_si512(b + 2 * k_pad + k), shift);
+            __m512i vb3 = _mm512_xor_si512(_mm512_loadu_si512(b + 3 * k_pad + k), shift);
+            __m512i va;
+            INT8_VNNI_ROW(0);
+            INT8_VNNI_ROW(1);
+            INT8_VNNI_ROW(2);
+            INT8_VNNI_ROW(3);
+        }
+        INT8_VNNI_STORE_ROW(c, c00, c01, c02, c03, comp[0]);
+        INT8_VNNI_STORE_ROW(c + ldc, c10, c11, c12, c13, comp[1]);
+        INT8_VNNI_STORE_ROW(c + 2 * ldc, c20, c21, c22, c23, comp[2]);
+        INT8_VNNI_STORE_ROW(c + 3 * ldc, c30, c31, c32, c33, comp[3]);
+    }
+
+    static X86_AVX512_VNNI_TARGET int32_t Dot(const int8_t *a, const int8_t *b, const int32_t *comp, long k_pad) {
+        const __m512i shift = _mm512_set1_epi8((char)0x80);
+        __m512i acc         = _mm512_setzero_si512();
+        for (long k = 0; k < k_pad; k += 64) {
+            __m512i vb = _mm512_xor_si512(_mm512_loadu_si512(b + k), shift);
+            acc        = _mm512_dpbusd_epi32(acc, vb, _mm512_loadu_si512(a + k));
+        }
+        return _mm512_reduce_add_epi32(acc) - comp[0];
+    }
+};
+
+#undef INT8_VNNI_ROW
+#undef INT8_VNNI_STORE_ROW
+
+// a tile of mr rows of a is reused for all columns of the block, the edges are computed by single dot products
+template <typename Kernel>
+static X86_INLINE void Int8GemmBlock(int32_t *c, const int8_t *a, const int8_t *b, const int32_t *comp, long m,
+                                     long n, long k_pad, long ldc) {
+    const int mr = Kernel::mr;
+    const int nr = Kernel::nr;
+    long i       = 0;
+    for (; i + mr <= m; i += mr) {
+        long j = 0;
+        for (; j + nr <= n; j += nr) {
+            Kernel::Tile(c + i * ldc + j, a + i * k_pad, b + j * k_pad, comp + i, k_pad, ldc);
+        }
+        for (; j < n; j++) {
+            for (long ii = i; ii < i + mr; ii++) {
+                c[ii * ldc + j] = Kernel::Dot(a + ii * k_pad, b + j * k_pad, comp + ii, k_pad);
+            }
+        }
+    }
+    for (; i < m; i++) {
+        for (long j = 0; j < n; j++) {
+            c[i * ldc + j] = Kernel::Dot(a + i * k_pad, b + j * k_pad, comp + i, k_pad);
+        }
+    }
+}
+
+static void Int8GemmBlockSSE(int32_t *c, const int8_t *a, const int8_t *b, const int32_t *comp, long m, long n,
+                             long k_pad, long ldc) {
+    Int8GemmBlock<Int8KernelSSE>(c, a, b, comp, m, n, k_pad, ldc);
+}
+
+static X86_AVX2_TARGET void Int8GemmBlockAVX2(int32_t *c, const int8_t *a, const int8_t *b, const int32_t *comp,
+                                              long m, long n, long k_pad, long ldc) {
+    Int8GemmBlock<Int8KernelAVX2>(c, a, b, comp, m, n, k_pad, ldc);
+}
+
+static X86_AVX512_VNNI_TARGET void Int8GemmBlockVNNI(int32_t *c, const int8_t *a, const int8_t *b,
+                                                     const int32_t *comp, long m, long n, long k_pad, long ldc) {
+    Int8GemmBlock<Int8KernelVNNI>(c, a, b, comp, m, n, k_pad, ldc);
+}
+
+void X86Int8Gemm(x86_isa_t arch, int32_t *c, const int8_t *a, const int8_t *b, const int32_t *comp, long m, long n,
+                 long k_pad, long ldc) {
+    auto block_func = Int8GemmBlockSSE;
+    if (arch >= avx512_vnni) {
+        block_func = Int8GemmBlockVNNI;
+    } else if (arch >= avx2) {
+        block_func = Int8GemmBlockAVX2;
+    }
+
+    // blocks of 64 rows and 16 columns are computed in parallel
+    const long m_block = 64;
+    const long n_block = 16;
+    long m_blocks      = UP_DIV(m, m_block);
+    long n_blocks      = UP_DIV(n, n_block);
+    OMP_PARALLEL_FOR_
+    for (long t = 0; t < m_blocks * n_blocks; t++) {
+        long i = (t / n_blocks) * m_block;
+        long j = (t % n_blocks) * n_block;
+        block_func(c + i * ldc + j, a + i * k_pad, b + j * k_pad, comp + i, MIN(m_block, m - i),
+                   MIN(n_block, n - j), k_pad, ldc);
+    }
+}
+
+static X86_INLINE __m128i LoadInt8x4(const int8_t *src) {
+    int32_t v;
+    memcpy(&v, src, sizeof(v));
+    return _mm_cvtepi8_epi32(_mm_cvtsi32_si128(v));
+}
+
+// round to nearest and saturate 4 floats to int8
+static X86_INLINE void StoreInt8x4(int8_t *dst, __m128 v) {
+    v         = _mm_min_ps(_mm_max_ps(v, _mm_set1_ps(-128.f)), _mm_set1_ps(127.f));
+    __m128i q = _mm_cvtps_epi32(v);
+    q         = _mm_packs_epi32(q, q);
+    q         = _mm_packs_epi16(q, q);
+    int32_t r = _mm_cvtsi128_si32(q);
+    memcpy(dst, &r, sizeof(r));
+}
+
+static X86_INLINE int8_t FloatToInt8(float v) {
+    return static_cast<int8_t>(std::max(std::min(v + (v >= 0.f ? 0.5f : -0.5f), 127.0f), -128.0f));
+}
+
+void X86Int8Requant(int8_t *dst, const int32_t *src, long len, int32_t bias, float scale, long relu,
+                    const int8_t *add_input, float add_scale, int fusion_type) {
+    const bool add_before = add_input && fusion_type == FusionType_Conv_Add_Activation;
+    const bool add_after  = add_input && fusion_type == FusionType_Conv_Activation_Add;
+
+    __m128i v_bias  = _mm_set1_epi32(bias);
+    __m128 v_scale  = _mm_set1_ps(scale);
+    __m128 v_add_sc = _mm_set1_ps(add_scale);
+    __m128 v_zero   = _mm_setzero_ps();
+    long i          = 0;
+    for (; i + 4 <= len; i += 4) {
+        __m128i acc = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i)), v_bias);
+        __m128 v    = _mm_mul_ps(_mm_cvtepi32_ps(acc), v_scale);
+        if (add_before) {
+            v = _mm_add_ps(v, _mm_mul_ps(_mm_cvtepi32_ps(LoadInt8x4(add_input + i)), v_add_sc));
+        }
+        if (relu) {
+            v = _mm_max_ps(v, v_zero);
+        }
+        if (add_after) {
+            v = _mm_add_ps(v, _mm_mul_ps(_mm_cvtepi32_ps(LoadInt8x4(add_input + i)), v_add_sc));
+        }
+        StoreInt8x4(dst + i, v);
+    }
+    for (; i < len; i++) {
+        float v = (src[i] + bias) * scale;
+        if (add_before) {
+            v += add_input[i] * add_scale;
+        }
+        if (relu) {
+            v = std::max(v, 0.f);
+        }
+        if (add_after) {
+            v += add_input[i] * add_scale;
+        }
+        dst[i] = FloatToInt8(v);
+    }
+}
+
+// x of output col reads input col x * stride + offset, get the range of x inside the input
+static void GetValidRange(long offset, long stride, long size, long out_size, long &begin, long &end) {
+    begin = offset >= 0 ? 0 : (-offset + stride - 1) / stride;
+    end   = size - 1 - offset >= 0 ? std::min(out_size, (size - 1 - offset) / stride + 1) : 0;
+    begin = std::min(begin, end);
+}
+
+void X86DepthwiseInt8(int32_t *dst, const int8_t *src, const int8_t *weight, long height, long width, long out_height,
+                      long out_width, long kernel_h, long kernel_w, long pad_t, long pad_l, long stride_h,
+                      long stride_w, long dilation_h, long dilation_w) {
+    memset(dst, 0, out_height * out_width * sizeof(int32_t));
+    for (long oy = 0; oy < out_height; oy++) {
+        auto dst_y = dst + oy * out_width;
+        for (long ky = 0; ky < kernel_h; ky++) {
+            long iy = oy * stride_h - pad_t + ky * dilation_h;
+            if (iy < 0 || iy >= height) {
+                continue;
+            }
+            auto src_y = src + iy * width;
+            for (long kx = 0; kx < kernel_w; kx++) {
+                int32_t w   = weight[ky * kernel_w + kx];
+                long offset = kx * dilation_w - pad_l;
+                long begin, end;
+                GetValidRange(offset, stride_w, width, out_width, begin, end);
+                if (stride_w == 1) {
+                    auto src_k = src_y + offset;
+                    for (long ox = begin; ox < end; ox++) {
+                        dst_y[ox] += w * src_k[ox];
+                    }
+                } else {
+                    for (long ox = begin; ox < end; ox++) {
+                        dst_y[ox] += w * src_y[ox * stride_w + offset];
+                    }
+                }
+            }
+        }
+    }
+}
+
+void X86MaxPoolingInt8(int8_t *dst, const int8_t *src, long height, long width, long out_height, long out_width,
+                       long kernel_h, long kernel_w, long stride_h, long stride_w, long pad_t, long pad_l) {
+    for (long oy = 0; oy < out_height; oy++) {
+        long y_begin = std::max(oy * stride_h - pad_t, 0L);
+        long y_end   = std::min(oy * stride_h - pad_t + kernel_h, height);
+        auto dst_y   = dst + oy * out_width;
+        for (long ox = 0; ox < out_width; ox++) {
+            dst_y[ox] = -INT8_MAX;
+        }
+        for (long iy = y_begin; iy < y_end; iy++) {
+            auto src_y = src + iy * width;
+            for (long kx = 0; kx < kernel_w; kx++) {
+                long offset = kx - pad_l;
+                long begin, end;
+                GetValidRange(offset, stride_w, width, out_width, begin, end);
+                for (long ox = begin; ox < end; ox++) {
+                    dst_y[ox] = std::max(dst_y[ox], src_y[ox * stride_w + offset]);
+                }
+            }
+        }
+    }
+}
+
+void X86AvgPoolingInt8(int8_t *dst, const int8_t *src, long height, long width, long out_height, long out_width,
+                       long kernel_h, long kernel_w, long stride_h, long stride_w, long pad_t, long pad_l) {
+    for (long oy = 0; oy < out_height; oy++) {
+        long y_begin = std::max(oy * stride_h - pad_t, 0L);
+        long y_end   = std::min(oy * stride_h - pad_t + kernel_h, height);
+        for (long ox = 0; ox < out_width; ox++) {
+            long x_begin = std::max(ox * stride_w - pad_l, 0L);
+            long x_end   = std::min(ox * stride_w - pad_l + kernel_w, width);
+            int32_t sum  = 0;
+            for (long iy = y_begin; iy < y_end; iy++) {
+                for (long ix = x_begin; ix < x_end; ix++) {
+                    sum += src[iy * width + ix];
+                }
+            }
+            long count                = (y_end - y_begin) * (x_end - x_begin);
+            dst[oy * out_width + ox] = count > 0 ? static_cast<int8_t>(sum / count) : 0;
+        }
+    }
+}
+
+void X86MatrixAddInt8(int8_t *dst, const int8_t *a, const int8_t *b, const float *dst_scale, const float *a_scale,
+                      const float *b_scale, long batch, long channel, long hw) {
+    OMP_PARALLEL_FOR_
+    for (long bc = 0; bc < batch * channel; bc++) {
+        long c       = bc % channel;
+        auto a_c     = a + bc * hw;
+        auto b_c     = b + bc * hw;
+        auto dst_c   = dst + bc * hw;
+        __m128 v_sa  = _mm_set1_ps(a_scale[c]);
+        __m128 v_sb  = _mm_set1_ps(b_scale[c]);
+        __m128 v_sd  = _mm_set1_ps(dst_scale[c]);
+        long i       = 0;
+        for (; i + 4 <= hw; i += 4) {
+            __m128 va = _mm_mul_ps(_mm_cvtepi32_ps(LoadInt8x4(a_c + i)), v_sa);
+            __m128 vb = _mm_mul_ps(_mm_cvtepi32_ps(LoadInt8x4(b_c + i)), v_sb);
+            StoreInt8x4(dst_c + i, _mm_mul_ps(_mm_add_ps(va, vb), v_sd));
+        }
+        for (; i < hw; i++) {
+            dst_c[i] = FloatToInt8((a_c[i] * a_scale[c] + b_c[i] * b_scale[c]) * dst_scale[c]);
+        }
+    }
+}
+
+void X86Int8ToFloat(float *dst, const int8_t *src, const float *scale, long batch, long channel, long hw) {
+    OMP_PARALLEL_FOR_
+    for (long bc = 0; bc < batch * channel; bc++) {
+        long c     = bc % channel;
+        auto src_c = src + bc * hw;
+        auto dst_c = dst + bc * hw;
+        __m128 v_s = _mm_set1_ps(scale[c]);
+        long i     = 0;
+        for (; i + 4 <= hw; i += 4) {
+            _mm_storeu_ps(dst_c + i, _mm_mul_ps(_mm_cvtepi32_ps(LoadInt8x4(src_c + i)), v_s));
+        }
+        for (; i < hw; i++) {
+            dst_c[i] = src_c[i] * scale[c];
+        }
+    }
+}
+
+void X86FloatToInt8(int8_t *dst, const float *src, const float *scale, long batch, long channel, long hw) {
+    OMP_PARALLEL_FOR_
+    for (long bc = 0; bc < batch * channel; bc++) {
+        long c     = bc % channel;
+        auto src_c = src + bc * hw;
+        auto dst_c = dst + bc * hw;
+        __m128 v_s = _mm_set1_ps(scale[c]);
+        long i     = 0;
+        for (; i + 4 <= hw; i += 4) {
+            StoreInt8x4(dst_c + i, _mm_mul_ps(_mm_loadu_ps(src_c + i), v_s));
+        }
+        for (; i < hw; i++) {
+            dst_c[i] = FloatToInt8(src_c[i] * scale[c]);
+        }
+    }
+}
+
+}  // namespace TNN_NS
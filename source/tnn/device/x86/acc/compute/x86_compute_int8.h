@@ -0,0 +1,71 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_X86_COMPUTE_INT8_H_
+#define TNN_SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_X86_COMPUTE_INT8_H_
+
+#include <stdint.h>
+
+#include "tnn/core/common.h"
+#include "tnn/device/x86/acc/compute/jit/utils/cpu_isa.h"
+
+namespace TNN_NS {
+
+// the k dim of packed int8 gemm operands is padded with zeros to a multiple of it
+#define X86_INT8_K_ALIGN 64
+
+// @brief pad m rows of int8 weights from k to k_pad. Weights are clamped to [-127, 127] as the
+// quantization tool does, comp gets 128 * sum of each row, the vnni kernel shifts inputs to uint8
+// and subtracts it.
+void X86Int8PackWeight(int8_t *dst, int32_t *comp, const int8_t *src, long m, long k, long k_pad);
+
+// @brief im2col of one group, dst is stored by output pixel, each pixel with k_pad values
+void X86Int8Im2Col(int8_t *dst, const int8_t *src, long channel, long height, long width, long kernel_h,
+                   long kernel_w, long pad_t, long pad_l, long stride_h, long stride_w, long dilation_h,
+                   long dilation_w, long out_height, long out_width, long k_pad);
+
+// @brief c[i * ldc + j] = sum(a[i][k] * b[j][k]) in int32, a is packed by X86Int8PackWeight, b holds n rows
+// of k_pad values. Uses vpdpbusd on avx512 vnni, vpmaddubsw on avx2 and sse.
+void X86Int8Gemm(x86_isa_t arch, int32_t *c, const int8_t *a, const int8_t *b, const int32_t *comp, long m, long n,
+                 long k_pad, long ldc);
+
+// @brief requantize len int32 values of one channel, dst = int8((src + bias) * scale) with relu,
+// add_input is scaled by add_scale and added before or after relu as fusion_type requires
+void X86Int8Requant(int8_t *dst, const int32_t *src, long len, int32_t bias, float scale, long relu,
+                    const int8_t *add_input, float add_scale, int fusion_type);
+
+// @brief depthwise conv of one channel, the int32 sums are stored in dst
+void X86DepthwiseInt8(int32_t *dst, const int8_t *src, const int8_t *weight, long height, long width, long out_height,
+                      long out_width, long kernel_h, long kernel_w, long pad_t, long pad_l, long stride_h,
+                      long stride_w, long dilation_h, long dilation_w);
+
+void X86MaxPoolingInt8(int8_t *dst, const int8_t *src, long height, long width, long out_height, long out_width,
+                       long kernel_h, long kernel_w, long stride_h, long stride_w, long pad_t, long pad_l);
+
+void X86AvgPoolingInt8(int8_t *dst, const int8_t *src, long height, long width, long out_height, long out_width,
+                       long kernel_h, long kernel_w, long stride_h, long stride_w, long pad_t, long pad_l);
+
+// @brief dst = int8((a * a_scale + b * b_scale) * dst_scale), scales are given per channel,
+// dst_scale is the reciprocal of the output scale
+void X86MatrixAddInt8(int8_t *dst, const int8_t *a, const int8_t *b, const float *dst_scale, const float *a_scale,
+                      const float *b_scale, long batch, long channel, long hw);
+
+void X86Int8ToFloat(float *dst, const int8_t *src, const float *scale, long batch, long channel, long hw);
+
+// @brief scale is the reciprocal of the blob scale per channel
+void X86FloatToInt8(int8_t *dst, const float *src, const float *scale, long batch, long channel, long hw);
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_X86_COMPUTE_INT8_H_
@@ -0,0 +1,554 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_X86_COMPUTE_VEC_H_
+#define SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_X86_COMPUTE_VEC_H_
+
+// Vector kernels templated by VEC (Float4, Float8 or Float16). Each isa variant is explicitly
+// instantiated in its own translation unit: x86_compute.cc for sse4.2, x86_compute_avx2.cc and
+// x86_compute_avx512.cc include this file inside X86_AVX2_BEGIN / X86_AVX512_BEGIN, after
+// all other headers, so that only the kernels below are compiled for the wider isa.
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#include "tnn/core/common.h"
+#include "tnn/device/x86/acc/Float16.h"
+#include "tnn/device/x86/acc/Float4.h"
+#include "tnn/device/x86/acc/Float8.h"
+#include "tnn/device/x86/acc/compute/x86_compute.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+/*
+max pooling corner func, left/right/top/bottom
+*/
+template <class T, int pack_c>
+void X86MaxPoolingCorner(const float* src, long iw, long ih, float* dst, long ow, long kw, long kh, long stride_w, long stride_h,
+                      long pad_w, long pad_h, long l, long r, long t, long b) {
+    for (long oy = t; oy < b; ++oy) {
+        for (long ox = l; ox < r; ++ox) {
+            T vmax(-FLT_MAX);
+
+            const long srcOriginX = ox * stride_w - pad_w;
+            const long srcOriginY = oy * stride_h - pad_h;
+            const long kxs        = MAX(0, -srcOriginX);
+            const long kxe        = MIN(kw, iw - srcOriginX);
+            const long kys        = MAX(0, -srcOriginY);
+            const long kye        = MIN(kh, ih - srcOriginY);
+            const auto src_ptr    = src + (srcOriginY * iw + srcOriginX) * pack_c;
+            auto dst_ptr          = dst + (oy * ow + ox) * pack_c;
+
+            for (long ky = kys; ky < kye; ++ky) {
+                const auto src_ptr_h = src_ptr + (ky * iw) * pack_c;
+                for (long kx = kxs; kx < kxe; kx++) {
+                    vmax = T::max(vmax, T::load(src_ptr_h + kx * pack_c));
+                }
+            }
+
+            T::save(dst_ptr, vmax);
+        }
+    }
+}
+
+/*
+max pooling 3x3s2 kernel
+*/
+template <class T, int pack_c>
+void X86MaxPoolingCenter3x3s2(const float* src, long iw, long ih, float* dst, long ow, long oh, long pad_w, long pad_h, long l,
+                           long r, long t, long b) {
+    for (long oy = t; oy < b; ++oy) {
+        for (long ox = l; ox < r; ++ox) {
+            T vmax(-FLT_MAX);
+
+            const long src_offset_x = ox * 2 - pad_w;
+            const long src_offset_y = oy * 2 - pad_h;
+            const auto src_ptr      = src + (src_offset_y * iw + src_offset_x) * pack_c;
+            auto dst_ptr            = dst + (oy * ow + ox) * pack_c;
+
+            for (long ky = 0; ky < 3; ++ky) {
+                const auto src_ptr_h = src_ptr + (ky * iw) * pack_c;
+                vmax                 = T::max(vmax, T::load(src_ptr_h + 0 * pack_c));
+                vmax                 = T::max(vmax, T::load(src_ptr_h + 1 * pack_c));
+                vmax                 = T::max(vmax, T::load(src_ptr_h + 2 * pack_c));
+            }
+            T::save(dst_ptr, vmax);
+        }
+    }
+}
+
+/*
+general max pooling center kernel
+*/
+template <class T, int pack_c>
+void X86MaxPoolingCenter(const float* src, long iw, long ih, float* dst, long ow, long oh, long kw, long kh, long stride_w,
+                      long stride_h, long pad_w, long pad_h, long l, long r, long t, long b) {
+    for (long oy = t; oy < b; ++oy) {
+        for (long ox = l; ox < r; ++ox) {
+            T vmax(-FLT_MAX);
+
+            const long src_offset_x = ox * stride_w - pad_w;
+            const long src_offset_y = oy * stride_h - pad_h;
+            const auto src_ptr      = src + (src_offset_y * iw + src_offset_x) * pack_c;
+            auto dst_ptr            = dst + (oy * ow + ox) * pack_c;
+
+            for (long ky = 0; ky < kh; ++ky) {
+                const auto src_ptr_h = src_ptr + (ky * iw) * pack_c;
+                for (long kx = 0; kx < kw; kx++) {
+                    vmax = T::max(vmax, T::load(src_ptr_h + kx * pack_c));
+                }
+            }
+
+            T::save(dst_ptr, vmax);
+        }
+    }
+}
+
+/*
+max pooling func, process four corners and center
+*/
+template <class T, int pack_c>
+void X86MaxPooling(const float* src, long iw, long ih, float* dst, long ow, long oh, long kw, long kh, long stride_w,
+                long stride_h, long pad_w, long pad_h, long l, long r, long t, long b) {
+    // top corner
+    X86MaxPoolingCorner<T, pack_c>(src, iw, ih, dst, ow, kw, kh, stride_w, stride_h, pad_w, pad_h, 0, ow, 0, t);
+    if (kw == 3 && kh == 3 && stride_h == 2 && stride_w == 2) {
+        X86MaxPoolingCenter3x3s2<T, pack_c>(src, iw, ih, dst, ow, oh, pad_w, pad_h, l, r, t, b);
+    } else {
+        X86MaxPoolingCenter<T, pack_c>(src, iw, ih, dst, ow, oh, kw, kh, stride_w, stride_h, pad_w, pad_h, l, r, t, b);
+    }
+
+    // bottom corner
+    X86MaxPoolingCorner<T, pack_c>(src, iw, ih, dst, ow, kw, kh, stride_w, stride_h, pad_w, pad_h, 0, ow, b, oh);
+    // left corner
+    X86MaxPoolingCorner<T, pack_c>(src, iw, ih, dst, ow, kw, kh, stride_w, stride_h, pad_w, pad_h, 0, l, t, b);
+    // right corner
+    X86MaxPoolingCorner<T, pack_c>(src, iw, ih, dst, ow, kw, kh, stride_w, stride_h, pad_w, pad_h, r, ow, t, b);
+}
+
+
+/*
+general avg pooling func
+*/
+template <class T, int pack_c>
+void X86AvgPooling(const float* src, long iw, long ih, float* dst, long ow, long oh, long kw, long kh, long stride_w,
+                long stride_h, long pad_w, long pad_h) {
+    for (long oy = 0; oy < oh; ++oy) {
+        for (long ox = 0; ox < ow; ++ox) {
+            T vavg(0.f);
+
+            const long srcOriginX    = ox * stride_w - pad_w;
+            const long srcOriginY    = oy * stride_h - pad_h;
+            const long kxs           = MAX(0, -srcOriginX);
+            const long kxe           = MIN(kw, iw - srcOriginX);
+            const long kys           = MAX(0, -srcOriginY);
+            const long kye           = MIN(kh, ih - srcOriginY);
+            const float kernel_count = 1.0 / ((kxe - kxs) * (kye - kys));
+            const auto src_ptr       = src + (srcOriginY * iw + srcOriginX) * pack_c;
+            auto dst_ptr             = dst + (oy * ow + ox) * pack_c;
+
+            for (long ky = kys; ky < kye; ++ky) {
+                const auto src_ptr_h = src_ptr + (ky * iw) * pack_c;
+                for (long kx = kxs; kx < kxe; kx++) {
+                    vavg = vavg + T::load(src_ptr_h + kx * pack_c);
+                }
+            }
+
+            vavg = vavg * T(kernel_count);
+            T::save(dst_ptr, vavg);
+        }
+    }
+}
+
+
+template <int activation_type, typename VEC, int pack>
+void DepthwiseConv(float* dst, const float* src, const float* weight, const float* bias, long width, long src_w_step, long fw, long fh,
+                   long dilate_x_step, long dilate_y_step, long height, long srcHStep, long dstHStep) {
+    long dx, fx, fy;
+    VEC bias_v = VEC::loadu(bias);
+    VEC v_zero = VEC(0.f);
+    VEC v_6    = VEC(6.f);
+    for (long y = 0; y < height; ++y) {
+        auto srcY = src + y * srcHStep;
+        auto dstY = dst + y * dstHStep;
+        dx        = 0;
+        for (; dx + 3 < width; dx += 4) {
+            VEC dst_v[4];
+            for (long i = 0; i < 4; i++)
+                dst_v[i] = bias_v;
+            const auto* src_z    = srcY + src_w_step * dx;
+            const auto* weight_z = weight;
+            for (fy = 0; fy < fh; ++fy) {
+                const auto* src_y    = src_z + fy * dilate_y_step;
+                const auto* weight_y = weight_z + fy * fw * pack;
+                for (fx = 0; fx < fw; ++fx) {
+                    VEC weight_v = VEC::loadu(weight_y + pack * fx);
+                    VEC src_v0   = VEC::load(src_y + fx * dilate_x_step);
+                    VEC src_v1   = VEC::load(src_y + fx * dilate_x_step + src_w_step);
+                    VEC src_v2   = VEC::load(src_y + fx * dilate_x_step + 2 * src_w_step);
+                    VEC src_v3   = VEC::load(src_y + fx * dilate_x_step + 3 * src_w_step);
+                    VEC::mla(dst_v[0], src_v0, weight_v);
+                    VEC::mla(dst_v[1], src_v1, weight_v);
+                    VEC::mla(dst_v[2], src_v2, weight_v);
+                    VEC::mla(dst_v[3], src_v3, weight_v);
+                }
+            }
+            if (activation_type == ActivationType_ReLU || 
+                activation_type == ActivationType_ReLU6) {
+                dst_v[0] = VEC::max(dst_v[0], v_zero);
+                dst_v[1] = VEC::max(dst_v[1], v_zero);
+                dst_v[2] = VEC::max(dst_v[2], v_zero);
+                dst_v[3] = VEC::max(dst_v[3], v_zero);
+            }
+            if (activation_type == ActivationType_ReLU6) {
+                dst_v[0] = VEC::min(dst_v[0], v_6);
+                dst_v[1] = VEC::min(dst_v[1], v_6);
+                dst_v[2] = VEC::min(dst_v[2], v_6);
+                dst_v[3] = VEC::min(dst_v[3], v_6);
+            }
+            VEC::save(dstY + (dx + 0) * pack, dst_v[0]);
+            VEC::save(dstY + (dx + 1) * pack, dst_v[1]);
+            VEC::save(dstY + (dx + 2) * pack, dst_v[2]);
+            VEC::save(dstY + (dx + 3) * pack, dst_v[3]);
+        }
+        for (; dx < width; ++dx) {
+            VEC dst_v = bias_v;
+            const auto* src_z    = srcY + src_w_step * dx;
+            const auto* weight_z = weight;
+            for (fy = 0; fy < fh; ++fy) {
+                const auto* src_y    = src_z + fy * dilate_y_step;
+                const auto* weight_y = weight_z + fy * fw * pack;
+                for (fx = 0; fx < fw; ++fx) {
+                    VEC src_v    = VEC::load(src_y + fx * dilate_x_step);
+                    VEC weight_v = VEC::loadu(weight_y + pack * fx);
+                    VEC::mla(dst_v, src_v, weight_v);
+                }
+            }
+            if (activation_type == ActivationType_ReLU || 
+                activation_type == ActivationType_ReLU6) {
+                dst_v = VEC::max(dst_v, v_zero);
+            }
+            if (activation_type == ActivationType_ReLU6) {
+                dst_v = VEC::min(dst_v, v_6);
+            }
+            VEC::save(dstY + dx * pack, dst_v);
+        }
+    }
+}
+
+
+template <int left, int oc_>
+static void X86SgemvLeft(float* dst, const float* src, const float* weight, float *bias, size_t batch_stride) {
+    float acc[8];
+    for (int i = 0; i < left; i++) {
+        acc[i] = bias[i];
+    }
+    for (size_t ic = 0; ic < batch_stride; ic++) {
+        auto weight_ic = weight + ic * oc_;
+        for (int i = 0; i < left; i++) {
+            acc[i] += weight_ic[i] * src[ic];
+        }
+    }
+    for (int i = 0; i < left; i++) {
+        dst[i] = acc[i];
+    }
+}
+
+template <typename VEC, int pack>
+void X86Sgemv(float* dst, const float* src, const float* weight, float *bias, DimsVector dims_input, DimsVector dims_output) {
+    size_t batch_stride = DimsVectorUtils::Count(dims_input, 1);
+    for (int b = 0; b < dims_output[0]; ++b) {
+        const float *src_batch = src + b * batch_stride;
+        float *dst_batch = dst + b * dims_output[1];
+
+        int oc = 0;
+        for (; oc + pack - 1 < dims_output[1]; oc += pack) {
+            auto weight_oc = weight + oc * batch_stride;
+            VEC acc = VEC::loadu(bias + oc);
+            size_t ic = 0;
+            for (; ic + 3 < batch_stride; ic += 4) {
+                auto weight_ic   = weight_oc + ic * pack;
+                VEC src_v0    = VEC(src_batch[ic]);
+                VEC src_v1    = VEC(src_batch[ic + 1]);
+                VEC src_v2    = VEC(src_batch[ic + 2]);
+                VEC src_v3    = VEC(src_batch[ic + 3]);
+                VEC weight_v0 = VEC::load(weight_ic);
+                VEC weight_v1 = VEC::load(weight_ic + pack * 1);
+                VEC weight_v2 = VEC::load(weight_ic + pack * 2);
+                VEC weight_v3 = VEC::load(weight_ic + pack * 3);
+                VEC::mla(acc, weight_v0, src_v0);
+                VEC::mla(acc, weight_v1, src_v1);
+                VEC::mla(acc, weight_v2, src_v2);
+                VEC::mla(acc, weight_v3, src_v3);
+            }
+            for (; ic < batch_stride; ic++) {
+                VEC src_v    = VEC(src_batch[ic]);
+                VEC weight_v = VEC::load(weight_oc + ic * pack);
+                VEC::mla(acc, weight_v, src_v);
+            }
+            VEC::saveu(dst_batch + oc, acc);
+        }
+        int left = dims_output[1] - oc;
+        if (pack == 8) {
+            if (left == 7) {
+                X86SgemvLeft<7, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
+            } else if (left == 6) {
+                X86SgemvLeft<6, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
+            } else if (left == 5) {
+                X86SgemvLeft<5, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
+            } else if (left == 4) {
+                X86SgemvLeft<4, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
+            }
+        }
+        if (left == 3) {
+            X86SgemvLeft<3, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
+        } else if (left == 2) {
+            X86SgemvLeft<2, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
+        } else if (left == 1) {
+            X86SgemvLeft<1, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
+        }
+    }
+}
+
+template <int activation_type, typename VEC, int pack>
+void X86_Post_Exec(float *dst, const float *bias, long channel, long area) {
+    for (long c = 0; c < channel; c++) {
+        auto dst_c = dst + c * area;
+        VEC bias_v = VEC(bias + c);
+        VEC zero_v = VEC(0.f);
+        VEC six_v = VEC(6.f);
+        long i = 0;
+        for (; i + pack - 1 < area; i += pack) {
+            VEC src_v = VEC::loadu(dst_c + i);
+            VEC dst_v = VEC::add(src_v, bias_v);
+
+            if (activation_type == ActivationType_ReLU || 
+                activation_type == ActivationType_ReLU6) {
+                dst_v = VEC::max(dst_v, zero_v);
+            }
+            if (activation_type == ActivationType_ReLU6) {
+                dst_v = VEC::min(dst_v, six_v);
+            }
+            VEC::saveu(dst_c + i, dst_v);
+        }
+
+        for (; i < area; i++) {
+            float dst_value = dst_c[i] + bias[c];
+            if (activation_type == ActivationType_ReLU || 
+                activation_type == ActivationType_ReLU6) {
+                dst_value = std::max(dst_value, 0.f);
+            }
+            if (activation_type == ActivationType_ReLU6) {
+                dst_value = std::min(dst_value, 6.f);
+            }
+            dst_c[i] = dst_value;
+        }
+    }
+}
+
+template <typename VEC, int pack>
+void X86_VectorAdd(float *dst, const float *src_a, const float *src_b, long len) {
+    long i = 0;
+    for (; i + pack - 1 < len; i += pack) {
+        VEC a_vec = VEC::loadu(src_a + i);
+        VEC b_vec = VEC::loadu(src_b + i);
+        VEC c_vec = VEC::add(a_vec, b_vec);
+        VEC::saveu(dst + i, c_vec);
+    }
+    for (; i < len; i++) {
+        dst[i] = src_a[i] + src_b[i];
+    }
+}
+
+template <typename VEC, int pack>
+void X86_VectorAdd(float *dst, const float *src, long len) {
+    long i = 0;
+    for (; i + pack - 1 < len; i += pack) {
+        VEC a_vec = VEC::loadu(src + i);
+        VEC b_vec = VEC::loadu(dst + i);
+        VEC c_vec = VEC::add(a_vec, b_vec);
+        VEC::saveu(dst + i, c_vec);
+    }
+    for (; i < len; i++) {
+        dst[i] += src[i];
+    }
+}
+
+template <typename VEC, int pack>
+void X86_FMA_Kernel(float *input_data, float *output_data, float *scale_data, float *bias_data,
+                    bool shared_channel, bool has_bias, DimsVector output_dim) {
+    int channel = output_dim[1];
+    long cal_count;
+    if (shared_channel)
+        cal_count = DimsVectorUtils::Count(output_dim);
+    else
+        cal_count = DimsVectorUtils::Count(output_dim, 2);
+    long outer_count = shared_channel ? 1 : output_dim[0] * channel;
+
+    for (long oc = 0; oc < outer_count; oc++) {
+        int c         = shared_channel ? 0 : oc % channel;
+        float scale   = scale_data[c];
+        float bias    = has_bias ? bias_data[c] : 0.f;
+        VEC scale_v   = VEC(scale);
+        VEC bias_v    = VEC(bias);
+        float *input  = input_data + oc * cal_count;
+        float *output = output_data + oc * cal_count;
+        long i = 0;
+        for (; i + pack - 1 < cal_count; i += pack) {
+            VEC dst_v = bias_v;
+            VEC::mla(dst_v, VEC::loadu(input + i), scale_v);
+            VEC::saveu(output + i, dst_v);
+        }
+        for (; i < cal_count; i++) {
+            output[i] = input[i] * scale + bias;
+        }
+    }
+}
+
+// the channels of a NC8HW8 block are the lanes of VEC, padded channels stay zero
+template <typename VEC, int pack>
+void X86_FMA_NC8HW8_Kernel(float *input_data, float *output_data, float *scale_data, float *bias_data,
+                           bool shared_channel, bool has_bias, DimsVector output_dim) {
+    int channel    = output_dim[1];
+    int channel_r  = ROUND_UP(channel, pack);
+    long cal_count = DimsVectorUtils::Count(output_dim, 2);
+
+    for (long b = 0; b < output_dim[0]; b++) {
+        for (int c = 0; c < channel_r; c += pack) {
+            float scale[pack], bias[pack];
+            for (int i = 0; i < pack; i++) {
+                int idx   = shared_channel ? 0 : c + i;
+                bool real = c + i < channel;
+                scale[i]  = real ? scale_data[idx] : 0.f;
+                bias[i]   = real && has_bias ? bias_data[idx] : 0.f;
+            }
+            VEC scale_v   = VEC::loadu(scale);
+            VEC bias_v    = VEC::loadu(bias);
+            float *input  = input_data + (b * channel_r + c) * cal_count;
+            float *output = output_data + (b * channel_r + c) * cal_count;
+            for (long i = 0; i < cal_count; i++) {
+                VEC dst_v = bias_v;
+                VEC::mla(dst_v, VEC::loadu(input + i * pack), scale_v);
+                VEC::saveu(output + i * pack, dst_v);
+            }
+        }
+    }
+}
+
+// attention of rows queries over seq_k keys, the scores are made block_k keys at a time and folded into dst
+// with a running max and sum of each row, so the full score matrix is never stored
+template <typename VEC, int pack>
+void X86FlashAttention(const float *q, const float *kt, const float *v, const float *mask, long mask_row_stride,
+                       long mask_col_stride, float *dst, long rows, long seq_k, long depth, long depth_v, float scale,
+                       long block_k, float *workspace) {
+    float *scores  = workspace;
+    float *row_max = scores + rows * block_k;
+    float *row_sum = row_max + rows;
+    for (long r = 0; r < rows; r++) {
+        row_max[r] = -FLT_MAX;
+        row_sum[r] = 0.f;
+    }
+    memset(dst, 0, rows * depth_v * sizeof(float));
+
+    for (long k_begin = 0; k_begin < seq_k; k_begin += block_k) {
+        long kn = MIN(block_k, seq_k - k_begin);
+        // scores = scale * q x kt + mask
+        for (long r = 0; r < rows; r++) {
+            float *s         = scores + r * block_k;
+            const float *q_r = q + r * depth;
+            long j = 0;
+            for (; j + pack - 1 < kn; j += pack) {
+                VEC s_v = VEC(0.f);
+                for (long d = 0; d < depth; d++) {
+                    VEC::mla(s_v, VEC::loadu(kt + d * seq_k + k_begin + j), VEC(q_r[d]));
+                }
+                VEC::saveu(s + j, s_v * scale);
+            }
+            for (; j < kn; j++) {
+                float s_j = 0.f;
+                for (long d = 0; d < depth; d++) {
+                    s_j += q_r[d] * kt[d * seq_k + k_begin + j];
+                }
+                s[j] = s_j * scale;
+            }
+            if (mask) {
+                const float *mask_r = mask + r * mask_row_stride + k_begin * mask_col_stride;
+                for (j = 0; j < kn; j++) {
+                    s[j] += mask_r[j * mask_col_stride];
+                }
+            }
+        }
+
+        for (long r = 0; r < rows; r++) {
+            float *s     = scores + r * block_k;
+            float *dst_r = dst + r * depth_v;
+            float max_v  = row_max[r];
+            for (long j = 0; j < kn; j++) {
+                max_v = std::max(max_v, s[j]);
+            }
+            // rescale what has been accumulated with the old max
+            float correction = std::exp(row_max[r] - max_v);
+            row_max[r]       = max_v;
+
+            long j      = 0;
+            VEC max_vec = VEC(max_v);
+            for (; j + pack - 1 < kn; j += pack) {
+                VEC::saveu(s + j, VEC::exp(VEC::loadu(s + j) - max_vec));
+            }
+            for (; j < kn; j++) {
+                s[j] = std::exp(s[j] - max_v);
+            }
+            float sum = 0.f;
+            for (j = 0; j < kn; j++) {
+                sum += s[j];
+            }
+            row_sum[r] = row_sum[r] * correction + sum;
+
+            long c = 0;
+            for (; c + pack - 1 < depth_v; c += pack) {
+                VEC dst_v = VEC::loadu(dst_r + c) * correction;
+                for (j = 0; j < kn; j++) {
+                    VEC::mla(dst_v, VEC::loadu(v + (k_begin + j) * depth_v + c), VEC(s[j]));
+                }
+                VEC::saveu(dst_r + c, dst_v);
+            }
+            for (; c < depth_v; c++) {
+                float dst_c = dst_r[c] * correction;
+                for (j = 0; j < kn; j++) {
+                    dst_c += s[j] * v[(k_begin + j) * depth_v + c];
+                }
+                dst_r[c] = dst_c;
+            }
+        }
+    }
+
+    for (long r = 0; r < rows; r++) {
+        float *dst_r  = dst + r * depth_v;
+        float inv_sum = 1.f / row_sum[r];
+        long c = 0;
+        for (; c + pack - 1 < depth_v; c += pack) {
+            VEC::saveu(dst_r + c, VEC::loadu(dst_r + c) * inv_sum);
+        }
+        for (; c < depth_v; c++) {
+            dst_r[c] *= inv_sum;
+        }
+    }
+}
+
+}  // namespace TNN_NS
+
+#endif  // SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_X86_COMPUTE_VEC_H_
@@ -0,0 +1,217 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/device/x86/acc/convolution/x86_conv_int8_layer_common.h"
+
+#include <float.h>
+
+#include "tnn/core/blob_int8.h"
+#include "tnn/device/x86/acc/compute/x86_compute_int8.h"
+#include "tnn/interpreter/layer_resource.h"
+#include "tnn/utils/dims_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+/*
+X86ConvInt8LayerCommon as the last conv int8 solution, the input of each group is unfolded by im2col and
+multiplied with the packed weights, 1x1 and 3x3 convs also go this way
+*/
+bool X86ConvInt8LayerCommon::isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                                        const std::vector<Blob *> &outputs) {
+    return inputs[0]->GetBlobDesc().data_type == DATA_TYPE_INT8;
+}
+
+X86ConvInt8LayerCommon::~X86ConvInt8LayerCommon() {}
+
+Status X86ConvInt8LayerCommon::allocateBufferWeight(const std::vector<Blob *> &inputs,
+                                                    const std::vector<Blob *> &outputs) {
+    ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(conv_param);
+    ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(conv_res);
+
+    if (!buffer_weight_.GetBytesSize()) {
+        const int ic = inputs[0]->GetBlobDesc().dims[1];
+        const int oc = outputs[0]->GetBlobDesc().dims[1];
+        const int k  = ic / conv_param->group * conv_param->kernels[0] * conv_param->kernels[1];
+        k_pad_       = ROUND_UP(k, X86_INT8_K_ALIGN);
+
+        // from [o][i][h][w] to [o][k_pad], the rows of a group are contiguous
+        RawBuffer temp_buffer(oc * k_pad_, 64);
+        RawBuffer comp_buffer(oc * sizeof(int32_t));
+        X86Int8PackWeight(temp_buffer.force_to<int8_t *>(), comp_buffer.force_to<int32_t *>(),
+                          conv_res->filter_handle.force_to<int8_t *>(), oc, k, k_pad_);
+
+        buffer_weight_ = temp_buffer;
+        buffer_comp_   = comp_buffer;
+    }
+    return TNN_OK;
+}
+
+Status X86ConvInt8LayerCommon::allocateBufferBias(const std::vector<Blob *> &inputs,
+                                                  const std::vector<Blob *> &outputs) {
+    ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(conv_param);
+    ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(conv_res);
+
+    if (!buffer_bias_.GetBytesSize()) {
+        // int8 kernel always add bias, if not, set zeros
+        RawBuffer temp_buffer(outputs[0]->GetBlobDesc().dims[1] * sizeof(int32_t));
+        if (conv_param->bias) {
+            memcpy(temp_buffer.force_to<int32_t *>(), conv_res->bias_handle.force_to<int32_t *>(),
+                   conv_res->bias_handle.GetBytesSize());
+        }
+        buffer_bias_ = temp_buffer;
+    }
+    return TNN_OK;
+}
+
+// dst[i] = scale_a[i] / scale_b[i], scales of a single value are shared by all channels
+static Status GetScaleRatio(RawBuffer &dst, RawBuffer &scale_a, RawBuffer &scale_b, int channel) {
+    const float *a = scale_a.force_to<float *>();
+    const float *b = scale_b.force_to<float *>();
+    int len_a      = scale_a.GetDataCount();
+    int len_b      = scale_b.GetDataCount();
+
+    RawBuffer temp_buffer(channel * sizeof(float));
+    float *temp_ptr = temp_buffer.force_to<float *>();
+    for (int i = 0; i < channel; i++) {
+        float sa = a[len_a == 1 ? 0 : i];
+        float sb = b[len_b == 1 ? 0 : i];
+        if (sa < 0.0f || sb < 0.0f) {
+            return Status(TNNERR_PARAM_ERR, "int8-blob scale can not be negative");
+        }
+        temp_ptr[i] = sb >= FLT_MIN ? sa / sb : 0.0f;
+    }
+    dst = temp_buffer;
+    return TNN_OK;
+}
+
+Status X86ConvInt8LayerCommon::allocateBufferScale(const std::vector<Blob *> &inputs,
+                                                   const std::vector<Blob *> &outputs) {
+    ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(conv_res);
+
+    if (!buffer_scale_.GetBytesSize()) {
+        auto &o_scale = reinterpret_cast<BlobInt8 *>(outputs[0])->GetIntResource()->scale_handle;
+        RETURN_ON_NEQ(GetScaleRatio(buffer_scale_, conv_res->scale_handle, o_scale, outputs[0]->GetBlobDesc().dims[1]),
+                      TNN_OK);
+    }
+    return TNN_OK;
+}
+
+Status X86ConvInt8LayerCommon::allocateBufferAddScale(const std::vector<Blob *> &inputs,
+                                                      const std::vector<Blob *> &outputs) {
+    if (inputs.size() < 2 ||
+        DimsVectorUtils::Count(inputs[1]->GetBlobDesc().dims) !=
+            DimsVectorUtils::Count(outputs[0]->GetBlobDesc().dims)) {
+        return Status(TNNERR_LAYER_ERR, "Conv-Add fusion does not support broadcast-add");
+    }
+
+    if (!buffer_add_scale_.GetBytesSize()) {
+        auto &i_scale = reinterpret_cast<BlobInt8 *>(inputs[1])->GetIntResource()->scale_handle;
+        auto &o_scale = reinterpret_cast<BlobInt8 *>(outputs[0])->GetIntResource()->scale_handle;
+        RETURN_ON_NEQ(GetScaleRatio(buffer_add_scale_, i_scale, o_scale, outputs[0]->GetBlobDesc().dims[1]), TNN_OK);
+    }
+    return TNN_OK;
+}
+
+Status X86ConvInt8LayerCommon::Init(Context *context, LayerParam *param, LayerResource *resource,
+                                    const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    RETURN_ON_NEQ(X86LayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
+    RETURN_ON_NEQ(allocateBufferWeight(inputs, outputs), TNN_OK);
+    RETURN_ON_NEQ(allocateBufferBias(inputs, outputs), TNN_OK);
+    RETURN_ON_NEQ(allocateBufferScale(inputs, outputs), TNN_OK);
+
+    auto conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(conv_param);
+    if (conv_param->fusion_type != FusionType_None) {
+        RETURN_ON_NEQ(allocateBufferAddScale(inputs, outputs), TNN_OK);
+    }
+    // only support relu activation
+    relu_ = conv_param->activation_type == ActivationType_ReLU ? 1 : 0;
+
+    return TNN_OK;
+}
+
+void X86ConvInt8LayerCommon::Requant(int8_t *dst, const int32_t *src, const int8_t *add_input, int oc_begin,
+                                     int oc_end, int hw) {
+    auto conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    auto bias       = buffer_bias_.force_to<int32_t *>();
+    auto scale      = buffer_scale_.force_to<float *>();
+    auto add_scale  = buffer_add_scale_.force_to<float *>();
+    int fusion_type = conv_param->fusion_type;
+
+    OMP_PARALLEL_FOR_
+    for (int oc = oc_begin; oc < oc_end; oc++) {
+        auto add_c = add_input ? add_input + oc * hw : nullptr;
+        X86Int8Requant(dst + oc * hw, src + (oc - oc_begin) * hw, hw, bias[oc], scale[oc], relu_, add_c,
+                       add_c ? add_scale[oc] : 0.f, fusion_type);
+    }
+}
+
+Status X86ConvInt8LayerCommon::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+
+    auto input_dims  = inputs[0]->GetBlobDesc().dims;
+    auto output_dims = outputs[0]->GetBlobDesc().dims;
+    const int batch  = output_dims[0];
+    const int ic     = input_dims[1];
+    const int ih     = input_dims[2];
+    const int iw     = input_dims[3];
+    const int oc     = output_dims[1];
+    const int oh     = output_dims[2];
+    const int ow     = output_dims[3];
+    const int group  = param->group;
+    const int ic_g   = ic / group;
+    const int oc_g   = oc / group;
+    const int hw     = oh * ow;
+
+    // im2col data of one group followed by its int32 gemm output
+    size_t col_size  = ROUND_UP(hw * k_pad_, 64);
+    size_t work_size = col_size + oc_g * hw * sizeof(int32_t);
+    auto workspace   = reinterpret_cast<int8_t *>(context_->GetSharedWorkSpace(work_size));
+    auto col_data    = workspace;
+    auto gemm_output = reinterpret_cast<int32_t *>(workspace + col_size);
+
+    auto input_data  = (int8_t *)((char *)inputs[0]->GetHandle().base + inputs[0]->GetHandle().bytes_offset);
+    auto output_data = (int8_t *)((char *)outputs[0]->GetHandle().base + outputs[0]->GetHandle().bytes_offset);
+    int8_t *add_data = nullptr;
+    if (param->fusion_type != FusionType_None) {
+        add_data = (int8_t *)((char *)inputs[1]->GetHandle().base + inputs[1]->GetHandle().bytes_offset);
+    }
+    auto weight = buffer_weight_.force_to<int8_t *>();
+    auto comp   = buffer_comp_.force_to<int32_t *>();
+
+    for (int b = 0; b < batch; b++) {
+        auto input_b  = input_data + b * ic * ih * iw;
+        auto output_b = output_data + b * oc * hw;
+        auto add_b    = add_data ? add_data + b * oc * hw : nullptr;
+        for (int g = 0; g < group; g++) {
+            X86Int8Im2Col(col_data, input_b + g * ic_g * ih * iw, ic_g, ih, iw, param->kernels[1], param->kernels[0],
+                          param->pads[2], param->pads[0], param->strides[1], param->strides[0],
+                          param->dialations[1], param->dialations[0], oh, ow, k_pad_);
+            X86Int8Gemm(arch_, gemm_output, weight + g * oc_g * k_pad_, col_data, comp + g * oc_g, oc_g, hw, k_pad_,
+                        hw);
+            Requant(output_b, gemm_output, add_b, g * oc_g, (g + 1) * oc_g, hw);
+        }
+    }
+
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
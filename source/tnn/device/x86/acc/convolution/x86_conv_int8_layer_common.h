@@ -0,0 +1,62 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_SOURCE_TNN_DEVICE_X86_X86_CONV_INT8_LAYER_ACC_COMMON_H_
+#define TNN_SOURCE_TNN_DEVICE_X86_X86_CONV_INT8_LAYER_ACC_COMMON_H_
+
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+
+namespace TNN_NS {
+
+class X86ConvInt8LayerCommon : public X86LayerAcc {
+public:
+    virtual ~X86ConvInt8LayerCommon();
+
+    Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
+                const std::vector<Blob *> &outputs);
+
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    // always true as last int8 solution
+    static bool isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                           const std::vector<Blob *> &outputs);
+
+    // pack weights of each group for X86Int8Gemm
+    virtual Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    virtual Status allocateBufferBias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    // scale of weights divided by scale of output, per output channel
+    virtual Status allocateBufferScale(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    virtual Status allocateBufferAddScale(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+protected:
+    // requantize the int32 sums of output channels [oc_begin, oc_end) of one batch
+    void Requant(int8_t *dst, const int32_t *src, const int8_t *add_input, int oc_begin, int oc_end, int hw);
+
+    RawBuffer buffer_weight_;
+    RawBuffer buffer_comp_;
+    RawBuffer buffer_bias_;
+    RawBuffer buffer_scale_;
+    RawBuffer buffer_add_scale_;
+
+    long relu_ = 0;
+    int k_pad_ = 0;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_DEVICE_X86_X86_CONV_INT8_LAYER_ACC_COMMON_H_
@@ -0,0 +1,99 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/device/x86/acc/convolution/x86_conv_int8_layer_depthwise.h"
+
+#include "tnn/device/x86/acc/compute/x86_compute_int8.h"
+#include "tnn/interpreter/layer_resource.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+bool X86ConvInt8LayerDepthwise::isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                                           const std::vector<Blob *> &outputs) {
+    if (!param || inputs[0]->GetBlobDesc().data_type != DATA_TYPE_INT8) {
+        return false;
+    }
+
+    const int group          = param->group;
+    const int input_channel  = inputs[0]->GetBlobDesc().dims[1];
+    const int output_channel = outputs[0]->GetBlobDesc().dims[1];
+
+    return group > 1 && group == input_channel && group == output_channel;
+}
+
+X86ConvInt8LayerDepthwise::~X86ConvInt8LayerDepthwise() {}
+
+Status X86ConvInt8LayerDepthwise::allocateBufferWeight(const std::vector<Blob *> &inputs,
+                                                       const std::vector<Blob *> &outputs) {
+    ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(conv_res);
+
+    // weights of [c][h][w] are used as they are
+    if (!buffer_weight_.GetBytesSize()) {
+        const int byte_size = conv_res->filter_handle.GetBytesSize();
+        RawBuffer temp_buffer(byte_size);
+        memcpy(temp_buffer.force_to<int8_t *>(), conv_res->filter_handle.force_to<int8_t *>(), byte_size);
+        buffer_weight_ = temp_buffer;
+    }
+    return TNN_OK;
+}
+
+Status X86ConvInt8LayerDepthwise::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+
+    auto input_dims  = inputs[0]->GetBlobDesc().dims;
+    auto output_dims = outputs[0]->GetBlobDesc().dims;
+    const int batch   = output_dims[0];
+    const int channel = output_dims[1];
+    const int ih      = input_dims[2];
+    const int iw      = input_dims[3];
+    const int oh      = output_dims[2];
+    const int ow      = output_dims[3];
+    const int kh      = param->kernels[1];
+    const int kw      = param->kernels[0];
+
+    // int32 sums of one channel for each thread
+    size_t work_size = oh * ow * sizeof(int32_t) * OMP_MAX_THREADS_NUM_;
+    auto workspace   = reinterpret_cast<int32_t *>(context_->GetSharedWorkSpace(work_size));
+
+    auto input_data  = (int8_t *)((char *)inputs[0]->GetHandle().base + inputs[0]->GetHandle().bytes_offset);
+    auto output_data = (int8_t *)((char *)outputs[0]->GetHandle().base + outputs[0]->GetHandle().bytes_offset);
+    int8_t *add_data = nullptr;
+    if (param->fusion_type != FusionType_None) {
+        add_data = (int8_t *)((char *)inputs[1]->GetHandle().base + inputs[1]->GetHandle().bytes_offset);
+    }
+    auto weight    = buffer_weight_.force_to<int8_t *>();
+    auto bias      = buffer_bias_.force_to<int32_t *>();
+    auto scale     = buffer_scale_.force_to<float *>();
+    auto add_scale = buffer_add_scale_.force_to<float *>();
+
+    OMP_PARALLEL_FOR_
+    for (int bc = 0; bc < batch * channel; bc++) {
+        const int c = bc % channel;
+        auto sum    = workspace + OMP_TID_ * oh * ow;
+        auto add_c  = add_data ? add_data + bc * oh * ow : nullptr;
+        X86DepthwiseInt8(sum, input_data + bc * ih * iw, weight + c * kh * kw, ih, iw, oh, ow, kh, kw,
+                         param->pads[2], param->pads[0], param->strides[1], param->strides[0], param->dialations[1],
+                         param->dialations[0]);
+        X86Int8Requant(output_data + bc * oh * ow, sum, oh * ow, bias[c], scale[c], relu_, add_c,
+                       add_c ? add_scale[c] : 0.f, param->fusion_type);
+    }
+
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
@@ -15,15 +15,21 @@
 #include "tnn/device/x86/acc/convolution/x86_conv_layer_3x3.h"
 #include "tnn/device/x86/acc/Float4.h"
 #include "tnn/device/x86/acc/Float8.h"
+#include "tnn/device/x86/acc/compute/jit/utils/cpu_isa.h"
 #include "tnn/device/x86/acc/compute/x86_compute.h"
 #include "tnn/device/x86/x86_common.h"
 #include "tnn/device/x86/x86_context.h"
+#include "tnn/device/x86/x86_device.h"
 #include "tnn/device/x86/x86_util.h"
 
 #include "tnn/interpreter/raw_buffer.h"
 #include "tnn/utils/data_format_converter.h"
 #include "tnn/utils/data_type_utils.h"
 #include "tnn/utils/omp_utils.h"
+#include "tnn/utils/winograd_generator.h"
+
+#include <map>
+#include <mutex>
 
 namespace TNN_NS {
 
@@ -314,7 +320,7 @@ static void unpack_output_c4(const float *din, float *dout, int cs, int ce, int
 
 // A=6x8, B=8x8, C=6x8
 template <typename VEC, int M, int K, int N>
-static void gemm_kernel_avx(float *dst, float *src, const float *weight, const float *bias, int ic_8, int oc_8,
+static X86_INLINE void gemm_kernel_avx(float *dst, float *src, const float *weight, const float *bias, int ic_8, int oc_8,
                             int width) {
     auto w_unit         = width / M;
     auto w_unit_end     = M * w_unit;
@@ -406,7 +412,7 @@ static void gemm_kernel_avx(float *dst, float *src, const float *weight, const f
 //    0, -1, 1, 0,
 //    0, 1,  0, -1]
 template <typename VEC>
-static void input_trans_4x4(const float *src, int src_stride, int src_h_stride, float *dest, int dest_stride,
+static X86_INLINE void input_trans_4x4(const float *src, int src_stride, int src_h_stride, float *dest, int dest_stride,
                             int dest_h_stride) {
     VEC src00 = VEC::loadu(src);
     VEC src01 = VEC::loadu(src + src_stride);
@@ -488,15 +494,21 @@ static void input_trans_4x4(const float *src, int src_stride, int src_h_stride,
     VEC::saveu(dest + dest_stride + dest_stride, dest23);
     VEC::saveu(dest + dest_stride + dest_stride + dest_stride, dest33);
 }
-template void input_trans_4x4<Float8>(const float *src, int src_stride, int src_h_stride, float *dest, int dest_stride,
-                                      int dest_h_stride);
-template void input_trans_4x4<Float4>(const float *src, int src_stride, int src_h_stride, float *dest, int dest_stride,
-                                      int dest_h_stride);
+
+static void input_trans_4x4_sse(const float *src, int src_stride, int src_h_stride, float *dest, int dest_stride,
+                                int dest_h_stride, const float *bt, int alpha) {
+    input_trans_4x4<Float4>(src, src_stride, src_h_stride, dest, dest_stride, dest_h_stride);
+}
+
+static X86_AVX2_TARGET void input_trans_4x4_avx2(const float *src, int src_stride, int src_h_stride, float *dest,
+                                                 int dest_stride, int dest_h_stride, const float *bt, int alpha) {
+    input_trans_4x4<Float8>(src, src_stride, src_h_stride, dest, dest_stride, dest_h_stride);
+}
 
 // AT=[1, 1,  1,  0,
 //    0, 1, -1, -1
 template <typename VEC>
-static void output_trans_post_2x4(const float *src, int src_stride, int src_h_stride, float *dest, int dest_stride,
+static X86_INLINE void output_trans_post_2x4(const float *src, int src_stride, int src_h_stride, float *dest, int dest_stride,
                                   int dest_h_stride, float *bias_value, int relu_type) {
     VEC src00 = VEC::loadu(src);
     VEC src01 = VEC::loadu(src + src_stride);
@@ -561,10 +573,157 @@ static void output_trans_post_2x4(const float *src, int src_stride, int src_h_st
     VEC::saveu(dest, dest01);
     VEC::saveu(dest + dest_stride, dest11);
 }
-template void output_trans_post_2x4<Float8>(const float *src, int src_stride, int src_h_stride, float *dest,
-                                            int dest_stride, int dest_h_stride, float *bias_value, int relu_type);
-template void output_trans_post_2x4<Float4>(const float *src, int src_stride, int src_h_stride, float *dest,
-                                            int dest_stride, int dest_h_stride, float *bias_value, int relu_type);
+
+static void output_trans_post_2x4_sse(const float *src, int src_stride, int src_h_stride, float *dest,
+                                      int dest_stride, int dest_h_stride, float *bias_value, int relu_type,
+                                      const float *at, int alpha) {
+    output_trans_post_2x4<Float4>(src, src_stride, src_h_stride, dest, dest_stride, dest_h_stride, bias_value,
+                                  relu_type);
+}
+
+static X86_AVX2_TARGET void output_trans_post_2x4_avx2(const float *src, int src_stride, int src_h_stride, float *dest,
+                                                       int dest_stride, int dest_h_stride, float *bias_value,
+                                                       int relu_type, const float *at, int alpha) {
+    output_trans_post_2x4<Float8>(src, src_stride, src_h_stride, dest, dest_stride, dest_h_stride, bias_value,
+                                  relu_type);
+}
+
+// transforms of F(m, 3) with m = ALPHA - 2 > 2, bt is BT of ALPHA x ALPHA, at is AT of m x ALPHA,
+// both stored row major as given by WinogradGenerator.
+template <typename VEC, int ALPHA>
+static X86_INLINE void input_trans_generic(const float *src, int src_stride, int src_h_stride, float *dest,
+                                           int dest_stride, int dest_h_stride, const float *bt) {
+    VEC mid[ALPHA][ALPHA];
+    VEC line[ALPHA];
+
+    // mid = src * B
+    for (int y = 0; y < ALPHA; y++) {
+        for (int k = 0; k < ALPHA; k++) {
+            line[k] = VEC::loadu(src + y * src_h_stride + k * src_stride);
+        }
+        for (int x = 0; x < ALPHA; x++) {
+            VEC acc = line[0] * bt[x * ALPHA];
+            for (int k = 1; k < ALPHA; k++) {
+                VEC::mla(acc, line[k], VEC(bt[x * ALPHA + k]));
+            }
+            mid[y][x] = acc;
+        }
+    }
+
+    // dest = BT * mid
+    for (int x = 0; x < ALPHA; x++) {
+        for (int y = 0; y < ALPHA; y++) {
+            VEC acc = mid[0][x] * bt[y * ALPHA];
+            for (int k = 1; k < ALPHA; k++) {
+                VEC::mla(acc, mid[k][x], VEC(bt[y * ALPHA + k]));
+            }
+            VEC::saveu(dest + x * dest_h_stride + y * dest_stride, acc);
+        }
+    }
+}
+
+template <typename VEC>
+static X86_INLINE void input_trans_generic(const float *src, int src_stride, int src_h_stride, float *dest,
+                                           int dest_stride, int dest_h_stride, const float *bt, int alpha) {
+    if (alpha == 6) {
+        input_trans_generic<VEC, 6>(src, src_stride, src_h_stride, dest, dest_stride, dest_h_stride, bt);
+    } else if (alpha == 8) {
+        input_trans_generic<VEC, 8>(src, src_stride, src_h_stride, dest, dest_stride, dest_h_stride, bt);
+    }
+}
+
+static void input_trans_generic_sse(const float *src, int src_stride, int src_h_stride, float *dest, int dest_stride,
+                                    int dest_h_stride, const float *bt, int alpha) {
+    input_trans_generic<Float4>(src, src_stride, src_h_stride, dest, dest_stride, dest_h_stride, bt, alpha);
+}
+
+static X86_AVX2_TARGET void input_trans_generic_avx2(const float *src, int src_stride, int src_h_stride, float *dest,
+                                                     int dest_stride, int dest_h_stride, const float *bt, int alpha) {
+    input_trans_generic<Float8>(src, src_stride, src_h_stride, dest, dest_stride, dest_h_stride, bt, alpha);
+}
+
+template <typename VEC, int ALPHA>
+static X86_INLINE void output_trans_post_generic(const float *src, int src_stride, int src_h_stride, float *dest,
+                                                 int dest_stride, int dest_h_stride, float *bias_value, int relu_type,
+                                                 const float *at) {
+    const int UNIT = ALPHA - 2;
+    VEC mid[UNIT][ALPHA];
+    VEC line[ALPHA];
+
+    // mid = AT * src
+    for (int x = 0; x < ALPHA; x++) {
+        for (int k = 0; k < ALPHA; k++) {
+            line[k] = VEC::loadu(src + x * src_h_stride + k * src_stride);
+        }
+        for (int y = 0; y < UNIT; y++) {
+            VEC acc = line[0] * at[y * ALPHA];
+            for (int k = 1; k < ALPHA; k++) {
+                VEC::mla(acc, line[k], VEC(at[y * ALPHA + k]));
+            }
+            mid[y][x] = acc;
+        }
+    }
+
+    // dest = mid * A + bias
+    VEC bias  = bias_value ? VEC::loadu(bias_value) : VEC(0.f);
+    VEC zeros = VEC(0.f);
+    VEC sixs  = VEC(6.f);
+    for (int y = 0; y < UNIT; y++) {
+        for (int x = 0; x < UNIT; x++) {
+            VEC acc = bias;
+            for (int k = 0; k < ALPHA; k++) {
+                VEC::mla(acc, mid[y][k], VEC(at[x * ALPHA + k]));
+            }
+            if (relu_type == ActivationType_ReLU || relu_type == ActivationType_ReLU6) {
+                acc = VEC::max(acc, zeros);
+            }
+            if (relu_type == ActivationType_ReLU6) {
+                acc = VEC::min(acc, sixs);
+            }
+            VEC::saveu(dest + y * dest_h_stride + x * dest_stride, acc);
+        }
+    }
+}
+
+template <typename VEC>
+static X86_INLINE void output_trans_post_generic(const float *src, int src_stride, int src_h_stride, float *dest,
+                                                 int dest_stride, int dest_h_stride, float *bias_value, int relu_type,
+                                                 const float *at, int alpha) {
+    if (alpha == 6) {
+        output_trans_post_generic<VEC, 6>(src, src_stride, src_h_stride, dest, dest_stride, dest_h_stride,
+                                          bias_value, relu_type, at);
+    } else if (alpha == 8) {
+        output_trans_post_generic<VEC, 8>(src, src_stride, src_h_stride, dest, dest_stride, dest_h_stride,
+                                          bias_value, relu_type, at);
+    }
+}
+
+static void output_trans_post_generic_sse(const float *src, int src_stride, int src_h_stride, float *dest,
+                                          int dest_stride, int dest_h_stride, float *bias_value, int relu_type,
+                                          const float *at, int alpha) {
+    output_trans_post_generic<Float4>(src, src_stride, src_h_stride, dest, dest_stride, dest_h_stride, bias_value,
+                                      relu_type, at, alpha);
+}
+
+static X86_AVX2_TARGET void output_trans_post_generic_avx2(const float *src, int src_stride, int src_h_stride,
+                                                           float *dest, int dest_stride, int dest_h_stride,
+                                                           float *bias_value, int relu_type, const float *at,
+                                                           int alpha) {
+    output_trans_post_generic<Float8>(src, src_stride, src_h_stride, dest, dest_stride, dest_h_stride, bias_value,
+                                      relu_type, at, alpha);
+}
+
+static void gemm_kernel_sse(float *dst, float *src, const float *weight, const float *bias, int ic_8, int oc_8,
+                            int width) {
+    gemm_kernel_avx<Float4, 6, 4, 4>(dst, src, weight, bias, ic_8, oc_8, width);
+}
+
+static X86_AVX2_TARGET void gemm_kernel_avx2(float *dst, float *src, const float *weight, const float *bias, int ic_8,
+                                             int oc_8, int width) {
+    gemm_kernel_avx<Float8, 6, 8, 8>(dst, src, weight, bias, ic_8, oc_8, width);
+}
+
+#define TILE_NUM 6
 
 bool X86ConvLayer3x3::isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
                                  const std::vector<Blob *> &outputs) {
@@ -584,7 +743,82 @@ bool X86ConvLayer3x3::isPrefered(ConvLayerParam *param, const std::vector<Blob *
     const int sh = param->strides[1];
     const int ic = inputs[0]->GetBlobDesc().dims[1];
 
-    return kw == 3 && kh == 3 && dw == 1 && dh == 1 && sw == 1 && sh == 1 && ic >= 16;
+    if (!(kw == 3 && kh == 3 && dw == 1 && dh == 1 && sw == 1 && sh == 1 && ic >= 16)) {
+        return false;
+    }
+
+    return SelectWinograd(param, inputs, outputs) > 0;
+}
+
+/*
+ * choose the output unit m of F(m x m, 3 x 3) from 2, 4 and 6 by the cost of src transform + gemm + dst transform
+ * against the im2col sgemm, 0 if winograd is not worth it. Larger units do less multiplications in gemm, but pad
+ * more at the border of small outputs and have more transformed weights, which are streamed once every TILE_NUM
+ * tiles and become memory bound once they do not fit in the last level cache.
+ * The decision only depends on the shape, it is cached to be shared by the layers of the same shape.
+ */
+int X86ConvLayer3x3::SelectWinograd(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                                    const std::vector<Blob *> &outputs) {
+    if (!param || param->kernels[0] != 3) {
+        return 0;
+    }
+
+    const int ic   = inputs[0]->GetBlobDesc().dims[1];
+    const int oc   = outputs[0]->GetBlobDesc().dims[1];
+    const int oh   = outputs[0]->GetBlobDesc().dims[2];
+    const int ow   = outputs[0]->GetBlobDesc().dims[3];
+    const int arch = X86Device::GetIsa();
+
+    static std::mutex cache_mutex;
+    static std::map<std::vector<int>, int> unit_cache;
+    std::vector<int> key = {ic, oc, oh, ow, arch};
+
+    std::lock_guard<std::mutex> guard(cache_mutex);
+    auto iter = unit_cache.find(key);
+    if (iter != unit_cache.end()) {
+        return iter->second;
+    }
+
+    const int ch_pack = arch >= avx2 ? 8 : 4;
+    const float ic_r  = (float)ROUND_UP(ic, ch_pack);
+    const float oc_r  = (float)ROUND_UP(oc, ch_pack);
+    // the share of one core in the last level cache, 16MB at most
+    const size_t max_llc_size = 16 * 1024 * 1024;
+    size_t llc_size           = cpu_data_cache_size(3);
+    if (llc_size == 0 || llc_size > max_llc_size) {
+        llc_size = max_llc_size;
+    }
+
+    int dst_unit      = 0;
+    float max_rate    = 1.f;
+    float origin_cost = (float)ow * oh * ic_r * oc_r * 9;
+
+    for (int u = 2; u <= 6; u += 2) {
+        float src_unit = (float)(u + 2);
+        float tiles    = (float)UP_DIV(ow, u) * UP_DIV(oh, u);
+
+        // F(2x2, 3x3) transforms only add, the others are computed as dense matrix products
+        float trans_rate = u == 2 ? 0.25f : 1.f;
+        float gemm_cost  = src_unit * src_unit * ic_r * oc_r * tiles;
+        float trans_cost = (2 * src_unit * src_unit * src_unit * ic_r + 2 * src_unit * u * u * oc_r) * tiles;
+        // about one multiply-add per byte loaded from memory
+        float weight_bytes = src_unit * src_unit * ic_r * oc_r * sizeof(float);
+        float memory_cost  = weight_bytes > llc_size ? weight_bytes * UP_DIV((int)tiles, TILE_NUM) : 0.f;
+
+        float acc_rate = origin_cost / (gemm_cost + trans_cost * trans_rate + memory_cost);
+        if (acc_rate > max_rate * 1.1f) {
+            max_rate = acc_rate;
+            dst_unit = u;
+        }
+    }
+
+    // 10% penalty, winograd will result in more cache miss
+    if (max_rate < 1.1f) {
+        dst_unit = 0;
+    }
+
+    unit_cache[key] = dst_unit;
+    return dst_unit;
 }
 
 X86ConvLayer3x3::~X86ConvLayer3x3() {}
@@ -601,23 +835,66 @@ Status X86ConvLayer3x3::allocateBufferWeight(const std::vector<Blob *> &inputs,
     if (!buffer_weight_.GetBytesSize()) {
         const float *src = conv_res->filter_handle.force_to<float *>();
         auto CH_PACK     = 4;
-        if (arch_ == avx2)
+        if (arch_ >= avx2)
             CH_PACK = 8;
 
+        dst_unit_ = SelectWinograd(param, inputs, outputs);
+        if (dst_unit_ == 0) {
+            dst_unit_ = 2;
+        }
+        src_unit_ = dst_unit_ + 2;
+
         const int input_channel  = dims_input[1];
         const int output_channel = dims_output[1];
-        const int weight_count   = ROUND_UP(input_channel, CH_PACK) * ROUND_UP(output_channel, CH_PACK) * 4 * 4;
+        const int weight_count =
+            ROUND_UP(input_channel, CH_PACK) * ROUND_UP(output_channel, CH_PACK) * src_unit_ * src_unit_;
         const int data_byte_size = DataTypeUtils::GetBytesSize(conv_res->filter_handle.GetDataType());
 
         if (conv_res->filter_handle.GetDataType() == DATA_TYPE_FLOAT) {
-            RawBuffer pack_buffer(weight_count * data_byte_size);
-            float *dst = pack_buffer.force_to<float *>();
+            std::shared_ptr<float> G = nullptr;
+            if (dst_unit_ != 2) {
+                WinogradGenerator generator(dst_unit_, 3, 0.5f);
+                auto A = std::get<0>(generator.A());
+                auto B = std::get<0>(generator.B());
+                G      = std::get<0>(generator.G());
+
+                // keep BT and AT row major for the transforms
+                winograd_bt_.resize(src_unit_ * src_unit_);
+                winograd_at_.resize(dst_unit_ * src_unit_);
+                for (int i = 0; i < src_unit_; i++) {
+                    for (int k = 0; k < src_unit_; k++) {
+                        winograd_bt_[i * src_unit_ + k] = B.get()[k * src_unit_ + i];
+                    }
+                }
+                for (int i = 0; i < dst_unit_; i++) {
+                    for (int k = 0; k < src_unit_; k++) {
+                        winograd_at_[i * src_unit_ + k] = A.get()[k * dst_unit_ + i];
+                    }
+                }
+            }
 
-            const float G[4][3] = {{1.0f, 0.0f, 0.0f}, {0.5f, 0.5f, 0.5f}, {0.5f, -0.5f, 0.5f}, {0.0f, 0.0f, 1.0f}};
-            weight_transform(src, dst, 3, 4, input_channel, output_channel, CH_PACK, G);
+            auto pack = [&](std::vector<RawBuffer> &buffers) {
+                RawBuffer pack_buffer(weight_count * data_byte_size);
+                float *dst = pack_buffer.force_to<float *>();
 
-            pack_buffer.SetDataType(DATA_TYPE_FLOAT);
-            buffer_weight_ = pack_buffer;
+                if (dst_unit_ == 2) {
+                    const float G2[4][3] = {
+                        {1.0f, 0.0f, 0.0f}, {0.5f, 0.5f, 0.5f}, {0.5f, -0.5f, 0.5f}, {0.0f, 0.0f, 1.0f}};
+                    weight_transform(src, dst, 3, 4, input_channel, output_channel, CH_PACK, G2);
+                } else {
+                    weight_transform(src, dst, 3, src_unit_, input_channel, output_channel, CH_PACK,
+                                     reinterpret_cast<const float(*)[3]>(G.get()));
+                }
+
+                pack_buffer.SetDataType(DATA_TYPE_FLOAT);
+                buffers = {pack_buffer};
+                return Status(TNN_OK);
+            };
+            std::vector<RawBuffer> buffers;
+            RETURN_ON_NEQ(GetSharedWeights(conv_res->filter_handle, "conv_3x3",
+                                           {input_channel, output_channel, dst_unit_, CH_PACK}, pack, buffers),
+                          TNN_OK);
+            buffer_weight_ = buffers[0];
         } else {
             LOGE("Error: DataType %d not support\n", conv_res->filter_handle.GetDataType());
             return Status(TNNERR_MODEL_ERR, "conv_res DataType is not supported");
@@ -633,7 +910,6 @@ Status X86ConvLayer3x3::allocateBufferWeight(const std::vector<Blob *> &inputs,
 // output trans
 // write c8 to nchw
 
-#define TILE_NUM 6
 // #define CH_PACK 8
 
 Status X86ConvLayer3x3::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
@@ -668,26 +944,29 @@ Status X86ConvLayer3x3::DoForward(const std::vector<Blob *> &inputs, const std::
     int ic_stride    = width_in * height_in;
     int oc_stride    = width_out * height_out;
 
-    auto input_trans_func  = input_trans_4x4<Float4>;
-    auto output_trans_func = output_trans_post_2x4<Float4>;
+    const int src_unit = src_unit_;
+    const int dst_unit = dst_unit_;
+    const float *bt    = winograd_bt_.data();
+    const float *at    = winograd_at_.data();
+
+    auto input_trans_func  = dst_unit == 2 ? input_trans_4x4_sse : input_trans_generic_sse;
+    auto output_trans_func = dst_unit == 2 ? output_trans_post_2x4_sse : output_trans_post_generic_sse;
     auto pack_func         = pack_input_c4;
     auto unpack_func       = unpack_output_c4;
-    auto gemm_func         = gemm_kernel_avx<Float4, 6, 4, 4>;
+    auto gemm_func         = gemm_kernel_sse;
     auto CH_PACK           = 4;
-    if (arch_ == avx2) {
-        input_trans_func  = input_trans_4x4<Float8>;
-        output_trans_func = output_trans_post_2x4<Float8>;
+    if (arch_ >= avx2) {
+        input_trans_func  = dst_unit == 2 ? input_trans_4x4_avx2 : input_trans_generic_avx2;
+        output_trans_func = dst_unit == 2 ? output_trans_post_2x4_avx2 : output_trans_post_generic_avx2;
         pack_func         = pack_input_c8;
         unpack_func       = unpack_output_c8;
-        gemm_func         = gemm_kernel_avx<Float8, 6, 8, 8>;
+        gemm_func         = gemm_kernel_avx2;
         CH_PACK           = 8;
     }
 
     int ic_8 = UP_DIV(channel_in, CH_PACK);
     int oc_8 = UP_DIV(channel_out, CH_PACK);
 
-    const int src_unit = 4;
-    const int dst_unit = 2;
     int w_unit         = UP_DIV(width_out, dst_unit);
     int h_unit         = UP_DIV(height_out, dst_unit);
     int total_cnt      = UP_DIV(w_unit * h_unit, TILE_NUM);
@@ -754,14 +1033,15 @@ Status X86ConvLayer3x3::DoForward(const std::vector<Blob *> &inputs, const std::
                     for (int ci = 0; ci < ic_8; ++ci) {
                         const float *src_ci = src_ptr + ci * ic_8_stride;
                         float *dst_ci       = dst_ptr + ci * tile_count * CH_PACK;
-                        input_trans_func(src_ci, CH_PACK, w_pad * CH_PACK, dst_ci, b_gi_stride, b_gi_stride * src_unit);
+                        input_trans_func(src_ci, CH_PACK, w_pad * CH_PACK, dst_ci, b_gi_stride, b_gi_stride * src_unit, bt,
+                                         src_unit);
                     }
                 } else {
                     int x_size = ex;
                     for (int ci = 0; ci < ic_8; ++ci) {
                         const float *src_ci = src_ptr + ci * ic_8_stride;
                         // pad
-                        memset(src_trans_tmp_data, 0, 16 * CH_PACK * sizeof(float));  // src_unit * src_unit * ch_pack
+                        memset(src_trans_tmp_data, 0, src_unit * src_unit * CH_PACK * sizeof(float));
                         if (x_size > 0) {
                             for (int yi = 0; yi < ey; ++yi) {
                                 float *dst_yi       = src_trans_tmp_data + yi * src_unit * CH_PACK;
@@ -773,14 +1053,14 @@ Status X86ConvLayer3x3::DoForward(const std::vector<Blob *> &inputs, const std::
                         // trans
                         float *dst_ci = dst_ptr + ci * tile_count * CH_PACK;
                         input_trans_func(src_trans_tmp_data, CH_PACK, src_unit * CH_PACK, dst_ci, b_gi_stride,
-                                         b_gi_stride * src_unit);
+                                         b_gi_stride * src_unit, bt, src_unit);
                     }
                 }
             }
 
             // ---------------------------------------- gemm func ----------------------------------------
             // gemm
-            float *dst_temp_data = tmp_data + TILE_NUM * ic_8 * 16 * CH_PACK;  // src_unit * src_unit * ch_pack
+            float *dst_temp_data = tmp_data + TILE_NUM * ic_8 * src_unit * src_unit * CH_PACK;
             float *b_ptr         = tmp_data;
             int w_gi_stride      = ic_8 * oc_8 * CH_PACK * CH_PACK;
             for (int gi = 0; gi < src_unit * src_unit; ++gi) {
@@ -810,7 +1090,7 @@ Status X86ConvLayer3x3::DoForward(const std::vector<Blob *> &inputs, const std::
                 float *dst_ptr = output_ptr + (dst_y * width_out + dst_x) * CH_PACK;
                 float *src_ptr = dst_temp_data + ti * CH_PACK;
 
-                if (ex == 2) {
+                if (ex == dst_unit) {
                     // trans output
                     for (int ci = 0; ci < oc_8; ++ci) {
                         if (bias_ptr) {
@@ -820,7 +1100,7 @@ Status X86ConvLayer3x3::DoForward(const std::vector<Blob *> &inputs, const std::
                         float *dst_ci = dst_ptr + ci * oc_8_stride;
                         float *src_ci = src_ptr + ci * tile_count * CH_PACK;
                         output_trans_func(src_ci, c_gi_stride, c_gi_stride * src_unit, src_trans_tmp_data, CH_PACK,
-                                          dst_unit * CH_PACK, bias_value, param->activation_type);
+                                          dst_unit * CH_PACK, bias_value, param->activation_type, at, src_unit);
                         unpack_func(src_trans_tmp_data, output_ptr, ci * CH_PACK, ci * CH_PACK + CH_PACK, dst_y,
                                     dst_y + ey, dst_x, dst_x + ex, channel_out, height_out, width_out, false, zero_ptr);
                     }
@@ -833,9 +1113,9 @@ Status X86ConvLayer3x3::DoForward(const std::vector<Blob *> &inputs, const std::
                         float *dst_ci = dst_ptr + ci * oc_8_stride;
                         float *src_ci = src_ptr + ci * tile_count * CH_PACK;
                         output_trans_func(src_ci, c_gi_stride, c_gi_stride * src_unit, src_trans_tmp_data, CH_PACK,
-                                          dst_unit * CH_PACK, bias_value, param->activation_type);
+                                          dst_unit * CH_PACK, bias_value, param->activation_type, at, src_unit);
                         // copy to dest
-                        memset(dst_trans_tmp_data, 0, 4 * CH_PACK * sizeof(float));  // dst_unit * dst_unit * ch_pack
+                        memset(dst_trans_tmp_data, 0, dst_unit * dst_unit * CH_PACK * sizeof(float));
                         for (int i = 0; i < ey; ++i) {
                             memcpy(dst_trans_tmp_data + i * ex * CH_PACK, src_trans_tmp_data + i * CH_PACK * dst_unit,
                                    ex * sizeof(float) * CH_PACK);
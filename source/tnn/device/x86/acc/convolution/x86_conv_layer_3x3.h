@@ -28,7 +28,17 @@ public:
     static bool isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
                            const std::vector<Blob *> &outputs);
 
+    static int SelectWinograd(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                              const std::vector<Blob *> &outputs);
+
     virtual Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+protected:
+    int src_unit_ = 4;
+    int dst_unit_ = 2;
+    // BT and AT of F(dst_unit_, 3), empty for F(2, 3) which has its own transforms
+    std::vector<float> winograd_bt_;
+    std::vector<float> winograd_at_;
 };
 
 }  // namespace TNN_NS
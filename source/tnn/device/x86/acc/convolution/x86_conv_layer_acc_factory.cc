@@ -17,6 +17,7 @@
 #include "tnn/device/x86/acc/convolution/x86_conv_layer_depthwise.h"
 #include "tnn/device/x86/acc/convolution/x86_conv_layer_1x1.h"
 #include "tnn/device/x86/acc/convolution/x86_conv_layer_3x3.h"
+#include "tnn/device/x86/acc/convolution/x86_conv_int8_layer_depthwise.h"
 
 namespace TNN_NS {
 
@@ -44,4 +45,18 @@ void X86ConvLayerAccFactory::CreateImpFP(const std::vector<Blob *> &inputs, cons
     }
 }
 
+/*
+X86ConvInt8LayerCommon always as the last solution, 1x1 and 3x3 convs are done by its im2col gemm
+*/
+void X86ConvLayerAccFactory::CreateImpInt8(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs,
+                                           LayerParam *param, std::shared_ptr<X86LayerAcc> &conv_acc_impl) {
+    if (X86ConvInt8LayerDepthwise::isPrefered(dynamic_cast<ConvLayerParam *>(param), inputs, outputs)) {
+        if (!dynamic_cast<X86ConvInt8LayerDepthwise *>(conv_acc_impl.get())) {
+            conv_acc_impl = std::make_shared<X86ConvInt8LayerDepthwise>();
+        }
+    } else if (!dynamic_cast<X86ConvInt8LayerCommon *>(conv_acc_impl.get())) {
+        conv_acc_impl = std::make_shared<X86ConvInt8LayerCommon>();
+    }
+}
+
 }  // namespace TNN_NS
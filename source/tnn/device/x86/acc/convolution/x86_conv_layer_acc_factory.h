@@ -18,6 +18,7 @@
 #include "tnn/device/x86/acc/x86_layer_acc.h"
 #include "tnn/device/x86/acc/convolution/x86_conv_layer_common.h"
 #include "tnn/device/x86/acc/convolution/x86_conv_layer_depthwise.h"
+#include "tnn/device/x86/acc/convolution/x86_conv_int8_layer_common.h"
 #include <memory>
 #include <type_traits>
 
@@ -27,6 +28,9 @@ class X86ConvLayerAccFactory {
 public:
     static void CreateImpFP(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs, LayerParam *param,
                             std::shared_ptr<X86LayerAcc> &conv_acc_impl);
+
+    static void CreateImpInt8(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs,
+                              LayerParam *param, std::shared_ptr<X86LayerAcc> &conv_acc_impl);
 };
 
 }  // namespace TNN_NS
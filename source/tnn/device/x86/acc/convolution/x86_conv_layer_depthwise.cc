@@ -60,16 +60,23 @@ Status X86ConvLayerDepthwise::allocateBufferWeight(const std::vector<Blob *> &in
         int data_byte_size = DataTypeUtils::GetBytesSize(conv_res->filter_handle.GetDataType());
 
         if (conv_res->filter_handle.GetDataType() == DATA_TYPE_FLOAT) {
-            RawBuffer temp_buffer(weight_count * data_byte_size);
-            float *dst = temp_buffer.force_to<float *>();
-
-            if (arch_ == avx2) {
-                PackC8(dst, src, kh * kw, kh * kw, kh * kw, group);
-            } else if (arch_ == sse42) {
-                PackC4(dst, src, kh * kw, kh * kw, kh * kw, group);
-            }
-            temp_buffer.SetDataType(DATA_TYPE_FLOAT);
-            buffer_weight_ = temp_buffer;
+            auto pack = [&](std::vector<RawBuffer> &buffers) {
+                RawBuffer temp_buffer(weight_count * data_byte_size);
+                float *dst = temp_buffer.force_to<float *>();
+
+                if (arch_ >= avx2) {
+                    PackC8(dst, src, kh * kw, kh * kw, kh * kw, group);
+                } else if (arch_ == sse42) {
+                    PackC4(dst, src, kh * kw, kh * kw, kh * kw, group);
+                }
+                temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+                buffers = {temp_buffer};
+                return Status(TNN_OK);
+            };
+            std::vector<RawBuffer> buffers;
+            RETURN_ON_NEQ(GetSharedWeights(conv_res->filter_handle, "conv_depthwise", {kh, kw, group}, pack, buffers),
+                          TNN_OK);
+            buffer_weight_ = buffers[0];
         } else {
             LOGE("Error: DataType %d not support\n", conv_res->filter_handle.GetDataType());
             return Status(TNNERR_MODEL_ERR, "conv_res DataType is not supported");
@@ -105,6 +112,26 @@ void PackWithPad(
     memset(dst_ptr + src_h * src_pad_w_stride, 0, pads[3] * src_pad_w_stride * sizeof(float));
 }
 
+// pad a NC8HW8 block, it is packed already
+static void BlockWithPad(const float *src, float *dst, std::vector<int> pads, int src_h, int src_w) {
+    int src_pad_w_stride = (src_w + pads[0] + pads[1]) * 8;
+    memset(dst, 0, pads[2] * src_pad_w_stride * sizeof(float));
+
+    auto dst_ptr = dst + pads[2] * src_pad_w_stride;
+    for (int i = 0; i < src_h; i++) {
+        auto dst_h_ptr = dst_ptr + i * src_pad_w_stride;
+        memset(dst_h_ptr, 0, pads[0] * 8 * sizeof(float));
+        memcpy(dst_h_ptr + pads[0] * 8, src + i * src_w * 8, src_w * 8 * sizeof(float));
+        memset(dst_h_ptr + pads[0] * 8 + src_w * 8, 0, pads[1] * 8 * sizeof(float));
+    }
+    memset(dst_ptr + src_h * src_pad_w_stride, 0, pads[3] * src_pad_w_stride * sizeof(float));
+}
+
+// NC8HW8 blocks are the packed data of the avx2 kernels
+bool X86ConvLayerDepthwise::NC8HW8Implemented(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return arch_ >= avx2 && inputs[0]->GetBlobDesc().data_format == outputs[0]->GetBlobDesc().data_format;
+}
+
 Status X86ConvLayerDepthwise::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     ConvLayerParam *param = dynamic_cast<ConvLayerParam *>(param_);
     ConvLayerResource *resource = dynamic_cast<ConvLayerResource *>(resource_);
@@ -162,9 +189,14 @@ Status X86ConvLayerDepthwise::DoForward(const std::vector<Blob *> &inputs, const
     float *weights_data = buffer_weight_.force_to<float*>();
     float *bias_data = buffer_bias_.force_to<float*>();;
 
+    // NC8HW8 output is written in place, the padded channels have zero weights and bias
+    bool blocked = output->GetBlobDesc().data_format == DATA_FORMAT_NC8HW8;
+    int src_c    = blocked ? ROUND_UP(dims_input[1], 8) : dims_input[1];
+    int dst_c    = blocked ? ROUND_UP(dims_output[1], 8) : dims_output[1];
+
     for (int batch_idx = 0; batch_idx < batch; batch_idx++) {
-        auto src_ptr = src_origin + batch_idx * dims_input[1] * src_z_step;
-        auto dst_ptr = dst_origin + batch_idx * dims_output[1] * dst_z_step;
+        auto src_ptr = src_origin + batch_idx * src_c * src_z_step;
+        auto dst_ptr = dst_origin + batch_idx * dst_c * dst_z_step;
 
         // OMP_PARALLEL_FOR_
         for (int dz = 0; dz < dims_output[1]; dz += c_pack) {
@@ -176,11 +208,18 @@ Status X86ConvLayerDepthwise::DoForward(const std::vector<Blob *> &inputs, const
             auto *src_buf   = workspace;
             auto *dst_buf   = workspace + src_pad_size / sizeof(float);
 
-            PackWithPadAcc(src_z, src_buf, param->pads, dims_input[2], dims_input[3], real_dz);
+            if (blocked) {
+                BlockWithPad(src_z, src_buf, param->pads, dims_input[2], dims_input[3]);
+                dst_buf = dst_z;
+            } else {
+                PackWithPadAcc(src_z, src_buf, param->pads, dims_input[2], dims_input[3], real_dz);
+            }
             dw_full(dst_buf, src_buf, weight_dz, bias_z, dims_output[3], param->strides[0] * c_pack,
                     param->kernels[0], param->kernels[1], dilate_x_step, dilate_y_step,
                     dims_output[2], src_pad_w * c_pack * param->strides[1], dims_output[3] * c_pack);
-            UnpackAcc(dst_z, dst_buf, dst_z_step, dst_z_step, dst_z_step, real_dz);
+            if (!blocked) {
+                UnpackAcc(dst_z, dst_buf, dst_z_step, dst_z_step, dst_z_step, real_dz);
+            }
         }
     }
     return TNN_OK;
@@ -25,6 +25,8 @@ public:
 
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
+    virtual bool NC8HW8Implemented(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
     static bool isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
                            const std::vector<Blob *> &outputs);
 
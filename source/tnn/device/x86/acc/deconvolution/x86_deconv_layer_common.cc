@@ -29,6 +29,16 @@ bool X86DeconvLayerCommon::isPrefered(ConvLayerParam *param, const std::vector<B
 
 X86DeconvLayerCommon::~X86DeconvLayerCommon() {}
 
+template <int activation_type>
+static post_func_t GetPostFunc(x86_isa_t arch) {
+    if (arch >= avx512) {
+        return X86_Post_Exec<activation_type, Float16, 16>;
+    } else if (arch >= avx2) {
+        return X86_Post_Exec<activation_type, Float8, 8>;
+    }
+    return X86_Post_Exec<activation_type, Float4, 4>;
+}
+
 Status X86DeconvLayerCommon::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     return TNN_OK;
 }
@@ -115,16 +125,13 @@ Status X86DeconvLayerCommon::Init(Context *context, LayerParam *param, LayerReso
 
     switch (conv_param->activation_type) {
         case ActivationType_None:
-            post_func_ = (arch_ == avx2) ? X86_Post_Exec<ActivationType_None, Float8, 8>
-                                         : X86_Post_Exec<ActivationType_None, Float4, 4>;
+            post_func_ = GetPostFunc<ActivationType_None>(arch_);
             break;
         case ActivationType_ReLU:
-            post_func_ = (arch_ == avx2) ? X86_Post_Exec<ActivationType_ReLU, Float8, 8>
-                                         : X86_Post_Exec<ActivationType_ReLU, Float4, 4>;
+            post_func_ = GetPostFunc<ActivationType_ReLU>(arch_);
             break;
         case ActivationType_ReLU6:
-            post_func_ = (arch_ == avx2) ? X86_Post_Exec<ActivationType_ReLU6, Float8, 8>
-                                         : X86_Post_Exec<ActivationType_ReLU6, Float4, 4>;
+            post_func_ = GetPostFunc<ActivationType_ReLU6>(arch_);
             break;
         default:
             break;
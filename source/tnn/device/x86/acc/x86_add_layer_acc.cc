@@ -12,12 +12,85 @@
 // CONDITIONS OF ANY KIND, either express or implied. See the License for the
 // specific language governing permissions and limitations under the License.
 
-#include "tnn/device/x86/acc/x86_binary_op_layer_acc.h"
+
+#include "tnn/device/x86/acc/x86_add_layer_acc.h"
+
+#include <float.h>
+
+#include "tnn/core/blob_int8.h"
+#include "tnn/device/x86/acc/compute/x86_compute_int8.h"
+#include "tnn/utils/dims_utils.h"
 
 namespace TNN_NS {
 
-DECLARE_X86_BINARY_OP_ACC(Add, X86BinaryOpType::kADD);
+X86AddLayerAcc::~X86AddLayerAcc() {}
+
+Status X86AddLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
+                            const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    if (inputs[0]->GetBlobDesc().data_type == DATA_TYPE_INT8) {
+        RETURN_ON_NEQ(X86LayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
+        return allocateBufferParamInt8(inputs, outputs);
+    }
+    return X86BinaryOpLayerAcc::Init(context, param, resource, inputs, outputs);
+}
+
+Status X86AddLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    if (inputs[0]->GetBlobDesc().data_type == DATA_TYPE_INT8) {
+        return TNN_OK;
+    }
+    return X86BinaryOpLayerAcc::Reshape(inputs, outputs);
+}
+
+Status X86AddLayerAcc::allocateBufferParamInt8(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    // only support two inputs of the same shape
+    if (inputs.size() != 2 || !DimsVectorUtils::Equal(inputs[0]->GetBlobDesc().dims, inputs[1]->GetBlobDesc().dims)) {
+        return Status(TNNERR_UNSUPPORT_NET, "int8 add only supports two inputs of the same shape");
+    }
+
+    if (!input0_int_scale_.GetBytesSize()) {
+        const int channel     = outputs[0]->GetBlobDesc().dims[1];
+        auto &i0_handle       = reinterpret_cast<BlobInt8 *>(inputs[0])->GetIntResource()->scale_handle;
+        auto &i1_handle       = reinterpret_cast<BlobInt8 *>(inputs[1])->GetIntResource()->scale_handle;
+        auto &o_handle        = reinterpret_cast<BlobInt8 *>(outputs[0])->GetIntResource()->scale_handle;
+        const float *i0_scale = i0_handle.force_to<float *>();
+        const float *i1_scale = i1_handle.force_to<float *>();
+        const float *o_scale  = o_handle.force_to<float *>();
+
+        RawBuffer temp_buffer0(channel * sizeof(float));
+        RawBuffer temp_buffer1(channel * sizeof(float));
+        RawBuffer temp_buffer2(channel * sizeof(float));
+        float *temp_ptr0 = temp_buffer0.force_to<float *>();
+        float *temp_ptr1 = temp_buffer1.force_to<float *>();
+        float *temp_ptr2 = temp_buffer2.force_to<float *>();
+        for (int i = 0; i < channel; i++) {
+            temp_ptr0[i] = i0_scale[i0_handle.GetDataCount() == 1 ? 0 : i];
+            temp_ptr1[i] = i1_scale[i1_handle.GetDataCount() == 1 ? 0 : i];
+            float o_s    = o_scale[o_handle.GetDataCount() == 1 ? 0 : i];
+            temp_ptr2[i] = o_s >= FLT_MIN ? 1.0f / o_s : 0.0f;
+        }
+        input0_int_scale_ = temp_buffer0;
+        input1_int_scale_ = temp_buffer1;
+        output_int_scale_ = temp_buffer2;
+    }
+    return TNN_OK;
+}
+
+Status X86AddLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    if (outputs[0]->GetBlobDesc().data_type != DATA_TYPE_INT8) {
+        return X86BinaryOpLayerAcc::DoForward(inputs, outputs);
+    }
+
+    auto dims       = outputs[0]->GetBlobDesc().dims;
+    auto output_ptr = static_cast<int8_t *>(outputs[0]->GetHandle().base);
+    auto input0_ptr = static_cast<int8_t *>(inputs[0]->GetHandle().base);
+    auto input1_ptr = static_cast<int8_t *>(inputs[1]->GetHandle().base);
+    X86MatrixAddInt8(output_ptr, input0_ptr, input1_ptr, output_int_scale_.force_to<float *>(),
+                     input0_int_scale_.force_to<float *>(), input1_int_scale_.force_to<float *>(), dims[0], dims[1],
+                     DimsVectorUtils::Count(dims, 2));
+    return TNN_OK;
+}
 
 REGISTER_X86_ACC(Add, LAYER_ADD);
+REGISTER_X86_LAYOUT(LAYER_ADD, DATA_FORMAT_NC8HW8);
 
-}   // namespace TNN_NS
\ No newline at end of file
+}  // namespace TNN_NS
@@ -0,0 +1,48 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_SOURCE_TNN_DEVICE_X86_ACC_X86_ADD_LAYER_ACC_H_
+#define TNN_SOURCE_TNN_DEVICE_X86_ACC_X86_ADD_LAYER_ACC_H_
+
+#include "tnn/device/x86/acc/x86_binary_op_layer_acc.h"
+
+namespace TNN_NS {
+
+class X86AddLayerAcc : public X86BinaryOpLayerAcc {
+public:
+    X86AddLayerAcc() {
+        X86BinaryOpLayerAcc::op_type_ = X86BinaryOpType::kADD;
+    }
+    virtual ~X86AddLayerAcc();
+
+    virtual Status Init(Context *context, LayerParam *param, LayerResource *resource,
+                        const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+
+    virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+
+private:
+    // two input scales and the reciprocal of output scale, per channel
+    Status allocateBufferParamInt8(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    RawBuffer input0_int_scale_;
+    RawBuffer input1_int_scale_;
+    RawBuffer output_int_scale_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_DEVICE_X86_ACC_X86_ADD_LAYER_ACC_H_
@@ -42,6 +42,10 @@ Status X86BatchNormLayerAcc::Init(Context *context, LayerParam *param, LayerReso
     return TNN_OK;
 }
 
+bool X86BatchNormLayerAcc::NC8HW8Implemented(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return inputs[0]->GetBlobDesc().data_format == outputs[0]->GetBlobDesc().data_format;
+}
+
 Status X86BatchNormLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     
     auto resource = dynamic_cast<BatchNormLayerResource *>(resource_);
@@ -57,14 +61,17 @@ Status X86BatchNormLayerAcc::DoForward(const std::vector<Blob *> &inputs, const
     RawBuffer bias_handle  = resource->bias_handle;
     bool has_bias          = bias_handle.GetDataCount() > 0; 
 
-    X86_FMA(static_cast<float *>(input_blob->GetHandle().base),
-            static_cast<float *>(output_blob->GetHandle().base),
-            scale_handle.force_to<float *>(), bias_handle.force_to<float *>(),
-            shared_channel, has_bias, output_blob->GetBlobDesc().dims);
-
-    return TNN_OK;
+    auto fma_func = X86_FMA;
+    if (output_blob->GetBlobDesc().data_format == DATA_FORMAT_NC8HW8) {
+        fma_func = X86_FMA_NC8HW8;
+    }
+    return fma_func(static_cast<float *>(input_blob->GetHandle().base),
+                    static_cast<float *>(output_blob->GetHandle().base),
+                    scale_handle.force_to<float *>(), bias_handle.force_to<float *>(),
+                    shared_channel, has_bias, output_blob->GetBlobDesc().dims);
 }
 
 REGISTER_X86_ACC(BatchNorm, LAYER_BATCH_NORM);
+REGISTER_X86_LAYOUT(LAYER_BATCH_NORM, DATA_FORMAT_NC8HW8);
 
 }  // namespace TNN_NS
@@ -68,22 +68,22 @@ template<> Float4 binary_op<X86BinaryOpType::kMAX, Float4>(const Float4 &a, cons
 template<> Float4 binary_op<X86BinaryOpType::kMIN, Float4>(const Float4 &a, const Float4 &b) {
     return Float4::min(a, b);
 }
-template<> Float8 binary_op<X86BinaryOpType::kADD, Float8>(const Float8 &a, const Float8 &b) {
+template<> X86_AVX2_TARGET Float8 binary_op<X86BinaryOpType::kADD, Float8>(const Float8 &a, const Float8 &b) {
     return Float8::add(a, b);
 }
-template<> Float8 binary_op<X86BinaryOpType::kSUB, Float8>(const Float8 &a, const Float8 &b) {
+template<> X86_AVX2_TARGET Float8 binary_op<X86BinaryOpType::kSUB, Float8>(const Float8 &a, const Float8 &b) {
     return Float8::sub(a, b);
 }
-template<> Float8 binary_op<X86BinaryOpType::kMUL, Float8>(const Float8 &a, const Float8 &b) {
+template<> X86_AVX2_TARGET Float8 binary_op<X86BinaryOpType::kMUL, Float8>(const Float8 &a, const Float8 &b) {
     return Float8::mul(a, b);
 }
-template<> Float8 binary_op<X86BinaryOpType::kDIV, Float8>(const Float8 &a, const Float8 &b) {
+template<> X86_AVX2_TARGET Float8 binary_op<X86BinaryOpType::kDIV, Float8>(const Float8 &a, const Float8 &b) {
     return Float8::div(a, b);
 }
-template<> Float8 binary_op<X86BinaryOpType::kMAX, Float8>(const Float8 &a, const Float8 &b) {
+template<> X86_AVX2_TARGET Float8 binary_op<X86BinaryOpType::kMAX, Float8>(const Float8 &a, const Float8 &b) {
     return Float8::max(a, b);
 }
-template<> Float8 binary_op<X86BinaryOpType::kMIN, Float8>(const Float8 &a, const Float8 &b) {
+template<> X86_AVX2_TARGET Float8 binary_op<X86BinaryOpType::kMIN, Float8>(const Float8 &a, const Float8 &b) {
     return Float8::min(a, b);
 }
 
@@ -302,7 +302,7 @@ Binary func with different opreator,
 set dims0 full shape, dims1 broadcast shape, so we need to swap input ptrs
 */
 template <X86BinaryOpType op_type, typename VEC, int pack>
-Status BinaryFunc(float *output_ptr, const float *input0_ptr, const float *input1_ptr, DimsVector &dims0, DimsVector &dims1, DimsVector &output_dims) {
+X86_INLINE Status BinaryFunc(float *output_ptr, const float *input0_ptr, const float *input1_ptr, DimsVector &dims0, DimsVector &dims1, DimsVector &output_dims) {
     DimsVector dims = DimsVectorUtils::Max(dims0, dims1);
     DimsVector dims_broadcast;
     BroadcastType type = BroadcastTypeUnknown;
@@ -522,6 +522,18 @@ Status BinaryFunc(float *output_ptr, const float *input0_ptr, const float *input
     return TNN_OK;
 }
 
+template <X86BinaryOpType op_type>
+Status BinaryFuncSSE(float *output_ptr, const float *input0_ptr, const float *input1_ptr, DimsVector &dims0,
+                     DimsVector &dims1, DimsVector &output_dims) {
+    return BinaryFunc<op_type, Float4, 4>(output_ptr, input0_ptr, input1_ptr, dims0, dims1, output_dims);
+}
+
+template <X86BinaryOpType op_type>
+X86_AVX2_TARGET Status BinaryFuncAVX2(float *output_ptr, const float *input0_ptr, const float *input1_ptr,
+                                      DimsVector &dims0, DimsVector &dims1, DimsVector &output_dims) {
+    return BinaryFunc<op_type, Float8, 8>(output_ptr, input0_ptr, input1_ptr, dims0, dims1, output_dims);
+}
+
 X86BinaryOpLayerAcc::~X86BinaryOpLayerAcc() {}
 
 Status X86BinaryOpLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
@@ -577,28 +589,28 @@ Status X86BinaryOpLayerAcc::Init(Context *context, LayerParam *param, LayerResou
     }
 
     // set binary function pointer
-    binary_func_ = BinaryFunc<X86BinaryOpType::kADD, Float4, 4>;
+    binary_func_ = BinaryFuncSSE<X86BinaryOpType::kADD>;
     binary_general_func_ = BinaryGeneral<X86BinaryOpType::kADD>;
 
-    if (arch_ == avx2) {
+    if (arch_ >= avx2) {
         switch(op_type_) {
             case X86BinaryOpType::kADD :
-                binary_func_ = BinaryFunc<X86BinaryOpType::kADD, Float8, 8>;
+                binary_func_ = BinaryFuncAVX2<X86BinaryOpType::kADD>;
                 break;
             case X86BinaryOpType::kSUB :
-                binary_func_ = BinaryFunc<X86BinaryOpType::kSUB, Float8, 8>;
+                binary_func_ = BinaryFuncAVX2<X86BinaryOpType::kSUB>;
                 break;
             case X86BinaryOpType::kMUL :
-                binary_func_ = BinaryFunc<X86BinaryOpType::kMUL, Float8, 8>;
+                binary_func_ = BinaryFuncAVX2<X86BinaryOpType::kMUL>;
                 break;
             case X86BinaryOpType::kDIV :
-                binary_func_ = BinaryFunc<X86BinaryOpType::kDIV, Float8, 8>;
+                binary_func_ = BinaryFuncAVX2<X86BinaryOpType::kDIV>;
                 break;
             case X86BinaryOpType::kMAX :
-                binary_func_ = BinaryFunc<X86BinaryOpType::kMAX, Float8, 8>;
+                binary_func_ = BinaryFuncAVX2<X86BinaryOpType::kMAX>;
                 break;
             case X86BinaryOpType::kMIN :
-                binary_func_ = BinaryFunc<X86BinaryOpType::kMIN, Float8, 8>;
+                binary_func_ = BinaryFuncAVX2<X86BinaryOpType::kMIN>;
                 break;
 
             default :
@@ -608,22 +620,22 @@ Status X86BinaryOpLayerAcc::Init(Context *context, LayerParam *param, LayerResou
     } else if (arch_ == sse42) {
         switch(op_type_) {
             case X86BinaryOpType::kADD :
-                binary_func_ = BinaryFunc<X86BinaryOpType::kADD, Float4, 4>;
+                binary_func_ = BinaryFuncSSE<X86BinaryOpType::kADD>;
                 break;
             case X86BinaryOpType::kSUB :
-                binary_func_ = BinaryFunc<X86BinaryOpType::kSUB, Float4, 4>;
+                binary_func_ = BinaryFuncSSE<X86BinaryOpType::kSUB>;
                 break;
             case X86BinaryOpType::kMUL :
-                binary_func_ = BinaryFunc<X86BinaryOpType::kMUL, Float4, 4>;
+                binary_func_ = BinaryFuncSSE<X86BinaryOpType::kMUL>;
                 break;
             case X86BinaryOpType::kDIV :
-                binary_func_ = BinaryFunc<X86BinaryOpType::kDIV, Float4, 4>;
+                binary_func_ = BinaryFuncSSE<X86BinaryOpType::kDIV>;
                 break;
             case X86BinaryOpType::kMAX :
-                binary_func_ = BinaryFunc<X86BinaryOpType::kMAX, Float4, 4>;
+                binary_func_ = BinaryFuncSSE<X86BinaryOpType::kMAX>;
                 break;
             case X86BinaryOpType::kMIN :
-                binary_func_ = BinaryFunc<X86BinaryOpType::kMIN, Float4, 4>;
+                binary_func_ = BinaryFuncSSE<X86BinaryOpType::kMIN>;
                 break;
 
             default :
@@ -709,6 +721,20 @@ Status X86BinaryOpLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std
     return TNN_OK;
 }
 
+bool X86BinaryOpLayerAcc::NC8HW8Implemented(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    if (dynamic_cast<EltwiseLayerResource *>(resource_) && inputs.size() == 1) {
+        return false;
+    }
+    auto output_desc = outputs[0]->GetBlobDesc();
+    for (auto blob : inputs) {
+        if (blob->GetBlobDesc().data_format != output_desc.data_format ||
+            !DimsVectorUtils::Equal(blob->GetBlobDesc().dims, output_desc.dims)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 Status X86BinaryOpLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto layer_param = dynamic_cast<MultidirBroadcastLayerParam *>(param_);
     if (!layer_param) {
@@ -717,6 +743,23 @@ Status X86BinaryOpLayerAcc::DoForward(const std::vector<Blob *> &inputs, const s
     }
     auto layer_res = dynamic_cast<EltwiseLayerResource *>(resource_);
 
+    if (outputs[0]->GetBlobDesc().data_format == DATA_FORMAT_NC8HW8) {
+        // inputs have the output shape, compute the padded channels as elements and clear them after
+        auto dims = outputs[0]->GetBlobDesc().dims;
+        DimsVector padded_dims = {DimsFunctionUtils::GetDim(dims, 0), ROUND_UP(DimsFunctionUtils::GetDim(dims, 1), 8),
+                                  DimsVectorUtils::Count(dims, 2)};
+        auto output_ptr = reinterpret_cast<float *>(outputs[0]->GetHandle().base);
+        auto input0_ptr = reinterpret_cast<float *>(inputs[0]->GetHandle().base);
+        auto input1_ptr = reinterpret_cast<float *>(inputs[inputs.size() > 1 ? 1 : 0]->GetHandle().base);
+        binary_func_(output_ptr, input0_ptr, input1_ptr, padded_dims, padded_dims, padded_dims);
+        for (int i = 2; i < inputs.size(); i++) {
+            auto input_ptr = reinterpret_cast<float *>(inputs[i]->GetHandle().base);
+            binary_func_(output_ptr, output_ptr, input_ptr, padded_dims, padded_dims, padded_dims);
+        }
+        ClearNC8HW8Padding(output_ptr, dims);
+        return TNN_OK;
+    }
+
     std::vector<float *> input_ptrs;
     input_ptrs.reserve(4);
     auto output = outputs[0];
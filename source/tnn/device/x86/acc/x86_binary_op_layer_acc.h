@@ -32,13 +32,14 @@ enum class X86BinaryOpType : int {
     kMIN = 5,
 };
 
-template <X86BinaryOpType op_type, typename VEC, int pack>
-Status BinaryFunc(float *output_ptr, const float *input0_ptr, const float *input1_ptr,
-                  DimsVector &dims0, DimsVector &dims1, DimsVector &output_dims);
+// sse4.2 and avx2 variants of the broadcast binary func
+template <X86BinaryOpType op_type>
+Status BinaryFuncSSE(float *output_ptr, const float *input0_ptr, const float *input1_ptr,
+                     DimsVector &dims0, DimsVector &dims1, DimsVector &output_dims);
 template <X86BinaryOpType op_type>
 void BinaryGeneral(DimsVector output_shape, const std::vector<DimsVector> &input_shapes,
                    float *output_ptr, std::vector<float *> &input_ptrs);
-using binary_func_t = decltype(&BinaryFunc<X86BinaryOpType::kADD, Float4, 4>);
+using binary_func_t = decltype(&BinaryFuncSSE<X86BinaryOpType::kADD>);
 using binary_general_func_t = decltype(&BinaryGeneral<X86BinaryOpType::kADD>);
 
 class X86BinaryOpLayerAcc : public X86LayerAcc {
@@ -51,6 +52,9 @@ public:
                 const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
 
     virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+
+    // @brief NC8HW8 is computed directly if no input is broadcast
+    virtual bool NC8HW8Implemented(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
 protected:
     // Calculate Function
     Status Calculate(const std::vector<Blob *> &input_blobs, const std::vector<void *> &input_ptrs,
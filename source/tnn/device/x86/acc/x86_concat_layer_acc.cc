@@ -14,12 +14,69 @@
 
 #include "tnn/device/x86/acc/x86_layer_acc.h"
 #include "tnn/device/x86/x86_device.h"
+#include "tnn/device/x86/x86_util.h"
 #include "tnn/utils/dims_utils.h"
 #include "tnn/utils/data_type_utils.h"
 
 namespace TNN_NS {
 
-DECLARE_X86_ACC(Concat, LAYER_CONCAT);
+class X86ConcatLayerAcc : public X86LayerAcc {
+public:
+    virtual ~X86ConcatLayerAcc(){};
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+    virtual bool NC8HW8Implemented(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+
+private:
+    Status ConcatChannelNC8HW8(const std::vector<Blob *> &inputs, Blob *output);
+};
+
+bool X86ConcatLayerAcc::NC8HW8Implemented(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<ConcatLayerParam *>(param_);
+    if (!param || param->axis != 1) {
+        return false;
+    }
+    for (auto blob : inputs) {
+        if (blob->GetBlobDesc().data_format != outputs[0]->GetBlobDesc().data_format) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// the blocks of an input starting at a block boundary are copied at once, the others channel by channel
+Status X86ConcatLayerAcc::ConcatChannelNC8HW8(const std::vector<Blob *> &inputs, Blob *output) {
+    auto dims        = output->GetBlobDesc().dims;
+    int batch        = DimsFunctionUtils::GetDim(dims, 0);
+    int hw           = DimsVectorUtils::Count(dims, 2);
+    int output_c_r8  = ROUND_UP(DimsFunctionUtils::GetDim(dims, 1), 8);
+    float *output_data = static_cast<float *>(output->GetHandle().base);
+
+    int output_offset = 0;
+    for (auto input : inputs) {
+        int input_c       = DimsFunctionUtils::GetDim(input->GetBlobDesc().dims, 1);
+        int input_c_r8    = ROUND_UP(input_c, 8);
+        float *input_data = static_cast<float *>(input->GetHandle().base);
+        for (int b = 0; b < batch; b++) {
+            auto src = input_data + b * input_c_r8 * hw;
+            auto dst = output_data + b * output_c_r8 * hw;
+            if (output_offset % 8 == 0) {
+                memcpy(dst + output_offset * hw, src, input_c_r8 * hw * sizeof(float));
+                continue;
+            }
+            for (int c = 0; c < input_c; c++) {
+                int oc     = output_offset + c;
+                auto src_c = src + (c / 8) * 8 * hw + c % 8;
+                auto dst_c = dst + (oc / 8) * 8 * hw + oc % 8;
+                for (int i = 0; i < hw; i++) {
+                    dst_c[i * 8] = src_c[i * 8];
+                }
+            }
+        }
+        output_offset += input_c;
+    }
+    ClearNC8HW8Padding(output_data, dims);
+    return TNN_OK;
+}
 
 Status X86ConcatLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto param = dynamic_cast<ConcatLayerParam *>(param_);
@@ -35,6 +92,10 @@ Status X86ConcatLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std
     auto output = outputs[0];
     auto dims   = input->GetBlobDesc().dims;
 
+    if (output->GetBlobDesc().data_format == DATA_FORMAT_NC8HW8) {
+        return ConcatChannelNC8HW8(inputs, output);
+    }
+
     const int axis = param->axis;
     if (axis > dims.size() || axis < 0) {
         LOGE("Error: Concat layer param invalid\n");
@@ -70,5 +131,6 @@ Status X86ConcatLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std
 }
 
 REGISTER_X86_ACC(Concat, LAYER_CONCAT);
+REGISTER_X86_LAYOUT(LAYER_CONCAT, DATA_FORMAT_NC8HW8);
 
 }
\ No newline at end of file
@@ -40,11 +40,16 @@ Status X86ConvLayerAcc::Init(Context *context, LayerParam *param, LayerResource
         return ret;
     }
 
-    X86ConvLayerAccFactory::CreateImpFP(inputs, outputs, param_, conv_acc_impl_);
+    if (inputs[0]->GetBlobDesc().data_type == DATA_TYPE_INT8) {
+        X86ConvLayerAccFactory::CreateImpInt8(inputs, outputs, param_, conv_acc_impl_);
+    } else {
+        X86ConvLayerAccFactory::CreateImpFP(inputs, outputs, param_, conv_acc_impl_);
+    }
 
     if (!conv_acc_impl_) {
         return Status(TNNERR_NET_ERR, "Could not create conv impl_");
     }
+    conv_acc_impl_->SetWeightsShared(conv_acc_f32_resource_ == nullptr);
     ret = conv_acc_impl_->Init(context_, param_, resource_, inputs, outputs);
 
     // converted weights are assumed to be packed, and can be freed now
@@ -63,6 +68,11 @@ Status X86ConvLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::
     }
 }
 
+bool X86ConvLayerAcc::NC8HW8Implemented(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return conv_acc_impl_ && conv_acc_impl_->NC8HW8Implemented(inputs, outputs);
+}
+
 REGISTER_X86_ACC(Conv, LAYER_CONVOLUTION);
+REGISTER_X86_LAYOUT(LAYER_CONVOLUTION, DATA_FORMAT_NC8HW8);
 
 }   // namespace TNN_NS
\ No newline at end of file
@@ -32,6 +32,8 @@ public:
 
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
 
+    virtual bool NC8HW8Implemented(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+
 protected:
     std::shared_ptr<X86LayerAcc> conv_acc_impl_ = nullptr;
     std::shared_ptr<LayerResource> conv_acc_f32_resource_ = nullptr;
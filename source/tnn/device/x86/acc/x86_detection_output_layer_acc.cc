@@ -13,7 +13,7 @@
 // specific language governing permissions and limitations under the License.
 
 #include "tnn/device/x86/acc/x86_layer_acc.h"
-#include "tnn/utils/naive_compute.h"
+#include "tnn/utils/bbox_soa_util.h"
 
 namespace TNN_NS {
 
@@ -22,7 +22,7 @@ DECLARE_X86_ACC(DetectionOutput, LAYER_DETECTION_OUTPUT);
 Status X86DetectionOutputLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     DetectionOutputLayerParam *param = dynamic_cast<DetectionOutputLayerParam *>(param_);
     CHECK_PARAM_NULL(param);
-    NaiveDetectionOutput(inputs, outputs, param);
+    DetectionOutputSoA(inputs, outputs, param);
     return TNN_OK;
 }
 
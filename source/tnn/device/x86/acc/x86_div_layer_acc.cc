@@ -19,5 +19,6 @@ namespace TNN_NS {
 DECLARE_X86_BINARY_OP_ACC(Div, X86BinaryOpType::kDIV);
 
 REGISTER_X86_ACC(Div, LAYER_DIV);
+REGISTER_X86_LAYOUT(LAYER_DIV, DATA_FORMAT_NC8HW8);
 
 }   // namespace TNN_NS
\ No newline at end of file
@@ -26,7 +26,7 @@ typedef struct x86_exp_operator : x86_unary2_operator {
         return Float4::exp(v);
     }
 
-    virtual Float8 operator()(const Float8 &v) {
+    X86_AVX2_TARGET virtual Float8 operator()(const Float8 &v) {
         return Float8::exp(v);
     }
 } X86_EXP_OP;
@@ -35,5 +35,6 @@ X86_REGISTER_UNARY2_KERNEL(LAYER_EXP, avx2, unary2_kernel_avx<X86_EXP_OP>);
 X86_REGISTER_UNARY2_KERNEL(LAYER_EXP, sse42, unary2_kernel_sse<X86_EXP_OP>);
 DECLARE_X86_UNARY2_ACC(Exp, LAYER_EXP);
 REGISTER_X86_ACC(Exp, LAYER_EXP);
+REGISTER_X86_LAYOUT(LAYER_EXP, DATA_FORMAT_NC8HW8);
 
 }   // namespace TNN_NS
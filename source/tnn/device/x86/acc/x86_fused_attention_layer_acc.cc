@@ -0,0 +1,109 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/acc/compute/x86_compute.h"
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/utils/dims_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+DECLARE_X86_ACC(FusedAttention, LAYER_FUSED_ATTENTION);
+
+// query rows of a task and keys of a score block, the k^T and v of a key block stay in cache
+static const int kAttentionBlockQ = 32;
+static const int kAttentionBlockK = 128;
+
+Status X86FusedAttentionLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto layer_param = dynamic_cast<FusedAttentionLayerParam *>(param_);
+    CHECK_PARAM_NULL(layer_param);
+    if (outputs[0]->GetBlobDesc().data_type != DATA_TYPE_FLOAT) {
+        return Status(TNNERR_LAYER_ERR, "FusedAttention only supports float");
+    }
+
+    auto q_dims       = inputs[0]->GetBlobDesc().dims;
+    auto kt_dims      = inputs[1]->GetBlobDesc().dims;
+    auto v_dims       = inputs[2]->GetBlobDesc().dims;
+    auto output_dims  = outputs[0]->GetBlobDesc().dims;
+    const int seq_q   = q_dims[q_dims.size() - 2];
+    const int depth   = q_dims.back();
+    const int seq_k   = kt_dims.back();
+    const int depth_v = v_dims.back();
+    const float scale = layer_param->scale;
+
+    DimsVector batch_dims(output_dims.begin(), output_dims.end() - 2);
+    DimsVector q_batch_dims(q_dims.begin(), q_dims.end() - 2);
+    DimsVector kt_batch_dims(kt_dims.begin(), kt_dims.end() - 2);
+    DimsVector v_batch_dims(v_dims.begin(), v_dims.end() - 2);
+    const int batch = DimsVectorUtils::Count(batch_dims);
+
+    float *q      = static_cast<float *>(inputs[0]->GetHandle().base);
+    float *kt     = static_cast<float *>(inputs[1]->GetHandle().base);
+    float *v      = static_cast<float *>(inputs[2]->GetHandle().base);
+    float *output = static_cast<float *>(outputs[0]->GetHandle().base);
+
+    // the mask is broadcast to the scores [batch, seq_q, seq_k]
+    float *mask = nullptr;
+    DimsVector mask_dims, mask_batch_dims;
+    long mask_row_stride = 0, mask_col_stride = 0;
+    if (inputs.size() >= 4) {
+        mask      = static_cast<float *>(inputs[3]->GetHandle().base);
+        mask_dims = inputs[3]->GetBlobDesc().dims;
+        while (mask_dims.size() < 2) {
+            mask_dims.insert(mask_dims.begin(), 1);
+        }
+        mask_batch_dims = DimsVector(mask_dims.begin(), mask_dims.end() - 2);
+        mask_col_stride = mask_dims.back() == 1 ? 0 : 1;
+        mask_row_stride = mask_dims[mask_dims.size() - 2] == 1 ? 0 : mask_dims.back();
+    }
+
+    auto attention_func = X86FlashAttention<Float4, 4>;
+    if (arch_ >= avx2) {
+        attention_func = X86FlashAttention<Float8, 8>;
+    }
+
+    // scores of a key block and the running max and sum of each query row, per thread
+    const int block_k            = MIN(kAttentionBlockK, seq_k);
+    const int threads            = OMP_MAX_THREADS_NUM_;
+    size_t thread_workspace_size = ROUND_UP((kAttentionBlockQ * block_k + 2 * kAttentionBlockQ) * sizeof(float), 32);
+    char *workspace = reinterpret_cast<char *>(context_->GetSharedWorkSpace(thread_workspace_size * threads));
+
+    const int q_blocks = UP_DIV(seq_q, kAttentionBlockQ);
+    OMP_PARALLEL_FOR_
+    for (int task = 0; task < batch * q_blocks; ++task) {
+        int b     = task / q_blocks;
+        int row   = (task % q_blocks) * kAttentionBlockQ;
+        int rows  = MIN(kAttentionBlockQ, seq_q - row);
+        auto q_b  = q + DimsFunctionUtils::GetBroadcastOffset(batch_dims, q_batch_dims, b) * seq_q * depth;
+        auto kt_b = kt + DimsFunctionUtils::GetBroadcastOffset(batch_dims, kt_batch_dims, b) * depth * seq_k;
+        auto v_b  = v + DimsFunctionUtils::GetBroadcastOffset(batch_dims, v_batch_dims, b) * seq_k * depth_v;
+        const float *mask_b = nullptr;
+        if (mask) {
+            mask_b = mask + DimsFunctionUtils::GetBroadcastOffset(batch_dims, mask_batch_dims, b) *
+                                mask_dims[mask_dims.size() - 2] * mask_dims.back() +
+                     row * mask_row_stride;
+        }
+        auto thread_workspace = reinterpret_cast<float *>(workspace + OMP_TID_ * thread_workspace_size);
+
+        attention_func(q_b + row * depth, kt_b, v_b, mask_b, mask_row_stride, mask_col_stride,
+                       output + (b * seq_q + row) * depth_v, rows, seq_k, depth, depth_v, scale, block_k,
+                       thread_workspace);
+    }
+
+    return TNN_OK;
+}
+
+REGISTER_X86_ACC(FusedAttention, LAYER_FUSED_ATTENTION);
+
+}  // namespace TNN_NS
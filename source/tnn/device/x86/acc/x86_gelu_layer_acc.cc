@@ -20,7 +20,7 @@
 namespace TNN_NS {
 
 template <typename VEC>
-static VEC fast_erf_approximation(VEC x) {
+static X86_INLINE VEC fast_erf_approximation(VEC x) {
     auto t = VEC::div(VEC(1.f), VEC(1.f) + VEC(0.5f) * VEC::abs(x));
     auto t_2 = t * t;
     auto t_3 = t_2 * t;
@@ -56,7 +56,7 @@ typedef struct x86_gelu_operator : x86_unary2_operator {
         return Float4(0.5f) * v * (fast_erf_approximation<Float4>(v * Float4(0.707106793288165f)) + Float4(1.f));
     }
 
-    virtual Float8 operator()(const Float8 &v) {
+    X86_AVX2_TARGET virtual Float8 operator()(const Float8 &v) {
         return Float8(0.5f) * v * (fast_erf_approximation<Float8>(v * Float8(0.707106793288165f)) + Float8(1.f));
     }
 } X86_GELU_OP;
@@ -65,5 +65,6 @@ X86_REGISTER_UNARY2_KERNEL(LAYER_GELU, avx2, unary2_kernel_avx<X86_GELU_OP>);
 X86_REGISTER_UNARY2_KERNEL(LAYER_GELU, sse42, unary2_kernel_sse<X86_GELU_OP>);
 DECLARE_X86_UNARY2_ACC(Gelu, LAYER_GELU);
 REGISTER_X86_ACC(Gelu, LAYER_GELU);
+REGISTER_X86_LAYOUT(LAYER_GELU, DATA_FORMAT_NC8HW8);
 
 }   // namespace TNN_NS
\ No newline at end of file
@@ -0,0 +1,387 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/acc/x86_gru_layer_acc.h"
+#include "tnn/device/x86/acc/Float4.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+// z and r gates: zr = sigmoid(gates + bias + zr)
+static void X86GRUResetUpdate(const float *gates, const float *bias, float *zr, int len) {
+    int i = 0;
+    for (; i + 3 < len; i += 4) {
+        Float4 v = Float4::loadu(gates + i) + Float4::loadu(bias + i) + Float4::loadu(zr + i);
+        Float4::saveu(zr + i, Float4::sigmoid(v));
+    }
+    for (; i < len; i++) {
+        zr[i] = 1.f / (1.f + exp(-(gates[i] + bias[i] + zr[i])));
+    }
+}
+
+// h gate and the new hidden, hh is the recurrence of h without bias
+static void X86GRUActivate(const float *gates_h, const float *wb_h, const float *rb_h, const float *hh,
+                           const float *z, const float *r, float *h_t, float *y, int len, int linear_before_reset) {
+    int i = 0;
+    for (; i + 3 < len; i += 4) {
+        Float4 rec = Float4::loadu(hh + i) + Float4::loadu(rb_h + i);
+        if (linear_before_reset) {
+            rec = Float4::loadu(r + i) * rec;
+        }
+        Float4 n      = Float4::tanh(Float4::loadu(gates_h + i) + Float4::loadu(wb_h + i) + rec);
+        Float4 h_prev = Float4::loadu(h_t + i);
+        Float4 h      = n + Float4::loadu(z + i) * (h_prev - n);
+        Float4::saveu(h_t + i, h);
+        Float4::saveu(y + i, h);
+    }
+    for (; i < len; i++) {
+        float rec = hh[i] + rb_h[i];
+        if (linear_before_reset) {
+            rec = r[i] * rec;
+        }
+        float n = tanh(gates_h[i] + wb_h[i] + rec);
+        float h = n + z[i] * (h_t[i] - n);
+        h_t[i]  = h;
+        y[i]    = h;
+    }
+}
+
+Status X86GRULayerAcc::GRUOneDirection(const float *x, float *y, const float *w, const float *r_zr,
+                                       const float *r_h, const float *b, float *h_t, int seq_len, int batch_size,
+                                       int input_size, int hidden_size, int reverse, float *workspace) {
+    auto layer_param        = dynamic_cast<GRULayerParam *>(param_);
+    int linear_before_reset = layer_param->linear_before_reset;
+    int k_c                 = conv_gemm_conf_.K_c_;
+    int n_block             = conv_gemm_conf_.n_block_;
+
+    // sgemm for weight tensor
+    // weights: [3*hidden_size, input_size]
+    // inputs: [seq_len, batch, input_size]
+    int K = input_size;
+    int N = seq_len * batch_size;
+    int M = 3 * hidden_size;
+
+    // buffers of the direction, see GetDirectionWorkspaceSize
+    size_t gates_buf_size = ROUND_UP(N * M * sizeof(float), 32);
+    size_t gemm_buf_size  = ROUND_UP(k_c * ROUND_UP(N, n_block) * sizeof(float), 32);
+    float *gates_buf      = workspace;
+    float *gemm_buf       = gates_buf + gates_buf_size / sizeof(float);
+    // z and r of the steps, [batch, 2*hidden_size]
+    float *zr_buf = gemm_buf + gemm_buf_size / sizeof(float);
+    // recurrence of h, [batch, hidden_size]
+    float *hh_buf = zr_buf + batch_size * 2 * hidden_size;
+    // r * h_prev, [batch, hidden_size]
+    float *rh_buf = hh_buf + batch_size * hidden_size;
+    // zero bias at the head of workspace_, the gemm of a zero bias overwrites dst
+    float *zero_bias = workspace_.force_to<float *>();
+
+    conv_sgemm_tn_col_major_prepack_a(M, N, K, w, K, x, K, gates_buf, M, zero_bias, ActivationType_None, gemm_buf,
+                                      conv_gemm_conf_);
+
+    // bias: [z, r, Wb of h, Rb of h]
+    const float *b_zr = b;
+    const float *wb_h = b + 2 * hidden_size;
+    const float *rb_h = b + 3 * hidden_size;
+
+    for (int t = 0; t < seq_len; t++) {
+        int ti       = reverse ? seq_len - 1 - t : t;
+        auto gates_t = gates_buf + ti * batch_size * 3 * hidden_size;
+        auto y_t     = y + ti * batch_size * hidden_size;
+
+        // sgemm for recurrence weight of z and r
+        // weights: [2*hidden_size, hidden_size]
+        // inputs: [batch, hidden_size]
+        conv_sgemm_tn_col_major_prepack_a(2 * hidden_size, batch_size, hidden_size, r_zr, hidden_size, h_t,
+                                          hidden_size, zr_buf, 2 * hidden_size, zero_bias, ActivationType_None,
+                                          gemm_buf, conv_gemm_conf_);
+        for (int i = 0; i < batch_size; i++) {
+            X86GRUResetUpdate(gates_t + i * 3 * hidden_size, b_zr, zr_buf + i * 2 * hidden_size, 2 * hidden_size);
+        }
+
+        // sgemm for recurrence weight of h, the reset gate applies to h_prev or to the result
+        // weights: [hidden_size, hidden_size]
+        // inputs: [batch, hidden_size]
+        const float *h_src = h_t;
+        if (!linear_before_reset) {
+            for (int i = 0; i < batch_size; i++) {
+                auto r_b  = zr_buf + i * 2 * hidden_size + hidden_size;
+                auto h_b  = h_t + i * hidden_size;
+                auto rh_b = rh_buf + i * hidden_size;
+                for (int j = 0; j < hidden_size; j++) {
+                    rh_b[j] = r_b[j] * h_b[j];
+                }
+            }
+            h_src = rh_buf;
+        }
+        conv_sgemm_tn_col_major_prepack_a(hidden_size, batch_size, hidden_size, r_h, hidden_size, h_src,
+                                          hidden_size, hh_buf, hidden_size, zero_bias, ActivationType_None, gemm_buf,
+                                          conv_gemm_conf_);
+
+        // activation for h_t, output
+        for (int i = 0; i < batch_size; i++) {
+            auto zr_b = zr_buf + i * 2 * hidden_size;
+            X86GRUActivate(gates_t + i * 3 * hidden_size + 2 * hidden_size, wb_h, rb_h, hh_buf + i * hidden_size,
+                           zr_b, zr_b + hidden_size, h_t + i * hidden_size, y_t + i * hidden_size, hidden_size,
+                           linear_before_reset);
+        }
+    }
+    return TNN_OK;
+}
+
+size_t X86GRULayerAcc::GetDirectionWorkspaceSize(int seq_len, int batch_size, int hidden_size) {
+    int k_c               = conv_gemm_conf_.K_c_;
+    int n_block           = conv_gemm_conf_.n_block_;
+    int N                 = seq_len * batch_size;
+    size_t gates_buf_size = ROUND_UP(N * 3 * hidden_size * sizeof(float), 32);
+    // the gemm of the input is the larger one, the recurrence gemms reuse the buffer
+    size_t gemm_buf_size = ROUND_UP(k_c * ROUND_UP(N, n_block) * sizeof(float), 32);
+    // z and r, recurrence of h and r * h_prev
+    size_t step_buf_size = ROUND_UP(batch_size * 4 * hidden_size * sizeof(float), 32);
+    return gates_buf_size + gemm_buf_size + step_buf_size;
+}
+
+X86GRULayerAcc::~X86GRULayerAcc() {}
+
+Status X86GRULayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
+                            const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto status = X86LayerAcc::Init(context, param, resource, inputs, outputs);
+    RETURN_ON_NEQ(status, TNN_OK);
+
+    if (inputs.size() < 4 || outputs.size() < 2) {
+        return Status(TNNERR_LAYER_ERR, "GRU has invalid inputs or outputs");
+    }
+
+    RETURN_ON_NEQ(allocateBufferWeight(inputs, outputs), TNN_OK);
+    RETURN_ON_NEQ(allocateBufferBias(inputs, outputs), TNN_OK);
+
+    return TNN_OK;
+}
+
+Status X86GRULayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto layer_param      = dynamic_cast<GRULayerParam *>(param_);
+    int num_directions    = layer_param->direction >= 2 ? 2 : 1;
+    const auto input_dims = inputs[0]->GetBlobDesc().dims;
+    const int T           = input_dims[0];
+    const int batch       = input_dims[1];
+    const int hidden_size = layer_param->hidden_size;
+
+    // [zero bias][temp y of bidirection][direction 0][direction 1]
+    size_t zero_bias_size = ROUND_UP(MAX(T * batch, 2 * hidden_size) * sizeof(float), 32);
+    size_t y_temp_size    = num_directions == 2 ? ROUND_UP(2 * T * batch * hidden_size * sizeof(float), 32) : 0;
+    size_t workspace_size =
+        zero_bias_size + y_temp_size + num_directions * GetDirectionWorkspaceSize(T, batch, hidden_size);
+    if (workspace_.GetBytesSize() < workspace_size) {
+        workspace_ = RawBuffer(workspace_size, 32);
+    }
+    // the layout moves with the shape, the zero bias may be taken by the buffers of a smaller one before
+    memset(workspace_.force_to<void *>(), 0, zero_bias_size);
+
+    return X86LayerAcc::Reshape(inputs, outputs);
+}
+
+Status X86GRULayerAcc::allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    // weights for gates, [num_direction, 3 * hidden_size, input_size]
+    auto w_dims          = inputs[1]->GetBlobDesc().dims;
+    int w_direction_size = DimsVectorUtils::Count(w_dims, 1);
+    float *w_ptr = (float *)((char *)(inputs[1]->GetHandle().base) + inputs[1]->GetHandle().bytes_offset);
+
+    // recurrence weights, [num_direction, 3 * hidden_size, hidden_size]
+    auto r_dims          = inputs[2]->GetBlobDesc().dims;
+    int r_direction_size = DimsVectorUtils::Count(r_dims, 1);
+    float *r_ptr = (float *)((char *)(inputs[2]->GetHandle().base) + inputs[2]->GetHandle().bytes_offset);
+
+    int k_c         = conv_gemm_conf_.K_c_;
+    int m_block     = conv_gemm_conf_.m_block_;
+    int hidden_size = w_dims[1] / 3;
+
+    // gate weights, the gates of zrh are packed as they are
+    int K              = w_dims[2];
+    int M              = w_dims[1];
+    size_t w_pack_size = ROUND_UP(K, k_c) * ROUND_UP(M, m_block);
+    // align pointer of packed weights, since gemm use aligned load for input A
+    RawBuffer w_temp_buffer(w_dims[0] * w_pack_size * sizeof(float), 32);
+    for (int d = 0; d < w_dims[0]; d++) {
+        float *w_src = w_ptr + d * w_direction_size;
+        float *w_dst = w_temp_buffer.force_to<float *>() + d * w_pack_size;
+        conv_pack_col_a_t(M, K, w_src, K, w_dst, conv_gemm_conf_);
+    }
+
+    // recurrence weights of zr and h, h is computed after the reset gate
+    K                     = hidden_size;
+    size_t r_zr_pack_size = ROUND_UP(K, k_c) * ROUND_UP(2 * hidden_size, m_block);
+    size_t r_h_pack_size  = ROUND_UP(K, k_c) * ROUND_UP(hidden_size, m_block);
+    RawBuffer r_zr_temp_buffer(r_dims[0] * r_zr_pack_size * sizeof(float), 32);
+    RawBuffer r_h_temp_buffer(r_dims[0] * r_h_pack_size * sizeof(float), 32);
+    for (int d = 0; d < r_dims[0]; d++) {
+        float *r_src    = r_ptr + d * r_direction_size;
+        float *r_zr_dst = r_zr_temp_buffer.force_to<float *>() + d * r_zr_pack_size;
+        float *r_h_dst  = r_h_temp_buffer.force_to<float *>() + d * r_h_pack_size;
+        conv_pack_col_a_t(2 * hidden_size, K, r_src, K, r_zr_dst, conv_gemm_conf_);
+        conv_pack_col_a_t(hidden_size, K, r_src + 2 * hidden_size * K, K, r_h_dst, conv_gemm_conf_);
+    }
+
+    w_temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+    r_zr_temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+    r_h_temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+    buffer_w_    = w_temp_buffer;
+    buffer_r_zr_ = r_zr_temp_buffer;
+    buffer_r_h_  = r_h_temp_buffer;
+
+    return TNN_OK;
+}
+
+Status X86GRULayerAcc::allocateBufferBias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    // bias for gate and recurrence, [num_directions, 6*hidden_size]
+    auto b_dims     = inputs[3]->GetBlobDesc().dims;
+    int hidden_size = b_dims[1] / 6;
+    int bias_size   = hidden_size * 4;
+    RawBuffer b_temp_buffer(b_dims[0] * bias_size * sizeof(float));
+
+    float *b_ptr = (float *)((char *)(inputs[3]->GetHandle().base) + inputs[3]->GetHandle().bytes_offset);
+
+    for (int d = 0; d < b_dims[0]; d++) {
+        float *wb_d  = b_ptr + d * b_dims[1];
+        float *rb_d  = wb_d + 3 * hidden_size;
+        float *b_dst = b_temp_buffer.force_to<float *>() + d * bias_size;
+
+        // [Wb + Rb of z and r, Wb of h, Rb of h], Rb of h is applied with the recurrence of h
+        for (int i = 0; i < 2 * hidden_size; i++) {
+            b_dst[i] = wb_d[i] + rb_d[i];
+        }
+        memcpy(b_dst + 2 * hidden_size, wb_d + 2 * hidden_size, hidden_size * sizeof(float));
+        memcpy(b_dst + 3 * hidden_size, rb_d + 2 * hidden_size, hidden_size * sizeof(float));
+    }
+    b_temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+    buffer_b_ = b_temp_buffer;
+
+    return TNN_OK;
+}
+
+Status X86GRULayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto layer_param   = dynamic_cast<GRULayerParam *>(param_);
+    int num_directions = layer_param->direction >= 2 ? 2 : 1;
+
+    if (inputs.size() < 4 || outputs.size() < 2) {
+        return Status(TNNERR_LAYER_ERR, "GRU has invalid inputs or outputs");
+    }
+    Blob *blob_h0 = inputs.size() >= 5 ? inputs[4] : nullptr;
+
+    const auto input_dims  = inputs[0]->GetBlobDesc().dims;
+    const auto T           = input_dims[0];                          // length of sequence
+    const auto batch       = input_dims[1];                          // batch_size
+    const auto input_size  = DimsVectorUtils::Count(input_dims, 2);  // input dimension
+    const auto hidden_size = layer_param->hidden_size;               // output dimension
+    // block size for gemm
+    int k_c     = conv_gemm_conf_.K_c_;
+    int m_block = conv_gemm_conf_.m_block_;
+
+    //X shape [sequence batch_size input_size]
+    float *x = (float *)((char *)(inputs[0]->GetHandle().base) + inputs[0]->GetHandle().bytes_offset);
+
+    //Y shape [sequence batch_size num_directions *hidden_size]
+    float *y = (float *)((char *)(outputs[0]->GetHandle().base) + outputs[0]->GetHandle().bytes_offset);
+
+    //W[zrh], weight tensor for the gates, shape [num_directions, 3*hidden_size, input_size]
+    float *w           = buffer_w_.force_to<float *>();
+    size_t w_pack_size = ROUND_UP(input_size, k_c) * ROUND_UP(3 * hidden_size, m_block);
+
+    //R[zrh], recurrence weight tensor, shape [num_directions, 3*hidden_size, hidden_size]
+    float *r_zr           = buffer_r_zr_.force_to<float *>();
+    float *r_h            = buffer_r_h_.force_to<float *>();
+    size_t r_zr_pack_size = ROUND_UP(hidden_size, k_c) * ROUND_UP(2 * hidden_size, m_block);
+    size_t r_h_pack_size  = ROUND_UP(hidden_size, k_c) * ROUND_UP(hidden_size, m_block);
+
+    //B[zrh], see allocateBufferBias
+    float *b = buffer_b_.force_to<float *>();
+
+    //stateful gru starts from h of the last forward, the initial value is used after reset only
+    const int state_count = num_directions * batch * hidden_size;
+    float *state          = nullptr;
+    bool state_created    = true;
+    if (layer_param->stateful) {
+        state = (float *)context_->GetLayerState(layer_param->name, state_count * sizeof(float), &state_created);
+    }
+
+    //initial_h, initial value of the hidden, If not specified - assumed to be 0. shape [num_directions, batch_size, hidden_size]
+    auto h_t = (float *)((char *)(outputs[1]->GetHandle().base) + outputs[1]->GetHandle().bytes_offset);
+    if (!state_created) {
+        memcpy((void *)h_t, state, state_count * sizeof(float));
+    } else if (blob_h0 != nullptr) {
+        auto h_0 = (float *)((char *)(blob_h0->GetHandle().base) + blob_h0->GetHandle().bytes_offset);
+        memcpy((void *)h_t, h_0, state_count * sizeof(float));
+    } else {
+        memset((void *)h_t, 0, state_count * sizeof(float));
+    }
+
+    // see Reshape for the layout of workspace_
+    size_t zero_bias_size = ROUND_UP(MAX(T * batch, 2 * hidden_size) * sizeof(float), 32);
+    size_t y_temp_size    = num_directions == 2 ? ROUND_UP(2 * T * batch * hidden_size * sizeof(float), 32) : 0;
+    size_t direction_workspace_size = GetDirectionWorkspaceSize(T, batch, hidden_size);
+    float *y_temp                   = workspace_.force_to<float *>() + zero_bias_size / sizeof(float);
+    float *direction_workspace      = y_temp + y_temp_size / sizeof(float);
+
+    if (layer_param->direction == 0 || layer_param->direction == 1) {
+        RETURN_ON_NEQ(GRUOneDirection(x, y, w, r_zr, r_h, b, h_t, T, batch, input_size, hidden_size,
+                                      layer_param->direction, direction_workspace),
+                      TNN_OK);
+    } else if (layer_param->direction == 2) {
+        //Y shape [num_directions sequence batch_size hidden_size]
+        auto y0         = y_temp;
+        auto y1         = y0 + T * batch * hidden_size;
+        auto w1         = w + w_pack_size;
+        auto r_zr1      = r_zr + r_zr_pack_size;
+        auto r_h1       = r_h + r_h_pack_size;
+        auto b1         = b + 4 * hidden_size;
+        auto h_t1       = h_t + batch * hidden_size;
+        auto workspace1 = direction_workspace + direction_workspace_size / sizeof(float);
+
+        // the two directions only share the inputs, run them concurrently
+        Status status0 = TNN_OK, status1 = TNN_OK;
+        OMP_PARALLEL_SECTIONS_ {
+            OMP_SECTION_ {
+                status0 = GRUOneDirection(x, y0, w, r_zr, r_h, b, h_t, T, batch, input_size, hidden_size, 0,
+                                          direction_workspace);
+            }
+            OMP_SECTION_ {
+                status1 = GRUOneDirection(x, y1, w1, r_zr1, r_h1, b1, h_t1, T, batch, input_size, hidden_size, 1,
+                                          workspace1);
+            }
+        }
+        RETURN_ON_NEQ(status0, TNN_OK);
+        RETURN_ON_NEQ(status1, TNN_OK);
+
+        //transpose [num_directions sequence batch_size hidden_size] to [sequence batch_size num_directions*hidden_size]
+        for (int i = 0; i < T * batch; i++) {
+            auto y0_data = y0 + i * hidden_size;
+            auto y1_data = y1 + i * hidden_size;
+            auto y_data  = y + i * num_directions * hidden_size;
+
+            memcpy(y_data, y0_data, hidden_size * sizeof(float));
+            memcpy(y_data + hidden_size, y1_data, hidden_size * sizeof(float));
+        }
+    } else {
+        return Status(TNNERR_PARAM_ERR, "GRU has invalid direction param");
+    }
+
+    if (state) {
+        memcpy(state, h_t, state_count * sizeof(float));
+    }
+
+    return TNN_OK;
+}
+
+REGISTER_X86_ACC(GRU, LAYER_GRU);
+}  // namespace TNN_NS
@@ -23,45 +23,9 @@ namespace TNN_NS {
 
 DECLARE_X86_ACC(HardSwish, X86_HARDSWISH_OP);
 
-Status X86HardSwishLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
-    
-    auto param = dynamic_cast<HardSwishLayerParam *>(param_);
-    if (!param) {
-        LOGE("Error: HardSwishLayerParam is nil\n");
-        return Status(TNNERR_MODEL_ERR, "Error: HardSwishLayerParam is nil");
-    }
-
-    Blob *input_blob0, *input_blob1;
-    if (inputs.size() == 1) {
-        input_blob0 = inputs[0];
-        input_blob1 = inputs[0];
-    } else {
-        input_blob0 = inputs[0];
-        input_blob1 = inputs[1];
-    }
-
-    const float alpha = param->alpha;
-    const float beta  = param->beta;
-
-    auto input_dim0  = input_blob0->GetBlobDesc().dims;
-    auto input_dim1  = input_blob1->GetBlobDesc().dims;
-
-    int batch = input_dim0[0];
-    int channel = 1;
-    if (input_dim0.size() > 1) {
-        channel = input_dim0[1];
-    }
-    int channel_size = 1;
-    if (input_dim0.size() > 2) {
-        channel_size = DimsVectorUtils::Count(input_dim0, 2);
-    }
-
-    auto input_ptr0 = reinterpret_cast<float *>(input_blob0->GetHandle().base);
-    auto input_ptr1 = reinterpret_cast<float *>(input_blob1->GetHandle().base);
-
-    auto output_ptr = reinterpret_cast<float *>(outputs[0]->GetHandle().base);
-
-#ifdef __AVX2__
+static X86_AVX2_TARGET Status HardSwishAVX2(float *input_ptr0, float *input_ptr1, float *output_ptr,
+                                            const DimsVector &input_dim0, const DimsVector &input_dim1, int batch,
+                                            int channel, int channel_size, float alpha, float beta) {
     __m256 alpha_, beta_, zero_, one_, tmp00_, tmp01_, tmp02_, tmp03_, tmp10_, tmp11_, tmp12_, tmp13_;
     alpha_ = _mm256_set1_ps(alpha);
     beta_  = _mm256_set1_ps(beta);
@@ -240,8 +204,52 @@ Status X86HardSwishLayerAcc::DoForward(const std::vector<Blob *> &inputs, const
             }
         }
     }
+    return TNN_OK;
+}
+
+Status X86HardSwishLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    
+    auto param = dynamic_cast<HardSwishLayerParam *>(param_);
+    if (!param) {
+        LOGE("Error: HardSwishLayerParam is nil\n");
+        return Status(TNNERR_MODEL_ERR, "Error: HardSwishLayerParam is nil");
+    }
+
+    Blob *input_blob0, *input_blob1;
+    if (inputs.size() == 1) {
+        input_blob0 = inputs[0];
+        input_blob1 = inputs[0];
+    } else {
+        input_blob0 = inputs[0];
+        input_blob1 = inputs[1];
+    }
+
+    const float alpha = param->alpha;
+    const float beta  = param->beta;
+
+    auto input_dim0  = input_blob0->GetBlobDesc().dims;
+    auto input_dim1  = input_blob1->GetBlobDesc().dims;
+
+    int batch = input_dim0[0];
+    int channel = 1;
+    if (input_dim0.size() > 1) {
+        channel = input_dim0[1];
+    }
+    int channel_size = 1;
+    if (input_dim0.size() > 2) {
+        channel_size = DimsVectorUtils::Count(input_dim0, 2);
+    }
+
+    auto input_ptr0 = reinterpret_cast<float *>(input_blob0->GetHandle().base);
+    auto input_ptr1 = reinterpret_cast<float *>(input_blob1->GetHandle().base);
+
+    auto output_ptr = reinterpret_cast<float *>(outputs[0]->GetHandle().base);
+
+    if (arch_ >= avx2) {
+        return HardSwishAVX2(input_ptr0, input_ptr1, output_ptr, input_dim0, input_dim1, batch, channel,
+                             channel_size, alpha, beta);
+    }
 
-#else
     for (int b = 0; b < batch; b++) {
         for (int c = 0; c < channel; c++) {
             auto input_data0 = input_ptr0 + (b * channel + c) * channel_size;
@@ -255,7 +263,6 @@ Status X86HardSwishLayerAcc::DoForward(const std::vector<Blob *> &inputs, const
             }
         }
     }
-#endif
     return TNN_OK;
 }
 
@@ -12,13 +12,19 @@
 // CONDITIONS OF ANY KIND, either express or implied. See the License for the
 // specific language governing permissions and limitations under the License.
 
+#include <float.h>
+
+#include "tnn/core/blob_int8.h"
 #include "tnn/device/x86/x86_common.h"
 #include "tnn/device/x86/x86_context.h"
 #include "tnn/device/x86/x86_util.h"
 #include "tnn/utils/data_type_utils.h"
 #include "tnn/device/x86/acc/compute/x86_compute.h"
+#include "tnn/device/x86/acc/compute/x86_compute_int8.h"
 #include "tnn/device/x86/acc/x86_inner_product_layer_acc.h"
 #include "tnn/interpreter/layer_resource_generator.h"
+#include "tnn/utils/naive_compute.h"
+#include "tnn/utils/omp_utils.h"
 
 namespace TNN_NS {
 
@@ -38,6 +44,10 @@ Status X86InnerProductLayerAcc::Init(Context *context, LayerParam *param, LayerR
         return Status(TNNERR_MODEL_ERR, "output dim size is not supported");
     }
 
+    if (outputs[0]->GetBlobDesc().data_type == DATA_TYPE_INT8) {
+        return allocateBufferInt8(inputs, outputs);
+    }
+
     size_t flops = 2 * output_dims[0] * 
         DimsVectorUtils::Count(input_dims, 1) * 
         DimsVectorUtils::Count(output_dims, 1);
@@ -66,6 +76,7 @@ Status X86InnerProductLayerAcc::Init(Context *context, LayerParam *param, LayerR
     }
 
     RETURN_ON_NEQ(ret, TNN_OK);
+    SetWeightsShared(fc_acc_f32_resource_ == nullptr);
     RETURN_ON_NEQ(allocateBufferWeight(inputs, outputs), TNN_OK);
     RETURN_ON_NEQ(allocateBufferBias(inputs, outputs), TNN_OK);
 
@@ -102,17 +113,25 @@ Status X86InnerProductLayerAcc::allocateBufferWeight(const std::vector<Blob *> &
             int data_byte_size = DataTypeUtils::GetBytesSize(res->weight_handle.GetDataType());
 
             if (res->weight_handle.GetDataType() == DATA_TYPE_FLOAT) {
-                RawBuffer temp_buffer(weight_count * data_byte_size);
-                float *dst = temp_buffer.force_to<float *>();
-
-                if (arch_ == avx2) {
-                    PackC8(dst, src, input_stride, input_stride, input_stride, output_dims[1]);
-                } else if (arch_ == sse42) {
-                    PackC4(dst, src, input_stride, input_stride, input_stride, output_dims[1]);
-                }
-
-                temp_buffer.SetDataType(DATA_TYPE_FLOAT);
-                buffer_weight_ = temp_buffer;
+                auto pack = [&](std::vector<RawBuffer> &buffers) {
+                    RawBuffer temp_buffer(weight_count * data_byte_size);
+                    float *dst = temp_buffer.force_to<float *>();
+
+                    if (arch_ >= avx2) {
+                        PackC8(dst, src, input_stride, input_stride, input_stride, output_dims[1]);
+                    } else if (arch_ == sse42) {
+                        PackC4(dst, src, input_stride, input_stride, input_stride, output_dims[1]);
+                    }
+
+                    temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+                    buffers = {temp_buffer};
+                    return Status(TNN_OK);
+                };
+                std::vector<RawBuffer> buffers;
+                RETURN_ON_NEQ(GetSharedWeights(res->weight_handle, "inner_product_sgemv",
+                                               {(int)input_stride, output_dims[1]}, pack, buffers),
+                              TNN_OK);
+                buffer_weight_ = buffers[0];
             } else {
                 LOGE("Error: DataType %d not support\n", res->weight_handle.GetDataType());
                 return Status(TNNERR_MODEL_ERR, "innerproduct DataType is not supported");
@@ -126,14 +145,22 @@ Status X86InnerProductLayerAcc::allocateBufferWeight(const std::vector<Blob *> &
             const float *src = res->weight_handle.force_to<float *>();
 
             if (res->weight_handle.GetDataType() == DATA_TYPE_FLOAT) {
-                // align pointer of packed weights, since gemm use aligned load for input A
-                RawBuffer temp_buffer(weight_pack_size * sizeof(float), 32);
-                float *dst = temp_buffer.force_to<float *>();
-
-                conv_pack_col_a_t(M, K, src, K, dst, conv_gemm_conf_);
-
-                temp_buffer.SetDataType(DATA_TYPE_FLOAT);
-                buffer_weight_ = temp_buffer;
+                auto pack = [&](std::vector<RawBuffer> &buffers) {
+                    // align pointer of packed weights, since gemm use aligned load for input A
+                    RawBuffer temp_buffer(weight_pack_size * sizeof(float), 32);
+                    float *dst = temp_buffer.force_to<float *>();
+
+                    conv_pack_col_a_t(M, K, src, K, dst, conv_gemm_conf_);
+
+                    temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+                    buffers = {temp_buffer};
+                    return Status(TNN_OK);
+                };
+                std::vector<RawBuffer> buffers;
+                RETURN_ON_NEQ(GetSharedWeights(res->weight_handle, "inner_product_gemm", {K, M, k_c, m_block}, pack,
+                                               buffers),
+                              TNN_OK);
+                buffer_weight_ = buffers[0];
             } else {
                 LOGE("Error: DataType %d not support\n", res->weight_handle.GetDataType());
                 return Status(TNNERR_MODEL_ERR, "innerproduct res DataType is not supported");
@@ -163,12 +190,111 @@ Status X86InnerProductLayerAcc::allocateBufferBias(const std::vector<Blob *> &in
     return TNN_OK;
 }
 
+Status X86InnerProductLayerAcc::allocateBufferInt8(const std::vector<Blob *> &inputs,
+                                                  const std::vector<Blob *> &outputs) {
+    InnerProductLayerParam *param = dynamic_cast<InnerProductLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+    InnerProductLayerResource *res = dynamic_cast<InnerProductLayerResource *>(resource_);
+    CHECK_PARAM_NULL(res);
+
+    const int K = DimsVectorUtils::Count(inputs[0]->GetBlobDesc().dims, 1);
+    const int M = DimsVectorUtils::Count(outputs[0]->GetBlobDesc().dims, 1);
+    k_pad_      = ROUND_UP(K, X86_INT8_K_ALIGN);
+
+    if (!buffer_weight_.GetBytesSize()) {
+        auto pack = [&](std::vector<RawBuffer> &buffers) {
+            RawBuffer temp_buffer(M * k_pad_, 64);
+            RawBuffer comp_buffer(M * sizeof(int32_t));
+            X86Int8PackWeight(temp_buffer.force_to<int8_t *>(), comp_buffer.force_to<int32_t *>(),
+                              res->weight_handle.force_to<int8_t *>(), M, K, k_pad_);
+            buffers = {temp_buffer, comp_buffer};
+            return Status(TNN_OK);
+        };
+        std::vector<RawBuffer> buffers;
+        RETURN_ON_NEQ(GetSharedWeights(res->weight_handle, "inner_product_int8", {K, M, k_pad_}, pack, buffers),
+                      TNN_OK);
+        buffer_weight_ = buffers[0];
+        buffer_comp_   = buffers[1];
+    }
+
+    if (!buffer_bias_.GetBytesSize()) {
+        RawBuffer temp_buffer(M * sizeof(int32_t));
+        if (param->has_bias) {
+            memcpy(temp_buffer.force_to<int32_t *>(), res->bias_handle.force_to<int32_t *>(),
+                   res->bias_handle.GetBytesSize());
+        }
+        buffer_bias_ = temp_buffer;
+    }
+
+    if (!buffer_scale_.GetBytesSize()) {
+        const float *w_scale = res->scale_handle.force_to<float *>();
+        CHECK_PARAM_NULL(w_scale);
+        auto &o_scale_handle = reinterpret_cast<BlobInt8 *>(outputs[0])->GetIntResource()->scale_handle;
+        const float *o_scale = o_scale_handle.force_to<float *>();
+        int scale_len_w      = res->scale_handle.GetDataCount();
+        int scale_len_o      = o_scale_handle.GetDataCount();
+
+        RawBuffer temp_buffer(M * sizeof(float));
+        float *temp_ptr = temp_buffer.force_to<float *>();
+        for (int i = 0; i < M; i++) {
+            int w_scale_idx = scale_len_w == 1 ? 0 : i;
+            int o_scale_idx = scale_len_o == 1 ? 0 : i;
+            if (o_scale[o_scale_idx] >= FLT_MIN)
+                temp_ptr[i] = w_scale[w_scale_idx] / o_scale[o_scale_idx];
+            else
+                temp_ptr[i] = 0.0;
+        }
+        buffer_scale_ = temp_buffer;
+    }
+    return TNN_OK;
+}
+
+Status X86InnerProductLayerAcc::DoForwardInt8(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto input_dims  = inputs[0]->GetBlobDesc().dims;
+    auto output_dims = outputs[0]->GetBlobDesc().dims;
+    const int K      = DimsVectorUtils::Count(input_dims, 1);
+    const int N      = input_dims[0];
+    const int M      = DimsVectorUtils::Count(output_dims, 1);
+
+    // input rows padded to k_pad_, followed by the int32 gemm output of [M][N]
+    size_t in_size   = ROUND_UP(N * k_pad_, 64);
+    size_t work_size = in_size + M * N * sizeof(int32_t);
+    auto workspace   = reinterpret_cast<int8_t *>(context_->GetSharedWorkSpace(work_size));
+    auto input_pad   = workspace;
+    auto gemm_output = reinterpret_cast<int32_t *>(workspace + in_size);
+
+    auto input_data  = static_cast<int8_t *>(inputs[0]->GetHandle().base);
+    auto output_data = static_cast<int8_t *>(outputs[0]->GetHandle().base);
+    for (int n = 0; n < N; n++) {
+        memcpy(input_pad + n * k_pad_, input_data + n * K, K);
+        memset(input_pad + n * k_pad_ + K, 0, k_pad_ - K);
+    }
+
+    X86Int8Gemm(arch_, gemm_output, buffer_weight_.force_to<int8_t *>(), input_pad, buffer_comp_.force_to<int32_t *>(),
+                M, N, k_pad_, N);
+
+    auto bias  = buffer_bias_.force_to<int32_t *>();
+    auto scale = buffer_scale_.force_to<float *>();
+    for (int n = 0; n < N; n++) {
+        auto output_n = output_data + n * M;
+        OMP_PARALLEL_FOR_
+        for (int oc = 0; oc < M; oc++) {
+            output_n[oc] = float2int8((gemm_output[oc * N + n] + bias[oc]) * scale[oc]);
+        }
+    }
+    return TNN_OK;
+}
+
 Status X86InnerProductLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto param    = dynamic_cast<InnerProductLayerParam *>(param_);
     if (!param) {
         return Status(TNNERR_MODEL_ERR, "Error: InnerProductLayerParam is nil");
     }
 
+    if (outputs[0]->GetBlobDesc().data_type == DATA_TYPE_INT8) {
+        return DoForwardInt8(inputs, outputs);
+    }
+
     Blob *input_blob  = inputs[0];
     Blob *output_blob = outputs[0];
     auto input_dims   = inputs[0]->GetBlobDesc().dims;
@@ -184,10 +310,13 @@ Status X86InnerProductLayerAcc::DoForward(const std::vector<Blob *> &inputs, con
 
     auto X86SgemvFunc = X86Sgemv<Float4, 4>;
     void (*X86VecAddFunc)(float*, const float*, long) = X86_VectorAdd<Float4, 4>;
-    if (arch_ == avx2) {
+    if (arch_ >= avx2) {
         X86SgemvFunc = X86Sgemv<Float8, 8>;
         X86VecAddFunc = X86_VectorAdd<Float8, 8>;
     }
+    if (arch_ >= avx512) {
+        X86VecAddFunc = X86_VectorAdd<Float16, 16>;
+    }
     if (output_blob->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
         if (impl_ == InnerProductSgemv) {
             X86SgemvFunc(output_data, input_data, weight_data, bias_data, input_dims, output_dims);
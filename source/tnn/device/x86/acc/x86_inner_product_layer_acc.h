@@ -33,10 +33,17 @@ public:
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
     virtual Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
     virtual Status allocateBufferBias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    // pack int8 weights for X86Int8Gemm, with int32 bias and scales of weights divided by scales of output
+    virtual Status allocateBufferInt8(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
 protected:
+    Status DoForwardInt8(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
     RawBuffer buffer_weight_;
     RawBuffer buffer_bias_;
+    RawBuffer buffer_comp_;
+    RawBuffer buffer_scale_;
+    int k_pad_ = 0;
     conv_gemm_config<float, float, float> conv_gemm_conf_;
     InnerProductCompute impl_;
     std::shared_ptr<LayerResource> fc_acc_f32_resource_ = nullptr;
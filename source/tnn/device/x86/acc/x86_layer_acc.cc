@@ -14,6 +14,8 @@
 
 #include "tnn/device/x86/acc/x86_layer_acc.h"
 #include "tnn/utils/blob_transfer_utils.h"
+#include "tnn/utils/dims_utils.h"
+#include "tnn/utils/weight_cache_file.h"
 
 namespace TNN_NS {
 
@@ -29,13 +31,11 @@ Status X86LayerAcc::Init(Context *context, LayerParam *param, LayerResource *res
 
     RETURN_ON_NEQ(ReloadConstantBlobs(inputs, false), TNN_OK);
 
-    if (cpu_with_isa(avx2)) {
-        arch_ = avx2;
-    } else if (cpu_with_isa(sse42)) {
-        arch_ = sse42;
-    } else {
+    if (!cpu_with_isa(sse42)) {
         return Status(TNNERR_DEVICE_NOT_SUPPORT, "Cat not support X86 arch before SSE4.2");
     }
+    // kernels use the widest variant they have not beyond arch_
+    arch_ = X86Device::GetIsa();
 
     return Reshape(inputs, outputs);
 }
@@ -45,9 +45,74 @@ std::vector<DataFormat> X86LayerAcc::SupportDataFormat(DataType data_type, int d
     if (dims_size == 4) {
         support_list.push_back(DATA_FORMAT_NCHW);
     }
+    if (dims_size >= 2 && data_type == DATA_TYPE_FLOAT) {
+        support_list.push_back(DATA_FORMAT_NC8HW8);
+    }
     return support_list;
 }
 
+bool X86LayerAcc::NC8HW8Implemented(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return false;
+}
+
+static bool HasNC8HW8Blob(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    for (auto blobs : {&inputs, &outputs}) {
+        for (auto blob : *blobs) {
+            if (blob->GetBlobDesc().data_format == DATA_FORMAT_NC8HW8) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+Status X86LayerAcc::ForwardNC8HW8WithNCHW(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    std::vector<std::shared_ptr<Blob>> nchw_blobs;
+    std::vector<Blob *> nchw_inputs, nchw_outputs;
+    int index = 0;
+    for (auto blobs : {&inputs, &outputs}) {
+        bool is_input = blobs == &inputs;
+        for (auto blob : *blobs) {
+            auto desc = blob->GetBlobDesc();
+            if (desc.data_format != DATA_FORMAT_NC8HW8) {
+                (is_input ? nchw_inputs : nchw_outputs).push_back(blob);
+                continue;
+            }
+            if (desc.data_type != DATA_TYPE_FLOAT) {
+                return Status(TNNERR_LAYER_ERR, "X86LayerAcc only supports NC8HW8 blobs of float");
+            }
+
+            int bytes_size = DimsVectorUtils::Count(desc.dims) * sizeof(float);
+            if (nchw_buffers_.size() <= index) {
+                nchw_buffers_.resize(index + 1);
+            }
+            if (nchw_buffers_[index].GetBytesSize() < bytes_size) {
+                nchw_buffers_[index] = RawBuffer(bytes_size);
+            }
+            float *nchw_data = nchw_buffers_[index++].force_to<float *>();
+            if (is_input) {
+                UnpackNC8HW8(nchw_data, static_cast<float *>(blob->GetHandle().base), desc.dims);
+            }
+
+            desc.data_format = DATA_FORMAT_NCHW;
+            BlobHandle handle;
+            handle.base = nchw_data;
+            nchw_blobs.push_back(std::make_shared<Blob>(desc, handle));
+            (is_input ? nchw_inputs : nchw_outputs).push_back(nchw_blobs.back().get());
+        }
+    }
+
+    RETURN_ON_NEQ(this->DoForward(nchw_inputs, nchw_outputs), TNN_OK);
+
+    for (int i = 0; i < outputs.size(); ++i) {
+        if (nchw_outputs[i] != outputs[i]) {
+            PackNC8HW8(static_cast<float *>(outputs[i]->GetHandle().base),
+                       static_cast<float *>(nchw_outputs[i]->GetHandle().base), outputs[i]->GetBlobDesc().dims);
+        }
+    }
+    return TNN_OK;
+}
+
 Status X86LayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     Status status;
 #if TNN_PROFILE
@@ -56,7 +121,11 @@ Status X86LayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector
     timer.Start();
 #endif
 
-    status = this->DoForward(inputs, outputs);
+    if (HasNC8HW8Blob(inputs, outputs) && !NC8HW8Implemented(inputs, outputs)) {
+        status = ForwardNC8HW8WithNCHW(inputs, outputs);
+    } else {
+        status = this->DoForward(inputs, outputs);
+    }
 
 #if TNN_PROFILE
     pdata->kernel_time = timer.TimeEclapsed();
@@ -76,6 +145,44 @@ Status X86LayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vect
     return Status(TNNERR_LAYER_ERR, "DoForward not implement");
 }
 
+void X86LayerAcc::SetWeightsShared(bool shared) {
+    weights_shared_ = shared;
+}
+
+Status X86LayerAcc::GetSharedWeights(RawBuffer &source, const std::string &name, const std::vector<int> &params,
+                                     const SharedWeightCache::PackFunction &pack, std::vector<RawBuffer> &buffers) {
+    std::string key = "x86_" + name + "_" + std::to_string((int)arch_);
+    for (auto param : params) {
+        key += "_" + std::to_string(param);
+    }
+
+    // the weights packed by earlier processes are read from the cache file of the network if any
+    SharedWeightCache::PackFunction cached_pack = pack;
+    auto weight_cache_file = context_->GetWeightCacheFile();
+    if (weight_cache_file) {
+        std::string file_key = param_->name + "_" + key + "_" + std::to_string(source.GetBytesSize());
+        cached_pack          = [=](SharedWeightCache::Buffers &packed) -> Status {
+            if (weight_cache_file->Find(file_key, packed)) {
+                return TNN_OK;
+            }
+            RETURN_ON_NEQ(pack(packed), TNN_OK);
+            weight_cache_file->Add(file_key, packed);
+            return TNN_OK;
+        };
+    }
+
+    if (!weights_shared_) {
+        return cached_pack(buffers);
+    }
+
+    std::shared_ptr<SharedWeightCache::Buffers> shared = nullptr;
+    RETURN_ON_NEQ(SharedWeightCache::Get(source, key, cached_pack, shared), TNN_OK);
+    shared_weights_.push_back(shared);
+    // RawBuffer copies share the data
+    buffers = *shared;
+    return TNN_OK;
+}
+
 Status X86LayerAcc::ReloadConstantBlobs(const std::vector<Blob *> &inputs, bool only_reload_shape_differ_blob) {
     auto const_resource = const_resource_;
     auto const_resource_flag = const_resource_flag_;
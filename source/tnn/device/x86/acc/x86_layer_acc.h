@@ -15,6 +15,7 @@
 #ifndef TNN_SOURCE_TNN_DEVICE_X86_X86_LAYER_ACC_H_
 #define TNN_SOURCE_TNN_DEVICE_X86_X86_LAYER_ACC_H_
 
+#include <string>
 #include <vector>
 
 #include "tnn/core/abstract_layer_acc.h"
@@ -22,6 +23,7 @@
 #include "tnn/device/x86/x86_util.h"
 #include "tnn/device/x86/x86_context.h"
 #include "tnn/device/x86/acc/compute/jit/utils/cpu_isa.h"
+#include "tnn/utils/shared_weight_cache.h"
 
 namespace TNN_NS {
 
@@ -44,17 +46,39 @@ public:
     // Note: this func may cost much time, call this func only when necessary.
     virtual Status ReloadConstantBlobs(const std::vector<Blob *> &inputs, bool only_reload_shape_differ_blob = false);
 
+    // @brief return true if DoForward computes the NC8HW8 blobs directly. Otherwise Forward unpacks the
+    // NC8HW8 inputs to NCHW before DoForward and packs the outputs after it.
+    virtual bool NC8HW8Implemented(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    // @brief share packed weights with other instances of the model, disable it if the
+    // resource is converted by the acc and freed after packing
+    void SetWeightsShared(bool shared);
+
 #if TNN_PROFILE
     Timer timer;
 #endif
 
 protected:
+    // @brief get the weights packed from source, shared with the accs of other instances of the model.
+    // name and params describe the packing, arch_ is added to the key
+    Status GetSharedWeights(RawBuffer &source, const std::string &name, const std::vector<int> &params,
+                            const SharedWeightCache::PackFunction &pack, std::vector<RawBuffer> &buffers);
+
     LayerParam* param_          = nullptr;
     LayerResource* resource_    = nullptr;
     X86Context *context_           = nullptr;
     x86_isa_t arch_;
+    bool weights_shared_        = true;
 
 private:
+    // @brief run DoForward on NCHW copies of the NC8HW8 blobs
+    Status ForwardNC8HW8WithNCHW(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    // keep the shared weights alive
+    std::vector<std::shared_ptr<SharedWeightCache::Buffers>> shared_weights_;
+    // NCHW data of the NC8HW8 blobs, inputs first
+    std::vector<RawBuffer> nchw_buffers_;
+
     // @brief return device layer acc support data format
     virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size, BlobType blob_type);
 };
@@ -70,6 +94,9 @@ private:
     X86TypeLayerAccRegister<TypeLayerAccCreator<X86##type_string##LayerAcc>> g_x86_##layer_type##_acc_register( \
         layer_type);                                                                                            \
 
+#define REGISTER_X86_LAYOUT(layer_type, layout)                                                                    \
+    X86TypeLayerLayoutRegister g_x86_##layer_type##_##layout##_layout_register(layer_type, layout);
+
 } // TNN_NS
 
 #endif // TNN_SOURCE_TNN_DEVICE_X86_X86_LAYER_ACC_H_
\ No newline at end of file
@@ -24,8 +24,8 @@ namespace TNN_NS {
 DECLARE_X86_ACC(LayerNorm, LAYER_LAYER_NORM);
 
 template <typename VEC, int pack>
-static void norm_func(float *input, float *output, int channels, int area, const float *k_data, const float *b_data,
-                      float ep) {
+static X86_INLINE void norm_func(float *input, float *output, int channels, int area, const float *k_data,
+                                 const float *b_data, float ep) {
     float *input_data  = input;
     float *output_data = output;
     for (int c = 0; c < channels; c++) {
@@ -85,6 +85,16 @@ static void norm_func(float *input, float *output, int channels, int area, const
     }
 }
 
+static void norm_func_sse(float *input, float *output, int channels, int area, const float *k_data,
+                          const float *b_data, float ep) {
+    norm_func<Float4, 4>(input, output, channels, area, k_data, b_data, ep);
+}
+
+static X86_AVX2_TARGET void norm_func_avx2(float *input, float *output, int channels, int area, const float *k_data,
+                                           const float *b_data, float ep) {
+    norm_func<Float8, 8>(input, output, channels, area, k_data, b_data, ep);
+}
+
 Status X86LayerNormLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto layer_param = dynamic_cast<LayerNormLayerParam *>(param_);
     auto input_blob  = inputs[0];
@@ -109,9 +119,9 @@ Status X86LayerNormLayerAcc::DoForward(const std::vector<Blob *> &inputs, const
 
     const float epsilon = layer_param->eps;
 
-    auto func = norm_func<Float8, 8>;
-    if (arch_ == sse42) {
-        func = norm_func<Float4, 4>;
+    auto func = norm_func_sse;
+    if (arch_ >= avx2) {
+        func = norm_func_avx2;
     }
 
     if (output_blob->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
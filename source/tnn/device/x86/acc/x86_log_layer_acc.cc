@@ -27,7 +27,7 @@ typedef struct x86_log_operator : x86_unary2_operator {
         return Float4::log(v);
     }
 
-    virtual Float8 operator()(const Float8 &v) {
+    X86_AVX2_TARGET virtual Float8 operator()(const Float8 &v) {
         return Float8::log(v);
     }
 } X86_LOG_OP;
@@ -36,5 +36,6 @@ X86_REGISTER_UNARY2_KERNEL(LAYER_LOG, avx2, unary2_kernel_avx<X86_LOG_OP>);
 X86_REGISTER_UNARY2_KERNEL(LAYER_LOG, sse42, unary2_kernel_sse<X86_LOG_OP>);
 DECLARE_X86_UNARY2_ACC(Log, LAYER_LOG);
 REGISTER_X86_ACC(Log, LAYER_LOG);
+REGISTER_X86_LAYOUT(LAYER_LOG, DATA_FORMAT_NC8HW8);
 
 }   // namespace TNN_NS
\ No newline at end of file
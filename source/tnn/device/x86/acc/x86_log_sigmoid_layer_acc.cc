@@ -27,7 +27,7 @@ typedef struct x86_log_sigmoid_operator : x86_unary2_operator {
         return Float4::log(Float4::sigmoid(v));
     }
 
-    virtual Float8 operator()(const Float8 &v) {
+    X86_AVX2_TARGET virtual Float8 operator()(const Float8 &v) {
         return Float8::log(Float8::sigmoid(v));
     }
 } X86_LOGSIGMOID_OP;
@@ -36,5 +36,6 @@ X86_REGISTER_UNARY2_KERNEL(LAYER_LOGSIGMOID, avx2, unary2_kernel_avx<X86_LOGSIGM
 X86_REGISTER_UNARY2_KERNEL(LAYER_LOGSIGMOID, sse42, unary2_kernel_sse<X86_LOGSIGMOID_OP>);
 DECLARE_X86_UNARY2_ACC(LogSigmoid, LAYER_LOGSIGMOID);
 REGISTER_X86_ACC(LogSigmoid, LAYER_LOGSIGMOID);
+REGISTER_X86_LAYOUT(LAYER_LOGSIGMOID, DATA_FORMAT_NC8HW8);
 
 }   // namespace TNN_NS
\ No newline at end of file
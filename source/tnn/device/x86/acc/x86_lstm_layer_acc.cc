@@ -17,6 +17,7 @@
 #include "tnn/utils/dims_vector_utils.h"
 #include "tnn/device/x86/acc/x86_lstm_layer_acc.h"
 #include "tnn/device/x86/acc/Float4.h"
+#include "tnn/utils/omp_utils.h"
 
 namespace TNN_NS {
 
@@ -62,10 +63,7 @@ static void X86LSTMActivate(const float *gates, float *h_t, float *c_t, float *y
 
 Status X86LSTMONNXLayerAcc::LSTMOneDirection(const float *x, float *y, const float *w, const float *r,
                               const float *b, float *h_t, float *c_t, int seq_len, int batch_size,
-                              int input_size, int hidden_size, int reverse) {
-    int k_c = conv_gemm_conf_.K_c_;
-    int n_block = conv_gemm_conf_.n_block_;
-
+                              int input_size, int hidden_size, int reverse, float *workspace) {
     // sgemm for weight tensor
     // weights: [4*hidden_size, input_size]
     // inputs: [seq_len, batch, input_size]
@@ -73,18 +71,15 @@ Status X86LSTMONNXLayerAcc::LSTMOneDirection(const float *x, float *y, const flo
     int N = seq_len * batch_size;
     int M = 4 * hidden_size;
 
-    // two temp buf: gemm_buf and gates_buf
-    size_t gemm_buf_size = ROUND_UP(k_c * ROUND_UP(N, n_block) * sizeof(float), 32);
+    // gates_buf and gemm_buf of the direction, see GetDirectionWorkspaceSize
     size_t gates_buf_size = ROUND_UP(N * M * sizeof(float), 32);
-    size_t workspace_size = gemm_buf_size + gates_buf_size;
-    float *workspace = reinterpret_cast<float *>(context_->GetSharedWorkSpace(workspace_size));
-    float *gemm_buf = workspace;
-    float *gates_buf = workspace + gemm_buf_size / sizeof(float);
+    float *gates_buf = workspace;
+    float *gemm_buf = workspace + gates_buf_size / sizeof(float);
+    // zero bias at the head of workspace_, the gate bias is added for each step below
+    float *zero_bias = workspace_.force_to<float *>();
 
-    RawBuffer fake_bias(N * sizeof(float));
-    float *fake_bias_ptr = fake_bias.force_to<float *>();
     conv_sgemm_tn_col_major_prepack_a(M, N, K, w, K, x, K, gates_buf, M,
-            fake_bias_ptr, ActivationType_None, gemm_buf, conv_gemm_conf_);
+            zero_bias, ActivationType_None, gemm_buf, conv_gemm_conf_);
     
     for (int t = 0; t < seq_len; t++) {
         int ti = reverse ? seq_len - 1 - t : t;
@@ -116,6 +111,16 @@ Status X86LSTMONNXLayerAcc::LSTMOneDirection(const float *x, float *y, const flo
     return TNN_OK;
 }
 
+size_t X86LSTMONNXLayerAcc::GetDirectionWorkspaceSize(int seq_len, int batch_size, int hidden_size) {
+    int k_c = conv_gemm_conf_.K_c_;
+    int n_block = conv_gemm_conf_.n_block_;
+    int N = seq_len * batch_size;
+    size_t gates_buf_size = ROUND_UP(N * 4 * hidden_size * sizeof(float), 32);
+    // the gemm of the input is the larger one, the recurrence gemm reuses the buffer
+    size_t gemm_buf_size = ROUND_UP(k_c * ROUND_UP(N, n_block) * sizeof(float), 32);
+    return gates_buf_size + gemm_buf_size;
+}
+
 X86LSTMONNXLayerAcc::~X86LSTMONNXLayerAcc() {}
 
 Status X86LSTMONNXLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
@@ -133,6 +138,28 @@ Status X86LSTMONNXLayerAcc::Init(Context *context, LayerParam *param, LayerResou
     return TNN_OK;
 }
 
+Status X86LSTMONNXLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto layer_param = dynamic_cast<LSTMONNXLayerParam *>(param_);
+    int num_directions = layer_param->direction >= 2 ? 2 : 1;
+    const auto input_dims = inputs[0]->GetBlobDesc().dims;
+    const int T = input_dims[0];
+    const int batch = input_dims[1];
+    const int hidden_size = layer_param->hidden_size;
+
+    // [zero bias][temp y of bidirection][direction 0][direction 1]
+    size_t zero_bias_size = ROUND_UP(T * batch * sizeof(float), 32);
+    size_t y_temp_size = num_directions == 2 ? ROUND_UP(2 * T * batch * hidden_size * sizeof(float), 32) : 0;
+    size_t workspace_size = zero_bias_size + y_temp_size +
+                            num_directions * GetDirectionWorkspaceSize(T, batch, hidden_size);
+    if (workspace_.GetBytesSize() < workspace_size) {
+        workspace_ = RawBuffer(workspace_size, 32);
+    }
+    // the layout moves with the shape, the zero bias may be taken by the buffers of a smaller one before
+    memset(workspace_.force_to<void *>(), 0, zero_bias_size);
+
+    return X86LayerAcc::Reshape(inputs, outputs);
+}
+
 Status X86LSTMONNXLayerAcc::allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     // weights for gates, [num_direction, 4 * hidden_size, input_size]
     auto w_dims = inputs[1]->GetBlobDesc().dims;
@@ -237,7 +264,6 @@ Status X86LSTMONNXLayerAcc::DoForward(const std::vector<Blob *> &inputs, const s
     auto layer_param = dynamic_cast<LSTMONNXLayerParam *>(param_);
     int num_directions = layer_param->direction >=2 ? 2 : 1;
     
-    bool reverse = false;
     if (inputs.size() < 4) {
         return Status(TNNERR_LAYER_ERR, "LSTM has invalid inputs");
     }
@@ -253,7 +279,6 @@ Status X86LSTMONNXLayerAcc::DoForward(const std::vector<Blob *> &inputs, const s
     const auto T = input_dims[0]; // length of sequence
     const auto batch = input_dims[1];  // batch_size
     const auto input_size = DimsVectorUtils::Count(input_dims, 2); // input dimension
-    const auto output_dims = outputs[0]->GetBlobDesc().dims;
     const auto hidden_size = layer_param->hidden_size; // output dimension
     // block size for gemm
     int k_c = conv_gemm_conf_.K_c_;
@@ -277,37 +302,68 @@ Status X86LSTMONNXLayerAcc::DoForward(const std::vector<Blob *> &inputs, const s
     
     //B[iofc] Concatenation of [Wb[iofc], Rb[iofc]], [num_directions, 8*hidden_size]
     float *b = (float *)buffer_b_.force_to<float *>();
+
+    //stateful lstm starts from h and c of the last forward, the initial values are used after reset only
+    const int state_count = num_directions * batch * hidden_size;
+    float *state = nullptr;
+    bool state_created = true;
+    if (layer_param->stateful) {
+        state = (float *)context_->GetLayerState(layer_param->name, 2 * state_count * sizeof(float), &state_created);
+    }
     
     //initial_h, initial value of the hidden, If not specified - assumed to be 0. shape [num_directions, batch_size, hidden_size]
     auto h_t = (float *)((char*)(outputs[1]->GetHandle().base) + outputs[1]->GetHandle().bytes_offset);
     //initial_c, initial value of the cell, If not specified - assumed to be 0. shape [num_directions, batch_size, hidden_size]
     auto c_t = (float *)((char*)(outputs[2]->GetHandle().base) + outputs[2]->GetHandle().bytes_offset);
 
-    if (inputs.size() >= 6) {
+    if (!state_created) {
+        memcpy((void *)h_t, state, state_count * sizeof(float));
+        memcpy((void *)c_t, state + state_count, state_count * sizeof(float));
+    } else if (inputs.size() >= 6) {
         auto h_0 = (float *)((char*)(blob_h0->GetHandle().base) + blob_h0->GetHandle().bytes_offset);
         auto c_0 = (float *)((char*)(blob_c0->GetHandle().base) + blob_c0->GetHandle().bytes_offset);
-        memcpy((void *)h_t, h_0, num_directions * batch * hidden_size * sizeof(float));
-        memcpy((void *)c_t, c_0, num_directions * batch * hidden_size * sizeof(float));
+        memcpy((void *)h_t, h_0, state_count * sizeof(float));
+        memcpy((void *)c_t, c_0, state_count * sizeof(float));
     } else {
-        memset((void *)h_t, 0, num_directions * batch * hidden_size * sizeof(float));
-        memset((void *)c_t, 0, num_directions * batch * hidden_size * sizeof(float));
+        memset((void *)h_t, 0, state_count * sizeof(float));
+        memset((void *)c_t, 0, state_count * sizeof(float));
     }
-    
+
+    // see Reshape for the layout of workspace_
+    size_t zero_bias_size = ROUND_UP(T * batch * sizeof(float), 32);
+    size_t y_temp_size = num_directions == 2 ? ROUND_UP(2 * T * batch * hidden_size * sizeof(float), 32) : 0;
+    size_t direction_workspace_size = GetDirectionWorkspaceSize(T, batch, hidden_size);
+    float *y_temp = workspace_.force_to<float *>() + zero_bias_size / sizeof(float);
+    float *direction_workspace = y_temp + y_temp_size / sizeof(float);
+
     if (layer_param->direction == 0 || layer_param->direction == 1) {
-        return LSTMOneDirection(x, y, w, r, b, h_t, c_t, T, batch, input_size, hidden_size, layer_param->direction);
+        RETURN_ON_NEQ(LSTMOneDirection(x, y, w, r, b, h_t, c_t, T, batch, input_size, hidden_size,
+                                       layer_param->direction, direction_workspace), TNN_OK);
     } else if (layer_param->direction == 2) {
         //Y shape [num_directions sequence batch_size hidden_size]
-        auto y_temp = std::shared_ptr<float>(new float[num_directions*T*batch*hidden_size], [](float* p) { delete[] p; });
-        auto y0 = y_temp.get();
+        auto y0 = y_temp;
         auto y1 = y0 + T * batch * hidden_size;
-        LSTMOneDirection(x, y0, w, r, b, h_t, c_t, T, batch, input_size, hidden_size, 0);
-        
         auto w1 = w + w_pack_size;
         auto r1 = r + r_pack_size;
         auto b1 = b + 4 * hidden_size;
         auto h_t1 = h_t + batch * hidden_size;
         auto c_t1 = c_t + batch * hidden_size;
-        LSTMOneDirection(x, y1, w1, r1, b1, h_t1, c_t1, T, batch, input_size, hidden_size, 1);
+        auto workspace1 = direction_workspace + direction_workspace_size / sizeof(float);
+
+        // the two directions only share the inputs, run them concurrently
+        Status status0 = TNN_OK, status1 = TNN_OK;
+        OMP_PARALLEL_SECTIONS_ {
+            OMP_SECTION_ {
+                status0 = LSTMOneDirection(x, y0, w, r, b, h_t, c_t, T, batch, input_size, hidden_size, 0,
+                                           direction_workspace);
+            }
+            OMP_SECTION_ {
+                status1 = LSTMOneDirection(x, y1, w1, r1, b1, h_t1, c_t1, T, batch, input_size, hidden_size, 1,
+                                           workspace1);
+            }
+        }
+        RETURN_ON_NEQ(status0, TNN_OK);
+        RETURN_ON_NEQ(status1, TNN_OK);
         
         //transpose [num_directions sequence batch_size hidden_size] to [sequence batch_size num_directions*hidden_size]
         for (int i = 0; i < T*batch; i++) {
@@ -322,6 +378,11 @@ Status X86LSTMONNXLayerAcc::DoForward(const std::vector<Blob *> &inputs, const s
         return Status(TNNERR_PARAM_ERR, "LSTMONNX has invalid direction param");
     }
 
+    if (state) {
+        memcpy(state, h_t, state_count * sizeof(float));
+        memcpy(state + state_count, c_t, state_count * sizeof(float));
+    }
+
     return TNN_OK;
 }
 
@@ -26,17 +26,22 @@ public:
 
     Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
                 const std::vector<Blob *> &outputs) override;
+    virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
     virtual Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
     virtual Status allocateBufferBias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 protected:
     Status LSTMOneDirection(const float *x, float *y, const float *w, const float *r,
                            const float *b, float *h_t, float *c_t, int seq_len, int batch_size,
-                           int input_size, int hidden_size, int reverse);
+                           int input_size, int hidden_size, int reverse, float *workspace);
+    // @brief bytes of the gates and gemm buffers of one direction
+    size_t GetDirectionWorkspaceSize(int seq_len, int batch_size, int hidden_size);
 
     RawBuffer buffer_w_;
     RawBuffer buffer_r_;
     RawBuffer buffer_b_;
+    // gates and gemm buffers of each direction, zero bias and temp y, kept across forwards
+    RawBuffer workspace_;
     conv_gemm_config<float, float, float> conv_gemm_conf_;
 };
 
@@ -14,34 +14,118 @@
 
 #include "tnn/device/x86/acc/x86_layer_acc.h"
 #include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/omp_utils.h"
 #include "tnn/device/x86/acc/x86_mat_mul_layer_acc.h"
 
 namespace TNN_NS {
 
 X86MatMulLayerAcc::~X86MatMulLayerAcc() {}
 
-Status X86MatMulLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
-    auto param               = dynamic_cast<MatMulLayerParam *>(param_);
-    auto resource            = dynamic_cast<MatMulLayerResource *>(resource_);
-    DimsVector matrix_a_dims = param->matrix_a_dims;
-    DimsVector matrix_b_dims = param->matrix_b_dims;
+static void GetMatrixDims(MatMulLayerParam *param, DimsVector &matrix_a_dims, DimsVector &matrix_b_dims) {
+    matrix_a_dims = param->matrix_a_dims;
+    matrix_b_dims = param->matrix_b_dims;
     if (matrix_a_dims.size() == 1) {
         matrix_a_dims.insert(matrix_a_dims.begin(), 1);
     }
     if (matrix_b_dims.size() == 1) {
         matrix_b_dims.push_back(1);
     }
+}
+
+Status X86MatMulLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
+                               const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    RETURN_ON_NEQ(X86LayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
+    return allocateBufferWeight(inputs, outputs);
+}
+
+/*
+ * row major A[N * K] * B[K * M] = C[N * M] is computed as col major B[M * K] * A[K * N] = C[M * N],
+ * a constant B is packed as the col major gemm input a, a constant A as the col major gemm input b.
+ */
+Status X86MatMulLayerAcc::allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param    = dynamic_cast<MatMulLayerParam *>(param_);
+    auto resource = dynamic_cast<MatMulLayerResource *>(resource_);
+    CHECK_PARAM_NULL(param);
+
+    if (inputs.size() != 1 || !resource || resource->weight.GetDataType() != DATA_TYPE_FLOAT ||
+        buffer_weight_.GetBytesSize()) {
+        return TNN_OK;
+    }
+
+    DimsVector matrix_a_dims, matrix_b_dims;
+    GetMatrixDims(param, matrix_a_dims, matrix_b_dims);
+    if (matrix_a_dims.size() < 2 || matrix_b_dims.size() < 2) {
+        return TNN_OK;
+    }
+
+    int M = matrix_b_dims[matrix_b_dims.size() - 1];
+    int K = matrix_a_dims[matrix_a_dims.size() - 1];
+    int N = matrix_a_dims[matrix_a_dims.size() - 2];
+
+    const float *weight = resource->weight.force_to<float *>();
+    int weight_count    = resource->weight.GetDataCount();
+
+    if (param->weight_position == 1) {
+        weight_pack_size_ = ROUND_UP(K, conv_gemm_conf_.K_c_) * ROUND_UP(M, conv_gemm_conf_.m_block_);
+    } else if (param->weight_position == 0) {
+        weight_pack_size_ = ROUND_UP(K, conv_gemm_conf_.K_c_) * ROUND_UP(N, conv_gemm_conf_.n_block_);
+    } else {
+        return Status(TNNERR_INVALID_MODEL, "MatMul weight position is error");
+    }
+
+    int batch_w = weight_count / (M * K);
+    if (param->weight_position == 0) {
+        batch_w = weight_count / (N * K);
+    }
+
+    auto pack = [&](std::vector<RawBuffer> &buffers) {
+        // align pointer of packed weights, since gemm use aligned load for input a
+        RawBuffer temp_buffer(batch_w * weight_pack_size_ * sizeof(float), 32);
+        float *dst = temp_buffer.force_to<float *>();
+        for (int b = 0; b < batch_w; ++b) {
+            if (param->weight_position == 1) {
+                conv_pack_col_a_n(M, K, weight + b * M * K, M, dst + b * weight_pack_size_, conv_gemm_conf_);
+            } else {
+                conv_pack_col_b_n(N, K, weight + b * N * K, K, dst + b * weight_pack_size_, conv_gemm_conf_);
+            }
+        }
+        temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+        buffers = {temp_buffer};
+        return Status(TNN_OK);
+    };
+    std::vector<RawBuffer> buffers;
+    RETURN_ON_NEQ(GetSharedWeights(resource->weight, "mat_mul",
+                                   {param->weight_position, M, N, K, conv_gemm_conf_.K_c_, conv_gemm_conf_.m_block_,
+                                    conv_gemm_conf_.n_block_},
+                                   pack, buffers),
+                  TNN_OK);
+    buffer_weight_ = buffers[0];
+
+    return TNN_OK;
+}
+
+Status X86MatMulLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param               = dynamic_cast<MatMulLayerParam *>(param_);
+    auto resource            = dynamic_cast<MatMulLayerResource *>(resource_);
+    DimsVector matrix_a_dims, matrix_b_dims;
+    GetMatrixDims(param, matrix_a_dims, matrix_b_dims);
     DataType data_type       = inputs[0]->GetBlobDesc().data_type;
     auto matrix_c_dims       = outputs[0]->GetBlobDesc().dims;
     if (data_type == DATA_TYPE_FLOAT) {
         float *matrix_a;
         float *matrix_b;
 
+        // 0: no constant operand, 1: B is prepacked as gemm input a, 2: A is prepacked as gemm input b
+        int prepacked = 0;
         if (inputs.size() == 2) {
             matrix_a = static_cast<float *>(inputs[0]->GetHandle().base);
             matrix_b = static_cast<float *>(inputs[1]->GetHandle().base);
         } else {
             auto weight = resource->weight.force_to<float *>();
+            if (buffer_weight_.GetBytesSize()) {
+                weight    = buffer_weight_.force_to<float *>();
+                prepacked = param->weight_position == 1 ? 1 : 2;
+            }
             matrix_a    = param->weight_position == 0 ? weight : static_cast<float *>(inputs[0]->GetHandle().base);
             matrix_b    = param->weight_position == 1 ? weight : static_cast<float *>(inputs[0]->GetHandle().base);
         }
@@ -49,38 +133,70 @@ Status X86MatMulLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std
 
         int k_c = conv_gemm_conf_.K_c_;
         int m_c = conv_gemm_conf_.M_c_;
+        int m_block = conv_gemm_conf_.m_block_;
         int n_block = conv_gemm_conf_.n_block_;
 
         int M = matrix_b_dims[matrix_b_dims.size() - 1];
         int K = matrix_a_dims[matrix_a_dims.size() - 1];
         int N = matrix_a_dims[matrix_a_dims.size() - 2];
 
-        size_t pack_a_size = ROUND_UP(m_c * k_c * sizeof(float), 32);
-        size_t pack_b_size = k_c * ROUND_UP(N, n_block) * sizeof(float);
-        size_t workspace_size = pack_a_size + pack_b_size;
-        float *workspace = reinterpret_cast<float *>(context_->GetSharedWorkSpace(workspace_size));
-
-        RawBuffer fake_bias(N * sizeof(float));
-        float *fake_bias_ptr = fake_bias.force_to<float *>();
-
         int count_a     = DimsVectorUtils::Count(matrix_a_dims);
         int count_b     = DimsVectorUtils::Count(matrix_b_dims);
         int count_c     = DimsVectorUtils::Count(matrix_c_dims);
         int batch_a   = count_a / (K * N);
         int batch_b   = count_b / (M * K);
         int batch_c   = count_c / (M * N);
-        for (int bc = 0; bc < batch_c; ++bc) {
+
+        // split each matrix into slices computed in parallel with the other batches, M is split if A is
+        // prepacked, N otherwise, so that a few large matrices still use all threads
+        const int threads = OMP_MAX_THREADS_NUM_;
+        const int split_len  = prepacked == 2 ? M : N;
+        const int split_unit = prepacked == 2 ? m_block : n_block;
+        int split_num        = std::min(UP_DIV(split_len, split_unit), UP_DIV(threads, batch_c));
+        int slice_len        = ROUND_UP(UP_DIV(split_len, split_num), split_unit);
+        split_num            = UP_DIV(split_len, slice_len);
+
+        size_t pack_a_size = prepacked == 1 ? 0 : ROUND_UP(m_c * k_c * sizeof(float), 32);
+        size_t pack_b_size = prepacked == 2 ? 0 : ROUND_UP(k_c * ROUND_UP(slice_len, n_block) * sizeof(float), 32);
+        size_t thread_workspace_size = pack_a_size + pack_b_size;
+        char *workspace = reinterpret_cast<char *>(context_->GetSharedWorkSpace(thread_workspace_size * threads));
+
+        if (buffer_zero_bias_.GetBytesSize() < N * sizeof(float)) {
+            buffer_zero_bias_ = RawBuffer(N * sizeof(float));
+        }
+        float *zero_bias_ptr = buffer_zero_bias_.force_to<float *>();
+
+        OMP_PARALLEL_FOR_
+        for (int task = 0; task < batch_c * split_num; ++task) {
+            int bc = task / split_num;
+            int s  = task % split_num;
             int ba = bc < batch_a ? bc : 0;
             int bb = bc < batch_b ? bc : 0;
-            auto a_ptr = matrix_a + ba * K * N;
-            auto b_ptr = matrix_b + bb * M * K;
             auto c_ptr = matrix_c + bc * M * N;
+            auto thread_workspace = reinterpret_cast<float *>(workspace + OMP_TID_ * thread_workspace_size);
+
+            int begin = s * slice_len;
+            int len   = std::min(split_len - begin, slice_len);
 
             // row major A[N * K] * B[K * M] = C[N * M]
             // equals to
             // col major B[M * K] * A[K * N] = C[M * N]
-            conv_sgemm_nn_col_major(M, N, K, b_ptr, M, a_ptr, K, c_ptr, M,
-                fake_bias_ptr, ActivationType_None, workspace, conv_gemm_conf_);
+            if (prepacked == 1) {
+                auto a_ptr = matrix_a + ba * K * N;
+                auto b_ptr = matrix_b + bb * weight_pack_size_;
+                conv_sgemm_nn_col_major_prepack_a(M, len, K, b_ptr, M, a_ptr + begin * K, K, c_ptr + begin * M, M,
+                    zero_bias_ptr, ActivationType_None, thread_workspace, conv_gemm_conf_);
+            } else if (prepacked == 2) {
+                auto a_ptr = matrix_a + ba * weight_pack_size_;
+                auto b_ptr = matrix_b + bb * M * K;
+                conv_sgemm_nn_col_major_prepack_b(len, N, K, b_ptr + begin, M, a_ptr, K, c_ptr + begin, M,
+                    zero_bias_ptr, ActivationType_None, thread_workspace, conv_gemm_conf_);
+            } else {
+                auto a_ptr = matrix_a + ba * K * N;
+                auto b_ptr = matrix_b + bb * M * K;
+                conv_sgemm_nn_col_major(M, len, K, b_ptr, M, a_ptr + begin * K, K, c_ptr + begin * M, M,
+                    zero_bias_ptr, ActivationType_None, thread_workspace, conv_gemm_conf_);
+            }
         }
     }
 
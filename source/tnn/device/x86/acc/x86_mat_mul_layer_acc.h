@@ -23,10 +23,20 @@ class X86MatMulLayerAcc : public X86LayerAcc {
 public:
     virtual ~X86MatMulLayerAcc();
 
+    Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
+                const std::vector<Blob *> &outputs) override;
+
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
 
+    // @brief pack the constant weight once into the gemm panel layout, for each of its leading dims
+    virtual Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
 protected:
     conv_gemm_config<float, float, float> conv_gemm_conf_;
+    RawBuffer buffer_weight_;
+    // floats of one packed weight matrix in buffer_weight_
+    size_t weight_pack_size_ = 0;
+    RawBuffer buffer_zero_bias_;
 };
 
 }  // namespace TNN_NS
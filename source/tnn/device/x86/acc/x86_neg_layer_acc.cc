@@ -27,7 +27,7 @@ typedef struct x86_neg_operator : x86_unary2_operator {
         return Float4::neg(v);
     }
 
-    virtual Float8 operator()(const Float8 &v) {
+    X86_AVX2_TARGET virtual Float8 operator()(const Float8 &v) {
         return Float8::neg(v);
     }
 } X86_NEG_OP;
@@ -36,5 +36,6 @@ X86_REGISTER_UNARY2_KERNEL(LAYER_NEG, avx2, unary2_kernel_avx<X86_NEG_OP>);
 X86_REGISTER_UNARY2_KERNEL(LAYER_NEG, sse42, unary2_kernel_sse<X86_NEG_OP>);
 DECLARE_X86_UNARY2_ACC(Neg, LAYER_NEG);
 REGISTER_X86_ACC(Neg, LAYER_NEG);
+REGISTER_X86_LAYOUT(LAYER_NEG, DATA_FORMAT_NC8HW8);
 
 }   // namespace TNN_NS
\ No newline at end of file
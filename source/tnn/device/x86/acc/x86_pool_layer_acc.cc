@@ -19,9 +19,11 @@
 #include "tnn/device/x86/x86_util.h"
 
 #include "tnn/device/x86/acc/compute/x86_compute.h"
+#include "tnn/device/x86/acc/compute/x86_compute_int8.h"
 #include "tnn/device/x86/acc/x86_pool_layer_acc.h"
 #include "tnn/device/x86/acc/Float8.h"
 #include "tnn/device/x86/acc/Float4.h"
+#include "tnn/utils/omp_utils.h"
 
 namespace TNN_NS {
 
@@ -51,6 +53,11 @@ Status X86PoolLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::ve
     return TNN_OK;
 }
 
+// NC8HW8 blocks are the packed data of the avx2 kernels
+bool X86PoolLayerAcc::NC8HW8Implemented(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return arch_ >= avx2 && inputs[0]->GetBlobDesc().data_format == outputs[0]->GetBlobDesc().data_format;
+}
+
 Status X86PoolLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto param = dynamic_cast<PoolingLayerParam *>(param_);
     if (!param) {
@@ -69,12 +76,28 @@ Status X86PoolLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::
     auto input_ptr  = static_cast<float *>(input->GetHandle().base);
     auto output_ptr = static_cast<float *>(output->GetHandle().base);
 
+    if (output->GetBlobDesc().data_type == DATA_TYPE_INT8) {
+        // int8 data is nchw, each channel is pooled by one thread
+        auto src      = static_cast<int8_t *>(input->GetHandle().base);
+        auto dst      = static_cast<int8_t *>(output->GetHandle().base);
+        auto PoolFunc = param->pool_type == 0 ? X86MaxPoolingInt8 : X86AvgPoolingInt8;
+        size_t src_hw = dims_input[3] * dims_input[2];
+        size_t dst_hw = dims_output[3] * dims_output[2];
+        OMP_PARALLEL_FOR_
+        for (int bc = 0; bc < batch * dims_output[1]; bc++) {
+            PoolFunc(dst + bc * dst_hw, src + bc * src_hw, dims_input[2], dims_input[3], dims_output[2],
+                     dims_output[3], param->kernels[1], param->kernels[0], param->strides[1], param->strides[0],
+                     param->pads[2], param->pads[0]);
+        }
+        return TNN_OK;
+    }
+
     auto X86MaxPoolingAcc = X86MaxPooling<Float4, 4>;
     auto X86AvgPoolingAcc = X86AvgPooling<Float4, 4>;
     auto PackAcc          = PackC4;
     auto UnpackAcc        = UnpackC4;
     int c_pack = 4;
-    if (arch_ == avx2) {
+    if (arch_ >= avx2) {
         X86MaxPoolingAcc = X86MaxPooling<Float8, 8>;
         X86AvgPoolingAcc = X86AvgPooling<Float8, 8>;
         PackAcc          = PackC8;
@@ -84,20 +107,33 @@ Status X86PoolLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::
 
     size_t src_hw        = dims_input[3] * dims_input[2];
     size_t dst_hw        = dims_output[3] * dims_output[2];
-    size_t src_pack_size = ROUND_UP(src_hw * c_pack * sizeof(float), 32);
-    size_t dst_pack_size = ROUND_UP(dst_hw * c_pack * sizeof(float), 32);
-    float *workspace = reinterpret_cast<float *>(context_->GetSharedWorkSpace(src_pack_size + dst_pack_size));
-    auto src_pack_ptr = workspace;
-    auto dst_pack_ptr = workspace + src_pack_size / sizeof(float);
+    float *src_pack_ptr  = nullptr;
+    float *dst_pack_ptr  = nullptr;
+    if (output->GetBlobDesc().data_format != DATA_FORMAT_NC8HW8) {
+        size_t src_pack_size = ROUND_UP(src_hw * c_pack * sizeof(float), 32);
+        size_t dst_pack_size = ROUND_UP(dst_hw * c_pack * sizeof(float), 32);
+        float *workspace = reinterpret_cast<float *>(context_->GetSharedWorkSpace(src_pack_size + dst_pack_size));
+        src_pack_ptr     = workspace;
+        dst_pack_ptr     = workspace + src_pack_size / sizeof(float);
+    }
+
+    // NC8HW8 blocks are pooled in place, the padded channels stay zero
+    bool blocked = output->GetBlobDesc().data_format == DATA_FORMAT_NC8HW8;
+    int channel  = blocked ? ROUND_UP(dims_output[1], 8) : dims_output[1];
 
     if (output->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
         //OMP_PARALLEL_FOR_
         for (int b = 0; b < batch; b++) {
-            auto input_b  = reinterpret_cast<float *>(input_ptr) + b * dims_input[1] * src_hw;
-            auto output_b = reinterpret_cast<float *>(output_ptr) + b * dims_output[1] * dst_hw;
+            auto input_b  = reinterpret_cast<float *>(input_ptr) + b * channel * src_hw;
+            auto output_b = reinterpret_cast<float *>(output_ptr) + b * channel * dst_hw;
             for (int c = 0; c < dims_output[1]; c += c_pack) {
                 int left_c = MIN(dims_output[1] - c, c_pack);
-                PackAcc(src_pack_ptr, input_b + c * src_hw, src_hw, src_hw, src_hw, left_c);
+                if (blocked) {
+                    src_pack_ptr = input_b + c * src_hw;
+                    dst_pack_ptr = output_b + c * dst_hw;
+                } else {
+                    PackAcc(src_pack_ptr, input_b + c * src_hw, src_hw, src_hw, src_hw, left_c);
+                }
                 if (param->pool_type == 0) {
                     X86MaxPoolingAcc(src_pack_ptr, dims_input[3], dims_input[2], dst_pack_ptr,
                             dims_output[3], dims_output[2], param->kernels[0], param->kernels[1], param->strides[0],
@@ -108,7 +144,9 @@ Status X86PoolLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::
                             dims_output[3], dims_output[2], param->kernels[0], param->kernels[1], param->strides[0],
                             param->strides[1], param->pads[0], param->pads[2]);
                 }
-                UnpackAcc(output_b + c * dst_hw, dst_pack_ptr, dst_hw, dst_hw, dst_hw, left_c);
+                if (!blocked) {
+                    UnpackAcc(output_b + c * dst_hw, dst_pack_ptr, dst_hw, dst_hw, dst_hw, left_c);
+                }
             }
         }
     } else {
@@ -119,4 +157,5 @@ Status X86PoolLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::
 }
 
 REGISTER_X86_ACC(Pool, LAYER_POOLING);
+REGISTER_X86_LAYOUT(LAYER_POOLING, DATA_FORMAT_NC8HW8);
 }
\ No newline at end of file
@@ -23,7 +23,8 @@
 namespace TNN_NS {
 
 template <typename VEC, int pack>
-static void prelu_func(float *input, float *output, const float *slope, DimsVector dims, bool is_channel_shared) {
+static X86_INLINE void prelu_func(float *input, float *output, const float *slope, DimsVector dims,
+                                  bool is_channel_shared) {
     auto plane = DimsVectorUtils::Count(dims, 2);
 
     for (int b = 0; b < dims[0]; b++) {
@@ -59,6 +60,15 @@ static void prelu_func(float *input, float *output, const float *slope, DimsVect
     }
 }
 
+static void prelu_func_sse(float *input, float *output, const float *slope, DimsVector dims, bool is_channel_shared) {
+    prelu_func<Float4, 4>(input, output, slope, dims, is_channel_shared);
+}
+
+static X86_AVX2_TARGET void prelu_func_avx2(float *input, float *output, const float *slope, DimsVector dims,
+                                            bool is_channel_shared) {
+    prelu_func<Float8, 8>(input, output, slope, dims, is_channel_shared);
+}
+
 X86PReluLayerAcc::~X86PReluLayerAcc() {}
 
 Status X86PReluLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
@@ -106,9 +116,9 @@ Status X86PReluLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std:
         return Status(TNNERR_COMMON_ERROR, "Error: blob count is zero");
     }
 
-    auto calc = prelu_func<Float8, 8>;
-    if (arch_ == sse42) {
-        calc = prelu_func<Float4, 4>;
+    auto calc = prelu_func_sse;
+    if (arch_ >= avx2) {
+        calc = prelu_func_avx2;
     }
 
     if (output_blob->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
@@ -0,0 +1,139 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <float.h>
+
+#include "tnn/core/blob_int8.h"
+#include "tnn/device/x86/acc/compute/x86_compute_int8.h"
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+class X86ReformatLayerAcc : public X86LayerAcc {
+public:
+    virtual ~X86ReformatLayerAcc(){};
+
+    Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
+                const std::vector<Blob *> &outputs) override;
+
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+
+    virtual bool NC8HW8Implemented(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+
+private:
+    // per channel scales of each blob, the reciprocal of blob scales for quantization
+    Status allocateBufferParam(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    std::vector<RawBuffer> scale_buffers_;
+};
+
+Status X86ReformatLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
+                                 const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    RETURN_ON_NEQ(X86LayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
+
+    auto reformat_param = dynamic_cast<ReformatLayerParam *>(param);
+    CHECK_PARAM_NULL(reformat_param);
+
+    if (reformat_param->src_type == DATA_TYPE_FLOAT && reformat_param->dst_type == DATA_TYPE_FLOAT) {
+        if (reformat_param->src_format == DATA_FORMAT_NCHW && reformat_param->dst_format == DATA_FORMAT_NC8HW8) {
+            reformat_param->type = NCHWFP32_2_NC8HW8FP32;
+        } else if (reformat_param->src_format == DATA_FORMAT_NC8HW8 &&
+                   reformat_param->dst_format == DATA_FORMAT_NCHW) {
+            reformat_param->type = NC8HW8FP32_2_NCHWFP32;
+        } else {
+            LOGE("X86ReformatLayerAcc::Init Error: src_format: %d, dst_format: %d\n", reformat_param->src_format,
+                 reformat_param->dst_format);
+            return Status(TNNERR_MODEL_ERR, "X86ReformatLayerAcc::Init unsupport reformat type");
+        }
+        return TNN_OK;
+    } else if (reformat_param->src_type == DATA_TYPE_INT8 && reformat_param->dst_type == DATA_TYPE_FLOAT) {
+        reformat_param->type = DEQUANT_ONLY;
+    } else if (reformat_param->src_type == DATA_TYPE_FLOAT && reformat_param->dst_type == DATA_TYPE_INT8) {
+        reformat_param->type = QUANT_ONLY;
+    } else {
+        LOGE("X86ReformatLayerAcc::Init Error: src_type: %d, dst_type: %d\n", reformat_param->src_type,
+             reformat_param->dst_type);
+        return Status(TNNERR_MODEL_ERR, "X86ReformatLayerAcc::Init unsupport reformat type");
+    }
+    return allocateBufferParam(inputs, outputs);
+}
+
+bool X86ReformatLayerAcc::NC8HW8Implemented(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return true;
+}
+
+Status X86ReformatLayerAcc::allocateBufferParam(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<ReformatLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+
+    if (!scale_buffers_.empty()) {
+        return TNN_OK;
+    }
+    for (int i = 0; i < inputs.size(); ++i) {
+        auto int8_blob     = param->type == DEQUANT_ONLY ? inputs[i] : outputs[i];
+        auto &scale_handle = reinterpret_cast<BlobInt8 *>(int8_blob)->GetIntResource()->scale_handle;
+        const float *scale = scale_handle.force_to<float *>();
+        int scale_cnt      = scale_handle.GetDataCount();
+        int channel        = outputs[i]->GetBlobDesc().dims[1];
+
+        RawBuffer temp_buffer(channel * sizeof(float));
+        float *temp_ptr = temp_buffer.force_to<float *>();
+        for (int c = 0; c < channel; c++) {
+            float s = scale[scale_cnt == 1 ? 0 : c];
+            if (param->type == QUANT_ONLY) {
+                temp_ptr[c] = s >= FLT_MIN ? 1.0f / s : 0.0f;
+            } else {
+                temp_ptr[c] = s;
+            }
+        }
+        scale_buffers_.push_back(temp_buffer);
+    }
+    return TNN_OK;
+}
+
+Status X86ReformatLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<ReformatLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+
+    for (int i = 0; i < inputs.size(); ++i) {
+        auto dims   = outputs[i]->GetBlobDesc().dims;
+        if (param->type == NCHWFP32_2_NC8HW8FP32) {
+            PackNC8HW8(static_cast<float *>(outputs[i]->GetHandle().base),
+                       static_cast<float *>(inputs[i]->GetHandle().base), dims);
+            continue;
+        } else if (param->type == NC8HW8FP32_2_NCHWFP32) {
+            UnpackNC8HW8(static_cast<float *>(outputs[i]->GetHandle().base),
+                         static_cast<float *>(inputs[i]->GetHandle().base), dims);
+            continue;
+        }
+        int batch   = dims[0];
+        int channel = dims[1];
+        int hw      = DimsVectorUtils::Count(dims, 2);
+        auto scale  = scale_buffers_[i].force_to<float *>();
+        if (param->type == DEQUANT_ONLY) {
+            X86Int8ToFloat(static_cast<float *>(outputs[i]->GetHandle().base),
+                           static_cast<int8_t *>(inputs[i]->GetHandle().base), scale, batch, channel, hw);
+        } else if (param->type == QUANT_ONLY) {
+            X86FloatToInt8(static_cast<int8_t *>(outputs[i]->GetHandle().base),
+                           static_cast<float *>(inputs[i]->GetHandle().base), scale, batch, channel, hw);
+        }
+    }
+    return TNN_OK;
+}
+
+REGISTER_X86_ACC(Reformat, LAYER_REFORMAT);
+
+}  // namespace TNN_NS
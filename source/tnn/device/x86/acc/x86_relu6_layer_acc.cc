@@ -29,7 +29,7 @@ typedef struct x86_relu6_operator : x86_unary2_operator {
         return Float4::min(Float4::max(v, Float4(0.f)), Float4(6.f));
     }
 
-    virtual Float8 operator()(const Float8 &v) {
+    X86_AVX2_TARGET virtual Float8 operator()(const Float8 &v) {
         return Float8::min(Float8::max(v, Float8(0.f)), Float8(6.f));
     }
 } X86_RELU6_OP;
@@ -38,5 +38,6 @@ X86_REGISTER_UNARY2_KERNEL(LAYER_RELU6, avx2, unary2_kernel_avx<X86_RELU6_OP>);
 X86_REGISTER_UNARY2_KERNEL(LAYER_RELU6, sse42, unary2_kernel_sse<X86_RELU6_OP>);
 DECLARE_X86_UNARY2_ACC(Relu6, LAYER_RELU6);
 REGISTER_X86_ACC(Relu6, LAYER_RELU6);
+REGISTER_X86_LAYOUT(LAYER_RELU6, DATA_FORMAT_NC8HW8);
 
 }   // namespace TNN_NS
\ No newline at end of file
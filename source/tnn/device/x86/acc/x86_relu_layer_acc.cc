@@ -27,7 +27,7 @@ typedef struct x86_relu_operator : x86_unary2_operator {
         return Float4::max(v, Float4(0.f));
     }
 
-    virtual Float8 operator()(const Float8 &v) {
+    X86_AVX2_TARGET virtual Float8 operator()(const Float8 &v) {
         return (Float8::max(v, Float8(0.f)));
     }
 } X86_RELU_OP;
@@ -36,5 +36,6 @@ X86_REGISTER_UNARY2_KERNEL(LAYER_RELU, avx2, unary2_kernel_avx<X86_RELU_OP>);
 X86_REGISTER_UNARY2_KERNEL(LAYER_RELU, sse42, unary2_kernel_sse<X86_RELU_OP>);
 DECLARE_X86_UNARY2_ACC(Relu, LAYER_RELU);
 REGISTER_X86_ACC(Relu, LAYER_RELU);
+REGISTER_X86_LAYOUT(LAYER_RELU, DATA_FORMAT_NC8HW8);
 
 }   // namespace TNN_NS
\ No newline at end of file
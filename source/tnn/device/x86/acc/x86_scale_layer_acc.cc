@@ -20,7 +20,16 @@
 
 namespace TNN_NS {
 
-DECLARE_X86_ACC(Scale, LAYER_SCALE);
+class X86ScaleLayerAcc : public X86LayerAcc {
+public:
+    virtual ~X86ScaleLayerAcc(){};
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+    virtual bool NC8HW8Implemented(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+};
+
+bool X86ScaleLayerAcc::NC8HW8Implemented(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return inputs[0]->GetBlobDesc().data_format == outputs[0]->GetBlobDesc().data_format;
+}
 
 Status X86ScaleLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     
@@ -37,14 +46,17 @@ Status X86ScaleLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std:
     RawBuffer bias_handle  = resource->bias_handle;
     bool has_bias          = bias_handle.GetDataCount() > 0; 
 
-    X86_FMA(static_cast<float *>(input_blob->GetHandle().base),
-            static_cast<float *>(output_blob->GetHandle().base),
-            scale_handle.force_to<float *>(), bias_handle.force_to<float *>(),
-            shared_channel, has_bias, output_blob->GetBlobDesc().dims);
-
-    return TNN_OK;
+    auto fma_func = X86_FMA;
+    if (output_blob->GetBlobDesc().data_format == DATA_FORMAT_NC8HW8) {
+        fma_func = X86_FMA_NC8HW8;
+    }
+    return fma_func(static_cast<float *>(input_blob->GetHandle().base),
+                    static_cast<float *>(output_blob->GetHandle().base),
+                    scale_handle.force_to<float *>(), bias_handle.force_to<float *>(),
+                    shared_channel, has_bias, output_blob->GetBlobDesc().dims);
 }
 
 REGISTER_X86_ACC(Scale, LAYER_SCALE);
+REGISTER_X86_LAYOUT(LAYER_SCALE, DATA_FORMAT_NC8HW8);
 
 }  // namespace TNN_NS
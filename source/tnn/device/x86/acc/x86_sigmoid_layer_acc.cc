@@ -27,7 +27,7 @@ typedef struct x86_sigmoid_operator : x86_unary2_operator {
         return Float4::sigmoid(v);
     }
 
-    virtual Float8 operator()(const Float8 &v) {
+    X86_AVX2_TARGET virtual Float8 operator()(const Float8 &v) {
         return Float8::sigmoid(v);
     }
 } X86_SIGMOID_OP;
@@ -36,5 +36,6 @@ X86_REGISTER_UNARY2_KERNEL(LAYER_SIGMOID, avx2, unary2_kernel_avx<X86_SIGMOID_OP
 X86_REGISTER_UNARY2_KERNEL(LAYER_SIGMOID, sse42, unary2_kernel_sse<X86_SIGMOID_OP>);
 DECLARE_X86_UNARY2_ACC(Sigmoid, LAYER_SIGMOID);
 REGISTER_X86_ACC(Sigmoid, LAYER_SIGMOID);
+REGISTER_X86_LAYOUT(LAYER_SIGMOID, DATA_FORMAT_NC8HW8);
 
 }  // namespace TNN_NS
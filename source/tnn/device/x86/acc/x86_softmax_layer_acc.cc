@@ -26,7 +26,8 @@ namespace TNN_NS {
 DECLARE_X86_ACC(SoftMax, LAYER_SOFTMAX);
 
 template <typename VEC, int pack>
-static void softmax_channel_func(float *input_ptr, float *output_ptr, int channel, int count, void *workspace) {
+static X86_INLINE void softmax_channel_func(float *input_ptr, float *output_ptr, int channel, int count,
+                                            void *workspace) {
     float *temp = reinterpret_cast<float *>(workspace);
 
     temp[0] = input_ptr[0];
@@ -83,7 +84,7 @@ static void softmax_channel_func(float *input_ptr, float *output_ptr, int channe
 }
 
 template <typename VEC, int pack>
-static void softmax_func(float *input_ptr, float *output_ptr, int channel, int count, void *workspace) {
+static X86_INLINE void softmax_func(float *input_ptr, float *output_ptr, int channel, int count, void *workspace) {
     if (count == 1) {
         return softmax_channel_func<VEC, pack>(input_ptr, output_ptr, channel, count, workspace);
     }
@@ -150,6 +151,15 @@ static void softmax_func(float *input_ptr, float *output_ptr, int channel, int c
     }
 }
 
+static void softmax_func_sse(float *input_ptr, float *output_ptr, int channel, int count, void *workspace) {
+    softmax_func<Float4, 4>(input_ptr, output_ptr, channel, count, workspace);
+}
+
+static X86_AVX2_TARGET void softmax_func_avx2(float *input_ptr, float *output_ptr, int channel, int count,
+                                              void *workspace) {
+    softmax_func<Float8, 8>(input_ptr, output_ptr, channel, count, workspace);
+}
+
 Status X86SoftMaxLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto params = dynamic_cast<SoftmaxLayerParam *>(param_);
 
@@ -171,9 +181,9 @@ Status X86SoftMaxLayerAcc::DoForward(const std::vector<Blob *> &inputs, const st
 
     auto workspace = context_->GetSharedWorkSpace(count * sizeof(float));
 
-    auto func = softmax_func<Float8, 8>;
-    if (arch_ == sse42) {
-        func = softmax_func<Float4, 4>;
+    auto func = softmax_func_sse;
+    if (arch_ >= avx2) {
+        func = softmax_func_avx2;
     }
 
     for (int n = 0; n < batch; n++) {
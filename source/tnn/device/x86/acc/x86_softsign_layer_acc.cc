@@ -27,7 +27,7 @@ typedef struct x86_softsign_operator : x86_unary2_operator {
         return Float4::div(v, (Float4::abs(v) + Float4(1.0f)));
     }
 
-    virtual Float8 operator()(const Float8 &v) {
+    X86_AVX2_TARGET virtual Float8 operator()(const Float8 &v) {
         return Float8::div(v, (Float8::abs(v) + Float8(1.0f)));
     }
 } X86_SOFTSIGN_OP;
@@ -36,5 +36,6 @@ X86_REGISTER_UNARY2_KERNEL(LAYER_SOFTSIGN, avx2, unary2_kernel_avx<X86_SOFTSIGN_
 X86_REGISTER_UNARY2_KERNEL(LAYER_SOFTSIGN, sse42, unary2_kernel_sse<X86_SOFTSIGN_OP>);
 DECLARE_X86_UNARY2_ACC(Softsign, LAYER_SOFTSIGN);
 REGISTER_X86_ACC(Softsign, LAYER_SOFTSIGN);
+REGISTER_X86_LAYOUT(LAYER_SOFTSIGN, DATA_FORMAT_NC8HW8);
 
 }  // namespace TNN_NS
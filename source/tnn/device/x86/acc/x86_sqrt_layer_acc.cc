@@ -27,7 +27,7 @@ typedef struct x86_sqrt_operator : x86_unary2_operator {
         return Float4::sqrt(v);
     }
 
-    virtual Float8 operator()(const Float8 &v) {
+    X86_AVX2_TARGET virtual Float8 operator()(const Float8 &v) {
         return Float8::sqrt(v);
     }
 } X86_SQRT_OP;
@@ -36,5 +36,6 @@ X86_REGISTER_UNARY2_KERNEL(LAYER_SQRT, avx2, unary2_kernel_avx<X86_SQRT_OP>);
 X86_REGISTER_UNARY2_KERNEL(LAYER_SQRT, sse42, unary2_kernel_sse<X86_SQRT_OP>);
 DECLARE_X86_UNARY2_ACC(Sqrt, LAYER_SQRT);
 REGISTER_X86_ACC(Sqrt, LAYER_SQRT);
+REGISTER_X86_LAYOUT(LAYER_SQRT, DATA_FORMAT_NC8HW8);
 
 }   // namespace TNN_NS
\ No newline at end of file
@@ -35,14 +35,17 @@ Status X86Unary2LayerAcc::RegisterUnary2Kernel(LayerType type, x86_isa_t arch, u
     return TNN_OK;
 }
 
+// use the kernel of the widest isa registered, not beyond arch
 Status X86Unary2LayerAcc::GetUnary2Kernel(LayerType type, x86_isa_t arch, unary2_kernel_avx_func_t &kernel) {
-    const auto &kernel_map  = GetUnary2KernelMap();
-    std::string kernel_name = GetUnaryKernelName(type, arch);
-    if (kernel_map.find(kernel_name) == kernel_map.end() || kernel_map.at(kernel_name) == nullptr) {
-        return Status(TNNERR_PARAM_ERR, "X86Unary2LayerAcc can not find unary kernel");
+    const auto &kernel_map = GetUnary2KernelMap();
+    for (int isa = arch; isa >= sse42; --isa) {
+        std::string kernel_name = GetUnaryKernelName(type, static_cast<x86_isa_t>(isa));
+        if (kernel_map.find(kernel_name) != kernel_map.end() && kernel_map.at(kernel_name) != nullptr) {
+            kernel = kernel_map.at(kernel_name);
+            return TNN_OK;
+        }
     }
-    kernel = kernel_map.at(kernel_name);
-    return TNN_OK;
+    return Status(TNNERR_PARAM_ERR, "X86Unary2LayerAcc can not find unary kernel");
 }
 
 Status X86_UNARY2_CALCULATE(DimsVector &dims, const float *src, float *dst, LayerType type, x86_isa_t arch,
@@ -57,16 +60,28 @@ Status X86_UNARY2_CALCULATE(DimsVector &dims, const float *src, float *dst, Laye
 
 X86Unary2LayerAcc::~X86Unary2LayerAcc() {}
 
+bool X86Unary2LayerAcc::NC8HW8Implemented(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return inputs[0]->GetBlobDesc().data_format == outputs[0]->GetBlobDesc().data_format;
+}
+
 Status X86Unary2LayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto input  = inputs[0];
     auto output = outputs[0];
 
     auto dims = output->GetBlobDesc().dims;
 
-    int count        = DimsVectorUtils::Count(dims);
     auto input_data  = static_cast<float *>(input->GetHandle().base);
     auto output_data = static_cast<float *>(output->GetHandle().base);
 
+    if (output->GetBlobDesc().data_format == DATA_FORMAT_NC8HW8) {
+        // compute the padded channels too, then clear them
+        DimsVector padded_dims = {DimsFunctionUtils::GetDim(dims, 0), ROUND_UP(DimsFunctionUtils::GetDim(dims, 1), 8),
+                                  DimsVectorUtils::Count(dims, 2)};
+        RETURN_ON_NEQ(X86_UNARY2_CALCULATE(padded_dims, input_data, output_data, type_, arch_, param_), TNN_OK);
+        ClearNC8HW8Padding(output_data, dims);
+        return TNN_OK;
+    }
+
     RETURN_ON_NEQ(X86_UNARY2_CALCULATE(dims, input_data, output_data, type_, arch_, param_), TNN_OK);
 
     return TNN_OK;
@@ -38,7 +38,8 @@ public:
         return v;
     }
 
-    virtual Float8 operator()(const Float8 &v) {
+    // Float8 operators are only called by unary2_kernel_avx
+    X86_AVX2_TARGET virtual Float8 operator()(const Float8 &v) {
         return v;
     }
 
@@ -47,7 +48,7 @@ protected:
 } X86_UNARY2_OP;
 
 template <typename UNARY2_OP>
-void unary2_kernel_avx(std::vector<int> dims, const float *src, float *dst, LayerParam *param) {
+X86_AVX2_TARGET void unary2_kernel_avx(std::vector<int> dims, const float *src, float *dst, LayerParam *param) {
     UNARY2_OP op;
     op.Init(param);
 
@@ -86,6 +87,8 @@ public:
 
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
 
+    virtual bool NC8HW8Implemented(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+
     static Status RegisterUnary2Kernel(LayerType type, x86_isa_t arch, unary2_kernel_avx_func_t kernel);
     static Status GetUnary2Kernel(LayerType type, x86_isa_t arch, unary2_kernel_avx_func_t &kernel);
 
@@ -204,8 +204,84 @@ static inline int upsample_cubic2d(float *output_data, const float *input_data,
     return 0;
 }
 
+// nearest interpolate function of NC8HW8 blocks, the 8 channels of a pixel are copied together
+static inline int upsample_nearest2d_nc8hw8(float *output_data, const float *input_data, int input_height,
+                                            int input_width, int output_height, int output_width, int blocks) {
+    const float height_scale = (float)input_height / (float)output_height;
+    const float width_scale  = (float)input_width / (float)output_width;
+
+    OMP_PARALLEL_FOR_
+    for (int z = 0; z < blocks; ++z) {
+        const float *src = input_data + z * input_height * input_width * 8;
+        float *dst       = output_data + z * output_height * output_width * 8;
+        for (int j = 0; j < output_height; ++j) {
+            int scaled_j = static_cast<int>(j * height_scale);
+            for (int u = 0; u < output_width; ++u) {
+                int scaled_u = static_cast<int>(u * width_scale);
+                memcpy(dst + (j * output_width + u) * 8, src + (scaled_j * input_width + scaled_u) * 8,
+                       8 * sizeof(float));
+            }
+        }
+    }
+
+    return 0;
+}
+
+// bilinear interpolate function of NC8HW8 blocks
+static inline int upsample_bilinear2d_nc8hw8(float *output_data, const float *input_data, int input_height,
+                                             int input_width, int output_height, int output_width, int blocks,
+                                             bool align_corners) {
+    float rheight, rwidth;
+    if (align_corners) {
+        rheight = (output_height > 1) ? (float)(input_height - 1) / (output_height - 1) : 0.f;
+        rwidth  = (output_width > 1) ? (float)(input_width - 1) / (output_width - 1) : 0.f;
+    } else {
+        rheight = (output_height > 1) ? (float)(input_height) / (output_height) : 0.f;
+        rwidth  = (output_width > 1) ? (float)(input_width) / (output_width) : 0.f;
+    }
+
+    OMP_PARALLEL_FOR_
+    for (int h2 = 0; h2 < output_height; ++h2) {
+        float h1r = align_corners ? rheight * h2 : static_cast<float>(rheight * (h2 + 0.5) - 0.5);
+        h1r       = h1r >= 0 ? h1r : 0;
+
+        const int h1         = static_cast<int>(h1r);
+        const int h1p        = (h1 < input_height - 1) ? 1 : 0;
+        const float h1lambda = h1r - h1;
+        const float h0lambda = (float)1. - h1lambda;
+        for (int w2 = 0; w2 < output_width; ++w2) {
+            float w1r = align_corners ? rwidth * w2 : static_cast<float>(rwidth * (w2 + 0.5) - 0.5);
+            w1r       = w1r >= 0 ? w1r : 0;
+
+            const int w1         = static_cast<int>(w1r);
+            const int w1p        = (w1 < input_width - 1) ? 1 : 0;
+            const float w1lambda = w1r - w1;
+            const float w0lambda = (float)1. - w1lambda;
+            for (int z = 0; z < blocks; ++z) {
+                const float *x00 = input_data + ((z * input_height + h1) * input_width + w1) * 8;
+                const float *x01 = x00 + w1p * 8;
+                const float *x10 = x00 + h1p * input_width * 8;
+                const float *x11 = x10 + w1p * 8;
+                float *y         = output_data + ((z * output_height + h2) * output_width + w2) * 8;
+                for (int k = 0; k < 8; ++k) {
+                    y[k] = h0lambda * (w0lambda * x00[k] + w1lambda * x01[k]) +
+                           h1lambda * (w0lambda * x10[k] + w1lambda * x11[k]);
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
 X86UpsampleLayerAcc::~X86UpsampleLayerAcc() {}
 
+bool X86UpsampleLayerAcc::NC8HW8Implemented(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<UpsampleLayerParam *>(param_);
+    return param && (param->mode == 1 || param->mode == 2) &&
+           inputs[0]->GetBlobDesc().data_format == outputs[0]->GetBlobDesc().data_format;
+}
+
 
 Status X86UpsampleLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     if (outputs[0]->GetBlobDesc().data_type == DATA_TYPE_INT8) {
@@ -254,6 +330,19 @@ Status X86UpsampleLayerAcc::DoForward(const std::vector<Blob *> &inputs, const s
         output_data = buffer_output_fp32_.force_to<float *>();
     }
 
+    if (output_blob->GetBlobDesc().data_format == DATA_FORMAT_NC8HW8) {
+        // batches are continuous blocks
+        int blocks = batch * UP_DIV(channel, 8);
+        if (param->mode == 1) {
+            upsample_nearest2d_nc8hw8(output_data, input_data, input_height, input_width, output_height,
+                                      output_width, blocks);
+        } else {
+            upsample_bilinear2d_nc8hw8(output_data, input_data, input_height, input_width, output_height,
+                                       output_width, blocks, (bool)param->align_corners);
+        }
+        return TNN_OK;
+    }
+
     if (param->mode == 1) {  // nearest
         for (int b = 0; b < batch; ++b) {
             upsample_nearest2d(output_data + b * output_plane, input_data + b * input_plane, input_height, input_width,
@@ -287,5 +376,6 @@ Status X86UpsampleLayerAcc::DoForward(const std::vector<Blob *> &inputs, const s
 }
 
 REGISTER_X86_ACC(Upsample, LAYER_UPSAMPLE);
+REGISTER_X86_LAYOUT(LAYER_UPSAMPLE, DATA_FORMAT_NC8HW8);
 
 }  // namespace TNN_NS
@@ -32,6 +32,8 @@ class X86UpsampleLayerAcc : public X86LayerAcc {
 
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
+    virtual bool NC8HW8Implemented(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
 private:
     RawBuffer buffer_input_fp32_;
     RawBuffer buffer_output_fp32_;
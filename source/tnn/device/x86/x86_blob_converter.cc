@@ -13,15 +13,85 @@
 // specific language governing permissions and limitations under the License.
 
 #include "tnn/core/macro.h"
+#include "tnn/device/x86/x86_mat_util.h"
+#include "tnn/device/x86/x86_util.h"
+#include "tnn/interpreter/raw_buffer.h"
 #include "tnn/utils/blob_converter_default.h"
 #include "tnn/utils/blob_converter.h"
+#include "tnn/utils/dims_utils.h"
 
 namespace TNN_NS {
 
+// NC8HW8 blobs are converted through a NCHW copy of the blob data
 class X86BlobConverterAcc : public DefaultBlobConverterAcc {
 public:
     X86BlobConverterAcc(Blob *blob) : DefaultBlobConverterAcc(blob) {}
     ~X86BlobConverterAcc() {}
+
+    virtual Status ConvertToMatAsync(Mat &image, MatConvertParam param, void *command_queue = NULL) {
+        if (!IsNC8HW8()) {
+            return DefaultBlobConverterAcc::ConvertToMatAsync(image, param, command_queue);
+        }
+        auto desc = blob_->GetBlobDesc();
+        auto nchw_blob = CreateNCHWBlob();
+        UnpackNC8HW8(static_cast<float *>(nchw_blob->GetHandle().base),
+                     static_cast<float *>(blob_->GetHandle().base), desc.dims);
+        return DefaultBlobConverterAcc(nchw_blob.get()).ConvertToMatAsync(image, param, command_queue);
+    }
+
+    virtual Status ConvertFromMatAsync(Mat &image, MatConvertParam param, void *command_queue = NULL) {
+        if (!IsNC8HW8()) {
+            return DefaultBlobConverterAcc::ConvertFromMatAsync(image, param, command_queue);
+        }
+        auto desc = blob_->GetBlobDesc();
+        auto nchw_blob = CreateNCHWBlob();
+        RETURN_ON_NEQ(DefaultBlobConverterAcc(nchw_blob.get()).ConvertFromMatAsync(image, param, command_queue),
+                      TNN_OK);
+        PackNC8HW8(static_cast<float *>(blob_->GetHandle().base),
+                   static_cast<float *>(nchw_blob->GetHandle().base), desc.dims);
+        return TNN_OK;
+    }
+
+    // resize and normalize are fused into one pass over the image
+    virtual Status ConvertFromMatWithResize(Mat &image, ResizeParam resize_param, MatConvertParam param,
+                                            void *command_queue = NULL) {
+        auto desc = blob_->GetBlobDesc();
+        bool nchw = desc.data_format == DATA_FORMAT_NCHW || desc.data_format == DATA_FORMAT_AUTO;
+        if ((!nchw && !IsNC8HW8()) || !CanFuseResize(image, resize_param, param)) {
+            return BlobConverterAcc::ConvertFromMatWithResize(image, resize_param, param, command_queue);
+        }
+
+        auto dims      = desc.dims;
+        auto nchw_blob = nchw ? nullptr : CreateNCHWBlob();
+        auto dst       = static_cast<float *>((nchw ? blob_ : nchw_blob.get())->GetHandle().base);
+        ResizeConvertToNCHW(static_cast<uint8_t *>(image.GetData()), dims[0], image.GetWidth(), image.GetHeight(),
+                            image.GetMatType(), dst, dims[3], dims[2], dims[1], param.scale.data(),
+                            param.bias.data(), param.reverse_channel, resize_param.type);
+        if (!nchw) {
+            PackNC8HW8(static_cast<float *>(blob_->GetHandle().base), dst, dims);
+        }
+        return TNN_OK;
+    }
+
+private:
+    bool IsNC8HW8() {
+        return blob_ != nullptr && blob_->GetBlobDesc().data_format == DATA_FORMAT_NC8HW8 &&
+               blob_->GetBlobDesc().data_type == DATA_TYPE_FLOAT;
+    }
+
+    std::shared_ptr<Blob> CreateNCHWBlob() {
+        auto desc        = blob_->GetBlobDesc();
+        desc.data_format = DATA_FORMAT_NCHW;
+        int bytes_size   = DimsVectorUtils::Count(desc.dims) * sizeof(float);
+        if (nchw_buffer_.GetBytesSize() < bytes_size) {
+            nchw_buffer_ = RawBuffer(bytes_size);
+        }
+        BlobHandle handle;
+        handle.base = nchw_buffer_.force_to<void *>();
+        return std::make_shared<Blob>(desc, handle);
+    }
+
+    RawBuffer nchw_buffer_;
 };
 
 DECLARE_BLOB_CONVERTER_CREATER(X86);
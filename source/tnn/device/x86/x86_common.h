@@ -23,4 +23,47 @@
 #include <x86intrin.h>
 #endif
 
+// The x86 backend is compiled for SSE4.2, wider kernels are compiled for their own isa with
+// the macros below and only called after the isa is checked at runtime, see X86Device::GetIsa.
+// X86_AVX2_TARGET / X86_AVX512_TARGET mark a single function, functions defined between
+// X86_AVX2_BEGIN and X86_AVX2_END (X86_AVX512_BEGIN and X86_AVX512_END) are all compiled for the isa.
+// X86_AVX512_VNNI_TARGET additionally enables the int8 dot product instructions.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define X86_AVX2_TARGET
+#define X86_AVX512_TARGET
+#define X86_AVX512_VNNI_TARGET
+#define X86_AVX2_BEGIN
+#define X86_AVX2_END
+#define X86_AVX512_BEGIN
+#define X86_AVX512_END
+#elif defined(__clang__)
+#define X86_AVX2_TARGET __attribute__((target("avx,avx2,fma")))
+#define X86_AVX512_TARGET __attribute__((target("avx,avx2,fma,avx512f,avx512bw,avx512vl,avx512dq")))
+#define X86_AVX512_VNNI_TARGET \
+    __attribute__((target("avx,avx2,fma,avx512f,avx512bw,avx512vl,avx512dq,avx512vnni")))
+#define X86_AVX2_BEGIN _Pragma("clang attribute push(__attribute__((target(\"avx,avx2,fma\"))), apply_to = function)")
+#define X86_AVX2_END _Pragma("clang attribute pop")
+#define X86_AVX512_BEGIN \
+    _Pragma("clang attribute push(__attribute__((target(\"avx,avx2,fma,avx512f,avx512bw,avx512vl,avx512dq\"))), apply_to = function)")
+#define X86_AVX512_END _Pragma("clang attribute pop")
+#else
+#define X86_AVX2_TARGET __attribute__((target("avx,avx2,fma")))
+#define X86_AVX512_TARGET __attribute__((target("avx,avx2,fma,avx512f,avx512bw,avx512vl,avx512dq")))
+#define X86_AVX512_VNNI_TARGET \
+    __attribute__((target("avx,avx2,fma,avx512f,avx512bw,avx512vl,avx512dq,avx512vnni")))
+#define X86_AVX2_BEGIN _Pragma("GCC push_options") _Pragma("GCC target(\"avx,avx2,fma\")")
+#define X86_AVX2_END _Pragma("GCC pop_options")
+#define X86_AVX512_BEGIN \
+    _Pragma("GCC push_options") _Pragma("GCC target(\"avx,avx2,fma,avx512f,avx512bw,avx512vl,avx512dq\")")
+#define X86_AVX512_END _Pragma("GCC pop_options")
+#endif
+
+// Templates shared by several isa variants are always inlined into the targeted functions
+// calling them, so that each variant is compiled for its own isa.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define X86_INLINE __forceinline
+#else
+#define X86_INLINE inline __attribute__((always_inline))
+#endif
+
 #endif
\ No newline at end of file
@@ -14,8 +14,39 @@
 
 #include "tnn/device/x86/x86_context.h"
 
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "tnn/core/macro.h"
+#include "tnn/utils/cpu_utils.h"
+#include "tnn/utils/omp_utils.h"
+
 namespace TNN_NS {
 
+// parse the cpu list of a numa node, such as "0-15,32-47"
+static Status GetNumaNodeCpus(int numa_node, std::vector<int> &cpu_list) {
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(numa_node) + "/cpulist");
+    std::string line;
+    if (!file.is_open() || !std::getline(file, line)) {
+        LOGE("X86Context get cpus of numa node %d failed\n", numa_node);
+        return Status(TNNERR_SET_CPU_AFFINITY, "get cpus of numa node failed");
+    }
+
+    std::stringstream ss(line);
+    std::string range;
+    while (std::getline(ss, range, ',')) {
+        int begin = 0, end = 0;
+        auto pos  = range.find('-');
+        begin     = std::atoi(range.substr(0, pos).c_str());
+        end       = pos == std::string::npos ? begin : std::atoi(range.substr(pos + 1).c_str());
+        for (int i = begin; i <= end; ++i) {
+            cpu_list.push_back(i);
+        }
+    }
+    return TNN_OK;
+}
+
 Status X86Context::LoadLibrary(std::vector<std::string> path) {
     return TNN_OK;
 }
@@ -25,7 +56,13 @@ Status X86Context::GetCommandQueue(void** command_queue) {
 }
 
 Status X86Context::OnInstanceForwardBegin() {
-    return TNN_OK;
+    Context::OnInstanceForwardBegin();
+    return BindThreads();
+}
+
+Status X86Context::OnInstanceReshapeBegin() {
+    Context::OnInstanceReshapeBegin();
+    return BindThreads();
 }
 
 Status X86Context::OnInstanceForwardEnd() {
@@ -36,18 +73,77 @@ Status X86Context::Synchronize() {
     return TNN_OK;
 }
 
+Status X86Context::SetNumThreads(int num_threads) {
+    int max_threads = cpu_list_.empty() ? OMP_CORES_ : (int)cpu_list_.size();
+    num_threads_    = MIN(MAX(num_threads, 1), max_threads);
+    return TNN_OK;
+}
+
+Status X86Context::SetCpuAffinity(const std::vector<int> &cpu_list, int numa_node) {
+    std::vector<int> cpus = cpu_list;
+    if (cpus.empty() && numa_node >= 0) {
+        RETURN_ON_NEQ(GetNumaNodeCpus(numa_node, cpus), TNN_OK);
+    }
+    cpu_list_          = cpus;
+    bound_num_threads_ = 0;
+    if (!cpu_list_.empty() && (num_threads_ == 0 || num_threads_ > (int)cpu_list_.size())) {
+        num_threads_ = (int)cpu_list_.size();
+    }
+    return TNN_OK;
+}
+
+int X86Context::GetNumThreads() {
+    return num_threads_;
+}
+
+/*
+ * omp_set_num_threads only affects the calling thread, so instances forwarding on
+ * different threads each get their own omp team. The team threads are reused by
+ * later parallel regions of the same calling thread, pinning them once is enough.
+ */
+Status X86Context::BindThreads() {
+    if (num_threads_ > 0) {
+        OMP_SET_THREADS_(num_threads_);
+    }
+    if (cpu_list_.empty()) {
+        return TNN_OK;
+    }
+
+    int num_threads = OMP_MAX_THREADS_NUM_;
+    if (bound_thread_ == std::this_thread::get_id() && bound_num_threads_ == num_threads) {
+        return TNN_OK;
+    }
+
+    std::vector<int> rets(num_threads, TNN_OK);
+    OMP_PARALLEL_FOR_
+    for (int i = 0; i < num_threads; i++) {
+        rets[i] = (int)CpuUtils::SetCpuAffinity(cpu_list_);
+    }
+    for (int i = 0; i < num_threads; i++) {
+        if (rets[i] != TNN_OK) {
+            LOGE("X86Context pin threads to cpus failed\n");
+            return Status(TNNERR_SET_CPU_AFFINITY, "pin threads to cpus failed");
+        }
+    }
+    bound_thread_      = std::this_thread::get_id();
+    bound_num_threads_ = num_threads;
+    return TNN_OK;
+}
+
 void* X86Context::GetSharedWorkSpace(size_t size) {
     return GetSharedWorkSpace(size, 0);
 }
 
 void* X86Context::GetSharedWorkSpace(size_t size, int index) {
-    while(work_space_.size() < index + 1) {
-        work_space_.push_back(RawBuffer(size, 32));
+    std::lock_guard<std::mutex> guard(work_space_mutex_);
+    auto &work_space = work_space_[GetWorkerIndex()];
+    while(work_space.size() < index + 1) {
+        work_space.push_back(RawBuffer(size, 32));
     }
-    if (work_space_[index].GetBytesSize() < size) {
-        work_space_[index] = RawBuffer(size, 32);
+    if (work_space[index].GetBytesSize() < size) {
+        work_space[index] = RawBuffer(size, 32);
     }
-    return work_space_[index].force_to<void*>();
+    return work_space[index].force_to<void*>();
 }
 
 }  // namespace TNN_NS
@@ -15,7 +15,10 @@
 #ifndef TNN_SOURCE_TNN_DEVICE_X86_X86_CONTEXT_H_
 #define TNN_SOURCE_TNN_DEVICE_X86_X86_CONTEXT_H_
 
+#include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "tnn/core/context.h"
@@ -38,15 +41,37 @@ public:
     // @brief after instace forword
     virtual Status OnInstanceForwardEnd() override;
 
+    // @brief before instance reshape
+    virtual Status OnInstanceReshapeBegin() override;
+
     // @brief wait for jobs in the current context to complete
     virtual Status Synchronize() override;
 
+    // @brief set threads run on device
+    virtual Status SetNumThreads(int num_threads) override;
+
+    // @brief pin the threads run on device to cpus
+    virtual Status SetCpuAffinity(const std::vector<int> &cpu_list, int numa_node) override;
+
+    // @brief get threads run on device, 0 if not set
+    int GetNumThreads();
+
     void* GetSharedWorkSpace(size_t size);
     void* GetSharedWorkSpace(size_t size, int index);
 
 private:
-    int num_threads_ = 1;
-    std::vector<RawBuffer> work_space_;
+    // @brief set the omp threads of the calling thread and pin them to cpu_list_
+    Status BindThreads();
+
+    // 0 means the omp default is used
+    int num_threads_ = 0;
+    std::vector<int> cpu_list_;
+    // calling thread and number of threads the omp threads are pinned for
+    std::thread::id bound_thread_;
+    int bound_num_threads_ = 0;
+    // work space of each inter-op worker
+    std::map<int, std::vector<RawBuffer>> work_space_;
+    std::mutex work_space_mutex_;
 };
 
 }  // namespace TNN_NS
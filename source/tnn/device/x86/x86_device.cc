@@ -14,11 +14,14 @@
 
 #include "tnn/device/x86/x86_device.h"
 #include "tnn/device/x86/x86_context.h"
+#include "tnn/device/x86/x86_common.h"
 #include "tnn/utils/blob_memory_size_utils.h"
 
 namespace TNN_NS {
 
-X86Device::X86Device(DeviceType device_type) : AbstractDevice(device_type) {}
+X86Device::X86Device(DeviceType device_type) : AbstractDevice(device_type) {
+    LOGD("X86Device select isa: %d\n", GetIsa());
+}
 
 X86Device::~X86Device() {}
 
@@ -49,21 +52,32 @@ Status X86Device::Allocate(void** handle, MatType mat_type, DimsVector dims) {
 
 Status X86Device::Allocate(void** handle, BlobMemorySizeInfo& size_info) {
     if (handle) {
-        *handle = malloc(GetBlobMemoryBytesSize(size_info));
+        // packed and NC8HW8 kernels load and store aligned 8-float vectors
+        *handle = _mm_malloc(GetBlobMemoryBytesSize(size_info), 32);
     }
     return TNN_OK;
 }
 
 Status X86Device::Free(void* handle) {
     if (handle) {
-        free(handle);
+        _mm_free(handle);
     }
     return TNN_OK;
 }
 
 std::shared_ptr<const ImplementedLayout> X86Device::GetImplementedLayout(LayerType type) {
     auto layouts = new ImplementedLayout();
-    layouts->layouts.push_back(DATA_FORMAT_NCHW);
+    // empty layouts means the layer is not implemented on x86
+    if (GetLayerCreatorMap().count(type) > 0) {
+        layouts->layouts.push_back(DATA_FORMAT_NCHW);
+        // the blocked NC8HW8 kernels are built for avx2 and above
+        auto &layout_map = GetLayerLayoutMap();
+        if (GetIsa() >= avx2 && layout_map.count(type) > 0) {
+            for (auto layout : layout_map[type]) {
+                layouts->layouts.push_back(layout);
+            }
+        }
+    }
     return std::shared_ptr<ImplementedLayout>(layouts);
 }
 
@@ -107,11 +121,33 @@ Status X86Device::RegisterLayerAccCreator(LayerType type, LayerAccCreator* creat
     return TNN_OK;
 }
 
+Status X86Device::RegisterLayerLayout(LayerType type, DataFormat layout) {
+    GetLayerLayoutMap()[type].push_back(layout);
+    return TNN_OK;
+}
+
+x86_isa_t X86Device::GetIsa() {
+    static x86_isa_t isa = []() {
+        for (auto candidate : {avx512_vnni, avx512, avx2}) {
+            if (cpu_with_isa(candidate)) {
+                return candidate;
+            }
+        }
+        return sse42;
+    }();
+    return isa;
+}
+
 std::map<LayerType, std::shared_ptr<LayerAccCreator>>& X86Device::GetLayerCreatorMap() {
     static std::map<LayerType, std::shared_ptr<LayerAccCreator>> layer_creator_map;
     return layer_creator_map;
 }
 
+std::map<LayerType, std::vector<DataFormat>>& X86Device::GetLayerLayoutMap() {
+    static std::map<LayerType, std::vector<DataFormat>> layer_layout_map;
+    return layer_layout_map;
+}
+
 TypeDeviceRegister<X86Device> g_x86_device_register(DEVICE_X86);
 
 } // namespace TNN_NS
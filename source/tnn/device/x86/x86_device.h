@@ -18,8 +18,10 @@
 #include <map>
 #include <memory>
 #include <cstring>
+#include <vector>
 
 #include "tnn/core/abstract_device.h"
+#include "tnn/device/x86/acc/compute/jit/utils/cpu_isa.h"
 
 namespace TNN_NS {
 
@@ -58,8 +60,16 @@ public:
 
     static Status RegisterLayerAccCreator(LayerType type, LayerAccCreator* creator);
 
+    // @brief register a layout the layer acc computes natively besides NCHW
+    static Status RegisterLayerLayout(LayerType type, DataFormat layout);
+
+    // @brief the best isa supported by the cpu, selected once when X86Device is created.
+    // x86 kernels are built for several isa, layer accs pick their variants by it.
+    static x86_isa_t GetIsa();
+
 private:
     static std::map<LayerType, std::shared_ptr<LayerAccCreator>> &GetLayerCreatorMap();
+    static std::map<LayerType, std::vector<DataFormat>> &GetLayerLayoutMap();
 };
 
 // @brief X86TypeLayerAccRegister register X86TypeLayerAccCreator
@@ -71,6 +81,14 @@ public:
     }
 };
 
+// @brief X86TypeLayerLayoutRegister register the layouts implemented by a layer acc
+class X86TypeLayerLayoutRegister {
+public:
+    explicit X86TypeLayerLayoutRegister(LayerType type, DataFormat layout) {
+        X86Device::RegisterLayerLayout(type, layout);
+    }
+};
+
 } // namespace TNN_NS
 
 #endif // TNN_SOURCE_TNN_DEVICE_X86_X86_DEVICE_H
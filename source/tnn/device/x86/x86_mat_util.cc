@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <type_traits>
+#include <vector>
 
 #include "tnn/core/macro.h"
 #include "tnn/device/x86/x86_common.h"
@@ -1103,6 +1104,155 @@ void ResizeNearestYUV420sp(const uint8_t* src, int batch, int src_w, int src_h,
     }
 }
 
+#ifdef __SSE4_2__
+
+// pixel x of row y as b, g, r, a, yuv420sp pixels are converted in the same way as YUVToBGR
+template <MatType src_type>
+static inline __m128 ResizeConvertLoadPixel(const uint8_t* src_row, const uint8_t* vu_row, int x) {
+    if (src_type == N8UC3) {
+        const uint8_t* p = src_row + x * 3;
+        return _mm_cvtepi32_ps(_mm_setr_epi32(p[0], p[1], p[2], 0));
+    } else if (src_type == N8UC4) {
+        int p;
+        memcpy(&p, src_row + x * 4, sizeof(int));
+        return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(p)));
+    }
+
+    const uint8_t* vuptr = vu_row + (x / 2) * 2;
+    int u = (src_type == NNV12 ? vuptr[0] : vuptr[1]);
+    int v = (src_type == NNV12 ? vuptr[1] : vuptr[0]);
+    u     = (u > 240 ? 240 : u) - 128;
+    v     = (v > 240 ? 240 : v) - 128;
+
+    __m128i yy  = _mm_set1_epi32(src_row[x] * 74 - 1135);
+    __m128i uv  = _mm_setr_epi32(129 * u, -52 * v - 25 * u, 102 * v, 0);
+    __m128i bgr = _mm_srai_epi32(_mm_add_epi32(yy, uv), 6);
+    bgr         = _mm_min_epi32(_mm_max_epi32(bgr, _mm_setzero_si128()), _mm_set1_epi32(255));
+    return _mm_cvtepi32_ps(_mm_insert_epi32(bgr, 255, 3));
+}
+
+// horizontally interpolated row sy, 4 floats of b, g, r, a for each dst pixel
+template <MatType src_type>
+static void ResizeConvertOneRow(const uint8_t* src, int src_w, int src_h, int sy, const int* xofs,
+                                const float* alpha, int w, float* row) {
+    int pixel_size         = src_type == N8UC3 ? 3 : (src_type == N8UC4 ? 4 : 1);
+    const uint8_t* src_row = src + sy * src_w * pixel_size;
+    const uint8_t* vu_row  = src + src_w * src_h + (sy / 2) * src_w;
+    for (int dx = 0; dx < w; ++dx) {
+        int sx    = xofs[dx];
+        __m128 p0 = ResizeConvertLoadPixel<src_type>(src_row, vu_row, sx);
+        __m128 p1 = ResizeConvertLoadPixel<src_type>(src_row, vu_row, sx + 1);
+        _mm_storeu_ps(row + dx * 4, _mm_add_ps(p0, _mm_mul_ps(_mm_sub_ps(p1, p0), _mm_set1_ps(alpha[dx]))));
+    }
+}
+
+template <MatType src_type>
+static void ResizeConvertToNCHWImpl(const uint8_t* src, int batch, int src_w, int src_h, float* dst, int w, int h,
+                                    int channel, const float* scale, const float* bias, bool reverse_channel,
+                                    InterpType type) {
+    int src_size = src_w * src_h;
+    int src_step = src_type == N8UC3 ? src_size * 3 : (src_type == N8UC4 ? src_size * 4 : src_size * 3 / 2);
+    int hw       = h * w;
+
+    std::vector<int> xofs(w), yofs(h);
+    std::vector<float> alpha(w), beta(h);
+    bool nearest = type == INTERP_TYPE_NEAREST;
+    CalculatePositionAndRatio(w, (double)src_w / w, src_w, 1, nearest, xofs.data(), alpha.data());
+    CalculatePositionAndRatio(h, (double)src_h / h, src_h, 1, nearest, yofs.data(), beta.data());
+
+    // dst channel c is taken from pixel lane src_c[c]
+    int src_c[4] = {0, 1, 2, 3};
+    if (reverse_channel) {
+        std::swap(src_c[0], src_c[2]);
+    }
+    __m128 scale_v[4], bias_v[4];
+    for (int c = 0; c < channel; ++c) {
+        scale_v[c] = _mm_set1_ps(scale[c]);
+        bias_v[c]  = _mm_set1_ps(bias[c]);
+    }
+
+    // the two rows interpolated horizontally are kept for the next dst row of the thread
+    int max_num_threads = OMP_MAX_THREADS_NUM_;
+    std::vector<float> rows(w * 8 * max_num_threads);
+    std::vector<float*> rows0_t(max_num_threads), rows1_t(max_num_threads);
+    std::vector<int> prev_sy(max_num_threads);
+
+    for (int b = 0; b < batch; ++b) {
+        const uint8_t* src_b = src + b * src_step;
+        float* dst_b         = dst + b * channel * hw;
+        for (int t = 0; t < max_num_threads; ++t) {
+            prev_sy[t] = -2;
+            rows0_t[t] = rows.data() + t * w * 8;
+            rows1_t[t] = rows0_t[t] + w * 4;
+        }
+
+        OMP_PARALLEL_FOR_
+        for (int dy = 0; dy < h; dy++) {
+            int thread_id = OMP_TID_;
+            float*& rows0 = rows0_t[thread_id];
+            float*& rows1 = rows1_t[thread_id];
+            int sy        = yofs[dy];
+            if (sy == prev_sy[thread_id] + 1) {
+                std::swap(rows0, rows1);
+                ResizeConvertOneRow<src_type>(src_b, src_w, src_h, sy + 1, xofs.data(), alpha.data(), w, rows1);
+            } else if (sy != prev_sy[thread_id]) {
+                ResizeConvertOneRow<src_type>(src_b, src_w, src_h, sy, xofs.data(), alpha.data(), w, rows0);
+                ResizeConvertOneRow<src_type>(src_b, src_w, src_h, sy + 1, xofs.data(), alpha.data(), w, rows1);
+            }
+            prev_sy[thread_id] = sy;
+
+            // vertical interpolation of 4 pixels, transposed to 4 channels for the nchw planes
+            float* dst_row = dst_b + dy * w;
+            __m128 beta_v  = _mm_set1_ps(beta[dy]);
+            int dx         = 0;
+            for (; dx + 3 < w; dx += 4) {
+                __m128 v[4];
+                for (int i = 0; i < 4; ++i) {
+                    __m128 r0 = _mm_loadu_ps(rows0 + (dx + i) * 4);
+                    __m128 r1 = _mm_loadu_ps(rows1 + (dx + i) * 4);
+                    v[i]      = _mm_add_ps(r0, _mm_mul_ps(_mm_sub_ps(r1, r0), beta_v));
+                }
+                _MM_TRANSPOSE4_PS(v[0], v[1], v[2], v[3]);
+                for (int c = 0; c < channel; ++c) {
+                    _mm_storeu_ps(dst_row + c * hw + dx, _mm_add_ps(_mm_mul_ps(v[src_c[c]], scale_v[c]), bias_v[c]));
+                }
+            }
+            for (; dx < w; ++dx) {
+                for (int c = 0; c < channel; ++c) {
+                    float r0 = rows0[dx * 4 + src_c[c]];
+                    float r1 = rows1[dx * 4 + src_c[c]];
+                    dst_row[c * hw + dx] = scale[c] * (r0 + (r1 - r0) * beta[dy]) + bias[c];
+                }
+            }
+        }
+    }
+}
+
+#endif
+
+void ResizeConvertToNCHW(const uint8_t* src, int batch, int src_w, int src_h, MatType src_type, float* dst, int w,
+                         int h, int channel, const float* scale, const float* bias, bool reverse_channel,
+                         InterpType type) {
+#ifdef __SSE4_2__
+    if (src_type == N8UC3) {
+        ResizeConvertToNCHWImpl<N8UC3>(src, batch, src_w, src_h, dst, w, h, channel, scale, bias, reverse_channel,
+                                       type);
+    } else if (src_type == N8UC4) {
+        ResizeConvertToNCHWImpl<N8UC4>(src, batch, src_w, src_h, dst, w, h, channel, scale, bias, reverse_channel,
+                                       type);
+    } else if (src_type == NNV12) {
+        ResizeConvertToNCHWImpl<NNV12>(src, batch, src_w, src_h, dst, w, h, channel, scale, bias, reverse_channel,
+                                       type);
+    } else if (src_type == NNV21) {
+        ResizeConvertToNCHWImpl<NNV21>(src, batch, src_w, src_h, dst, w, h, channel, scale, bias, reverse_channel,
+                                       type);
+    }
+#else
+    NaiveResizeConvertToNCHW(src, batch, src_w, src_h, src_type, dst, w, h, channel, scale, bias, reverse_channel,
+                             type);
+#endif
+}
+
 #define INTER_REMAP_COEF_BITS 15
 #define INTER_REMAP_COEF_SCALE (1 << INTER_REMAP_COEF_BITS)
 #define INTER_BITS 5
@@ -21,6 +21,7 @@
 #include "tnn/core/blob.h"
 #include "tnn/core/macro.h"
 #include "tnn/utils/bfp16.h"
+#include "tnn/utils/mat_utils.h"
 
 namespace TNN_NS {
 
@@ -54,6 +55,11 @@ void ResizeNearestC3(const uint8_t* src, int batch, int src_w, int src_h, uint8_
 void ResizeNearestC4(const uint8_t* src, int batch, int src_w, int src_h, uint8_t* dst, int w, int h);
 void ResizeNearestYUV420sp(const uint8_t* src, int batch, int src_w, int src_h, uint8_t* dst, int w, int h);
 
+// resize a N8UC3, N8UC4, NNV12 or NNV21 image and convert it to a float nchw blob with scale and bias in one pass
+void ResizeConvertToNCHW(const uint8_t* src, int batch, int src_w, int src_h, MatType src_type, float* dst, int w,
+                         int h, int channel, const float* scale, const float* bias, bool reverse_channel,
+                         InterpType type);
+
 // warp affine
 void WarpAffineBilinearC1(const uint8_t* src, int batch, int src_w, int src_h, uint8_t* dst, int w, int h,
                           const float (*transform)[3], const float border_val = 0.0);
@@ -14,10 +14,12 @@
 
 #include "tnn/device/x86/x86_util.h"
 #include "tnn/device/x86/x86_common.h"
+#include "tnn/device/x86/x86_device.h"
 
 #include <type_traits>
 
 #include "tnn/core/macro.h"
+#include "tnn/utils/dims_utils.h"
 #include "tnn/utils/naive_compute.h"
 
 namespace TNN_NS {
@@ -110,6 +112,9 @@ int PackC4(float *dst, const float *src, size_t hw, size_t src_hw_stride, size_t
     return 0;
 }
 
+// PackC8 and UnpackC8 are only called by the avx2 kernels
+X86_AVX2_BEGIN
+
 #define _MM256_TRANSPOSE8(v0, v1, v2, v3, v4, v5, v6, v7) \
     __m256 t0 = _mm256_unpacklo_ps(v0, v1); \
     __m256 t1 = _mm256_unpackhi_ps(v0, v1); \
@@ -169,7 +174,6 @@ inline void PackC8_Left(float *dst, const float *src, size_t hw, size_t src_hw_s
     auto src5 = src + src_hw_stride * 5;
     auto src6 = src + src_hw_stride * 6;
     int cur_hw = 0;
-#ifdef __AVX2__
     __m256 v1 = _mm256_setzero_ps();
     __m256 v2 = _mm256_setzero_ps();
     __m256 v3 = _mm256_setzero_ps();
@@ -197,7 +201,6 @@ inline void PackC8_Left(float *dst, const float *src, size_t hw, size_t src_hw_s
         _mm256_storeu_ps(dst_hw + 48, t6);
         _mm256_storeu_ps(dst_hw + 56, t7);
     }
-#endif
     for (; cur_hw < hw; cur_hw++) {
         dst[cur_hw * 8 + 0] = src0[cur_hw];
         if (left_c > 1) {
@@ -246,7 +249,6 @@ int PackC8(float *dst, const float *src, size_t hw, size_t src_hw_stride, size_t
         auto src7 = src0 + src_hw_stride * 7;
         auto dst_c = dst + c * dst_hw_stride;
         int cur_hw = 0;
-#ifdef __AVX2__
         for (; cur_hw + 7 < hw; cur_hw += 8) {
             auto dst_hw = dst_c + cur_hw * 8;
             __m256 v0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src0 + cur_hw)),     _mm_loadu_ps(src4 + cur_hw), 1);
@@ -267,7 +269,6 @@ int PackC8(float *dst, const float *src, size_t hw, size_t src_hw_stride, size_t
             _mm256_storeu_ps(dst_hw + 48, v6);
             _mm256_storeu_ps(dst_hw + 56, v7);
         }
-#endif
         for (; cur_hw < hw; cur_hw++) {
             dst_c[cur_hw * 8 + 0] = src0[cur_hw];
             dst_c[cur_hw * 8 + 1] = src1[cur_hw];
@@ -298,6 +299,8 @@ int PackC8(float *dst, const float *src, size_t hw, size_t src_hw_stride, size_t
     return 0;
 }
 
+X86_AVX2_END
+
 template <int left_c>
 inline void UnpackC4_Left(float *dst, const float *src, size_t hw, size_t dst_hw_stride) {
     auto dst0 = dst;
@@ -361,6 +364,8 @@ int UnpackC4(float *dst, const float *src, size_t hw, size_t src_hw_stride, size
     return 0;
 }
 
+X86_AVX2_BEGIN
+
 template <int left_c>
 inline void UnpackC8_Left(float *dst, const float *src, size_t hw, size_t dst_hw_stride) {
     auto dst0 = dst;
@@ -371,7 +376,6 @@ inline void UnpackC8_Left(float *dst, const float *src, size_t hw, size_t dst_hw
     auto dst5 = dst + dst_hw_stride * 5;
     auto dst6 = dst + dst_hw_stride * 6;
     int cur_hw = 0;
-#ifdef __AVX2__
     for (; cur_hw + 7 < hw; cur_hw += 8) {
         auto src_hw = src + cur_hw * 8;
         __m256 v0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(src_hw)),      _mm_load_ps(src_hw + 32), 1);
@@ -391,7 +395,6 @@ inline void UnpackC8_Left(float *dst, const float *src, size_t hw, size_t dst_hw
         if(left_c > 5) _mm256_storeu_ps(dst5 + cur_hw, v5);
         if(left_c > 6) _mm256_storeu_ps(dst6 + cur_hw, v6);
     }
-#endif
     for (; cur_hw < hw; cur_hw++) {
         dst0[cur_hw] = src[cur_hw * 8 + 0];
         if (left_c > 1) dst1[cur_hw] = src[cur_hw * 8 + 1];
@@ -416,7 +419,6 @@ int UnpackC8(float *dst, const float *src, size_t hw, size_t src_hw_stride, size
         auto dst6 = dst0 + dst_hw_stride * 6;
         auto dst7 = dst0 + dst_hw_stride * 7;
         int cur_hw = 0;
-#ifdef __AVX2__
         for (; cur_hw + 7 < hw; cur_hw += 8) {
             auto src_hw = src_c + cur_hw * 8;
             __m256 v0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(src_hw)),      _mm_load_ps(src_hw + 32), 1);
@@ -437,7 +439,6 @@ int UnpackC8(float *dst, const float *src, size_t hw, size_t src_hw_stride, size
             _mm256_storeu_ps(dst6 + cur_hw, v6);
             _mm256_storeu_ps(dst7 + cur_hw, v7);
         }
-#endif
         for (; cur_hw < hw; cur_hw++) {
             dst0[cur_hw] = src_c[cur_hw * 8 + 0];
             dst1[cur_hw] = src_c[cur_hw * 8 + 1];
@@ -468,6 +469,78 @@ int UnpackC8(float *dst, const float *src, size_t hw, size_t src_hw_stride, size
     return 0;
 }
 
+X86_AVX2_END
+
+int PackNC8HW8(float *dst, const float *src, const DimsVector &dims) {
+    const int batch   = DimsFunctionUtils::GetDim(dims, 0);
+    const int channel = DimsFunctionUtils::GetDim(dims, 1);
+    const int c_r8    = ROUND_UP(channel, 8);
+    const int hw      = DimsVectorUtils::Count(dims, 2);
+    for (int b = 0; b < batch; b++) {
+        auto src_b = src + b * channel * hw;
+        auto dst_b = dst + b * c_r8 * hw;
+        if (X86Device::GetIsa() >= avx2) {
+            PackC8(dst_b, src_b, hw, hw, hw, channel);
+            continue;
+        }
+        for (int c = 0; c < c_r8; c++) {
+            auto dst_c = dst_b + (c / 8) * 8 * hw + c % 8;
+            if (c < channel) {
+                auto src_c = src_b + c * hw;
+                for (int i = 0; i < hw; i++) {
+                    dst_c[i * 8] = src_c[i];
+                }
+            } else {
+                for (int i = 0; i < hw; i++) {
+                    dst_c[i * 8] = 0.f;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+int UnpackNC8HW8(float *dst, const float *src, const DimsVector &dims) {
+    const int batch   = DimsFunctionUtils::GetDim(dims, 0);
+    const int channel = DimsFunctionUtils::GetDim(dims, 1);
+    const int c_r8    = ROUND_UP(channel, 8);
+    const int hw      = DimsVectorUtils::Count(dims, 2);
+    for (int b = 0; b < batch; b++) {
+        auto src_b = src + b * c_r8 * hw;
+        auto dst_b = dst + b * channel * hw;
+        // UnpackC8 loads src aligned
+        if (X86Device::GetIsa() >= avx2 && ((uintptr_t)src_b & 15) == 0) {
+            UnpackC8(dst_b, src_b, hw, hw, hw, channel);
+            continue;
+        }
+        for (int c = 0; c < channel; c++) {
+            auto src_c = src_b + (c / 8) * 8 * hw + c % 8;
+            auto dst_c = dst_b + c * hw;
+            for (int i = 0; i < hw; i++) {
+                dst_c[i] = src_c[i * 8];
+            }
+        }
+    }
+    return 0;
+}
+
+int ClearNC8HW8Padding(float *data, const DimsVector &dims) {
+    const int batch   = DimsFunctionUtils::GetDim(dims, 0);
+    const int channel = DimsFunctionUtils::GetDim(dims, 1);
+    const int c_r8    = ROUND_UP(channel, 8);
+    const int hw      = DimsVectorUtils::Count(dims, 2);
+    if (channel == c_r8) {
+        return 0;
+    }
+    for (int b = 0; b < batch; b++) {
+        auto block = data + (b * c_r8 + c_r8 - 8) * hw;
+        for (int i = 0; i < hw; i++) {
+            memset(block + i * 8 + channel % 8, 0, (8 - channel % 8) * sizeof(float));
+        }
+    }
+    return 0;
+}
+
 template<typename T>
 int MatTranspose(T *dst, const T *src, size_t M, size_t N) {
     for (size_t m = 0; m < M; m++) {
@@ -49,12 +49,21 @@ private:
 
 int PackC4(float *dst, const float *src, size_t hw, size_t src_hw_stride, size_t dst_hw_stride, size_t channel);
 
+// PackC8 and UnpackC8 are compiled for avx2, only call them when X86Device::GetIsa() >= avx2
 int PackC8(float *dst, const float *src, size_t hw, size_t src_hw_stride, size_t dst_hw_stride, size_t channel);
 
 int UnpackC4(float *dst, const float *src, size_t hw, size_t src_hw_stride, size_t dst_hw_stride, size_t channel);
 
 int UnpackC8(float *dst, const float *src, size_t hw, size_t src_hw_stride, size_t dst_hw_stride, size_t channel);
 
+// @brief convert float blob data between NCHW and NC8HW8, channels are padded to 8 with zero in NC8HW8
+int PackNC8HW8(float *dst, const float *src, const DimsVector &dims);
+
+int UnpackNC8HW8(float *dst, const float *src, const DimsVector &dims);
+
+// @brief set the padded channels of the last channel block of NC8HW8 data to zero
+int ClearNC8HW8Padding(float *data, const DimsVector &dims);
+
 template<typename T>
 int MatTranspose(T *dst, const T *src, size_t M, size_t N);
 
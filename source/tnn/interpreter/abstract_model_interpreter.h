@@ -35,6 +35,11 @@ public:
     // @brief different interpreter has different order param
     virtual Status Interpret(std::vector<std::string>& params) = 0;
 
+    // @brief interpret model by model config, the default implementation only interprets params
+    virtual Status Interpret(ModelConfig& config) {
+        return Interpret(config.params);
+    }
+
     // @brief copy interpreter
     virtual std::shared_ptr<AbstractModelInterpreter> Copy() {
         return nullptr;
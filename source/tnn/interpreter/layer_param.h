@@ -449,6 +449,9 @@ typedef enum {
     // nchw <-> nc8hw8 fp16
     NC8HW8FP16_2_NCHWFP16 = 8,
     NCHWFP16_2_NC8HW8FP16 = 9,
+    // nchw <-> nc8hw8 fp32 for x86
+    NCHWFP32_2_NC8HW8FP32 = 10,
+    NC8HW8FP32_2_NCHWFP32 = 11,
     // to be continued
 } ReformatType;
 
@@ -600,10 +603,32 @@ struct LSTMONNXLayerParam : public LayerParam {
     int hidden_size      = 0;
     //0: forword 1:reverse 2:bidirection
     int direction                        = 0;
+    // 1: keep h and c in the instance across forwards, the initial h and c are used after reset only
+    int stateful = 0;
 
     PARAM_COPY(LSTMONNXLayerParam)
 };
 
+struct GRULayerParam : public LayerParam {
+    float clip_threshold = 0;
+    int hidden_size      = 0;
+    //0: forword 1:reverse 2:bidirection
+    int direction = 0;
+    // 1: apply the linear transformation of h before multiplying by the reset gate
+    int linear_before_reset = 0;
+    // 1: keep h in the instance across forwards, the initial h is used after reset only
+    int stateful = 0;
+
+    PARAM_COPY(GRULayerParam)
+};
+
+// softmax(q x k^T * scale + mask) x v, fused from the matmul, softmax and eltwise layers of attention
+struct FusedAttentionLayerParam : public LayerParam {
+    float scale = 1.0f;
+
+    PARAM_COPY(FusedAttentionLayerParam)
+};
+
 struct ExpandLayerParam : public LayerParam {
     std::vector<int> shape;
 
@@ -410,46 +410,61 @@ class HdrGuideLayerResourceGenerator : public LayerResourceGenerator {
     }
 };
 
+// the weights and bias of recurrent layers are the inputs 1 to 3, they are filled as constants
+static Status GenRecurrentConstantResource(std::vector<Blob*>& inputs, ConstantResource* consts) {
+    auto fill_map_for_blob = [&](Blob *blob) {
+        if (blob == nullptr)
+            return;
+        auto blob_name = blob->GetBlobDesc().name;
+        auto data_type = blob->GetBlobDesc().data_type;
+        auto count = DimsVectorUtils::Count(blob->GetBlobDesc().dims);
+        if (consts->count(blob_name) > 0) {
+            return;
+        }
+        if (data_type == DATA_TYPE_FLOAT) {
+            auto buffer = std::make_shared<RawBuffer>(count * sizeof(float));
+            buffer->SetBufferDims(blob->GetBlobDesc().dims);
+            buffer->SetDataType(DATA_TYPE_FLOAT);
+            InitRandom(buffer->force_to<float *>(), count, 1.0f);
+            (*consts)[blob_name] = buffer;
+        } else if (data_type == DATA_TYPE_HALF) {
+            auto buffer = std::make_shared<RawBuffer>(count * sizeof(fp16_t));
+            buffer->SetBufferDims(blob->GetBlobDesc().dims);
+            buffer->SetDataType(DATA_TYPE_HALF);
+            InitRandom(buffer->force_to<fp16_t *>(), count, fp16_t(1));
+            (*consts)[blob_name] = buffer;
+        }
+    };
+
+    fill_map_for_blob(inputs[1]);
+    fill_map_for_blob(inputs[2]);
+    fill_map_for_blob(inputs[3]);
+
+    return TNN_OK;
+}
+
 class LSTMONNXLayerResourceGenerator : public LayerResourceGenerator {
     virtual Status GenLayerConstantResource(LayerParam* param, LayerResource** resource,
                                             std::vector<Blob*>& inputs, ConstantResource* consts) {
         LOGD("LSTMONNXLayerResourceGenerator\n");
         auto layer_param = dynamic_cast<LSTMONNXLayerParam*>(param);
         CHECK_PARAM_NULL(layer_param);
-        auto hidden_size = layer_param->hidden_size;
-        auto num_directions = layer_param->direction == 2? 2: 1;
-        auto input_size  = DimsVectorUtils::Count(inputs[0]->GetBlobDesc().dims, 2);
-
-        auto fill_map_for_blob = [&](Blob *blob) {
-            if (blob == nullptr)
-                return;
-            auto blob_name = blob->GetBlobDesc().name;
-            auto data_type = blob->GetBlobDesc().data_type;
-            auto count = DimsVectorUtils::Count(blob->GetBlobDesc().dims);
-            if (consts->count(blob_name) > 0) {
-                return;
-            }
-            if (data_type == DATA_TYPE_FLOAT) {
-                auto buffer = std::make_shared<RawBuffer>(count * sizeof(float));
-                buffer->SetBufferDims(blob->GetBlobDesc().dims);
-                buffer->SetDataType(DATA_TYPE_FLOAT);
-                InitRandom(buffer->force_to<float *>(), count, 1.0f);
-                (*consts)[blob_name] = buffer;
-            } else if (data_type == DATA_TYPE_HALF) {
-                auto buffer = std::make_shared<RawBuffer>(count * sizeof(fp16_t));
-                buffer->SetBufferDims(blob->GetBlobDesc().dims);
-                buffer->SetDataType(DATA_TYPE_HALF);
-                InitRandom(buffer->force_to<fp16_t *>(), count, fp16_t(1));
-                (*consts)[blob_name] = buffer;
-            }
-        };
-
-        fill_map_for_blob(inputs[1]);
-        fill_map_for_blob(inputs[2]);
-        fill_map_for_blob(inputs[3]);
+        return GenRecurrentConstantResource(inputs, consts);
+    }
 
+    virtual Status ConvertHalfLayerResource(LayerResource* fp16_res, LayerResource** fp32_res) {
         return TNN_OK;
     }
+};
+
+class GRULayerResourceGenerator : public LayerResourceGenerator {
+    virtual Status GenLayerConstantResource(LayerParam* param, LayerResource** resource,
+                                            std::vector<Blob*>& inputs, ConstantResource* consts) {
+        LOGD("GRULayerResourceGenerator\n");
+        auto layer_param = dynamic_cast<GRULayerParam*>(param);
+        CHECK_PARAM_NULL(layer_param);
+        return GenRecurrentConstantResource(inputs, consts);
+    }
 
     virtual Status ConvertHalfLayerResource(LayerResource* fp16_res, LayerResource** fp32_res) {
         return TNN_OK;
@@ -475,5 +490,6 @@ REGISTER_LAYER_RESOURCE(SquaredDifference, LAYER_SQUARED_DIFFERENCE);
 REGISTER_LAYER_RESOURCE(HdrGuide, LAYER_HDRGUIDE);
 
 REGISTER_LAYER_CONSTANT_RESOURCE(LSTMONNX, LAYER_LSTMONNX);
+REGISTER_LAYER_CONSTANT_RESOURCE(GRU, LAYER_GRU);
 
 }  // namespace TNN_NS
@@ -62,6 +62,11 @@ RawBuffer::RawBuffer(int bytes_size, char* buffer, DimsVector dims) : RawBuffer(
           this->dims_ = dims;
 }
 
+RawBuffer::RawBuffer(int bytes_size, shared_ptr<char> buffer) {
+    buff_       = bytes_size > 0 ? buffer : nullptr;
+    bytes_size_ = bytes_size;
+}
+
 RawBuffer::RawBuffer(const RawBuffer &buf) {
     this->bytes_size_ = buf.bytes_size_;
     this->data_type_  = buf.data_type_;
@@ -34,6 +34,8 @@ public:
     RawBuffer(int bytes_size, DimsVector dims);
     RawBuffer(int bytes_size, char *buffer);
     RawBuffer(int bytes_size, char* buffer, DimsVector dims);
+    // share the buffer without copy, eg. a region of the memory mapped model
+    RawBuffer(int bytes_size, shared_ptr<char> buffer);
     RawBuffer(const RawBuffer &buf);
     RawBuffer(int bytes_size, int alignment);
     RawBuffer &operator=(RawBuffer buf);
@@ -51,6 +51,9 @@ Status ConvLayerInterpreter::InterpretProto(str_arr layer_cfg_arr, int start_ind
     // activation
     GET_INT_1(p->activation_type);
 
+    // fusion, set by the optimizer
+    GET_INT_1(p->fusion_type);
+
     return TNN_OK;
 }
 
@@ -104,6 +107,9 @@ Status ConvLayerInterpreter::SaveProto(std::ofstream& output_stream, LayerParam*
     output_stream << layer_param->dialations[0] << " ";
 
     output_stream << layer_param->activation_type << " ";
+    if (layer_param->fusion_type != FusionType_None) {
+        output_stream << layer_param->fusion_type << " ";
+    }
 
     return TNN_OK;
 }
@@ -51,6 +51,12 @@ Status ReformatLayerInterpreter::InterpretProto(str_arr layer_cfg_arr, int start
         dst_type_value = atoi(layer_cfg_arr[index++].c_str());
     }
     layer_param->dst_type = GetDataType(dst_type_value);
+    // layout reformat layers are inserted by the optimizer, the formats are only
+    // saved with the optimized net
+    if (index + 1 < layer_cfg_arr.size()) {
+        layer_param->src_format = (DataFormat)atoi(layer_cfg_arr[index++].c_str());
+        layer_param->dst_format = (DataFormat)atoi(layer_cfg_arr[index++].c_str());
+    }
     return TNN_OK;
 }
 
@@ -62,6 +68,10 @@ Status ReformatLayerInterpreter::SaveProto(std::ofstream& output_stream, LayerPa
     auto layer_param = dynamic_cast<ReformatLayerParam*>(param);
     output_stream << layer_param->src_type << " ";
     output_stream << layer_param->dst_type << " ";
+    if (layer_param->src_format != layer_param->dst_format) {
+        output_stream << layer_param->src_format << " ";
+        output_stream << layer_param->dst_format << " ";
+    }
     return TNN_OK;
 }
 
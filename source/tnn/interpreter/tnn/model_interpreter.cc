@@ -32,7 +32,8 @@ std::string ModelInterpreter::Transfer(std::string content) {
 
 // Check if the magic number is valid.
 bool ModelInterpreter::IsValidVersionNumber(uint32_t number) {
-    return number == g_version_magic_number || number == g_version_magic_number_v2;
+    return number == g_version_magic_number || number == g_version_magic_number_v2 ||
+           number == g_version_magic_number_v3;
 }
 
 std::shared_ptr<Deserializer> ModelInterpreter::GetDeserializer(std::istream &is) {
@@ -105,6 +106,45 @@ Status ModelInterpreter::Interpret(std::vector<std::string> &params) {
     return status;
 }
 
+// Interpret the proto and the memory mapped model file.
+Status ModelInterpreter::Interpret(ModelConfig &config) {
+    if (!config.enable_mmap) {
+        return Interpret(config.params);
+    }
+    if (config.params.size() < 2) {
+        return Status(TNNERR_PARAM_ERR, "model file path is missing");
+    }
+
+    Status status = InterpretProto(config.params[0]);
+    if (status != TNN_OK) {
+        return status;
+    }
+
+    auto model_file = std::make_shared<MmapFile>();
+    status          = model_file->Map(config.params[1]);
+    if (status != TNN_OK) {
+        return status;
+    }
+    status = InterpretModel(model_file);
+    if (status != TNN_OK) {
+        return status;
+    }
+
+    // md5 of the model content, keep the same as loading model from content
+    MD5 model_md5;
+    const size_t block_size = 1 << 30;
+    for (size_t offset = 0; offset < model_file->GetSize(); offset += block_size) {
+        size_t length = std::min(block_size, model_file->GetSize() - offset);
+        model_md5.update(model_file->GetData() + offset, static_cast<MD5::size_type>(length));
+    }
+    params_md5_.push_back(md5(config.params[0]));
+    params_md5_.push_back(model_md5.finalize().hexdigest());
+    for (size_t i = 2; i < config.params.size(); ++i) {
+        params_md5_.push_back(md5(config.params[i]));
+    }
+    return status;
+}
+
 // Copy Interpreter
 std::shared_ptr<AbstractModelInterpreter> ModelInterpreter::Copy() {
     std::shared_ptr<AbstractModelInterpreter> interp(new ModelInterpreter(*this));
@@ -333,8 +373,6 @@ Status ModelInterpreter::InterpretLayer(const std::string &layer_str) {
 }
 
 Status ModelInterpreter::InterpretModel(std::string &model_content) {
-    NetResource *net_resource = GetNetResource();
-
     const auto model_length = model_content.length();
     if (model_length <= 0) {
 #ifdef GENERATE_RESOURCE
@@ -347,41 +385,45 @@ Status ModelInterpreter::InterpretModel(std::string &model_content) {
 
     std::istringstream content_stream;
     content_stream.str(model_content);
+    return InterpretModelStream(content_stream, GetDeserializer(content_stream));
+}
+
+/*
+ * The mapped model file is kept alive by the raw buffers sharing its memory,
+ * and unmapped after all of them are released.
+ */
+Status ModelInterpreter::InterpretModel(std::shared_ptr<MmapFile> model_file) {
+    std::shared_ptr<char> model_data(model_file, model_file->GetData());
+    MemoryStreamBuffer content_buffer(model_file->GetData(), model_file->GetSize());
+    std::istream content_stream(&content_buffer);
+    auto deserializer = std::make_shared<MmapDeserializer>(content_stream, model_data);
+    return InterpretModelStream(content_stream, deserializer);
+}
+
+Status ModelInterpreter::InterpretModelStream(std::istream &content_stream,
+                                              std::shared_ptr<Deserializer> deserializer) {
+    NetResource *net_resource = GetNetResource();
 
     uint32_t magic_version_number = 0;
     content_stream.read(reinterpret_cast<char *>(&magic_version_number), sizeof(g_version_magic_number));
+    if (magic_version_number == g_version_magic_number_v3) {
+        return InterpretModelV3(content_stream, deserializer);
+    }
     if (!IsValidVersionNumber(magic_version_number)) {
         content_stream.seekg(0, std::ios::beg);
     }
 
     res_header header;
-    auto deserializer = GetDeserializer(content_stream);
     header.deserialize(*deserializer);
     if (header.layer_cnt_ < 0 || header.layer_cnt_ >= 10000) {
         LOGE("tnnmodel is invalid, maybe you should upgrade TNN\n");
         return Status(TNNERR_INVALID_MODEL, "Error: model is illegal");
     }
-    
-    auto &layer_interpreter_map = GetLayerInterpreterMap();
+
     for (int index = 0; index < header.layer_cnt_; ++index) {
-        layer_header ly_head;
-        ly_head.deserialize(*deserializer);
-
-        LayerResource *layer_resource = NULL;
-        auto layer_interpreter        = layer_interpreter_map[ly_head.type_];
-        // refactor later, layer_interpreter NULL return error_code.
-        if (layer_interpreter != NULL) {
-            Status result = layer_interpreter->InterpretResource(*deserializer, &layer_resource);
-            if (result != TNN_OK) {
-                return result;
-            }
-            net_resource->resource_map[ly_head.name_] = std::shared_ptr<LayerResource>(layer_resource);
-        } else {
-            LOGE(
-                "Error: layer_interpreter nil name:%s type_from_str:%s "
-                "type:%d\n",
-                ly_head.name_.c_str(), ly_head.type_str_.c_str(), ly_head.type_);
-            return Status(TNNERR_LOAD_MODEL, "Error: layer_interpreter is nil");
+        Status result = InterpretLayerResource(deserializer);
+        if (result != TNN_OK) {
+            return result;
         }
     }
 
@@ -409,6 +451,96 @@ Status ModelInterpreter::InterpretModel(std::string &model_content) {
     return TNN_OK;
 }
 
+/*
+ * v3 model layout:
+ *   magic number | model_header_v3 | meta section | index section | data section
+ * The meta section has the same content as v2 model except that raw data records keep
+ * the offset of their data in the data section. Layer resources are located by the index,
+ * and the data section starts at a page aligned offset with every raw data 64 bytes aligned.
+ */
+Status ModelInterpreter::InterpretModelV3(std::istream &content_stream, std::shared_ptr<Deserializer> deserializer) {
+    NetResource *net_resource = GetNetResource();
+
+    model_header_v3 model_header;
+    model_header.deserialize(*deserializer);
+    if (!content_stream.good() || model_header.meta_offset_ <= 0 || model_header.index_offset_ <= 0 ||
+        model_header.data_offset_ <= 0) {
+        LOGE("tnnmodel v3 header is invalid\n");
+        return Status(TNNERR_INVALID_MODEL, "Error: model header is illegal");
+    }
+    deserializer->SetDataSection(model_header.data_offset_);
+
+    content_stream.seekg(model_header.meta_offset_, std::ios::beg);
+    res_header header;
+    header.deserialize(*deserializer);
+    if (header.layer_cnt_ < 0 || header.layer_cnt_ >= 10000) {
+        LOGE("tnnmodel is invalid, maybe you should upgrade TNN\n");
+        return Status(TNNERR_INVALID_MODEL, "Error: model is illegal");
+    }
+
+    content_stream.seekg(model_header.index_offset_, std::ios::beg);
+    int section_count = deserializer->GetInt();
+    if (!content_stream.good() || section_count < header.layer_cnt_ || section_count > header.layer_cnt_ + 1) {
+        LOGE("tnnmodel v3 index is invalid (section count: %d)\n", section_count);
+        return Status(TNNERR_INVALID_MODEL, "Error: model index is illegal");
+    }
+    std::vector<section_index> sections(section_count);
+    for (auto &section : sections) {
+        section.deserialize(*deserializer);
+    }
+
+    for (const auto &section : sections) {
+        content_stream.seekg(model_header.meta_offset_ + section.meta_offset_, std::ios::beg);
+        if (!section.name_.empty()) {
+            Status result = InterpretLayerResource(deserializer);
+            if (result != TNN_OK) {
+                return result;
+            }
+            continue;
+        }
+
+        uint32_t magic_number_ignore = deserializer->GetInt();
+        int const_map_size           = deserializer->GetInt();
+        ConstantResource const_map;
+        for (int ii = 0; ii < const_map_size; ii++) {
+            auto key    = deserializer->GetString();
+            auto buffer = std::make_shared<RawBuffer>();
+            deserializer->GetRaw(*(buffer.get()));
+
+            const_map[key] = buffer;
+        }
+        net_resource->constant_map = const_map;
+    }
+
+    return TNN_OK;
+}
+
+Status ModelInterpreter::InterpretLayerResource(std::shared_ptr<Deserializer> deserializer) {
+    NetResource *net_resource   = GetNetResource();
+    auto &layer_interpreter_map = GetLayerInterpreterMap();
+
+    layer_header ly_head;
+    ly_head.deserialize(*deserializer);
+
+    LayerResource *layer_resource = NULL;
+    auto layer_interpreter        = layer_interpreter_map[ly_head.type_];
+    // refactor later, layer_interpreter NULL return error_code.
+    if (layer_interpreter != NULL) {
+        Status result = layer_interpreter->InterpretResource(*deserializer, &layer_resource);
+        if (result != TNN_OK) {
+            return result;
+        }
+        net_resource->resource_map[ly_head.name_] = std::shared_ptr<LayerResource>(layer_resource);
+    } else {
+        LOGE(
+            "Error: layer_interpreter nil name:%s type_from_str:%s "
+            "type:%d\n",
+            ly_head.name_.c_str(), ly_head.type_str_.c_str(), ly_head.type_);
+        return Status(TNNERR_LOAD_MODEL, "Error: layer_interpreter is nil");
+    }
+    return TNN_OK;
+}
+
 Status ModelInterpreter::RegisterLayerInterpreter(LayerType type, AbstractLayerInterpreter *interpreter) {
     std::map<LayerType, std::shared_ptr<AbstractLayerInterpreter>> &layer_interpreter_map = GetLayerInterpreterMap();
     layer_interpreter_map[type] = std::shared_ptr<AbstractLayerInterpreter>(interpreter);
@@ -18,6 +18,7 @@
 #include <algorithm>
 #include "tnn/interpreter/default_model_interpreter.h"
 #include "tnn/interpreter/tnn/objseri.h"
+#include "tnn/utils/mmap_file.h"
 
 using namespace TNN_NS;
 namespace TNN_NS {
@@ -45,6 +46,69 @@ public:
     }
 };
 
+// header of v3 model, offsets are relative to the start of the model file
+struct model_header_v3 : public Serializable {
+    int alignment_       = g_model_v3_data_alignment;
+    int64_t meta_offset_  = 0;
+    int64_t meta_size_    = 0;
+    int64_t index_offset_ = 0;
+    int64_t index_size_   = 0;
+    int64_t data_offset_  = 0;
+    int64_t data_size_    = 0;
+
+public:
+    virtual void serialize(Serializer& out) {
+        out.PutInt(alignment_);
+        out.PutInt64(meta_offset_);
+        out.PutInt64(meta_size_);
+        out.PutInt64(index_offset_);
+        out.PutInt64(index_size_);
+        out.PutInt64(data_offset_);
+        out.PutInt64(data_size_);
+    }
+
+    virtual void deserialize(Deserializer& in) {
+        alignment_    = in.GetInt();
+        meta_offset_  = in.GetInt64();
+        meta_size_    = in.GetInt64();
+        index_offset_ = in.GetInt64();
+        index_size_   = in.GetInt64();
+        data_offset_  = in.GetInt64();
+        data_size_    = in.GetInt64();
+    }
+};
+
+// index entry of one layer resource in v3 model: offset of the layer meta in meta section,
+// offset and size of each raw data in data section. The constant map has an empty name.
+struct section_index : public Serializable {
+    std::string name_;
+    int64_t meta_offset_ = 0;
+    std::vector<std::pair<int64_t, int64_t>> tensors_;
+
+public:
+    virtual void serialize(Serializer& out) {
+        out.PutString(name_);
+        out.PutInt64(meta_offset_);
+        out.PutInt((int)tensors_.size());
+        for (const auto& tensor : tensors_) {
+            out.PutInt64(tensor.first);
+            out.PutInt64(tensor.second);
+        }
+    }
+
+    virtual void deserialize(Deserializer& in) {
+        name_        = in.GetString();
+        meta_offset_ = in.GetInt64();
+        int count    = in.GetInt();
+        tensors_.clear();
+        for (int i = 0; i < count; ++i) {
+            int64_t offset = in.GetInt64();
+            int64_t size   = in.GetInt64();
+            tensors_.push_back(std::make_pair(offset, size));
+        }
+    }
+};
+
 struct layer_header : public Serializable {
 public:
     layer_header() {
@@ -98,6 +162,10 @@ public:
     // model contents.
     virtual Status Interpret(std::vector<std::string>& params);
 
+    // @brief model interpreter load params is proto contents,
+    // model contents or model file path if mmap is enabled.
+    virtual Status Interpret(ModelConfig& config);
+
     static Status RegisterLayerInterpreter(LayerType type, AbstractLayerInterpreter* creator);
 
     // @brief get layer interpreter by layer type
@@ -109,6 +177,10 @@ public:
 protected:
     virtual Status InterpretProto(std::string& content);
     virtual Status InterpretModel(std::string& model_content);
+    virtual Status InterpretModel(std::shared_ptr<MmapFile> model_file);
+    virtual Status InterpretModelStream(std::istream& content_stream, std::shared_ptr<Deserializer> deserializer);
+    virtual Status InterpretModelV3(std::istream& content_stream, std::shared_ptr<Deserializer> deserializer);
+    virtual Status InterpretLayerResource(std::shared_ptr<Deserializer> deserializer);
     virtual Status InterpretInput(const std::string& inputs_content);
     virtual Status InterpretOutput(const std::string& outputs_content);
     virtual Status InterpretLayer(const std::string& layer_str);
@@ -14,6 +14,8 @@
 
 #include "tnn/interpreter/tnn/model_packer.h"
 
+#include <sstream>
+
 #include "tnn/interpreter/tnn/layer_interpreter/abstract_layer_interpreter.h"
 #include "tnn/interpreter/tnn/model_interpreter.h"
 #include "tnn/interpreter/tnn/objseri.h"
@@ -180,6 +182,10 @@ Status ModelPacker::PackProto(std::string file_path) {
 }
 
 Status ModelPacker::PackModel(std::string file_path) {
+    if (model_version_ == 3) {
+        return PackModelV3(file_path);
+    }
+
     NetResource *net_resource = GetNetResource();
     NetStructure *net_struct  = GetNetStructure();
     std::ofstream write_stream;
@@ -238,6 +244,97 @@ Status ModelPacker::PackModel(std::string file_path) {
     return TNN_OK;
 }
 
+Status ModelPacker::PackModelV3(std::string file_path) {
+    NetResource *net_resource = GetNetResource();
+    std::ofstream write_stream;
+    write_stream.open(file_path, std::ios::binary);
+    if (!write_stream || !write_stream.is_open() || !write_stream.good()) {
+        write_stream.close();
+        LOGE("invalid model file name! (%s)\n", file_path.c_str());
+        return Status(TNNERR_PACK_MODEL, "model file cannot be written");
+    }
+
+    // meta section is the same as v2 model, raw data is written to the data section
+    std::ostringstream meta_stream;
+    std::ostringstream data_stream;
+    auto aligned_serializer                = std::make_shared<AlignedSerializer>(meta_stream, data_stream);
+    std::shared_ptr<Serializer> serializer = aligned_serializer;
+
+    res_header header;
+    int resource_count = 0;
+    auto ret           = PackLayers(serializer, false, resource_count);
+    if (ret != TNN_OK) {
+        write_stream.close();
+        return ret;
+    }
+    header.layer_cnt_ = resource_count;
+    header.serialize(*serializer);
+
+    ret = PackLayers(serializer, true, resource_count);
+    if (ret != TNN_OK) {
+        write_stream.close();
+        return ret;
+    }
+
+    auto const_map = net_resource->constant_map;
+    if (const_map.size() > 0) {
+        serializer->BeginSection("");
+        serializer->PutInt(g_version_magic_number_v3);
+        serializer->PutInt((int)const_map.size());
+        for (const auto &iter : const_map) {
+            serializer->PutString(iter.first);
+            serializer->PutRaw(*(iter.second.get()));
+        }
+    }
+
+    std::ostringstream index_stream;
+    Serializer index_serializer(index_stream);
+    auto &sections = aligned_serializer->GetSections();
+    index_serializer.PutInt((int)sections.size());
+    for (const auto &section : sections) {
+        section_index index;
+        index.name_        = section.name;
+        index.meta_offset_ = section.meta_offset;
+        index.tensors_     = section.tensors;
+        index.serialize(index_serializer);
+    }
+
+    std::ostringstream header_stream;
+    Serializer header_serializer(header_stream);
+    model_header_v3 model_header;
+    model_header.serialize(header_serializer);
+
+    const std::string meta  = meta_stream.str();
+    const std::string index = index_stream.str();
+    const std::string data  = data_stream.str();
+
+    model_header.meta_offset_  = sizeof(uint32_t) + header_stream.str().size();
+    model_header.meta_size_    = meta.size();
+    model_header.index_offset_ = model_header.meta_offset_ + model_header.meta_size_;
+    model_header.index_size_   = index.size();
+    model_header.data_offset_  = (model_header.index_offset_ + model_header.index_size_ + g_model_v3_section_alignment -
+                                 1) / g_model_v3_section_alignment * g_model_v3_section_alignment;
+    model_header.data_size_    = aligned_serializer->GetDataSize();
+
+    uint32_t magic_number = g_version_magic_number_v3;
+    write_stream.write(reinterpret_cast<char *>(&magic_number), sizeof(uint32_t));
+    Serializer file_serializer(write_stream);
+    model_header.serialize(file_serializer);
+    write_stream.write(meta.data(), meta.size());
+    write_stream.write(index.data(), index.size());
+    std::vector<char> padding(model_header.data_offset_ - model_header.index_offset_ - model_header.index_size_, 0);
+    write_stream.write(padding.data(), padding.size());
+    write_stream.write(data.data(), data.size());
+
+    if (!write_stream.good()) {
+        write_stream.close();
+        LOGE("write model file failed! (%s)\n", file_path.c_str());
+        return Status(TNNERR_PACK_MODEL, "model file write failed");
+    }
+    write_stream.close();
+    return TNN_OK;
+}
+
 Status ModelPacker::PackLayers(std::shared_ptr<Serializer> &serializer, bool save_resource, int &resource_count) {
     resource_count = 0;
 
@@ -319,6 +416,7 @@ Status ModelPacker::PackResource(std::map<std::string, std::shared_ptr<LayerReso
     ly_header.type_                = layer_info->type;
     ly_header.type_str_            = layer_info->type_str;
     static int resource_pack_count = 0;
+    serializer->BeginSection(ly_header.name_);
     ly_header.serialize(*serializer);
     LayerResource *layer_resource = iter->second.get();
     auto layer_interpreter        = layer_interpreter_map[layer_info->type];
@@ -29,13 +29,15 @@ public:
     // @brief save the rpn model into files
     virtual Status Pack(std::string proto_path, std::string model_path);
 
-    // @brief set the model version to pack
+    // @brief set the model version to pack, version 3 packs the model into the
+    // v3 container with tensor index and aligned raw data
     void SetVersion(int version);
 
 private:
     std::shared_ptr<LayerInfo> FindLayerInfo(std::string layer_name);
     Status PackProto(std::string file_path);
     Status PackModel(std::string file_path);
+    Status PackModelV3(std::string file_path);
     Status PackLayers(std::shared_ptr<Serializer> &serializer, bool save_resource, int &resource_count);
     Status PackResource(std::map<std::string, std::shared_ptr<LayerResource>> &resource_map, std::string &layer_name,
                         std::shared_ptr<Serializer> &serializer);
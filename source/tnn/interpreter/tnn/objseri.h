@@ -17,10 +17,15 @@
 
 #include <string>
 #include <fstream>
+#include <memory>
+#include <streambuf>
 #include <string>
 #include <typeinfo>
+#include <utility>
+#include <vector>
 #include "tnn/core/common.h"
 #include "tnn/interpreter/raw_buffer.h"
+#include "tnn/utils/data_type_utils.h"
 
 #define BLOB_SCALE_SUFFIX "_scale_data_"
 
@@ -28,6 +33,10 @@
 namespace TNN_NS {
     static const uint32_t g_version_magic_number = 0x0FABC0002;
     static const uint32_t g_version_magic_number_v2 = 0x0FABC0004;
+    // v3 model: header, layer meta, tensor index and aligned raw data sections
+    static const uint32_t g_version_magic_number_v3 = 0x0FABC0006;
+    static const int g_model_v3_data_alignment      = 64;
+    static const int g_model_v3_section_alignment   = 4096;
 
     class Serializer {
     public:
@@ -42,6 +51,9 @@ namespace TNN_NS {
         void PutInt(int value) {
             return put_basic_t<int>(value);
         }
+        void PutInt64(int64_t value) {
+            return put_basic_t<int64_t>(value);
+        }
         void PutString(const std::string &value) {
             return PutString_t<std::string>(value);
         }
@@ -54,7 +66,7 @@ namespace TNN_NS {
             PutRaw(length, buffer, dims, data_type);
         }
         
-        void PutRaw(int length, char* buffer, std::vector<int> dims, DataType data_type = DATA_TYPE_FLOAT)
+        virtual void PutRaw(int length, char* buffer, std::vector<int> dims, DataType data_type = DATA_TYPE_FLOAT)
         {
             PutInt(g_version_magic_number_v2);
             PutInt(data_type);
@@ -76,6 +88,8 @@ namespace TNN_NS {
             return;
         }
 
+        // @brief mark the start of the resource of one layer, used by serializers with index
+        virtual void BeginSection(const std::string &name) {}
 
     protected:
         std::ostream &_ostream;
@@ -122,6 +136,9 @@ namespace TNN_NS {
         int GetInt() {
             return get_basic_t<int>();
         }
+        int64_t GetInt64() {
+            return get_basic_t<int64_t>();
+        }
         std::string GetString() {
             return get_string_t<std::string>();
         }
@@ -139,21 +156,14 @@ namespace TNN_NS {
         }
 
         virtual void GetRaw(TNN_NS::RawBuffer &value) {
-            auto magic_number  = static_cast<uint32_t>(GetInt());
-            auto data_type = (TNN_NS::DataType)GetInt();
-            int length = GetInt();
-            if (length <= 0) {
+            DataType data_type;
+            int length;
+            DimsVector dims;
+            std::streamoff data_offset;
+            if (!GetRawHeader(data_type, length, dims, data_offset)) {
                 return;
             }
 
-            DimsVector dims;
-            if(magic_number == g_version_magic_number_v2) {
-                int size = GetInt();
-                for (int i = 0; i < size; ++i) {
-                    dims.push_back(GetInt());
-                }
-            }
- 
             value = TNN_NS::RawBuffer(length);
             value.SetDataType(data_type);
             value.SetBufferDims(dims);
@@ -161,13 +171,50 @@ namespace TNN_NS {
             char *buffer = value.force_to<char *>();
             if (_istream.eof())
                 return;
-            
+
+            if (data_offset < 0) {
+                _istream.read(buffer, static_cast<std::streamsize>(length));
+                return;
+            }
+            const auto pos_cur = _istream.tellg();
+            _istream.seekg(_data_section + data_offset, std::ios::beg);
             _istream.read(buffer, static_cast<std::streamsize>(length));
+            _istream.seekg(pos_cur, std::ios::beg);
             return;
         }
 
+        // @brief set the stream offset of the raw data section of v3 model
+        void SetDataSection(std::streamoff offset) {
+            _data_section = offset;
+        }
+
     protected:
         std::istream &_istream;
+        std::streamoff _data_section = 0;
+
+        // read the header of raw buffer, return false if the raw buffer is empty.
+        // data_offset is the offset of raw data in the data section for v3 model, or -1 if the
+        // raw data follows the header.
+        bool GetRawHeader(DataType &data_type, int &length, DimsVector &dims, std::streamoff &data_offset) {
+            auto magic_number = static_cast<uint32_t>(GetInt());
+            data_type         = (TNN_NS::DataType)GetInt();
+            length            = GetInt();
+            data_offset       = -1;
+            if (length <= 0) {
+                return false;
+            }
+
+            if (magic_number == g_version_magic_number_v2 || magic_number == g_version_magic_number_v3) {
+                int size = GetInt();
+                for (int i = 0; i < size; ++i) {
+                    dims.push_back(GetInt());
+                }
+            }
+            if (magic_number == g_version_magic_number_v3) {
+                data_offset = static_cast<std::streamoff>(GetInt64());
+            }
+            return true;
+        }
         
         template <typename T>
         T get_basic_t();
@@ -204,6 +251,140 @@ namespace TNN_NS {
         return value;
     }
 
+    // @brief read only stream buffer on a memory block, the memory is not copied
+    class MemoryStreamBuffer : public std::streambuf {
+    public:
+        MemoryStreamBuffer(char *data, size_t size) {
+            setg(data, data, data + size);
+        }
+
+    protected:
+        virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                                 std::ios_base::openmode which = std::ios_base::in) {
+            char *target = egptr() + off;
+            if (dir == std::ios_base::beg) {
+                target = eback() + off;
+            } else if (dir == std::ios_base::cur) {
+                target = gptr() + off;
+            }
+            if (target < eback() || target > egptr()) {
+                return pos_type(off_type(-1));
+            }
+            setg(eback(), target, egptr());
+            return pos_type(target - eback());
+        }
+
+        virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which = std::ios_base::in) {
+            return seekoff(off_type(pos), std::ios_base::beg, which);
+        }
+    };
+
+    // @brief MmapDeserializer reads model from memory mapped file. Raw data aligned
+    // to its element size is shared with the mapping instead of copied.
+    class MmapDeserializer : public Deserializer {
+    public:
+        MmapDeserializer(std::istream &is, std::shared_ptr<char> base) : Deserializer(is), _base(base) {}
+
+        virtual void GetRaw(TNN_NS::RawBuffer &value) {
+            DataType data_type;
+            int length;
+            DimsVector dims;
+            std::streamoff data_offset;
+            if (!GetRawHeader(data_type, length, dims, data_offset)) {
+                return;
+            }
+
+            const auto pos_cur = _istream.tellg();
+            if (data_offset >= 0) {
+                _istream.seekg(_data_section + data_offset, std::ios::beg);
+            }
+            std::streamoff offset = _istream.tellg();
+            char *buffer          = _base.get() + offset;
+            int element_size      = DataTypeUtils::GetBytesSize(data_type);
+            if (offset >= 0 && element_size > 0 && reinterpret_cast<uintptr_t>(buffer) % element_size == 0 &&
+                _istream.rdbuf()->in_avail() >= length) {
+                value = TNN_NS::RawBuffer(length, std::shared_ptr<char>(_base, buffer));
+                _istream.seekg(length, std::ios::cur);
+            } else {
+                value = TNN_NS::RawBuffer(length);
+                _istream.read(value.force_to<char *>(), static_cast<std::streamsize>(length));
+            }
+            if (data_offset >= 0) {
+                _istream.seekg(pos_cur, std::ios::beg);
+            }
+            value.SetDataType(data_type);
+            value.SetBufferDims(dims);
+        }
+
+    protected:
+        std::shared_ptr<char> _base;
+    };
+
+    // @brief AlignedSerializer writes v3 model. Raw data goes to a separate data stream with
+    // every record aligned to g_model_v3_data_alignment, and the record header keeps its offset.
+    // The raw data records of each section are collected to build the tensor index.
+    class AlignedSerializer : public Serializer {
+    public:
+        struct Section {
+            std::string name;
+            int64_t meta_offset;
+            std::vector<std::pair<int64_t, int64_t>> tensors;
+        };
+
+        AlignedSerializer(std::ostream &os, std::ostream &data_os) : Serializer(os), _data_ostream(data_os) {}
+
+        using Serializer::PutRaw;
+        virtual void PutRaw(int length, char *buffer, std::vector<int> dims, DataType data_type = DATA_TYPE_FLOAT) {
+            PutInt(g_version_magic_number_v3);
+            PutInt(data_type);
+            PutInt(static_cast<int>(length));
+            if (length <= 0) {
+                return;
+            }
+
+            PutInt((int)(dims.size()));
+            if (dims.size() > 0) {
+                _ostream.write(reinterpret_cast<char *>(dims.data()),
+                               static_cast<std::streamsize>(dims.size() * sizeof(int32_t)));
+            }
+
+            int64_t padding = (g_model_v3_data_alignment - _data_size % g_model_v3_data_alignment) %
+                              g_model_v3_data_alignment;
+            if (padding > 0) {
+                std::vector<char> zeros(padding, 0);
+                _data_ostream.write(zeros.data(), static_cast<std::streamsize>(padding));
+                _data_size += padding;
+            }
+            PutInt64(_data_size);
+            if (!_sections.empty()) {
+                _sections.back().tensors.push_back(std::make_pair(_data_size, (int64_t)length));
+            }
+
+            _data_ostream.write(buffer, static_cast<std::streamsize>(length));
+            _data_size += length;
+        }
+
+        virtual void BeginSection(const std::string &name) {
+            Section section;
+            section.name        = name;
+            section.meta_offset = static_cast<int64_t>(_ostream.tellp());
+            _sections.push_back(section);
+        }
+
+        std::vector<Section> &GetSections() {
+            return _sections;
+        }
+
+        int64_t GetDataSize() {
+            return _data_size;
+        }
+
+    protected:
+        std::ostream &_data_ostream;
+        int64_t _data_size = 0;
+        std::vector<Section> _sections;
+    };
+
     class Serializable {
     public:
         Serializable() {}
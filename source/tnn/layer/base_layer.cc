@@ -43,6 +43,8 @@ Status BaseLayer::Init(Context* context, LayerParam* param, LayerResource* resou
 
     param_    = param;
     resource_ = resource;
+    context_  = context;
+    device_   = device;
 
     auto status = InferOutputDataType();
     if (status != TNN_OK) {
@@ -72,20 +74,29 @@ Status BaseLayer::Init(Context* context, LayerParam* param, LayerResource* resou
     }
     
     if (device->GetDeviceType() == DEVICE_NAIVE || !IsOutputConstant()) {
-        layer_acc_ = device->CreateLayerAcc(type_);
-        if (layer_acc_ != NULL) {
-            layer_acc_->SetRuntimeMode(runtime_model_);
-            layer_acc_->SetConstantResource(const_resource_);
-            layer_acc_->SetConstantResourceFlag(const_resource_flag_);
-            return layer_acc_->Init(context, param, resource, input_blobs_, output_blobs_);
-        } else {
-            LOGE("layer acc of type(%d) is nil\n", type_);
-            return Status(TNNERR_LAYER_ERR, "layer acc is nil");
-        }
+        return CreateLayerAcc(&layer_acc_);
     }
     return TNN_OK;
 }
 
+Status BaseLayer::CreateLayerAcc(AbstractLayerAcc** layer_acc) {
+    *layer_acc = device_->CreateLayerAcc(type_);
+    if (*layer_acc == NULL) {
+        LOGE("layer acc of type(%d) is nil\n", type_);
+        return Status(TNNERR_LAYER_ERR, "layer acc is nil");
+    }
+    (*layer_acc)->SetRuntimeMode(runtime_model_);
+    (*layer_acc)->SetConstantResource(const_resource_);
+    (*layer_acc)->SetConstantResourceFlag(const_resource_flag_);
+    return (*layer_acc)->Init(context_, param_, resource_, input_blobs_, output_blobs_);
+}
+
+AbstractLayerAcc* BaseLayer::SwapLayerAcc(AbstractLayerAcc* layer_acc) {
+    auto old_layer_acc = layer_acc_;
+    layer_acc_         = layer_acc;
+    return old_layer_acc;
+}
+
 Status BaseLayer::FillLayerParamWithConstantResource() {
     return TNN_OK;
 }
@@ -162,7 +173,7 @@ Status BaseLayer::InferOutputDataType() {
     return TNN_OK;
 }
 
-Status BaseLayer::Reshape() {
+Status BaseLayer::InferShape() {
     if (!output_blobs_[0]->NeedAllocateInForward()){
         auto status = InferOutputShape();
         RETURN_ON_NEQ(status, TNN_OK);
@@ -175,9 +186,15 @@ Status BaseLayer::Reshape() {
             }
         }
     }
+    return TNN_OK;
+}
+
+Status BaseLayer::Reshape() {
+    auto status = InferShape();
+    RETURN_ON_NEQ(status, TNN_OK);
 
     if (layer_acc_ != NULL) {
-        auto status = layer_acc_->ReloadConstantBlobs(input_blobs_, true);
+        status = layer_acc_->ReloadConstantBlobs(input_blobs_, true);
         RETURN_ON_NEQ(status, TNN_OK);
         return layer_acc_->Reshape(input_blobs_, output_blobs_);
     } else {
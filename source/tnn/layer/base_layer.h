@@ -46,6 +46,15 @@ public:
     //@brief Reshape recalculate the output tensor dims
     virtual Status Reshape();
 
+    //@brief recalculate the output tensor dims without reshaping the layer acc
+    Status InferShape();
+
+    //@brief create a new layer acc and init it for the current tensor dims, the caller owns it
+    Status CreateLayerAcc(AbstractLayerAcc** layer_acc);
+
+    //@brief replace the layer acc, the caller owns the one returned
+    AbstractLayerAcc* SwapLayerAcc(AbstractLayerAcc* layer_acc);
+
     //@brief layer infer
     virtual Status Forward();
 
@@ -90,6 +99,8 @@ protected:
     std::vector<Blob*> input_blobs_;
     std::vector<Blob*> output_blobs_;
     AbstractLayerAcc* layer_acc_;
+    Context* context_       = nullptr;
+    AbstractDevice* device_ = nullptr;
 
     LayerParam* param_;
     LayerResource* resource_;
@@ -0,0 +1,84 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/layer/base_layer.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+DECLARE_LAYER(FusedAttention, LAYER_FUSED_ATTENTION);
+
+Status FusedAttentionLayer::InferOutputDataType() {
+    return BaseLayer::InferOutputDataType();
+}
+
+// @brief broadcast the batch dims of b into batch_dims, dims are right aligned
+static Status BroadcastBatchDims(DimsVector &batch_dims, const DimsVector &b) {
+    if (b.size() > batch_dims.size()) {
+        batch_dims.insert(batch_dims.begin(), b.size() - batch_dims.size(), 1);
+    }
+    const int offset = (int)(batch_dims.size() - b.size());
+    for (int i = 0; i < b.size(); ++i) {
+        int &dim = batch_dims[offset + i];
+        if (dim == 1) {
+            dim = b[i];
+        } else if (b[i] != 1 && b[i] != dim) {
+            return Status(TNNERR_PARAM_ERR, "FusedAttention has inputs of unbroadcastable batch dims");
+        }
+    }
+    return TNN_OK;
+}
+
+// inputs are q [..., seq_q, depth], k^T [..., depth, seq_k], v [..., seq_k, depth_v] and an optional
+// additive mask broadcast to the scores [..., seq_q, seq_k], output is [..., seq_q, depth_v]
+Status FusedAttentionLayer::InferOutputShape(bool ignore_error) {
+    BaseLayer::InferOutputShape(ignore_error);
+
+    if (input_blobs_.size() < 3) {
+        return Status(TNNERR_PARAM_ERR, "FusedAttention has invalid inputs");
+    }
+    auto q_dims  = input_blobs_[0]->GetBlobDesc().dims;
+    auto kt_dims = input_blobs_[1]->GetBlobDesc().dims;
+    auto v_dims  = input_blobs_[2]->GetBlobDesc().dims;
+    if (q_dims.size() < 2 || kt_dims.size() < 2 || v_dims.size() < 2 || q_dims.back() != kt_dims[kt_dims.size() - 2] ||
+        kt_dims.back() != v_dims[v_dims.size() - 2]) {
+        return Status(TNNERR_PARAM_ERR, "FusedAttention has wrong shape of q, k or v");
+    }
+
+    DimsVector batch_dims(q_dims.begin(), q_dims.end() - 2);
+    RETURN_ON_NEQ(BroadcastBatchDims(batch_dims, DimsVector(kt_dims.begin(), kt_dims.end() - 2)), TNN_OK);
+    RETURN_ON_NEQ(BroadcastBatchDims(batch_dims, DimsVector(v_dims.begin(), v_dims.end() - 2)), TNN_OK);
+
+    auto output_dims = batch_dims;
+    output_dims.push_back(q_dims[q_dims.size() - 2]);
+    output_dims.push_back(v_dims.back());
+
+    if (input_blobs_.size() >= 4) {
+        // the mask is broadcast to the scores, not the other way round
+        auto scores_dims = batch_dims;
+        scores_dims.push_back(q_dims[q_dims.size() - 2]);
+        scores_dims.push_back(kt_dims.back());
+        auto mask_scores_dims = scores_dims;
+        RETURN_ON_NEQ(BroadcastBatchDims(mask_scores_dims, input_blobs_[3]->GetBlobDesc().dims), TNN_OK);
+        if (!DimsVectorUtils::Equal(mask_scores_dims, scores_dims)) {
+            return Status(TNNERR_PARAM_ERR, "FusedAttention has wrong shape of mask");
+        }
+    }
+
+    output_blobs_[0]->GetBlobDesc().dims = output_dims;
+    return TNN_OK;
+}
+
+REGISTER_LAYER(FusedAttention, LAYER_FUSED_ATTENTION);
+
+}  // namespace TNN_NS
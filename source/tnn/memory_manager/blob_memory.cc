@@ -14,11 +14,15 @@
 
 #include "tnn/memory_manager/blob_memory.h"
 
+#include <limits.h>
+
 namespace TNN_NS {
 
 BlobMemory::BlobMemory(AbstractDevice* device, BlobMemorySizeInfo& size_info, int use_count)
     : device_(device), size_info_(size_info), use_count_(use_count) {
     need_release_memory_ = false;
+    first_use_           = 0;
+    last_use_            = INT_MAX;
 }
 BlobMemory::~BlobMemory() {
     if (need_release_memory_) {
@@ -69,4 +73,17 @@ BlobHandle BlobMemory::GetHandle() {
     return handle_;
 }
 
+void BlobMemory::SetLiveInterval(int first_use, int last_use) {
+    first_use_ = first_use;
+    last_use_  = last_use;
+}
+
+int BlobMemory::GetFirstUse() const {
+    return first_use_;
+}
+
+int BlobMemory::GetLastUse() const {
+    return last_use_;
+}
+
 }  // namespace TNN_NS
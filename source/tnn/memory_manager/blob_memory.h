@@ -36,6 +36,11 @@ public:
     void SetHandleFromExternal(BlobHandle handle);
     BlobHandle GetHandle();
 
+    // liveness interval [first_use, last_use] in layer index of the blob holding this memory
+    void SetLiveInterval(int first_use, int last_use);
+    int GetFirstUse() const;
+    int GetLastUse() const;
+
 protected:
     BlobMemorySizeInfo size_info_;
 
@@ -47,6 +52,8 @@ private:
     BlobHandle handle_;
     bool need_release_memory_;
     int use_count_;
+    int first_use_;
+    int last_use_;
 };
 
 }  // namespace TNN_NS
@@ -44,8 +44,17 @@ AbstractDevice *BlobMemoryPool::GetDevice() {
     return device_;
 }
 
+void BlobMemoryPool::SetMemoryPlanMode(MemoryPlanMode mode) {
+    memory_plan_mode_ = mode;
+}
+
+MemoryPlanMode BlobMemoryPool::GetMemoryPlanMode() {
+    return memory_plan_mode_;
+}
+
 BlobMemory *BlobMemoryPool::BorrowBlobMemory(int use_count, BlobMemorySizeInfo &size_info, bool use_new_memory) {
-    if (use_new_memory) {
+    // blob memory is never reused in offset plan mode, the arena offsets are shared instead
+    if (use_new_memory || memory_plan_mode_ == MEMORY_PLAN_MODE_OFFSET) {
         BlobMemory *blob_memory = CreateBlobMemory(use_count, size_info);
         blob_memory_library_.insert(blob_memory);
         return blob_memory;
@@ -67,6 +76,9 @@ BlobMemory *BlobMemoryPool::BorrowBlobMemory(int use_count, BlobMemorySizeInfo &
 
 void BlobMemoryPool::RefundBlobMemory(BlobMemory *blob_memory) {
     ASSERT(blob_memory != NULL);
+    if (memory_plan_mode_ == MEMORY_PLAN_MODE_OFFSET) {
+        return;
+    }
     DataType data_type          = blob_memory->GetBlobMemorySizeInfo().data_type;
     BlobMemoryNode *list_header = GetBlobMemoryNodeListHeader(data_type);
     BlobMemoryNode *new_header  = new BlobMemoryNode();
@@ -126,6 +138,12 @@ int BlobMemoryPool::GetAllBlobMemorySize() {
 }
 
 void BlobMemoryPool::CalculateAllBlobMemorySize() {
+    if (memory_plan_mode_ == MEMORY_PLAN_MODE_OFFSET) {
+        std::map<BlobMemory *, int> offsets;
+        all_blob_memory_size_ = MemoryOffsetAssignStrategy::PlanBlobMemoryOffset(blob_memory_library_, offsets);
+        return;
+    }
+
     typename std::set<BlobMemory *>::iterator iter;
     all_blob_memory_size_ = 0;
     for (auto iter : blob_memory_library_) {
@@ -20,6 +20,7 @@
 
 #include "tnn/core/abstract_device.h"
 #include "tnn/memory_manager/blob_memory.h"
+#include "tnn/memory_manager/memory_offset_assign_strategy.h"
 #include "tnn/memory_manager/memory_seperate_assign_strategy.h"
 #include "tnn/memory_manager/memory_unify_assign_strategy.h"
 
@@ -39,6 +40,8 @@ public:
     Status AssignAllBlobMemory(MemoryAssignStrategy &strategy);
     virtual void ClearBlobMemoryPool();
     AbstractDevice *GetDevice();
+    void SetMemoryPlanMode(MemoryPlanMode mode);
+    MemoryPlanMode GetMemoryPlanMode();
 protected:
     AbstractDevice *device_ = nullptr;
     void ReleaseBlobMemoryNodeList(BlobMemoryNode *list_header);
@@ -58,6 +61,7 @@ private:
 
     int all_blob_memory_size_ = 0;;
     std::set<BlobMemory *> blob_memory_library_ = {};
+    MemoryPlanMode memory_plan_mode_ = MEMORY_PLAN_MODE_DEFAULT;
 };
 
 }  // namespace TNN_NS
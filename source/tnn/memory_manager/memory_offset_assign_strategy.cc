@@ -0,0 +1,119 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/memory_manager/memory_offset_assign_strategy.h"
+
+#include <limits.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace TNN_NS {
+
+// offset alignment of each blob memory in the arena, friendly to simd load and store
+static const int kBlobMemoryOffsetAlignment = 64;
+
+struct BlobMemoryOffsetRecord {
+    BlobMemory* blob_memory = nullptr;
+    int64_t offset          = 0;
+    int64_t bytes_size      = 0;
+    int first_use           = 0;
+    int last_use            = 0;
+};
+
+static inline bool IsLiveIntervalOverlap(const BlobMemoryOffsetRecord& a, const BlobMemoryOffsetRecord& b) {
+    return a.first_use <= b.last_use && b.first_use <= a.last_use;
+}
+
+MemoryOffsetAssignStrategy::MemoryOffsetAssignStrategy(void* data) {
+    all_blob_memory_data_ = data;
+}
+
+Status MemoryOffsetAssignStrategy::AssignAllBlobMemory(std::set<BlobMemory*>& blob_memory_library) {
+    std::map<BlobMemory*, int> offsets;
+    PlanBlobMemoryOffset(blob_memory_library, offsets);
+    for (auto& iter : blob_memory_library) {
+        BlobHandle handle;
+        handle.base         = all_blob_memory_data_;
+        handle.bytes_offset = offsets[iter];
+        iter->SetHandleFromExternal(handle);
+    }
+    return TNN_OK;
+}
+
+/*
+ * Blob memories are placed from the largest to the smallest. Each one takes the smallest gap
+ * between the placed blob memories whose liveness intervals overlap with it, or the end of them
+ * if no gap is large enough.
+ */
+int MemoryOffsetAssignStrategy::PlanBlobMemoryOffset(std::set<BlobMemory*>& blob_memory_library,
+                                                     std::map<BlobMemory*, int>& offsets) {
+    std::vector<BlobMemoryOffsetRecord> records;
+    for (auto& iter : blob_memory_library) {
+        BlobMemorySizeInfo size_info = iter->GetBlobMemorySizeInfo();
+        BlobMemoryOffsetRecord record;
+        record.blob_memory = iter;
+        int64_t bytes_size = GetBlobMemoryBytesSize(size_info);
+        record.bytes_size  = (bytes_size + kBlobMemoryOffsetAlignment - 1) / kBlobMemoryOffsetAlignment *
+                            kBlobMemoryOffsetAlignment;
+        record.first_use   = iter->GetFirstUse();
+        record.last_use    = iter->GetLastUse();
+        records.push_back(record);
+    }
+
+    std::stable_sort(records.begin(), records.end(),
+                     [](const BlobMemoryOffsetRecord& a, const BlobMemoryOffsetRecord& b) {
+                         if (a.bytes_size != b.bytes_size) {
+                             return a.bytes_size > b.bytes_size;
+                         }
+                         return a.first_use < b.first_use;
+                     });
+
+    // placed records ordered by offset
+    std::vector<BlobMemoryOffsetRecord> placed;
+    int64_t arena_size = 0;
+    for (auto& record : records) {
+        int64_t best_offset = -1;
+        int64_t best_gap    = LLONG_MAX;
+        int64_t prev_end    = 0;
+        for (const auto& other : placed) {
+            if (!IsLiveIntervalOverlap(record, other)) {
+                continue;
+            }
+            int64_t gap = other.offset - prev_end;
+            if (gap >= record.bytes_size && gap < best_gap) {
+                best_offset = prev_end;
+                best_gap    = gap;
+            }
+            prev_end = std::max(prev_end, other.offset + other.bytes_size);
+        }
+        record.offset = best_offset >= 0 ? best_offset : prev_end;
+
+        auto pos = std::upper_bound(placed.begin(), placed.end(), record,
+                                    [](const BlobMemoryOffsetRecord& a, const BlobMemoryOffsetRecord& b) {
+                                        return a.offset < b.offset;
+                                    });
+        placed.insert(pos, record);
+        arena_size = std::max(arena_size, record.offset + record.bytes_size);
+    }
+
+    offsets.clear();
+    for (const auto& record : placed) {
+        offsets[record.blob_memory] = (int)record.offset;
+    }
+    return (int)arena_size;
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,45 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_SOURCE_TNN_MEMORY_MANAGER_MEMORY_OFFSET_ASSIGN_STRATEGY_H_
+#define TNN_SOURCE_TNN_MEMORY_MANAGER_MEMORY_OFFSET_ASSIGN_STRATEGY_H_
+
+#include <map>
+
+#include "tnn/memory_manager/memory_assign_strategy.h"
+
+namespace TNN_NS {
+
+// @brief place every blob memory at a planned offset of one arena. Blob memories whose
+// liveness intervals do not overlap may share the same bytes of the arena.
+class MemoryOffsetAssignStrategy : public MemoryAssignStrategy {
+public:
+    explicit MemoryOffsetAssignStrategy(void* data);
+    virtual Status AssignAllBlobMemory(std::set<BlobMemory*>& blob_memory_library);
+
+    // @brief plan bytes offset of all blob memory by greedy-by-size best fit
+    // @param blob_memory_library blob memory with liveness interval
+    // @param offsets planned bytes offset of each blob memory
+    // @return arena bytes size required
+    static int PlanBlobMemoryOffset(std::set<BlobMemory*>& blob_memory_library,
+                                    std::map<BlobMemory*, int>& offsets);
+
+private:
+    void* all_blob_memory_data_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_MEMORY_MANAGER_MEMORY_OFFSET_ASSIGN_STRATEGY_H_
@@ -0,0 +1,222 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/optimizer/net_optimizer_fuse_attention.h"
+
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "tnn/core/layer_type.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/interpreter/layer_resource.h"
+#include "tnn/optimizer/net_optimizer_manager.h"
+#include "tnn/optimizer/optimizer_const.h"
+
+namespace TNN_NS {
+
+namespace optimizer {
+
+    // P1 priority: should be fuse after bn scale fuse
+    NetOptimizerRegister<NetOptimizerFuseAttention> g_net_optimizer_fuse_attention(OptPriority::P1);
+
+    std::string NetOptimizerFuseAttention::Strategy() {
+        return kNetOptimizerFuseAttention;
+    }
+
+    bool NetOptimizerFuseAttention::IsSupported(const NetworkConfig &net_config) {
+#ifdef TNN_CONVERTER_RUNTIME
+        return false;
+#else
+        auto device = net_config.device_type;
+        return device == DEVICE_X86 || device == DEVICE_NAIVE;
+#endif
+    }
+
+    // get the float value of a single element buffer
+    static bool GetScalar(RawBuffer &buffer, float &value) {
+        if (buffer.GetDataType() != DATA_TYPE_FLOAT || buffer.GetDataCount() != 1) {
+            return false;
+        }
+        value = buffer.force_to<float *>()[0];
+        return true;
+    }
+
+    // mul or div of input by a scalar, in layer resource or constant
+    static bool GetScale(std::shared_ptr<LayerInfo> layer, NetResource *resource, const std::string &input,
+                         float &scale) {
+        if (layer->type != LAYER_MUL && layer->type != LAYER_DIV) {
+            return false;
+        }
+        float value = 0;
+        if (layer->inputs.size() == 1 && layer->inputs[0] == input) {
+            auto param = dynamic_cast<MultidirBroadcastLayerParam *>(layer->param.get());
+            if (!param || (layer->type == LAYER_DIV && param->weight_input_index != 1) ||
+                resource->resource_map.count(layer->name) == 0) {
+                return false;
+            }
+            auto layer_resource = dynamic_cast<EltwiseLayerResource *>(resource->resource_map[layer->name].get());
+            if (!layer_resource || !GetScalar(layer_resource->element_handle, value)) {
+                return false;
+            }
+        } else if (layer->inputs.size() == 2 && (layer->inputs[0] == input || layer->inputs[1] == input)) {
+            if (layer->type == LAYER_DIV && layer->inputs[0] != input) {
+                return false;
+            }
+            auto other = layer->inputs[0] == input ? layer->inputs[1] : layer->inputs[0];
+            if (resource->constant_map.count(other) == 0 || !GetScalar(*resource->constant_map[other], value)) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+        if (layer->type == LAYER_DIV) {
+            if (value == 0) {
+                return false;
+            }
+            value = 1.0f / value;
+        }
+        scale = value;
+        return true;
+    }
+
+    static bool IsMatMulOfBlobs(std::shared_ptr<LayerInfo> layer, NetResource *resource) {
+        return layer->type == LAYER_MATMUL && layer->inputs.size() == 2 && layer->outputs.size() == 1 &&
+               resource->resource_map.count(layer->name) == 0;
+    }
+
+    Status NetOptimizerFuseAttention::Optimize(NetStructure *structure, NetResource *resource) {
+        if (!structure) {
+            LOGE("Error: empty NetStructure\n");
+            return Status(TNNERR_NET_ERR, "Error: empty NetStructure");
+        }
+
+        std::vector<std::shared_ptr<LayerInfo>> layers_orig = structure->layers;
+        const int count                                     = (const int)layers_orig.size();
+        if (count <= 2) {
+            return TNN_OK;
+        }
+
+        // the only layer reading a blob, intermediates read by others or being outputs are not fused
+        std::map<std::string, int> consumer_count;
+        std::map<std::string, int> consumer_index;
+        for (int index = 0; index < count; index++) {
+            for (auto input : layers_orig[index]->inputs) {
+                consumer_count[input]++;
+                consumer_index[input] = index;
+            }
+        }
+        std::set<std::string> net_outputs(structure->outputs.begin(), structure->outputs.end());
+        auto next_layer = [&](const std::string &blob) -> int {
+            if (consumer_count[blob] != 1 || net_outputs.count(blob) > 0) {
+                return -1;
+            }
+            return consumer_index[blob];
+        };
+
+        std::set<int> fused_indexes;
+        std::map<int, std::shared_ptr<LayerInfo>> fused_layers;
+        for (int index = 0; index < count; index++) {
+            auto qk = layers_orig[index];
+            if (fused_indexes.count(index) > 0 || !IsMatMulOfBlobs(qk, resource)) {
+                continue;
+            }
+            std::vector<int> chain = {index};
+            std::string cur_blob   = qk->outputs[0];
+            int cur                = next_layer(cur_blob);
+
+            // optional scale
+            float scale = 1.0f;
+            if (cur >= 0 && GetScale(layers_orig[cur], resource, cur_blob, scale)) {
+                chain.push_back(cur);
+                cur_blob = layers_orig[cur]->outputs[0];
+                cur      = next_layer(cur_blob);
+            }
+
+            // optional additive mask
+            std::string mask = "";
+            if (cur >= 0 && layers_orig[cur]->type == LAYER_ADD && layers_orig[cur]->inputs.size() == 2 &&
+                layers_orig[cur]->inputs[0] != layers_orig[cur]->inputs[1]) {
+                auto add = layers_orig[cur];
+                mask     = add->inputs[0] == cur_blob ? add->inputs[1] : add->inputs[0];
+                chain.push_back(cur);
+                cur_blob = add->outputs[0];
+                cur      = next_layer(cur_blob);
+            }
+
+            // softmax on the last axis of 4 dims scores
+            if (cur < 0 || layers_orig[cur]->type != LAYER_SOFTMAX) {
+                continue;
+            }
+            auto softmax_param = dynamic_cast<SoftmaxLayerParam *>(layers_orig[cur]->param.get());
+            if (!softmax_param || (softmax_param->axis != -1 && softmax_param->axis != 3)) {
+                continue;
+            }
+            chain.push_back(cur);
+            cur_blob = layers_orig[cur]->outputs[0];
+            cur      = next_layer(cur_blob);
+
+            if (cur < 0 || !IsMatMulOfBlobs(layers_orig[cur], resource) || layers_orig[cur]->inputs[0] != cur_blob) {
+                continue;
+            }
+            auto pv = layers_orig[cur];
+            chain.push_back(cur);
+
+            auto param  = std::make_shared<FusedAttentionLayerParam>();
+            param->name  = pv->name;
+            param->type  = "FusedAttention";
+            param->scale = scale;
+
+            auto fused      = std::make_shared<LayerInfo>();
+            fused->type     = LAYER_FUSED_ATTENTION;
+            fused->type_str = "FusedAttention";
+            fused->name     = pv->name;
+            fused->inputs   = {qk->inputs[0], qk->inputs[1], pv->inputs[1]};
+            if (!mask.empty()) {
+                fused->inputs.push_back(mask);
+            }
+            fused->outputs = pv->outputs;
+            fused->param   = param;
+
+            // the fused layer takes the place of the last matmul, all inputs are ready there
+            for (int i = 0; i < chain.size(); i++) {
+                fused_indexes.insert(chain[i]);
+                if (i + 1 < chain.size()) {
+                    structure->blobs.erase(layers_orig[chain[i]]->outputs[0]);
+                }
+            }
+            fused_layers[cur] = fused;
+        }
+
+        if (fused_layers.empty()) {
+            return TNN_OK;
+        }
+
+        std::vector<std::shared_ptr<LayerInfo>> layers_fused;
+        for (int index = 0; index < count; index++) {
+            if (fused_layers.count(index) > 0) {
+                layers_fused.push_back(fused_layers[index]);
+            } else if (fused_indexes.count(index) == 0) {
+                layers_fused.push_back(layers_orig[index]);
+            }
+        }
+        structure->layers = layers_fused;
+
+        return TNN_OK;
+    }
+
+}  // namespace optimizer
+
+}  // namespace TNN_NS
@@ -59,6 +59,10 @@ namespace optimizer {
             }
         }
 
+        // x86 uses blocked layout only if asked by the config
+        if (device == DEVICE_X86) {
+            return net_config.data_format == DATA_FORMAT_NC8HW8;
+        }
         return device == DEVICE_ARM || device == DEVICE_OPENCL || device == DEVICE_METAL;
     }
 
@@ -99,6 +103,19 @@ namespace optimizer {
         return res;
     }
 
+    // x86 chooses NC8HW8 for the layers implementing it, the others run in NCHW including the layers
+    // falling back to naive device
+    static std::shared_ptr<const ImplementedLayout> GetX86Layouts(std::shared_ptr<const ImplementedLayout> layouts) {
+        auto res = std::make_shared<ImplementedLayout>();
+        if (layouts && std::find(layouts->layouts.begin(), layouts->layouts.end(), DATA_FORMAT_NC8HW8) !=
+                           layouts->layouts.end()) {
+            res->layouts.push_back(DATA_FORMAT_NC8HW8);
+        } else {
+            res->layouts.push_back(DATA_FORMAT_NCHW);
+        }
+        return res;
+    }
+
     static bool NeedDoReformat(DataFormat src_fmt, std::shared_ptr<const ImplementedLayout> dst_fmts) {
         for (const auto &dst_fmt : dst_fmts->layouts) {
             if (dst_fmt == src_fmt) {
@@ -111,6 +128,9 @@ namespace optimizer {
     // metal and opencl may use adaptor layer to fall back computing on arm
     std::shared_ptr<const ImplementedLayout> NetOptimizerInsertLayoutReformat::GetLayoutsByLayerType(LayerType type) {
         auto device_layouts = device_->GetImplementedLayout(type);
+        if (device_->GetDeviceType() == DEVICE_X86) {
+            return GetX86Layouts(device_layouts);
+        }
         if (!device_layouts || device_layouts->layouts.size() < 1) {
             auto adaptor_device_layouts = adaptor_device_->GetImplementedLayout(type);
             if (!adaptor_device_layouts || adaptor_device_layouts->layouts.size() < 1) {
@@ -31,6 +31,9 @@ static const std::string kNetOptimizerCbamFusedReduce =
 static const std::string kNetOptimizerCbamFusedPooling =
     "net_optimizer_cbam_fused_pooling";
 
+static const std::string kNetOptimizerFuseAttention =
+    "net_optimizer_fuse_attention";
+
 static const std::string kNetOptimizerInsertInt8Reformat =
     "net_optimizer_insert_int8_reformat";
 
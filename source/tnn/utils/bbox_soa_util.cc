@@ -0,0 +1,335 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/utils/bbox_soa_util.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/naive_compute.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+void BBoxSoA::Resize(int count) {
+    xmin.resize(count);
+    ymin.resize(count);
+    xmax.resize(count);
+    ymax.resize(count);
+    size.resize(count);
+}
+
+void BBoxSoA::Clear() {
+    Resize(0);
+}
+
+int BBoxSoA::Count() const {
+    return static_cast<int>(xmin.size());
+}
+
+void BBoxSoA::PushBack(const BBoxSoA &bboxes, int index) {
+    xmin.push_back(bboxes.xmin[index]);
+    ymin.push_back(bboxes.ymin[index]);
+    xmax.push_back(bboxes.xmax[index]);
+    ymax.push_back(bboxes.ymax[index]);
+    size.push_back(bboxes.size[index]);
+}
+
+// the code type is checked out of the loops, so that each loop is branch free and only exp is left scalar
+void DecodeBBoxesSoA(const float *loc_data, const int loc_step, const float *prior_data, const int num_priors,
+                     const CodeType code_type, const bool variance_encoded_in_target, const bool clip,
+                     BBoxSoA *decode_bboxes) {
+    decode_bboxes->Resize(num_priors);
+    float *xmin           = decode_bboxes->xmin.data();
+    float *ymin           = decode_bboxes->ymin.data();
+    float *xmax           = decode_bboxes->xmax.data();
+    float *ymax           = decode_bboxes->ymax.data();
+    float *size           = decode_bboxes->size.data();
+    const float *variance = prior_data + num_priors * 4;
+
+    // variance encoded in target is the same as unit variances, multiplying by 1 is exact
+    const float unit_variance[4] = {1.f, 1.f, 1.f, 1.f};
+    const int variance_step      = variance_encoded_in_target ? 0 : 4;
+    if (variance_encoded_in_target) {
+        variance = unit_variance;
+    }
+
+    if (code_type == PriorBoxParameter_CodeType_CORNER) {
+        for (int i = 0; i < num_priors; ++i) {
+            const float *prior = prior_data + i * 4;
+            const float *loc   = loc_data + i * loc_step;
+            const float *var   = variance + i * variance_step;
+            xmin[i]            = prior[0] + var[0] * loc[0];
+            ymin[i]            = prior[1] + var[1] * loc[1];
+            xmax[i]            = prior[2] + var[2] * loc[2];
+            ymax[i]            = prior[3] + var[3] * loc[3];
+        }
+    } else if (code_type == PriorBoxParameter_CodeType_CENTER_SIZE) {
+        for (int i = 0; i < num_priors; ++i) {
+            const float *prior   = prior_data + i * 4;
+            const float *loc     = loc_data + i * loc_step;
+            const float *var     = variance + i * variance_step;
+            float prior_width    = prior[2] - prior[0];
+            float prior_height   = prior[3] - prior[1];
+            float prior_center_x = (prior[0] + prior[2]) / 2.f;
+            float prior_center_y = (prior[1] + prior[3]) / 2.f;
+            float center_x       = var[0] * loc[0] * prior_width + prior_center_x;
+            float center_y       = var[1] * loc[1] * prior_height + prior_center_y;
+            float width          = std::exp(var[2] * loc[2]) * prior_width;
+            float height         = std::exp(var[3] * loc[3]) * prior_height;
+            xmin[i]              = center_x - width / 2.f;
+            ymin[i]              = center_y - height / 2.f;
+            xmax[i]              = center_x + width / 2.f;
+            ymax[i]              = center_y + height / 2.f;
+        }
+    } else if (code_type == PriorBoxParameter_CodeType_CORNER_SIZE) {
+        for (int i = 0; i < num_priors; ++i) {
+            const float *prior = prior_data + i * 4;
+            const float *loc   = loc_data + i * loc_step;
+            const float *var   = variance + i * variance_step;
+            float prior_width  = prior[2] - prior[0];
+            float prior_height = prior[3] - prior[1];
+            xmin[i]            = prior[0] + var[0] * loc[0] * prior_width;
+            ymin[i]            = prior[1] + var[1] * loc[1] * prior_height;
+            xmax[i]            = prior[2] + var[2] * loc[2] * prior_width;
+            ymax[i]            = prior[3] + var[3] * loc[3] * prior_height;
+        }
+    } else {
+        assert(false);  // Unknown LocLossType.
+    }
+
+    for (int i = 0; i < num_priors; ++i) {
+        if (clip) {
+            xmin[i] = std::max(std::min(xmin[i], 1.f), 0.f);
+            ymin[i] = std::max(std::min(ymin[i], 1.f), 0.f);
+            xmax[i] = std::max(std::min(xmax[i], 1.f), 0.f);
+            ymax[i] = std::max(std::min(ymax[i], 1.f), 0.f);
+        }
+        float width  = xmax[i] - xmin[i];
+        float height = ymax[i] - ymin[i];
+        size[i]      = (width < 0 || height < 0) ? 0.f : width * height;
+    }
+}
+
+void GetTopKScoreIndexSoA(const float *scores, const int count, const float threshold, const int top_k,
+                          std::vector<std::pair<float, int>> *score_index_vec) {
+    score_index_vec->clear();
+    for (int i = 0; i < count; ++i) {
+        if (scores[i] > threshold) {
+            score_index_vec->push_back(std::make_pair(scores[i], i));
+        }
+    }
+
+    // ordering equal scores by index gives the result of a stable sort
+    auto descend = [](const std::pair<float, int> &pair1, const std::pair<float, int> &pair2) {
+        return pair1.first > pair2.first || (pair1.first == pair2.first && pair1.second < pair2.second);
+    };
+    if (top_k > -1 && top_k < score_index_vec->size()) {
+        std::partial_sort(score_index_vec->begin(), score_index_vec->begin() + top_k, score_index_vec->end(),
+                          descend);
+        score_index_vec->resize(top_k);
+    } else {
+        std::sort(score_index_vec->begin(), score_index_vec->end(), descend);
+    }
+}
+
+bool OverlapsKeptBBoxes(const BBoxSoA &kept_bboxes, const BBoxSoA &bboxes, const int index, const float threshold) {
+    const float xmin = bboxes.xmin[index];
+    const float ymin = bboxes.ymin[index];
+    const float xmax = bboxes.xmax[index];
+    const float ymax = bboxes.ymax[index];
+    const float size = bboxes.size[index];
+    const int count  = kept_bboxes.Count();
+
+    int k = 0;
+#ifdef __SSE2__
+    const __m128 v_xmin      = _mm_set1_ps(xmin);
+    const __m128 v_ymin      = _mm_set1_ps(ymin);
+    const __m128 v_xmax      = _mm_set1_ps(xmax);
+    const __m128 v_ymax      = _mm_set1_ps(ymax);
+    const __m128 v_size      = _mm_set1_ps(size);
+    const __m128 v_threshold = _mm_set1_ps(threshold);
+    const __m128 v_zero      = _mm_setzero_ps();
+    for (; k + 4 <= count; k += 4) {
+        __m128 width  = _mm_sub_ps(_mm_min_ps(v_xmax, _mm_loadu_ps(kept_bboxes.xmax.data() + k)),
+                                  _mm_max_ps(v_xmin, _mm_loadu_ps(kept_bboxes.xmin.data() + k)));
+        __m128 height = _mm_sub_ps(_mm_min_ps(v_ymax, _mm_loadu_ps(kept_bboxes.ymax.data() + k)),
+                                   _mm_max_ps(v_ymin, _mm_loadu_ps(kept_bboxes.ymin.data() + k)));
+        __m128 valid  = _mm_and_ps(_mm_cmpgt_ps(width, v_zero), _mm_cmpgt_ps(height, v_zero));
+        __m128 inter  = _mm_mul_ps(width, height);
+        __m128 uni    = _mm_sub_ps(_mm_add_ps(v_size, _mm_loadu_ps(kept_bboxes.size.data() + k)), inter);
+        __m128 over   = _mm_and_ps(valid, _mm_cmpgt_ps(_mm_div_ps(inter, uni), v_threshold));
+        if (_mm_movemask_ps(over)) {
+            return true;
+        }
+    }
+#endif
+    for (; k < count; ++k) {
+        float width  = std::min(xmax, kept_bboxes.xmax[k]) - std::max(xmin, kept_bboxes.xmin[k]);
+        float height = std::min(ymax, kept_bboxes.ymax[k]) - std::max(ymin, kept_bboxes.ymin[k]);
+        if (width > 0 && height > 0) {
+            float inter = width * height;
+            if (inter / (size + kept_bboxes.size[k] - inter) > threshold) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void ApplyNMSFastSoA(const BBoxSoA &bboxes, const std::vector<std::pair<float, int>> &score_index_vec,
+                     const float nms_threshold, const float eta, const int max_keep, std::vector<int> *indices) {
+    float adaptive_threshold = nms_threshold;
+    BBoxSoA kept_bboxes;
+    indices->clear();
+    for (const auto &score_index : score_index_vec) {
+        if (max_keep > -1 && indices->size() >= max_keep) {
+            break;
+        }
+        const int idx = score_index.second;
+        if (OverlapsKeptBBoxes(kept_bboxes, bboxes, idx, adaptive_threshold)) {
+            continue;
+        }
+        indices->push_back(idx);
+        kept_bboxes.PushBack(bboxes, idx);
+        if (eta < 1 && adaptive_threshold > 0.5) {
+            adaptive_threshold *= eta;
+        }
+    }
+}
+
+void ApplyMultiClassNMSFastSoA(const std::vector<BBoxSoA> &bboxes, const bool share_location, const float *scores,
+                               const int num_classes, const int num_priors, const int background_label_id,
+                               const float score_threshold, const float nms_threshold, const float eta,
+                               const int top_k, std::vector<std::vector<int>> *indices) {
+    indices->clear();
+    indices->resize(num_classes);
+    OMP_PARALLEL_FOR_DYNAMIC_
+    for (int c = 0; c < num_classes; ++c) {
+        if (c == background_label_id) {
+            continue;
+        }
+        std::vector<std::pair<float, int>> score_index_vec;
+        GetTopKScoreIndexSoA(scores + c * num_priors, num_priors, score_threshold, top_k, &score_index_vec);
+        ApplyNMSFastSoA(bboxes[share_location ? 0 : c], score_index_vec, nms_threshold, eta, -1, &(*indices)[c]);
+    }
+}
+
+void DetectionOutputSoA(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs,
+                        DetectionOutputLayerParam *param) {
+    if (inputs.size() >= 4) {
+        NaiveDetectionOutput(inputs, outputs, param);
+        return;
+    }
+    ASSERT(param->code_type > 0 && param->code_type < 4);
+    const float *loc_data   = static_cast<const float *>(inputs[0]->GetHandle().base);
+    const float *conf_data  = static_cast<const float *>(inputs[1]->GetHandle().base);
+    const float *prior_data = static_cast<const float *>(inputs[2]->GetHandle().base);
+    Blob *output_blob       = outputs[0];
+
+    const int num             = inputs[0]->GetBlobDesc().dims[0];
+    const int num_priors      = inputs[2]->GetBlobDesc().dims[2] / 4;
+    const int num_classes     = param->num_classes;
+    const bool share_location = param->share_location;
+    const int num_loc_classes = share_location ? 1 : num_classes;
+    const CodeType code_type  = static_cast<CodeType>(param->code_type);
+
+    std::vector<BBoxSoA> bboxes(num_loc_classes);
+    std::vector<float> class_scores(num_classes * num_priors);
+    std::vector<std::vector<int>> indices;
+    // image id, label, score and bbox of the kept detections
+    std::vector<float> detections;
+    int num_kept = 0;
+    for (int i = 0; i < num; ++i) {
+        const float *loc = loc_data + i * num_priors * num_loc_classes * 4;
+        for (int c = 0; c < num_loc_classes; ++c) {
+            if (!share_location && c == param->background_label_id) {
+                continue;
+            }
+            DecodeBBoxesSoA(loc + c * 4, num_loc_classes * 4, prior_data, num_priors, code_type,
+                            param->variance_encoded_in_target, false, &bboxes[c]);
+        }
+
+        const float *conf = conf_data + i * num_priors * num_classes;
+        for (int p = 0; p < num_priors; ++p) {
+            for (int c = 0; c < num_classes; ++c) {
+                class_scores[c * num_priors + p] = conf[p * num_classes + c];
+            }
+        }
+
+        ApplyMultiClassNMSFastSoA(bboxes, share_location, class_scores.data(), num_classes, num_priors,
+                                  param->background_label_id, param->confidence_threshold,
+                                  param->nms_param.nms_threshold, param->eta, param->nms_param.top_k, &indices);
+
+        int num_det = 0;
+        for (const auto &class_indices : indices) {
+            num_det += static_cast<int>(class_indices.size());
+        }
+        if (param->keep_top_k > -1 && num_det > param->keep_top_k) {
+            std::vector<std::pair<float, std::pair<int, int>>> score_index_pairs;
+            for (int c = 0; c < num_classes; ++c) {
+                for (int idx : indices[c]) {
+                    float score = class_scores[c * num_priors + idx];
+                    score_index_pairs.push_back(std::make_pair(score, std::make_pair(c, idx)));
+                }
+            }
+            // Keep top k results per image.
+            auto descend = [](const std::pair<float, std::pair<int, int>> &pair1,
+                              const std::pair<float, std::pair<int, int>> &pair2) { return pair1.first > pair2.first; };
+            std::partial_sort(score_index_pairs.begin(), score_index_pairs.begin() + param->keep_top_k,
+                              score_index_pairs.end(), descend);
+            score_index_pairs.resize(param->keep_top_k);
+            for (auto &class_indices : indices) {
+                class_indices.clear();
+            }
+            for (const auto &score_index : score_index_pairs) {
+                indices[score_index.second.first].push_back(score_index.second.second);
+            }
+            num_det = param->keep_top_k;
+        }
+        num_kept += num_det;
+
+        for (int c = 0; c < num_classes; ++c) {
+            const BBoxSoA &class_bboxes = bboxes[share_location ? 0 : c];
+            for (int idx : indices[c]) {
+                detections.insert(detections.end(),
+                                  {static_cast<float>(i), static_cast<float>(c), class_scores[c * num_priors + idx],
+                                   class_bboxes.xmin[idx], class_bboxes.ymin[idx], class_bboxes.xmax[idx],
+                                   class_bboxes.ymax[idx]});
+            }
+        }
+    }
+
+    // same output as DealOutput
+    float *top_data = static_cast<float *>(output_blob->GetHandle().base);
+    std::fill(top_data, top_data + DimsVectorUtils::Count(output_blob->GetBlobDesc().dims), 0.f);
+    if (num_kept == 0) {
+        LOGD("%s:Couldn't find any detections.", __FUNCTION__);
+        output_blob->GetBlobDesc().dims[2] = num;
+        std::fill(top_data, top_data + DimsVectorUtils::Count(output_blob->GetBlobDesc().dims), -1.f);
+        for (int i = 0; i < num; ++i) {
+            top_data[i * 7] = static_cast<float>(i);
+        }
+    } else {
+        output_blob->GetBlobDesc().dims[2] = num_kept;
+        std::copy(detections.begin(), detections.end(), top_data);
+    }
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,79 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_UTILS_BBOX_SOA_UTIL_H_
+#define TNN_SOURCE_TNN_UTILS_BBOX_SOA_UTIL_H_
+
+#include <utility>
+#include <vector>
+
+#include "tnn/core/blob.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/utils/bbox_util.h"
+
+namespace TNN_NS {
+
+// @brief bboxes stored as structure of arrays, the size of each bbox is kept for the overlap computation.
+// the functions below give the same results as their NormalizedBBox counterparts in bbox_util.h
+struct BBoxSoA {
+    std::vector<float> xmin;
+    std::vector<float> ymin;
+    std::vector<float> xmax;
+    std::vector<float> ymax;
+    std::vector<float> size;
+
+    void Resize(int count);
+    void Clear();
+    int Count() const;
+    void PushBack(const BBoxSoA &bboxes, int index);
+};
+
+// Decode the loc predictions of one image and one loc class, same as DecodeBBoxes.
+//    loc_data: the first prediction, predictions are loc_step floats apart.
+//    prior_data: 1 x 2 x num_priors * 4 x 1 blob, same as GetPriorBBoxes.
+void DecodeBBoxesSoA(const float *loc_data, const int loc_step, const float *prior_data, const int num_priors,
+                     const CodeType code_type, const bool variance_encoded_in_target, const bool clip,
+                     BBoxSoA *decode_bboxes);
+
+// Get the scores higher than threshold in descending order, same as GetMaxScoreIndex.
+// only the top_k scores are sorted, equal scores keep the index order.
+void GetTopKScoreIndexSoA(const float *scores, const int count, const float threshold, const int top_k,
+                          std::vector<std::pair<float, int>> *score_index_vec);
+
+// Check a bbox against a block of kept bboxes at a time.
+//    returns true if the overlap of bboxes[index] with any kept bbox is larger than threshold.
+bool OverlapsKeptBBoxes(const BBoxSoA &kept_bboxes, const BBoxSoA &bboxes, const int index, const float threshold);
+
+// Do non maximum suppression on sorted (score, index) pairs, same as ApplyNMSFast.
+//    max_keep: if not -1, stop after max_keep picked indices.
+void ApplyNMSFastSoA(const BBoxSoA &bboxes, const std::vector<std::pair<float, int>> &score_index_vec,
+                     const float nms_threshold, const float eta, const int max_keep, std::vector<int> *indices);
+
+// Do non maximum suppression of all classes of one image.
+//    bboxes: decoded bboxes of each loc class, only bboxes[0] is used if share_location is true.
+//    scores: num_classes x num_priors, class major.
+//    indices: the kept indices of each class, empty for the background class.
+void ApplyMultiClassNMSFastSoA(const std::vector<BBoxSoA> &bboxes, const bool share_location, const float *scores,
+                               const int num_classes, const int num_priors, const int background_label_id,
+                               const float score_threshold, const float nms_threshold, const float eta,
+                               const int top_k, std::vector<std::vector<int>> *indices);
+
+// DetectionOutput on SoA bboxes, gives the same output as NaiveDetectionOutput.
+// the refinedet inputs (arm conf and arm loc) are handled by NaiveDetectionOutput.
+void DetectionOutputSoA(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs,
+                        DetectionOutputLayerParam *param);
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_UTILS_BBOX_SOA_UTIL_H_
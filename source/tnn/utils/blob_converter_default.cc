@@ -414,6 +414,49 @@ Status DefaultBlobConverterAcc::ConvertFromMatAsync(Mat &image_src, MatConvertPa
 
 #undef FREE_INT8_TEMP_DATA
 
+bool DefaultBlobConverterAcc::CanFuseResize(Mat &image, ResizeParam &resize_param, MatConvertParam &param) {
+    auto desc     = blob_->GetBlobDesc();
+    auto dims     = desc.dims;
+    auto mat_type = image.GetMatType();
+    if (image.GetDeviceType() != DEVICE_NAIVE && image.GetDeviceType() != DEVICE_X86) {
+        return false;
+    }
+    if (desc.data_type != DATA_TYPE_FLOAT || dims.size() != 4 || image.GetBatch() != dims[0]) {
+        return false;
+    }
+    if (resize_param.type != INTERP_TYPE_LINEAR && resize_param.type != INTERP_TYPE_NEAREST) {
+        return false;
+    }
+    if (image.GetWidth() < 2 || image.GetHeight() < 2) {
+        return false;
+    }
+    if ((mat_type == NNV12 || mat_type == NNV21) && (image.GetWidth() % 2 != 0 || image.GetHeight() % 2 != 0)) {
+        return false;
+    }
+
+    int channel = dims[1];
+    if (channel != 3 && !(mat_type == N8UC4 && channel == 4)) {
+        return false;
+    }
+    return param.scale.size() >= channel && param.bias.size() >= channel;
+}
+
+Status DefaultBlobConverterAcc::ConvertFromMatWithResize(Mat &image, ResizeParam resize_param, MatConvertParam param,
+                                                         void *command_queue) {
+    auto desc = blob_->GetBlobDesc();
+    if ((desc.data_format != DATA_FORMAT_NCHW && desc.data_format != DATA_FORMAT_AUTO) ||
+        !CanFuseResize(image, resize_param, param)) {
+        return BlobConverterAcc::ConvertFromMatWithResize(image, resize_param, param, command_queue);
+    }
+
+    auto dims = desc.dims;
+    NaiveResizeConvertToNCHW(reinterpret_cast<uint8_t *>(image.GetData()), dims[0], image.GetWidth(),
+                             image.GetHeight(), image.GetMatType(), reinterpret_cast<float *>(blob_->GetHandle().base),
+                             dims[3], dims[2], dims[1], param.scale.data(), param.bias.data(), param.reverse_channel,
+                             resize_param.type);
+    return TNN_OK;
+}
+
 Status DefaultBlobConverterAcc::ConvertToMat(Mat &image, MatConvertParam param, void *command_queue) {
     return ConvertToMatAsync(image, param, command_queue);
 }
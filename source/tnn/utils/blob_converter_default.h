@@ -32,6 +32,14 @@ public:
     virtual Status ConvertFromMat(Mat& image, MatConvertParam param, void* command_queue = NULL);
     virtual Status ConvertFromMatAsync(Mat& image, MatConvertParam param, void* command_queue = NULL);
 
+    virtual Status ConvertFromMatWithResize(Mat& image, ResizeParam resize_param, MatConvertParam param,
+                                            void* command_queue = NULL);
+
+protected:
+    // @brief check whether the image can be resized into the float blob in one pass, the blob layout is
+    // not checked
+    bool CanFuseResize(Mat& image, ResizeParam& resize_param, MatConvertParam& param);
+
 private:
     Status ConvertFromMatFunc(Mat& image, float* blob_data, MatConvertParam& param, BlobDesc& desc,
                               const DimsVector& dims, const int hw);
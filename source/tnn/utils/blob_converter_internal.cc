@@ -77,6 +77,28 @@ Status BlobConverter::ConvertFromMatAsync(Mat& image, MatConvertParam param, voi
     return impl_->ConvertFromMatAsync(image, param, command_queue);
 }
 
+Status BlobConverter::ConvertFromMatWithResize(Mat& image, ResizeParam resize_param, MatConvertParam param,
+                                               void* command_queue) {
+    if (!impl_) {
+        return Status(TNNERR_INIT_LAYER, "image converter is nil, check device type");
+    }
+
+    auto mat_type = image.GetMatType();
+    if (mat_type != N8UC3 && mat_type != N8UC4 && mat_type != NNV12 && mat_type != NNV21) {
+        return Status(TNNERR_PARAM_ERR, "convert with resize only supports N8UC3, N8UC4, NNV12 and NNV21 mats");
+    }
+    if (blob_->GetBlobDesc().dims.size() != 4) {
+        return Status(TNNERR_PARAM_ERR, "convert with resize only supports 4 dims blobs");
+    }
+
+    Status ret = CheckScaleBiasInParam(image, param, false);
+    if (ret != TNN_OK) {
+        return ret;
+    }
+
+    return impl_->ConvertFromMatWithResize(image, resize_param, param, command_queue);
+}
+
 Status BlobConverter::CheckScaleBiasInParam(Mat& image, MatConvertParam& param, bool convert_to_mat) {
     int channel = convert_to_mat ? blob_->GetBlobDesc().dims[1] : image.GetChannel();
     // 非图像类的Mat channel和scale/bias长度与不匹配时，如果scale全1，bias全0，会默认调整，否则报错
@@ -112,6 +134,22 @@ bool BlobConverter::NeedDoScaleBias(MatConvertParam &param) {
     return false;
 }
 
+Status BlobConverterAcc::ConvertFromMatWithResize(Mat& image, ResizeParam resize_param, MatConvertParam param,
+                                                  void* command_queue) {
+    auto dims = blob_->GetBlobDesc().dims;
+    Mat src   = image;
+    if (image.GetMatType() == NNV12 || image.GetMatType() == NNV21) {
+        auto type = image.GetMatType() == NNV12 ? COLOR_CONVERT_NV12TOBGR : COLOR_CONVERT_NV21TOBGR;
+        Mat bgr(image.GetDeviceType(), N8UC3, {image.GetBatch(), 3, image.GetHeight(), image.GetWidth()});
+        RETURN_ON_NEQ(MatUtils::CvtColor(image, bgr, type, command_queue), TNN_OK);
+        src = bgr;
+    }
+
+    Mat resized(src.GetDeviceType(), src.GetMatType(), {src.GetBatch(), src.GetChannel(), dims[2], dims[3]});
+    RETURN_ON_NEQ(MatUtils::Resize(src, resized, resize_param, command_queue), TNN_OK);
+    return ConvertFromMat(resized, param, command_queue);
+}
+
 std::shared_ptr<BlobConverterManager>& BlobConverterManager::Shared() {
     static std::once_flag once;
     static std::shared_ptr<BlobConverterManager> g_global_blob_converter_manager;
@@ -34,6 +34,10 @@ public:
     virtual Status ConvertFromMat(Mat& image, MatConvertParam param, void* command_queue = NULL)      = 0;
     virtual Status ConvertFromMatAsync(Mat& image, MatConvertParam param, void* command_queue = NULL) = 0;
 
+    // @brief convert color and resize with MatUtils, then convert the resized mat into the blob
+    virtual Status ConvertFromMatWithResize(Mat& image, ResizeParam resize_param, MatConvertParam param,
+                                            void* command_queue = NULL);
+
 protected:
     Blob* blob_;
 };
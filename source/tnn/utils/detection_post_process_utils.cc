@@ -17,7 +17,9 @@
 #include <algorithm>
 #include <cmath>
 #include <numeric>
-#include <queue>
+
+#include "tnn/utils/bbox_soa_util.h"
+
 namespace TNN_NS {
 
 void DecodeBoxes(DetectionPostProcessLayerParam* param, DetectionPostProcessLayerResource* resource,
@@ -115,74 +117,44 @@ void NonMaxSuppressionSingleClasssImpl(Blob* decoded_boxes, const float* scores,
     ASSERT(decoded_boxes->GetBlobDesc().dims[1] == 4);
 
     const int output_num = std::min(max_detections, num_boxes);
-    std::vector<float> scores_data(num_boxes);
-    std::copy_n(scores, num_boxes, scores_data.begin());
-
-    struct Candidate {
-        int box_index;
-        float score;
-    };
-
-    auto cmp = [](const Candidate bs_i, const Candidate bs_j) { return bs_i.score < bs_j.score; };
+    const auto boxes_ptr = static_cast<float*>(decoded_boxes->GetHandle().base);
 
-    std::priority_queue<Candidate, std::deque<Candidate>, decltype(cmp)> candidate_priority_queue(cmp);
+    // corners are ordered once, the overlaps with the selected boxes are then computed a block at a time
+    BBoxSoA bboxes;
+    bboxes.Resize(num_boxes);
+    for (int i = 0; i < num_boxes; ++i) {
+        const float* box = boxes_ptr + i * 4;
+        bboxes.ymin[i]   = std::min<float>(box[0], box[2]);
+        bboxes.xmin[i]   = std::min<float>(box[1], box[3]);
+        bboxes.ymax[i]   = std::max<float>(box[0], box[2]);
+        bboxes.xmax[i]   = std::max<float>(box[1], box[3]);
+        bboxes.size[i]   = (bboxes.ymax[i] - bboxes.ymin[i]) * (bboxes.xmax[i] - bboxes.xmin[i]);
+    }
 
-    for (int i = 0; i < scores_data.size(); ++i) {
-        if (scores_data[i] > score_threshold) {
-            candidate_priority_queue.emplace(Candidate({i, scores_data[i]}));
+    std::vector<std::pair<float, int>> candidates;
+    for (int i = 0; i < num_boxes; ++i) {
+        if (scores[i] > score_threshold) {
+            candidates.push_back(std::make_pair(scores[i], i));
         }
     }
 
-    // std::vector<float> selectedScores;
-    Candidate next_candidate;
-    float iou, original_score;
+    // only the candidates popped before output_num boxes are selected get ordered
+    auto less = [](const std::pair<float, int>& pair1, const std::pair<float, int>& pair2) {
+        return pair1.first < pair2.first || (pair1.first == pair2.first && pair1.second > pair2.second);
+    };
+    std::make_heap(candidates.begin(), candidates.end(), less);
 
-    const auto boxes_ptr = static_cast<float*>(decoded_boxes->GetHandle().base);
-    while (selected->size() < output_num && !candidate_priority_queue.empty()) {
-        next_candidate = candidate_priority_queue.top();
-        original_score = next_candidate.score;
-        candidate_priority_queue.pop();
-
-        // Overlapping boxes are likely to have similar scores,
-        // therefore we iterate through the previously selected boxes backwards
-        // in order to see if `next_candidate` should be suppressed.
-        bool should_select = true;
-        for (int j = (int)selected->size() - 1; j >= 0; --j) {
-            iou = IOU(boxes_ptr, next_candidate.box_index, selected->at(j));
-            if (iou == 0.0) {
-                continue;
-            }
-            if (iou > iou_threshold) {
-                should_select = false;
-            }
-        }
+    BBoxSoA selected_bboxes;
+    while (selected->size() < output_num && !candidates.empty()) {
+        std::pop_heap(candidates.begin(), candidates.end(), less);
+        const int box_index = candidates.back().second;
+        candidates.pop_back();
 
-        if (should_select) {
-            selected->push_back(next_candidate.box_index);
-            // selectedScores.push_back(next_candidate.score);
+        if (!OverlapsKeptBBoxes(selected_bboxes, bboxes, box_index, iou_threshold)) {
+            selected->push_back(box_index);
+            selected_bboxes.PushBack(bboxes, box_index);
         }
     }
 }
-static inline float IOU(const float* boxes, int i, int j) {
-    const float y_min_i = std::min<float>(boxes[i * 4 + 0], boxes[i * 4 + 2]);
-    const float x_min_i = std::min<float>(boxes[i * 4 + 1], boxes[i * 4 + 3]);
-    const float y_max_i = std::max<float>(boxes[i * 4 + 0], boxes[i * 4 + 2]);
-    const float x_max_i = std::max<float>(boxes[i * 4 + 1], boxes[i * 4 + 3]);
-    const float y_min_j = std::min<float>(boxes[j * 4 + 0], boxes[j * 4 + 2]);
-    const float x_min_j = std::min<float>(boxes[j * 4 + 1], boxes[j * 4 + 3]);
-    const float y_max_j = std::max<float>(boxes[j * 4 + 0], boxes[j * 4 + 2]);
-    const float x_max_j = std::max<float>(boxes[j * 4 + 1], boxes[j * 4 + 3]);
-    const float area_i  = (y_max_i - y_min_i) * (x_max_i - x_min_i);
-    const float area_j  = (y_max_j - y_min_j) * (x_max_j - x_min_j);
-    if (area_i <= 0 || area_j <= 0)
-        return 0.0;
-    const float intersection_y_min = std::max<float>(y_min_i, y_min_j);
-    const float intersection_x_min = std::max<float>(x_min_i, x_min_j);
-    const float intersection_y_max = std::min<float>(y_max_i, y_max_j);
-    const float intersection_x_max = std::min<float>(x_max_i, x_max_j);
-    const float intersection_area  = std::max<float>(intersection_y_max - intersection_y_min, 0.0) *
-                                    std::max<float>(intersection_x_max - intersection_x_min, 0.0);
-    return intersection_area / (area_i + area_j - intersection_area);
-}
 
 }  // namespace TNN_NS
\ No newline at end of file
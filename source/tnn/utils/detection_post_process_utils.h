@@ -45,8 +45,6 @@ void NonMaxSuppressionMultiClassFastImpl(DetectionPostProcessLayerParam* param,
 void NonMaxSuppressionSingleClasssImpl(Blob* decoded_boxes, const float* scores, int max_detections,
                                        float iou_threshold, float score_threshold, std::vector<int32_t>* selected);
 
-static inline float IOU(const float* boxes, int i, int j);
-
 }  // namespace TNN_NS
 
 #endif  // TNN_SOURCE_TNN_UTILS_DETECTION_POST_PROCESS_UTILS_H_
@@ -300,4 +300,20 @@ DimsVector DimsFunctionUtils::GetDimsStep(const DimsVector& dims) {
     return step_dims;
 }
 
+int DimsFunctionUtils::GetBroadcastOffset(const DimsVector& shape, const DimsVector& dims, int index) {
+    int offset = 0;
+    int step   = 1;
+    for (int i = (int)shape.size() - 1, j = (int)dims.size() - 1; i >= 0; --i, --j) {
+        int coord = index % shape[i];
+        index /= shape[i];
+        if (j >= 0) {
+            if (dims[j] != 1) {
+                offset += coord * step;
+            }
+            step *= dims[j];
+        }
+    }
+    return offset;
+}
+
 }  // namespace TNN_NS
@@ -90,6 +90,9 @@ public:
     // @brief step[i]: DimsVectorUtils::Count(dims, i + 1)
     static DimsVector GetDimsStep(const DimsVector& dims);
 
+    // @brief offset in dims of the index-th element of shape, dims is right aligned to shape and broadcast on dims of 1
+    static int GetBroadcastOffset(const DimsVector& shape, const DimsVector& dims, int index);
+
 };
 
 }  // namespace TNN_NS
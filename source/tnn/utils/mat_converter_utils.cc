@@ -76,6 +76,17 @@ void CalculatePositionAndMask(int length, double scale, int border, int channel,
     }
 }
 
+void CalculatePositionAndRatio(int length, double scale, int border, int channel, bool nearest,
+                               int* position, float* ratio) {
+    for (int i = 0; i < length; i++) {
+        float rat_f = CalculatePosition(position, i, scale, border, channel);
+        if (nearest) {
+            rat_f = (rat_f <= 0.5) ? 0.f : 1.f;
+        }
+        ratio[i] = rat_f;
+    }
+}
+
 #define  GetResizeBufPreparation(type)                                    \
     double scale_x = (double)src_w / w;                                   \
     double scale_y = (double)src_h / h;                                   \
@@ -31,6 +31,10 @@ void CalculatePositionAndRatio(int length, double scale, int border, int channel
 void CalculatePositionAndMask(int length, double scale, int border, int channel,
                                      int* position, uint8_t* mask);
 
+// ratio is the weight of the right (or bottom) neighbour, it is 0 or 1 if nearest is set
+void CalculatePositionAndRatio(int length, double scale, int border, int channel, bool nearest,
+                               int* position, float* ratio);
+
 // Meanings of xofs, yofs, ialpha, ibeta in src image:
 //                               |  ialpha[2*x]  |  ialpha[2*x+1]  |
 //     --       (xofs[x], yofs[y])                                 (xofs[x]+1, yofs[y])
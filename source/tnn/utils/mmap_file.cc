@@ -0,0 +1,129 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/utils/mmap_file.h"
+
+#if defined _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace TNN_NS {
+
+MmapFile::MmapFile() {}
+
+MmapFile::~MmapFile() {
+    Unmap();
+}
+
+#if defined _WIN32
+
+Status MmapFile::Map(const std::string &file_path) {
+    Unmap();
+    HANDLE file = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        LOGE("MmapFile open file failed: %s\n", file_path.c_str());
+        return Status(TNNERR_LOAD_MODEL, "open file failed");
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0) {
+        CloseHandle(file);
+        return Status(TNNERR_LOAD_MODEL, "file is empty");
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (mapping == NULL) {
+        CloseHandle(file);
+        return Status(TNNERR_LOAD_MODEL, "create file mapping failed");
+    }
+    void *data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    if (data == NULL) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return Status(TNNERR_LOAD_MODEL, "map view of file failed");
+    }
+    file_handle_    = file;
+    mapping_handle_ = mapping;
+    data_           = static_cast<char *>(data);
+    size_           = static_cast<size_t>(file_size.QuadPart);
+    return TNN_OK;
+}
+
+void MmapFile::Unmap() {
+    if (data_) {
+        UnmapViewOfFile(data_);
+        data_ = nullptr;
+    }
+    if (mapping_handle_) {
+        CloseHandle(mapping_handle_);
+        mapping_handle_ = nullptr;
+    }
+    if (file_handle_) {
+        CloseHandle(file_handle_);
+        file_handle_ = nullptr;
+    }
+    size_ = 0;
+}
+
+#else
+
+Status MmapFile::Map(const std::string &file_path) {
+    Unmap();
+    int fd = open(file_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOGE("MmapFile open file failed: %s\n", file_path.c_str());
+        return Status(TNNERR_LOAD_MODEL, "open file failed");
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+        close(fd);
+        return Status(TNNERR_LOAD_MODEL, "file is empty");
+    }
+    // private writable mapping, weights modified in place by optimizer or layers are copied on write
+    void *data = mmap(nullptr, file_stat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    // the mapping keeps a reference to the file
+    close(fd);
+    if (data == MAP_FAILED) {
+        LOGE("MmapFile mmap file failed: %s\n", file_path.c_str());
+        return Status(TNNERR_LOAD_MODEL, "mmap file failed");
+    }
+    data_ = static_cast<char *>(data);
+    size_ = static_cast<size_t>(file_stat.st_size);
+    return TNN_OK;
+}
+
+void MmapFile::Unmap() {
+    if (data_) {
+        munmap(data_, size_);
+        data_ = nullptr;
+    }
+    size_ = 0;
+}
+
+#endif  // _WIN32
+
+char *MmapFile::GetData() {
+    return data_;
+}
+
+size_t MmapFile::GetSize() {
+    return size_;
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,57 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_SOURCE_TNN_UTILS_MMAP_FILE_H_
+#define TNN_SOURCE_TNN_UTILS_MMAP_FILE_H_
+
+#include <string>
+
+#include "tnn/core/macro.h"
+#include "tnn/core/status.h"
+
+namespace TNN_NS {
+
+// @brief MmapFile maps a whole file into memory. The mapping is private, pages
+// written are copied on write and never go back to the file, untouched pages
+// are shared through the page cache by all processes mapping the same file.
+class MmapFile {
+public:
+    MmapFile();
+    ~MmapFile();
+
+    // @brief map the file of the given path
+    Status Map(const std::string &file_path);
+
+    // @brief unmap the file, data is invalid after unmap
+    void Unmap();
+
+    char *GetData();
+    size_t GetSize();
+
+private:
+    MmapFile(const MmapFile &);
+    MmapFile &operator=(const MmapFile &);
+
+    char *data_  = nullptr;
+    size_t size_ = 0;
+#if defined _WIN32
+    void *file_handle_    = nullptr;
+    void *mapping_handle_ = nullptr;
+#endif
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_UTILS_MMAP_FILE_H_
@@ -16,6 +16,7 @@
 
 #include <cstring>
 #include <type_traits>
+#include <vector>
 
 #include "math.h"
 #include "tnn/core/macro.h"
@@ -25,6 +26,7 @@
 #include "tnn/utils/dims_utils.h"
 #include "tnn/utils/omp_utils.h"
 #include "tnn/utils/half_utils_inner.h"
+#include "tnn/utils/mat_converter_utils.h"
 
 namespace TNN_NS {
 
@@ -1144,6 +1146,73 @@ void NaiveYUVToBGROrBGRA(const unsigned char *yuv, unsigned char *bgr, const int
     }
 }
 
+/*
+ * load pixel (x, y) as b, g, r, a, yuv420sp pixels are converted in the same way as NaiveYUVToBGR
+ */
+static inline void NaiveLoadPixel(const uint8_t *src, int src_w, int src_h, MatType src_type, int x, int y,
+                                  int *pixel) {
+    if (src_type == N8UC3 || src_type == N8UC4) {
+        int channel      = src_type == N8UC3 ? 3 : 4;
+        const uint8_t *p = src + (y * src_w + x) * channel;
+        for (int c = 0; c < channel; ++c) {
+            pixel[c] = p[c];
+        }
+        return;
+    }
+
+    const uint8_t *vuptr = src + src_w * src_h + (y / 2) * src_w + (x / 2) * 2;
+    int u, v;
+    if (src_type == NNV12) {
+        u = (vuptr[0] > 240 ? 240 : vuptr[0]) - 128;
+        v = (vuptr[1] > 240 ? 240 : vuptr[1]) - 128;
+    } else {
+        v = (vuptr[0] > 240 ? 240 : vuptr[0]) - 128;
+        u = (vuptr[1] > 240 ? 240 : vuptr[1]) - 128;
+    }
+    int yy   = src[y * src_w + x] * 74 - 1135;
+    pixel[0] = std::min(std::max((yy + 129 * u) >> 6, 0), 255);
+    pixel[1] = std::min(std::max((yy - 52 * v - 25 * u) >> 6, 0), 255);
+    pixel[2] = std::min(std::max((yy + 102 * v) >> 6, 0), 255);
+    pixel[3] = 255;
+}
+
+void NaiveResizeConvertToNCHW(const uint8_t *src, int batch, int src_w, int src_h, MatType src_type, float *dst,
+                              int w, int h, int channel, const float *scale, const float *bias, bool reverse_channel,
+                              InterpType type) {
+    int src_size = src_w * src_h;
+    int src_step = src_type == N8UC3 ? src_size * 3 : (src_type == N8UC4 ? src_size * 4 : src_size * 3 / 2);
+    int hw       = h * w;
+
+    std::vector<int> xofs(w), yofs(h);
+    std::vector<float> alpha(w), beta(h);
+    bool nearest = type == INTERP_TYPE_NEAREST;
+    CalculatePositionAndRatio(w, (double)src_w / w, src_w, 1, nearest, xofs.data(), alpha.data());
+    CalculatePositionAndRatio(h, (double)src_h / h, src_h, 1, nearest, yofs.data(), beta.data());
+
+    for (int b = 0; b < batch; ++b) {
+        const uint8_t *src_b = src + b * src_step;
+        float *dst_b         = dst + b * channel * hw;
+        for (int dy = 0; dy < h; ++dy) {
+            int sy = yofs[dy];
+            for (int dx = 0; dx < w; ++dx) {
+                int sx = xofs[dx];
+                int p00[4], p01[4], p10[4], p11[4];
+                NaiveLoadPixel(src_b, src_w, src_h, src_type, sx, sy, p00);
+                NaiveLoadPixel(src_b, src_w, src_h, src_type, sx + 1, sy, p01);
+                NaiveLoadPixel(src_b, src_w, src_h, src_type, sx, sy + 1, p10);
+                NaiveLoadPixel(src_b, src_w, src_h, src_type, sx + 1, sy + 1, p11);
+                for (int c = 0; c < channel; ++c) {
+                    int sc       = (reverse_channel && c < 3) ? 2 - c : c;
+                    float top    = p00[sc] + (p01[sc] - p00[sc]) * alpha[dx];
+                    float bottom = p10[sc] + (p11[sc] - p10[sc]) * alpha[dx];
+                    float value  = top + (bottom - top) * beta[dy];
+                    dst_b[c * hw + dy * w + dx] = scale[c] * value + bias[c];
+                }
+            }
+        }
+    }
+}
+
 void NaiveDequant(const int8_t *input_ptr, const float *scale_ptr, int scale_len, float *output, DimsVector dims) {
     int batch   = dims[0];
     int channel = dims[1];
@@ -26,6 +26,7 @@
 #include "tnn/core/common.h"
 #include "tnn/interpreter/layer_param.h"
 #include "tnn/utils/half_utils_inner.h"
+#include "tnn/utils/mat_utils.h"
 
 namespace TNN_NS {
 
@@ -108,6 +109,12 @@ void NaiveYUVToBGROrBGRALoop(const unsigned char *yptr0, const unsigned char *yp
 
 void NaiveYUVToBGROrBGRA(const unsigned char* yuv, unsigned char* bgr, const int channel, const int h, const int w, bool is_nv12);
 
+// resize a N8UC3, N8UC4, NNV12 or NNV21 image to h x w and convert it to a nchw float blob in one pass,
+// yuv420sp images are converted to bgr on the fly, y = scale * x + bias is applied to the resized pixels
+void NaiveResizeConvertToNCHW(const uint8_t *src, int batch, int src_w, int src_h, MatType src_type, float *dst,
+                              int w, int h, int channel, const float *scale, const float *bias, bool reverse_channel,
+                              InterpType type);
+
 void NaiveDequant(const int8_t *input_ptr, const float *scale_ptr, int scale_len, float *output, DimsVector dims);
 
 void NaiveQuant(const float *input_ptr, const float *scale_ptr, int scale_len, int8_t *output, DimsVector dims);
@@ -0,0 +1,101 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/utils/shared_weight_cache.h"
+
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace TNN_NS {
+
+typedef std::pair<const void *, std::string> SharedWeightKey;
+
+// the entry holds the source, its address is not reused while the entry is alive
+struct SharedWeightEntry {
+    RawBuffer source;
+    SharedWeightCache::Buffers buffers;
+};
+
+typedef std::map<SharedWeightKey, std::weak_ptr<SharedWeightCache::Buffers>> SharedWeightMap;
+
+static std::mutex &GetSharedWeightMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+static SharedWeightMap &GetSharedWeightMap() {
+    static SharedWeightMap map;
+    return map;
+}
+
+// drop the entries no acc holds any more, so a freed source address can be reused
+static void RemoveExpired(SharedWeightMap &map) {
+    for (auto iter = map.begin(); iter != map.end();) {
+        if (iter->second.expired()) {
+            iter = map.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+Status SharedWeightCache::Get(RawBuffer &source, const std::string &key, const PackFunction &pack,
+                              std::shared_ptr<Buffers> &buffers) {
+    const void *data = source.force_to<void *>();
+    if (!data) {
+        return Status(TNNERR_PARAM_ERR, "SharedWeightCache source buffer is empty");
+    }
+    SharedWeightKey cache_key(data, key + "_" + std::to_string(source.GetBytesSize()));
+
+    {
+        std::lock_guard<std::mutex> guard(GetSharedWeightMutex());
+        auto iter = GetSharedWeightMap().find(cache_key);
+        if (iter != GetSharedWeightMap().end()) {
+            buffers = iter->second.lock();
+            if (buffers) {
+                return TNN_OK;
+            }
+        }
+    }
+
+    // pack without the lock, layers of different instances may pack at the same time
+    auto entry    = std::make_shared<SharedWeightEntry>();
+    entry->source = source;
+    RETURN_ON_NEQ(pack(entry->buffers), TNN_OK);
+    std::shared_ptr<Buffers> packed(entry, &entry->buffers);
+
+    std::lock_guard<std::mutex> guard(GetSharedWeightMutex());
+    auto &map = GetSharedWeightMap();
+    RemoveExpired(map);
+    auto iter = map.find(cache_key);
+    if (iter != map.end()) {
+        // another acc packed the same weights meanwhile, keep the cached ones
+        buffers = iter->second.lock();
+        if (buffers) {
+            return TNN_OK;
+        }
+    }
+    map[cache_key] = packed;
+    buffers        = packed;
+    return TNN_OK;
+}
+
+int SharedWeightCache::GetCount() {
+    std::lock_guard<std::mutex> guard(GetSharedWeightMutex());
+    RemoveExpired(GetSharedWeightMap());
+    return (int)GetSharedWeightMap().size();
+}
+
+}  // namespace TNN_NS
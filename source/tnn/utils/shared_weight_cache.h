@@ -0,0 +1,50 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_UTILS_SHARED_WEIGHT_CACHE_H_
+#define TNN_SOURCE_TNN_UTILS_SHARED_WEIGHT_CACHE_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tnn/core/macro.h"
+#include "tnn/core/status.h"
+#include "tnn/interpreter/raw_buffer.h"
+
+namespace TNN_NS {
+
+// @brief SharedWeightCache shares the weights a layer acc transforms from a layer
+// resource, e.g. packed gemm weights. Instances created from one interpreter share
+// the layer resources, so the transformed weights are keyed by the source buffer
+// and a string describing the transform (device, precision, layout and its params).
+// An entry lives as long as one acc holds it, the buffers are read only.
+class SharedWeightCache {
+public:
+    typedef std::vector<RawBuffer> Buffers;
+    typedef std::function<Status(Buffers &buffers)> PackFunction;
+
+    // @brief get the buffers transformed from source as described by key, pack is
+    // called to create them if no acc holds them yet
+    static Status Get(RawBuffer &source, const std::string &key, const PackFunction &pack,
+                      std::shared_ptr<Buffers> &buffers);
+
+    // @brief number of entries held by accs
+    static int GetCount();
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_UTILS_SHARED_WEIGHT_CACHE_H_
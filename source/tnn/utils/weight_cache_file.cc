@@ -0,0 +1,176 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/utils/weight_cache_file.h"
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#include "tnn/interpreter/tnn/objseri.h"
+#include "tnn/utils/mmap_file.h"
+
+namespace TNN_NS {
+
+static const uint32_t g_weight_cache_magic_number = 0x0FABC0101;
+// magic number, data offset, data size and entry count
+static const int64_t g_weight_cache_header_size = sizeof(uint32_t) + 2 * sizeof(int64_t) + sizeof(int);
+static const int g_weight_cache_max_buffers     = 1024;
+
+WeightCacheFile::WeightCacheFile(const std::string &file_path) : file_path_(file_path) {}
+
+std::shared_ptr<WeightCacheFile> WeightCacheFile::Open(const std::string &file_path) {
+    std::shared_ptr<WeightCacheFile> cache_file(new WeightCacheFile(file_path));
+    auto status = cache_file->Load();
+    if (status != TNN_OK) {
+        LOGD("weight cache file %s is not loaded: %s\n", file_path.c_str(), status.description().c_str());
+        cache_file->entries_.clear();
+    }
+    return cache_file;
+}
+
+/*
+ * weight cache file layout:
+ *   magic number | data offset | data size | entry count | entries | data section
+ * Each entry is the key, the buffer count and the raw buffer records of v3 model,
+ * the data section starts at a page aligned offset with every raw data 64 bytes aligned.
+ */
+Status WeightCacheFile::Load() {
+    if (!std::ifstream(file_path_).good()) {
+        return Status(TNNERR_OPEN_FILE, "weight cache file not found");
+    }
+    auto file = std::make_shared<MmapFile>();
+    RETURN_ON_NEQ(file->Map(file_path_), TNN_OK);
+    const int64_t file_size = static_cast<int64_t>(file->GetSize());
+    if (file_size < g_weight_cache_header_size) {
+        return Status(TNNERR_INVALID_MODEL, "weight cache file is truncated");
+    }
+
+    // the mapping is kept alive by the buffers sharing its memory
+    std::shared_ptr<char> base(file, file->GetData());
+    MemoryStreamBuffer content_buffer(file->GetData(), file->GetSize());
+    std::istream content_stream(&content_buffer);
+    MmapDeserializer deserializer(content_stream, base);
+
+    const uint32_t magic_number = static_cast<uint32_t>(deserializer.GetInt());
+    const int64_t data_offset   = deserializer.GetInt64();
+    const int64_t data_size     = deserializer.GetInt64();
+    const int count             = deserializer.GetInt();
+    if (magic_number != g_weight_cache_magic_number || data_offset < g_weight_cache_header_size ||
+        data_size < 0 || data_offset + data_size > file_size || count < 0) {
+        return Status(TNNERR_INVALID_MODEL, "weight cache file header is invalid");
+    }
+    deserializer.SetDataSection(static_cast<std::streamoff>(data_offset));
+
+    for (int i = 0; i < count; ++i) {
+        std::string key  = deserializer.GetString();
+        int buffer_count = deserializer.GetInt();
+        if (!content_stream.good() || buffer_count < 0 || buffer_count > g_weight_cache_max_buffers) {
+            return Status(TNNERR_INVALID_MODEL, "weight cache file entry is invalid");
+        }
+        Buffers buffers(buffer_count);
+        for (auto &buffer : buffers) {
+            deserializer.GetRaw(buffer);
+        }
+        if (!content_stream.good()) {
+            return Status(TNNERR_INVALID_MODEL, "weight cache file entry is invalid");
+        }
+        entries_[key] = buffers;
+    }
+    return TNN_OK;
+}
+
+bool WeightCacheFile::Find(const std::string &key, Buffers &buffers) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto iter = entries_.find(key);
+    if (iter == entries_.end()) {
+        return false;
+    }
+    // RawBuffer copies share the data
+    buffers = iter->second;
+    return true;
+}
+
+void WeightCacheFile::Add(const std::string &key, const Buffers &buffers) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    entries_[key] = buffers;
+    changed_      = true;
+}
+
+/*
+ * The file is written to a temporary file and renamed, processes mapping the old
+ * file keep their pages and processes saving at the same time do not mix entries.
+ */
+Status WeightCacheFile::Save() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (!changed_) {
+        return TNN_OK;
+    }
+
+    std::ostringstream meta_stream;
+    std::ostringstream data_stream;
+    AlignedSerializer serializer(meta_stream, data_stream);
+    for (auto &entry : entries_) {
+        serializer.PutString(entry.first);
+        serializer.PutInt((int)entry.second.size());
+        for (auto &buffer : entry.second) {
+            serializer.PutRaw(buffer);
+        }
+    }
+    const std::string meta = meta_stream.str();
+    const std::string data = data_stream.str();
+    const int64_t meta_end = g_weight_cache_header_size + static_cast<int64_t>(meta.size());
+    const int64_t data_offset =
+        (meta_end + g_model_v3_section_alignment - 1) / g_model_v3_section_alignment * g_model_v3_section_alignment;
+    const int64_t data_size = static_cast<int64_t>(data.size());
+
+    const std::string temp_path = file_path_ + "." + std::to_string(std::random_device()()) + ".tmp";
+    std::ofstream write_stream(temp_path, std::ios::binary);
+    if (!write_stream || !write_stream.is_open() || !write_stream.good()) {
+        LOGE("invalid weight cache file name! (%s)\n", temp_path.c_str());
+        return Status(TNNERR_OPEN_FILE, "weight cache file cannot be written");
+    }
+    Serializer file_serializer(write_stream);
+    file_serializer.PutInt(static_cast<int>(g_weight_cache_magic_number));
+    file_serializer.PutInt64(data_offset);
+    file_serializer.PutInt64(data_size);
+    file_serializer.PutInt((int)entries_.size());
+    write_stream.write(meta.data(), meta.size());
+    std::vector<char> padding(data_offset - meta_end, 0);
+    write_stream.write(padding.data(), padding.size());
+    write_stream.write(data.data(), data.size());
+    write_stream.close();
+    if (!write_stream.good()) {
+        std::remove(temp_path.c_str());
+        return Status(TNNERR_OPEN_FILE, "weight cache file write failed");
+    }
+
+#if defined _WIN32
+    std::remove(file_path_.c_str());
+#endif
+    if (std::rename(temp_path.c_str(), file_path_.c_str()) != 0) {
+        std::remove(temp_path.c_str());
+        return Status(TNNERR_OPEN_FILE, "weight cache file rename failed");
+    }
+    changed_ = false;
+    return TNN_OK;
+}
+
+int WeightCacheFile::GetCount() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return (int)entries_.size();
+}
+
+}  // namespace TNN_NS
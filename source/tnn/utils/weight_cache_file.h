@@ -0,0 +1,67 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_UTILS_WEIGHT_CACHE_FILE_H_
+#define TNN_SOURCE_TNN_UTILS_WEIGHT_CACHE_FILE_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "tnn/core/macro.h"
+#include "tnn/core/status.h"
+#include "tnn/interpreter/raw_buffer.h"
+
+namespace TNN_NS {
+
+// @brief WeightCacheFile keeps the weights layer accs transform from layer resources,
+// e.g. packed gemm weights, in a file under the cache path. The file is mapped when
+// opened and the buffers found share the mapping, so later processes skip the transform
+// and share the pages. The key must describe the layer and the transform completely.
+class WeightCacheFile {
+public:
+    typedef std::vector<RawBuffer> Buffers;
+
+    // @brief open the cache file of the given path, entries of an existing valid file are
+    // mapped, a missing or invalid file gives an empty cache
+    static std::shared_ptr<WeightCacheFile> Open(const std::string &file_path);
+
+    // @brief find the buffers of key, return false if not cached
+    bool Find(const std::string &key, Buffers &buffers);
+
+    // @brief add the buffers of key, they are written to the file by Save
+    void Add(const std::string &key, const Buffers &buffers);
+
+    // @brief write all entries to the file if any entry was added after open
+    Status Save();
+
+    // @brief number of entries
+    int GetCount();
+
+private:
+    explicit WeightCacheFile(const std::string &file_path);
+
+    Status Load();
+
+    std::mutex mutex_;
+    std::string file_path_;
+    std::map<std::string, Buffers> entries_;
+    bool changed_ = false;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_UTILS_WEIGHT_CACHE_FILE_H_
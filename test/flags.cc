@@ -58,4 +58,6 @@ DEFINE_string(sc, "", scale_message);
 
 DEFINE_string(bi, "", bias_message);
 
+DEFINE_bool(mm, false, mmap_message);
+
 }  // namespace TNN_NS
@@ -67,6 +67,8 @@ static const char scale_message[] = "input scale: s0,s1,s2,...)";
 
 static const char bias_message[] = "input bias: b0,b1,b2,...)";
 
+static const char mmap_message[] = "memory map tnn model file instead of reading it (default false)";
+
 DECLARE_bool(h);
 
 DECLARE_string(mt);
@@ -109,6 +111,8 @@ DECLARE_string(sc);
 
 DECLARE_string(bi);
 
+DECLARE_bool(mm);
+
 }  // namespace TNN_NS
 
 #endif  // TNN_TEST_FLAGS_H_
@@ -209,6 +209,7 @@ namespace test {
         printf("    -et \"<enable tune>\t%s \n", enable_tune_message);
         printf("    -sc \"<input scale>\t%s \n", scale_message);
         printf("    -bi \"<input bias>\t%s \n", bias_message);
+        printf("    -mm \"<enable mmap>\t%s \n", mmap_message);
     }
 
     void SetCpuAffinity() {
@@ -285,7 +286,10 @@ namespace test {
                     std::string((std::istreambuf_iterator<char>(proto_stream)), std::istreambuf_iterator<char>());
             config.params.push_back(buffer);
 
-            if (config.model_type == MODEL_TYPE_TNN || config.model_type == MODEL_TYPE_NCNN) {
+            if (config.model_type == MODEL_TYPE_TNN && FLAGS_mm) {
+                config.enable_mmap = true;
+                config.params.push_back(model_path);
+            } else if (config.model_type == MODEL_TYPE_TNN || config.model_type == MODEL_TYPE_NCNN) {
                 std::ifstream model_stream(model_path, std::ios::binary);
                 if (!model_stream.is_open() || !model_stream.good()) {
                     config.params.push_back("");
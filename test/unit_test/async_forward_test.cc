@@ -0,0 +1,109 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tnn/core/instance.h"
+#include "tnn/core/tnn.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+static std::string GenerateSigmoidProto() {
+    return "\"1 3 1 4206624770 ,\"\n"
+           "\"input 1 3 8 8 ,\"\n"
+           "\" input sigmoid output ,\"\n"
+           "\"output ,\"\n"
+           "\" 2 ,\"\n"
+           "\"Sigmoid sigmoid 1 1 input sigmoid ,\"\n"
+           "\"ReLU output 1 1 sigmoid output ,\"\n";
+}
+
+static void FillInput(std::shared_ptr<Instance> instance, int seed) {
+    BlobMap input_blobs;
+    instance->GetAllInputBlobs(input_blobs);
+    Blob *input       = input_blobs["input"];
+    float *input_data = static_cast<float *>(input->GetHandle().base);
+    int input_count   = DimsVectorUtils::Count(input->GetBlobDesc().dims);
+    for (int i = 0; i < input_count; ++i) {
+        input_data[i] = (float)((i * 7 + seed * 3) % 17) - 8.0f;
+    }
+}
+
+static std::vector<float> GetOutput(std::shared_ptr<Instance> instance) {
+    BlobMap output_blobs;
+    instance->GetAllOutputBlobs(output_blobs);
+    Blob *output       = output_blobs["output"];
+    float *output_data = static_cast<float *>(output->GetHandle().base);
+    int output_count   = DimsVectorUtils::Count(output->GetBlobDesc().dims);
+    return std::vector<float>(output_data, output_data + output_count);
+}
+
+TEST(AsyncForwardTest, CallbackOnCompletion) {
+    ModelConfig model_config;
+    model_config.model_type = MODEL_TYPE_TNN;
+    // empty resource: layer count 0
+    model_config.params = {GenerateSigmoidProto(), std::string(sizeof(int), '\0')};
+
+    TNN net;
+    ASSERT_EQ(TNN_OK, (int)net.Init(model_config));
+
+    NetworkConfig network_config;
+    network_config.device_type = DEVICE_NAIVE;
+    Status status;
+    auto instance = net.CreateInst(network_config, status);
+    ASSERT_EQ(TNN_OK, (int)status);
+
+    FillInput(instance, 1);
+    ASSERT_EQ(TNN_OK, (int)instance->Forward());
+    auto expect = GetOutput(instance);
+
+    // the callback runs on the worker thread and may queue the next forward
+    std::promise<void> done;
+    std::thread::id caller_id = std::this_thread::get_id();
+    std::thread::id worker_id;
+    std::atomic<int> count(0);
+    std::vector<float> first;
+    Callback call_back = [&]() {
+        worker_id = std::this_thread::get_id();
+        if (++count == 1) {
+            first = GetOutput(instance);
+            EXPECT_EQ(TNN_OK, (int)instance->ForwardAsync(call_back));
+        } else {
+            done.set_value();
+        }
+    };
+    ASSERT_EQ(TNN_OK, (int)instance->ForwardAsync(call_back));
+    done.get_future().wait();
+    EXPECT_EQ(2, (int)count);
+    EXPECT_NE(caller_id, worker_id);
+    ASSERT_EQ(expect.size(), first.size());
+    for (size_t i = 0; i < expect.size(); ++i) {
+        EXPECT_FLOAT_EQ(expect[i], first[i]);
+    }
+
+    // a synchronous forward waits for the queued async forward
+    count = 1;
+    ASSERT_EQ(TNN_OK, (int)instance->ForwardAsync([&]() { count = 2; }));
+    ASSERT_EQ(TNN_OK, (int)instance->Forward());
+    EXPECT_EQ(2, (int)count);
+}
+
+}  // namespace TNN_NS
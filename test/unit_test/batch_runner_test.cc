@@ -0,0 +1,120 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tnn/core/batch_runner.h"
+#include "tnn/core/instance.h"
+#include "tnn/core/tnn.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+static std::string GenerateSigmoidProto() {
+    return "\"1 3 1 4206624770 ,\"\n"
+           "\"input 1 3 8 8 ,\"\n"
+           "\" input sigmoid output ,\"\n"
+           "\"output ,\"\n"
+           "\" 2 ,\"\n"
+           "\"Sigmoid sigmoid 1 1 input sigmoid ,\"\n"
+           "\"Abs output 1 1 sigmoid output ,\"\n";
+}
+
+static float InputValue(int request, int i) {
+    return (float)((i * 7 + request * 3) % 17) - 8.0f;
+}
+
+// a local load generator: client threads send batch 1 requests concurrently
+TEST(BatchRunnerTest, ConcurrentRequestsSameAsSingle) {
+    const int max_batch = 4, clients = 8, requests_per_client = 16;
+
+    ModelConfig model_config;
+    model_config.model_type = MODEL_TYPE_TNN;
+    // empty resource: layer count 0
+    model_config.params = {GenerateSigmoidProto(), std::string(sizeof(int), '\0')};
+
+    TNN net;
+    ASSERT_EQ(TNN_OK, (int)net.Init(model_config));
+
+    NetworkConfig network_config;
+    network_config.device_type = DEVICE_NAIVE;
+    Status status;
+    auto instance = net.CreateInst(network_config, status, {{"input", {1, 3, 8, 8}}},
+                                   {{"input", {max_batch, 3, 8, 8}}});
+    ASSERT_EQ(TNN_OK, (int)status);
+
+    BatchRunnerConfig config;
+    config.max_batch  = max_batch;
+    config.timeout_us = 2000;
+    BatchRunner runner(instance, config);
+
+    std::atomic<int> failures(0);
+    std::vector<std::thread> threads;
+    for (int c = 0; c < clients; ++c) {
+        threads.emplace_back([&, c]() {
+            for (int r = 0; r < requests_per_client; ++r) {
+                int request = c * requests_per_client + r;
+                std::shared_ptr<Mat> input(new Mat(DEVICE_NAIVE, NCHW_FLOAT, {1, 3, 8, 8}));
+                float *input_data = static_cast<float *>(input->GetData());
+                for (int i = 0; i < 3 * 8 * 8; ++i) {
+                    input_data[i] = InputValue(request, i);
+                }
+                MatMap inputs = {{"input", input}}, outputs;
+                if (runner.Forward(inputs, outputs) != TNN_OK || outputs.count("output") == 0 ||
+                    outputs["output"]->GetBatch() != 1) {
+                    failures++;
+                    continue;
+                }
+                float *output_data = static_cast<float *>(outputs["output"]->GetData());
+                for (int i = 0; i < 3 * 8 * 8; ++i) {
+                    float expect = 1.0f / (1.0f + std::exp(-InputValue(request, i)));
+                    if (std::fabs(output_data[i] - expect) > 1e-5f) {
+                        failures++;
+                        break;
+                    }
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(0, (int)failures);
+
+    auto statistics = runner.GetStatistics();
+    EXPECT_EQ(clients * requests_per_client, (int)statistics.request_count);
+    ASSERT_EQ(max_batch, (int)statistics.batch_size_histogram.size());
+    int64_t requests = 0, batches = 0, queued = 0, computed = 0;
+    for (int i = 0; i < max_batch; ++i) {
+        requests += statistics.batch_size_histogram[i] * (i + 1);
+        batches += statistics.batch_size_histogram[i];
+    }
+    for (size_t i = 0; i < statistics.queue_time_histogram.size(); ++i) {
+        queued += statistics.queue_time_histogram[i];
+        computed += statistics.compute_time_histogram[i];
+    }
+    EXPECT_EQ(statistics.request_count, requests);
+    // concurrent requests are merged
+    EXPECT_LT(batches, statistics.request_count);
+    EXPECT_EQ(statistics.request_count, queued);
+    EXPECT_EQ(batches, computed);
+}
+
+}  // namespace TNN_NS
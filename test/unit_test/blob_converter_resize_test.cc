@@ -0,0 +1,136 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "tnn/core/blob.h"
+#include "tnn/utils/blob_converter.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/mat_utils.h"
+
+namespace TNN_NS {
+
+class BlobConverterResizeTest
+    : public ::testing::TestWithParam<std::tuple<int, int, MatType, InterpType, bool, DataFormat>> {};
+
+INSTANTIATE_TEST_SUITE_P(BlobConverterResizeTest, BlobConverterResizeTest,
+                         ::testing::Combine(
+                             // batch
+                             testing::Values(1, 2),
+                             // output height, output width is height + 4
+                             testing::Values(7, 30),
+                             // mat type
+                             testing::Values(N8UC3, N8UC4, NNV12, NNV21),
+                             // interpolation
+                             testing::Values(INTERP_TYPE_LINEAR, INTERP_TYPE_NEAREST),
+                             // reverse_channel
+                             testing::Values(false, true),
+                             // blob data format
+                             testing::Values(DATA_FORMAT_NCHW, DATA_FORMAT_NC8HW8)));
+
+static std::vector<float> ReadBlob(Blob *blob) {
+    auto dims = blob->GetBlobDesc().dims;
+    Mat mat(DEVICE_NAIVE, NCHW_FLOAT, dims);
+    BlobConverter converter(blob);
+    EXPECT_EQ(TNN_OK, (int)converter.ConvertToMat(mat, MatConvertParam(), nullptr));
+    float *data = static_cast<float *>(mat.GetData());
+    return std::vector<float>(data, data + DimsVectorUtils::Count(dims));
+}
+
+// the fused conversion matches color conversion, resize and convert done one by one, up to the rounding of
+// the resized uint8 image
+TEST_P(BlobConverterResizeTest, BlobConverterResizeTest) {
+    int batch            = std::get<0>(GetParam());
+    int height           = std::get<1>(GetParam());
+    MatType mat_type     = std::get<2>(GetParam());
+    InterpType interp    = std::get<3>(GetParam());
+    bool reverse_channel = std::get<4>(GetParam());
+    DataFormat format    = std::get<5>(GetParam());
+
+    DeviceType dev = ConvertDeviceType(FLAGS_dt);
+    if (dev != DEVICE_NAIVE && dev != DEVICE_X86) {
+        GTEST_SKIP();
+    }
+    if (format == DATA_FORMAT_NC8HW8 && dev != DEVICE_X86) {
+        GTEST_SKIP();
+    }
+
+    const int src_h = 18, src_w = 24;
+    int width       = height + 4;
+    int channel     = mat_type == N8UC4 ? 4 : 3;
+    int src_count   = (mat_type == NNV12 || mat_type == NNV21) ? batch * src_h * src_w * 3 / 2
+                                                                : batch * channel * src_h * src_w;
+    std::vector<uint8_t> src_data(src_count);
+    for (int i = 0; i < src_count; ++i) {
+        src_data[i] = (uint8_t)((i * 37 + i / 7) % 256);
+    }
+    Mat src(dev, mat_type, {batch, channel, src_h, src_w}, src_data.data());
+
+    MatConvertParam param;
+    param.scale           = {0.5f, 0.25f, 2.0f, 1.0f};
+    param.bias            = {-1.0f, 0.5f, 0.0f, 2.0f};
+    param.reverse_channel = reverse_channel;
+    ResizeParam resize_param;
+    resize_param.type = interp;
+
+    // reference on naive device
+    Mat ref_src(DEVICE_NAIVE, mat_type, {batch, channel, src_h, src_w}, src_data.data());
+    MatType ref_type = mat_type == N8UC4 ? N8UC4 : N8UC3;
+    if (mat_type == NNV12 || mat_type == NNV21) {
+        // CvtColor takes a batch of yuv images as one tall image, convert them one by one
+        Mat bgr(DEVICE_NAIVE, N8UC3, {batch, 3, src_h, src_w});
+        auto type = mat_type == NNV12 ? COLOR_CONVERT_NV12TOBGR : COLOR_CONVERT_NV21TOBGR;
+        for (int b = 0; b < batch; ++b) {
+            Mat yuv_image(DEVICE_NAIVE, mat_type, {1, 3, src_h, src_w}, src_data.data() + b * src_h * src_w * 3 / 2);
+            Mat bgr_image(DEVICE_NAIVE, N8UC3, {1, 3, src_h, src_w},
+                          static_cast<uint8_t *>(bgr.GetData()) + b * 3 * src_h * src_w);
+            ASSERT_EQ(TNN_OK, (int)MatUtils::CvtColor(yuv_image, bgr_image, type, nullptr));
+        }
+        ref_src = bgr;
+    }
+    Mat ref_resized(DEVICE_NAIVE, ref_type, {batch, channel, height, width});
+    ASSERT_EQ(TNN_OK, (int)MatUtils::Resize(ref_src, ref_resized, resize_param, nullptr));
+
+    BlobDesc ref_desc;
+    ref_desc.device_type = DEVICE_NAIVE;
+    ref_desc.data_format = DATA_FORMAT_NCHW;
+    ref_desc.dims        = {batch, channel, height, width};
+    Blob ref_blob(ref_desc, true);
+    BlobConverter ref_converter(&ref_blob);
+    ASSERT_EQ(TNN_OK, (int)ref_converter.ConvertFromMat(ref_resized, param, nullptr));
+
+    BlobDesc desc        = ref_desc;
+    desc.device_type     = dev;
+    desc.data_format     = format;
+    Blob blob(desc, true);
+    BlobConverter converter(&blob);
+    ASSERT_EQ(TNN_OK, (int)converter.ConvertFromMatWithResize(src, resize_param, param, nullptr));
+
+    auto expect = ReadBlob(&ref_blob);
+    auto actual = ReadBlob(&blob);
+    ASSERT_EQ(expect.size(), actual.size());
+    int hw = height * width;
+    for (size_t i = 0; i < expect.size(); ++i) {
+        float tolerance = std::fabs(param.scale[(i / hw) % channel]) + 1e-4f;
+        ASSERT_NEAR(expect[i], actual[i], tolerance) << "index " << i;
+    }
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,193 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tnn/core/instance.h"
+#include "tnn/core/layer_type.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/utils/blob_converter.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+static void AddLayer(NetStructure *structure, NetResource *resource, std::string type_str, std::string name,
+                     std::vector<std::string> inputs, std::vector<std::string> outputs,
+                     std::shared_ptr<LayerParam> param, std::shared_ptr<LayerResource> layer_resource = nullptr) {
+    std::shared_ptr<LayerInfo> layer_info = std::make_shared<LayerInfo>();
+    layer_info->type                      = GlobalConvertLayerType(type_str);
+    layer_info->type_str                  = type_str;
+    layer_info->name                      = name;
+    layer_info->inputs                    = inputs;
+    layer_info->outputs                   = outputs;
+    param->type                           = type_str;
+    param->name                           = name;
+    layer_info->param                     = param;
+    structure->layers.push_back(layer_info);
+    for (auto &blob : outputs) {
+        structure->blobs.insert(blob);
+    }
+    if (layer_resource) {
+        resource->resource_map[name] = layer_resource;
+    }
+}
+
+static RawBuffer GenerateBuffer(int count, float scale) {
+    RawBuffer buffer(count * sizeof(float));
+    float *data = buffer.force_to<float *>();
+    for (int i = 0; i < count; ++i) {
+        data[i] = (float)((i * 5) % 11 - 5) * scale;
+    }
+    buffer.SetDataType(DATA_TYPE_FLOAT);
+    return buffer;
+}
+
+static std::shared_ptr<ConvLayerParam> GenerateConvParam(int input_channel, int output_channel, int group) {
+    std::shared_ptr<ConvLayerParam> param(new ConvLayerParam());
+    param->input_channel  = input_channel / group;
+    param->output_channel = output_channel;
+    param->group          = group;
+    param->kernels        = {3, 3};
+    param->dialations     = {1, 1};
+    param->strides        = {1, 1};
+    param->pads           = {1, 1, 1, 1};
+    param->bias           = 1;
+    return param;
+}
+
+static std::shared_ptr<ConvLayerResource> GenerateConvResource(int input_channel, int output_channel, int group) {
+    std::shared_ptr<ConvLayerResource> resource(new ConvLayerResource());
+    resource->filter_handle = GenerateBuffer(output_channel * input_channel / group * 9, 0.05f);
+    resource->bias_handle   = GenerateBuffer(output_channel, 0.1f);
+    return resource;
+}
+
+// channels are not multiples of 8 to cover the padded channels of blocks, Rsqrt is not
+// implemented on x86 and runs on naive device in NCHW
+static std::shared_ptr<AbstractModelInterpreter> GenerateBlockedNetInterpreter(int channel, int size) {
+    auto interpreter = std::shared_ptr<AbstractModelInterpreter>(CreateModelInterpreter(MODEL_TYPE_TNN));
+    auto default_interpreter = dynamic_cast<DefaultModelInterpreter *>(interpreter.get());
+    if (!default_interpreter) {
+        return nullptr;
+    }
+    NetStructure *structure = default_interpreter->GetNetStructure();
+    NetResource *resource   = default_interpreter->GetNetResource();
+
+    structure->inputs_shape_map["input"] = {1, 3, size, size};
+    structure->blobs.insert("input");
+    structure->outputs.insert("output");
+
+    AddLayer(structure, resource, "Convolution", "conv", {"input"}, {"conv"}, GenerateConvParam(3, channel, 1),
+             GenerateConvResource(3, channel, 1));
+
+    std::shared_ptr<BatchNormLayerResource> bn_resource(new BatchNormLayerResource());
+    bn_resource->scale_handle = GenerateBuffer(channel, 0.3f);
+    bn_resource->bias_handle  = GenerateBuffer(channel, 0.2f);
+    AddLayer(structure, resource, "BatchNormCxx", "bn", {"conv"}, {"bn"}, std::make_shared<LayerParam>(),
+             bn_resource);
+    AddLayer(structure, resource, "ReLU", "relu", {"bn"}, {"relu"}, std::make_shared<LayerParam>());
+
+    auto dw_param             = GenerateConvParam(channel, channel, channel);
+    dw_param->activation_type = ActivationType_ReLU;
+    AddLayer(structure, resource, "Convolution", "dw", {"relu"}, {"dw"}, dw_param,
+             GenerateConvResource(channel, channel, channel));
+    AddLayer(structure, resource, "Add", "add", {"relu", "dw"}, {"add"},
+             std::make_shared<MultidirBroadcastLayerParam>());
+
+    std::shared_ptr<PoolingLayerParam> pool_param(new PoolingLayerParam());
+    pool_param->pool_type = 0;
+    pool_param->kernels        = {2, 2};
+    pool_param->kernels_params = {2, 2};
+    pool_param->kernel_indexs  = {-1, -1};
+    pool_param->strides        = {2, 2};
+    pool_param->pads           = {0, 0, 0, 0};
+    AddLayer(structure, resource, "Pooling", "pool", {"add"}, {"pool"}, pool_param);
+
+    std::shared_ptr<UpsampleLayerParam> upsample_param(new UpsampleLayerParam());
+    upsample_param->mode   = 2;
+    upsample_param->scales = {2.0f, 2.0f};
+    AddLayer(structure, resource, "Upsample", "upsample", {"pool"}, {"upsample"}, upsample_param);
+    AddLayer(structure, resource, "Sigmoid", "sigmoid", {"upsample"}, {"sigmoid"}, std::make_shared<LayerParam>());
+    AddLayer(structure, resource, "Rsqrt", "rsqrt", {"sigmoid"}, {"rsqrt"}, std::make_shared<LayerParam>());
+    AddLayer(structure, resource, "Concat", "output", {"add", "rsqrt", "sigmoid"}, {"output"},
+             std::make_shared<ConcatLayerParam>());
+    return interpreter;
+}
+
+static Status RunBlockedNet(std::shared_ptr<AbstractModelInterpreter> interpreter, DeviceType device_type,
+                            DataFormat data_format, std::vector<float> &result, DataFormat &output_format) {
+    NetworkConfig network_config;
+    network_config.device_type = device_type;
+    network_config.data_format = data_format;
+    ModelConfig model_config;
+    model_config.params = {"", ""};
+
+    auto instance = std::make_shared<Instance>(network_config, model_config);
+    RETURN_ON_NEQ(instance->Init(interpreter, InputShapesMap()), TNN_OK);
+
+    BlobMap input_blobs, output_blobs;
+    instance->GetAllInputBlobs(input_blobs);
+    instance->GetAllOutputBlobs(output_blobs);
+    Blob *input   = input_blobs["input"];
+    Blob *output  = output_blobs["output"];
+    output_format = output->GetBlobDesc().data_format;
+
+    // blobs are read and written through blob converters, which handle the blocked layout
+    Mat input_mat(DEVICE_NAIVE, NCHW_FLOAT, input->GetBlobDesc().dims);
+    float *input_data = static_cast<float *>(input_mat.GetData());
+    int input_count   = DimsVectorUtils::Count(input->GetBlobDesc().dims);
+    for (int i = 0; i < input_count; ++i) {
+        input_data[i] = (float)((i * 7) % 17) * 0.25f - 2.0f;
+    }
+    BlobConverter input_converter(input);
+    RETURN_ON_NEQ(input_converter.ConvertFromMat(input_mat, MatConvertParam(), nullptr), TNN_OK);
+
+    RETURN_ON_NEQ(instance->Forward(), TNN_OK);
+
+    Mat output_mat(DEVICE_NAIVE, NCHW_FLOAT, output->GetBlobDesc().dims);
+    BlobConverter output_converter(output);
+    RETURN_ON_NEQ(output_converter.ConvertToMat(output_mat, MatConvertParam(), nullptr), TNN_OK);
+    float *output_data = static_cast<float *>(output_mat.GetData());
+    result.assign(output_data, output_data + DimsVectorUtils::Count(output->GetBlobDesc().dims));
+    return TNN_OK;
+}
+
+TEST(BlockedLayoutTest, X86NC8HW8MatchesNaive) {
+    const int channel = 12;
+    const int size    = 10;
+    auto interpreter  = GenerateBlockedNetInterpreter(channel, size);
+    ASSERT_TRUE(interpreter != nullptr);
+
+    std::vector<float> expect, actual;
+    DataFormat expect_format, actual_format;
+    ASSERT_EQ(TNN_OK, (int)RunBlockedNet(interpreter, DEVICE_NAIVE, DATA_FORMAT_AUTO, expect, expect_format));
+    Status status = RunBlockedNet(interpreter, DEVICE_X86, DATA_FORMAT_NC8HW8, actual, actual_format);
+    if (status == TNNERR_DEVICE_NOT_SUPPORT) {
+        GTEST_SKIP();
+    }
+    ASSERT_EQ(TNN_OK, (int)status);
+    EXPECT_EQ(DATA_FORMAT_NC8HW8, actual_format);
+
+    ASSERT_EQ(1 * channel * 3 * size * size, (int)expect.size());
+    ASSERT_EQ(expect.size(), actual.size());
+    for (size_t i = 0; i < expect.size(); ++i) {
+        EXPECT_NEAR(expect[i], actual[i], 1e-4f);
+    }
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,78 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <sched.h>
+#endif
+
+#include <string>
+#include <thread>
+
+#include "tnn/core/instance.h"
+#include "tnn/core/tnn.h"
+
+namespace TNN_NS {
+
+#if defined(__linux__) && !defined(__ANDROID__)
+
+static std::string GenerateReluProto() {
+    return "\"1 2 1 4206624770 ,\"\n"
+           "\"input 1 3 8 8 ,\"\n"
+           "\" input output ,\"\n"
+           "\"output ,\"\n"
+           "\" 1 ,\"\n"
+           "\"ReLU output 1 1 input output ,\"\n";
+}
+
+TEST(CpuAffinityTest, X86InstanceThreadsPinned) {
+    ModelConfig model_config;
+    model_config.model_type = MODEL_TYPE_TNN;
+    // empty resource: layer count 0
+    model_config.params = {GenerateReluProto(), std::string(sizeof(int), '\0')};
+
+    TNN net;
+    ASSERT_EQ(TNN_OK, (int)net.Init(model_config));
+
+    // run on a fresh thread so the affinity of the test process is left untouched
+    int status = TNN_OK;
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    std::thread worker([&]() {
+        NetworkConfig network_config;
+        network_config.device_type  = DEVICE_X86;
+        network_config.cpu_affinity = {0};
+        Status ret;
+        auto instance = net.CreateInst(network_config, ret);
+        if (ret == TNN_OK) {
+            instance->SetCpuNumThreads(4);
+            ret = instance->Forward();
+        }
+        status = (int)ret;
+        sched_getaffinity(0, sizeof(mask), &mask);
+    });
+    worker.join();
+
+    if (status == TNNERR_DEVICE_NOT_SUPPORT) {
+        GTEST_SKIP();
+    }
+    ASSERT_EQ(TNN_OK, status);
+    EXPECT_EQ(1, CPU_COUNT(&mask));
+    EXPECT_TRUE(CPU_ISSET(0, &mask));
+}
+
+#endif
+
+}  // namespace TNN_NS
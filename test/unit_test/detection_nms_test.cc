@@ -0,0 +1,188 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "tnn/core/blob.h"
+#include "tnn/utils/bbox_soa_util.h"
+#include "tnn/utils/detection_post_process_utils.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/naive_compute.h"
+
+namespace TNN_NS {
+
+static std::shared_ptr<Blob> CreateBlob(DimsVector dims) {
+    BlobDesc desc;
+    desc.device_type = DEVICE_NAIVE;
+    desc.data_format = DATA_FORMAT_NCHW;
+    desc.dims        = dims;
+    return std::make_shared<Blob>(desc, true);
+}
+
+static float *BlobData(std::shared_ptr<Blob> blob) {
+    return static_cast<float *>(blob->GetHandle().base);
+}
+
+class DetectionOutputSoATest : public ::testing::TestWithParam<std::tuple<bool, int, bool, int, float>> {};
+
+INSTANTIATE_TEST_SUITE_P(DetectionOutputSoATest, DetectionOutputSoATest,
+                         ::testing::Combine(
+                             // share_location
+                             testing::Values(true, false),
+                             // code_type
+                             testing::Values(1, 2, 3),
+                             // variance_encoded_in_target
+                             testing::Values(false, true),
+                             // keep_top_k
+                             testing::Values(-1, 15),
+                             // eta
+                             testing::Values(1.0f, 0.9f)));
+
+// the SoA path gives the same detections in the same order as NaiveDetectionOutput
+TEST_P(DetectionOutputSoATest, DetectionOutputSoATest) {
+    DetectionOutputLayerParam param;
+    param.share_location             = std::get<0>(GetParam());
+    param.code_type                  = std::get<1>(GetParam());
+    param.variance_encoded_in_target = std::get<2>(GetParam());
+    param.keep_top_k                 = std::get<3>(GetParam());
+    param.eta                        = std::get<4>(GetParam());
+    param.num_classes                = 4;
+    param.background_label_id        = 0;
+    param.confidence_threshold       = 0.3f;
+    param.nms_param.nms_threshold    = 0.45f;
+    param.nms_param.top_k            = 40;
+
+    const int num             = 2;
+    const int num_priors      = 67;
+    const int num_loc_classes = param.share_location ? 1 : param.num_classes;
+
+    auto loc   = CreateBlob({num, num_priors * num_loc_classes * 4, 1, 1});
+    auto conf  = CreateBlob({num, num_priors * param.num_classes, 1, 1});
+    auto prior = CreateBlob({1, 2, num_priors * 4, 1});
+
+    std::mt19937 generator(17);
+    std::uniform_real_distribution<float> uniform(0.f, 1.f);
+    for (int i = 0; i < num * num_priors * num_loc_classes * 4; ++i) {
+        BlobData(loc)[i] = uniform(generator) - 0.5f;
+    }
+    for (int i = 0; i < num * num_priors * param.num_classes; ++i) {
+        BlobData(conf)[i] = uniform(generator);
+    }
+    // priors are clustered in a few places so that nms has overlaps to suppress
+    for (int i = 0; i < num_priors; ++i) {
+        float *box = BlobData(prior) + i * 4;
+        float x    = (i % 3) * 0.3f + uniform(generator) * 0.05f;
+        float y    = (i % 2) * 0.4f + uniform(generator) * 0.05f;
+        box[0]     = x;
+        box[1]     = y;
+        box[2]     = x + 0.2f + uniform(generator) * 0.1f;
+        box[3]     = y + 0.2f + uniform(generator) * 0.1f;
+
+        float *variance = BlobData(prior) + (num_priors + i) * 4;
+        variance[0]     = 0.1f;
+        variance[1]     = 0.1f;
+        variance[2]     = 0.2f;
+        variance[3]     = 0.2f;
+    }
+
+    const int max_detections = num * num_priors * param.num_classes;
+    auto expect_blob         = CreateBlob({1, 1, max_detections, 7});
+    auto actual_blob         = CreateBlob({1, 1, max_detections, 7});
+    NaiveDetectionOutput({loc.get(), conf.get(), prior.get()}, {expect_blob.get()}, &param);
+    DetectionOutputSoA({loc.get(), conf.get(), prior.get()}, {actual_blob.get()}, &param);
+
+    auto expect_dims = expect_blob->GetBlobDesc().dims;
+    ASSERT_EQ(expect_dims, actual_blob->GetBlobDesc().dims);
+    ASSERT_GT(expect_dims[2], num);
+    if (param.keep_top_k > -1) {
+        EXPECT_EQ(num * param.keep_top_k, expect_dims[2]);
+    }
+    int count = DimsVectorUtils::Count(expect_dims);
+    for (int i = 0; i < count; ++i) {
+        ASSERT_FLOAT_EQ(BlobData(expect_blob)[i], BlobData(actual_blob)[i]) << "index " << i;
+    }
+}
+
+static float CornerIOU(const float *boxes, int i, int j) {
+    const float *box_i = boxes + i * 4;
+    const float *box_j = boxes + j * 4;
+    const float area_i = std::fabs((box_i[2] - box_i[0]) * (box_i[3] - box_i[1]));
+    const float area_j = std::fabs((box_j[2] - box_j[0]) * (box_j[3] - box_j[1]));
+    if (area_i <= 0 || area_j <= 0) {
+        return 0.f;
+    }
+    const float height = std::min(std::max(box_i[0], box_i[2]), std::max(box_j[0], box_j[2])) -
+                         std::max(std::min(box_i[0], box_i[2]), std::min(box_j[0], box_j[2]));
+    const float width  = std::min(std::max(box_i[1], box_i[3]), std::max(box_j[1], box_j[3])) -
+                        std::max(std::min(box_i[1], box_i[3]), std::min(box_j[1], box_j[3]));
+    const float inter  = std::max(height, 0.f) * std::max(width, 0.f);
+    return inter / (area_i + area_j - inter);
+}
+
+// greedy nms checking every candidate against every selected box
+TEST(DetectionPostProcessNMSTest, MatchesGreedyNMS) {
+    const int num_boxes         = 203;
+    const int max_detections    = 25;
+    const float iou_threshold   = 0.5f;
+    const float score_threshold = 0.2f;
+
+    auto boxes = CreateBlob({num_boxes, 4, 1, 1});
+    std::vector<float> scores(num_boxes);
+    std::mt19937 generator(5);
+    std::uniform_real_distribution<float> uniform(0.f, 1.f);
+    for (int i = 0; i < num_boxes; ++i) {
+        float *box = BlobData(boxes) + i * 4;
+        float y    = (i % 4) * 0.2f + uniform(generator) * 0.1f;
+        float x    = (i % 5) * 0.15f + uniform(generator) * 0.1f;
+        // some boxes have their corners swapped
+        box[0]    = y;
+        box[1]    = x;
+        box[2]    = y + (i % 7 == 0 ? -0.25f : 0.25f);
+        box[3]    = x + 0.2f;
+        scores[i] = uniform(generator);
+    }
+
+    std::vector<int> order(num_boxes);
+    for (int i = 0; i < num_boxes; ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int i, int j) { return scores[i] > scores[j]; });
+    std::vector<int32_t> expect;
+    for (int index : order) {
+        if (expect.size() >= max_detections || scores[index] <= score_threshold) {
+            break;
+        }
+        bool keep = true;
+        for (int selected : expect) {
+            keep = keep && CornerIOU(BlobData(boxes), index, selected) <= iou_threshold;
+        }
+        if (keep) {
+            expect.push_back(index);
+        }
+    }
+
+    std::vector<int32_t> actual;
+    NonMaxSuppressionSingleClasssImpl(boxes.get(), scores.data(), max_detections, iou_threshold, score_threshold,
+                                      &actual);
+    EXPECT_GT(expect.size(), 1);
+    EXPECT_EQ(expect, actual);
+}
+
+}  // namespace TNN_NS
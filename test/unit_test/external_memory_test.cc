@@ -0,0 +1,152 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/instance.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+static std::shared_ptr<AbstractModelInterpreter> GenerateConvInterpreter(int channel, int input_size) {
+    std::shared_ptr<ConvLayerParam> param(new ConvLayerParam());
+    param->name           = "Conv";
+    param->input_channel  = channel;
+    param->output_channel = channel;
+    param->group          = 1;
+    param->kernels        = {3, 3};
+    param->dialations     = {1, 1};
+    param->strides        = {1, 1};
+    param->pads           = {1, 1, 1, 1};
+    param->bias           = 1;
+
+    std::shared_ptr<ConvLayerResource> resource(new ConvLayerResource());
+    RawBuffer filter(channel * channel * 9 * sizeof(float));
+    float *filter_data = filter.force_to<float *>();
+    for (int i = 0; i < channel * channel * 9; ++i) {
+        filter_data[i] = (float)(i % 7) * 0.125f - 0.375f;
+    }
+    filter.SetDataType(DATA_TYPE_FLOAT);
+    RawBuffer bias(channel * sizeof(float));
+    float *bias_data = bias.force_to<float *>();
+    for (int i = 0; i < channel; ++i) {
+        bias_data[i] = (float)i * 0.25f;
+    }
+    bias.SetDataType(DATA_TYPE_FLOAT);
+    resource->filter_handle = filter;
+    resource->bias_handle   = bias;
+
+    return GenerateInterpreter("Convolution", {{1, channel, input_size, input_size}}, param, resource);
+}
+
+static float *AlignTo32(float *data) {
+    return reinterpret_cast<float *>((reinterpret_cast<uintptr_t>(data) + 31) & ~(uintptr_t)31);
+}
+
+static void FillInput(float *data, int count) {
+    for (int i = 0; i < count; ++i) {
+        data[i] = (float)((i * 5) % 13) * 0.5f - 3.0f;
+    }
+}
+
+// the input and output blobs use the caller memory and are left out of the forward memory
+TEST(ExternalMemoryTest, ForwardWithBoundMemory) {
+    DeviceType device_type = ConvertDeviceType(FLAGS_dt);
+    if (device_type != DEVICE_NAIVE && device_type != DEVICE_X86 && device_type != DEVICE_ARM) {
+        GTEST_SKIP();
+    }
+    auto interpreter = GenerateConvInterpreter(8, 12);
+    ASSERT_TRUE(interpreter != nullptr);
+
+    NetworkConfig config;
+    config.device_type = device_type;
+    ModelConfig model_config;
+    model_config.params = {"", ""};
+
+    auto instance = std::make_shared<Instance>(config, model_config);
+    ASSERT_EQ(TNN_OK, (int)instance->Init(interpreter, InputShapesMap()));
+
+    NetworkConfig external_config         = config;
+    external_config.external_memory_blobs = {"input0", "output0"};
+    auto external_instance                = std::make_shared<Instance>(external_config, model_config);
+    ASSERT_EQ(TNN_OK, (int)external_instance->Init(interpreter, InputShapesMap()));
+
+    int memory_size = 0, external_memory_size = 0;
+    instance->GetForwardMemorySize(memory_size);
+    external_instance->GetForwardMemorySize(external_memory_size);
+    EXPECT_LT(external_memory_size, memory_size);
+
+    BlobMap input_blobs, output_blobs;
+    instance->GetAllInputBlobs(input_blobs);
+    instance->GetAllOutputBlobs(output_blobs);
+    Blob *input       = input_blobs["input0"];
+    Blob *output      = output_blobs["output0"];
+    BlobDesc in_desc  = input->GetBlobDesc();
+    BlobDesc out_desc = output->GetBlobDesc();
+    if (in_desc.data_format != DATA_FORMAT_NCHW || out_desc.data_format != DATA_FORMAT_NCHW) {
+        // blocked layouts are bound the same way, the test fills nchw data only
+        GTEST_SKIP();
+    }
+    int input_count  = DimsVectorUtils::Count(in_desc.dims);
+    int output_count = DimsVectorUtils::Count(out_desc.dims);
+    FillInput(static_cast<float *>(input->GetHandle().base), input_count);
+    ASSERT_EQ(TNN_OK, (int)instance->Forward());
+    float *expect = static_cast<float *>(output->GetHandle().base);
+
+    // not bound yet
+    EXPECT_NE(TNN_OK, (int)external_instance->Forward());
+
+    std::vector<float> input_memory(input_count + 8), output_memory(output_count + 8);
+    float *input_data  = AlignTo32(input_memory.data());
+    float *output_data = AlignTo32(output_memory.data());
+    EXPECT_NE(TNN_OK, (int)external_instance->BindExternalMemory("input0", input_data + 1, input_count * 4));
+    EXPECT_NE(TNN_OK, (int)external_instance->BindExternalMemory("input0", input_data, input_count * 4 - 4));
+    EXPECT_NE(TNN_OK, (int)external_instance->BindExternalMemory("Conv", input_data, input_count * 4));
+    ASSERT_EQ(TNN_OK, (int)external_instance->BindExternalMemory("input0", input_data, input_count * 4));
+    ASSERT_EQ(TNN_OK, (int)external_instance->BindExternalMemory("output0", output_data, output_count * 4));
+
+    FillInput(input_data, input_count);
+    ASSERT_EQ(TNN_OK, (int)external_instance->Forward());
+
+    BlobMap external_outputs;
+    external_instance->GetAllOutputBlobs(external_outputs);
+    EXPECT_EQ(output_data, external_outputs["output0"]->GetHandle().base);
+    for (int i = 0; i < output_count; ++i) {
+        ASSERT_NEAR(expect[i], output_data[i], 1e-4f) << "index " << i;
+    }
+}
+
+// only input and output blobs can be listed
+TEST(ExternalMemoryTest, RejectsUnknownBlobs) {
+    DeviceType device_type = ConvertDeviceType(FLAGS_dt);
+    if (device_type != DEVICE_NAIVE && device_type != DEVICE_X86 && device_type != DEVICE_ARM) {
+        GTEST_SKIP();
+    }
+    NetworkConfig config;
+    config.device_type           = device_type;
+    config.external_memory_blobs = {"not_a_blob"};
+    ModelConfig model_config;
+    model_config.params = {"", ""};
+
+    auto instance = std::make_shared<Instance>(config, model_config);
+    EXPECT_NE(TNN_OK, (int)instance->Init(GenerateConvInterpreter(8, 12), InputShapesMap()));
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,185 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/instance.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/optimizer/net_optimizer_manager.h"
+#include "tnn/optimizer/optimizer_const.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+static const int kHeads = 2;
+static const int kSeqQ  = 5;
+static const int kSeqK  = 19;
+static const int kDepth = 8;
+static const float kScale = 0.35f;
+
+static std::shared_ptr<LayerInfo> CreateLayer(LayerType type, const std::string &type_str, const std::string &name,
+                                              const std::vector<std::string> &inputs, const std::string &output,
+                                              std::shared_ptr<LayerParam> param) {
+    param->name          = name;
+    param->type          = type_str;
+    auto layer_info      = std::make_shared<LayerInfo>();
+    layer_info->type     = type;
+    layer_info->type_str = type_str;
+    layer_info->name     = name;
+    layer_info->inputs   = inputs;
+    layer_info->outputs  = {output};
+    layer_info->param    = param;
+    return layer_info;
+}
+
+// q x k^T -> mul by scale -> add mask -> softmax -> x v
+static std::shared_ptr<AbstractModelInterpreter> GenerateAttentionInterpreter() {
+    auto interpreter = std::shared_ptr<AbstractModelInterpreter>(CreateModelInterpreter(MODEL_TYPE_TNN));
+    auto default_interpreter = dynamic_cast<DefaultModelInterpreter *>(interpreter.get());
+    NetStructure *structure  = default_interpreter->GetNetStructure();
+    NetResource *resource    = default_interpreter->GetNetResource();
+
+    structure->inputs_shape_map = {{"q", {1, kHeads, kSeqQ, kDepth}},
+                                   {"kt", {1, kHeads, kDepth, kSeqK}},
+                                   {"v", {1, kHeads, kSeqK, kDepth}},
+                                   {"mask", {1, 1, 1, kSeqK}}};
+    structure->blobs   = {"q", "kt", "v", "mask", "scores", "scaled", "masked", "probs", "output"};
+    structure->outputs = {"output"};
+
+    auto softmax_param  = std::make_shared<SoftmaxLayerParam>();
+    softmax_param->axis = 3;
+    structure->layers   = {
+        CreateLayer(LAYER_MATMUL, "MatMul", "qk", {"q", "kt"}, "scores", std::make_shared<MatMulLayerParam>()),
+        CreateLayer(LAYER_MUL, "Mul", "scale", {"scores"}, "scaled", std::make_shared<MultidirBroadcastLayerParam>()),
+        CreateLayer(LAYER_ADD, "Add", "mask_add", {"scaled", "mask"}, "masked",
+                    std::make_shared<MultidirBroadcastLayerParam>()),
+        CreateLayer(LAYER_SOFTMAX, "Softmax", "softmax", {"masked"}, "probs", softmax_param),
+        CreateLayer(LAYER_MATMUL, "MatMul", "pv", {"probs", "v"}, "output", std::make_shared<MatMulLayerParam>())};
+
+    auto scale_resource = std::make_shared<EltwiseLayerResource>();
+    RawBuffer scale(sizeof(float));
+    scale.force_to<float *>()[0] = kScale;
+    scale.SetDataType(DATA_TYPE_FLOAT);
+    scale.SetBufferDims({1});
+    scale_resource->element_handle  = scale;
+    scale_resource->element_shape   = {1};
+    resource->resource_map["scale"] = scale_resource;
+    return interpreter;
+}
+
+static void FillInput(std::vector<float> &data, int count, int seed) {
+    data.resize(count);
+    for (int i = 0; i < count; ++i) {
+        data[i] = (float)((i * 7 + seed) % 13) * 0.125f - 0.75f;
+    }
+}
+
+TEST(FusedAttentionTest, FusesAttentionChain) {
+    auto interpreter = GenerateAttentionInterpreter();
+    auto structure   = dynamic_cast<DefaultModelInterpreter *>(interpreter.get())->GetNetStructure();
+    auto resource    = dynamic_cast<DefaultModelInterpreter *>(interpreter.get())->GetNetResource();
+    auto optimizer   = optimizer::NetOptimizerManager::GetNetOptimizerByName(optimizer::kNetOptimizerFuseAttention);
+    ASSERT_TRUE(optimizer != nullptr);
+
+    NetStructure unfused = *structure;
+    ASSERT_EQ(TNN_OK, (int)optimizer->Optimize(structure, resource));
+    ASSERT_EQ(1, structure->layers.size());
+    auto fused = structure->layers[0];
+    EXPECT_EQ(LAYER_FUSED_ATTENTION, fused->type);
+    EXPECT_EQ(std::vector<std::string>({"q", "kt", "v", "mask"}), fused->inputs);
+    EXPECT_EQ(std::vector<std::string>({"output"}), fused->outputs);
+    EXPECT_EQ(0, structure->blobs.count("probs"));
+    auto param = dynamic_cast<FusedAttentionLayerParam *>(fused->param.get());
+    ASSERT_TRUE(param != nullptr);
+    EXPECT_FLOAT_EQ(kScale, param->scale);
+
+    // the probabilities are needed outside, nothing is fused
+    unfused.outputs.insert("probs");
+    ASSERT_EQ(TNN_OK, (int)optimizer->Optimize(&unfused, resource));
+    EXPECT_EQ(5, unfused.layers.size());
+}
+
+// the fused layer gives the same output as the attention computed step by step
+TEST(FusedAttentionTest, MatchesReference) {
+    DeviceType device_type = ConvertDeviceType(FLAGS_dt);
+    if (device_type != DEVICE_NAIVE && device_type != DEVICE_X86) {
+        GTEST_SKIP();
+    }
+    NetworkConfig config;
+    config.device_type = device_type;
+    ModelConfig model_config;
+    model_config.params = {"", ""};
+    auto instance       = std::make_shared<Instance>(config, model_config);
+    ASSERT_EQ(TNN_OK, (int)instance->Init(GenerateAttentionInterpreter(), InputShapesMap()));
+
+    std::vector<float> q, kt, v, mask;
+    FillInput(q, kHeads * kSeqQ * kDepth, 1);
+    FillInput(kt, kHeads * kDepth * kSeqK, 2);
+    FillInput(v, kHeads * kSeqK * kDepth, 3);
+    FillInput(mask, kSeqK, 4);
+    std::map<std::string, std::pair<std::vector<float> *, DimsVector>> inputs = {
+        {"q", {&q, {1, kHeads, kSeqQ, kDepth}}},
+        {"kt", {&kt, {1, kHeads, kDepth, kSeqK}}},
+        {"v", {&v, {1, kHeads, kSeqK, kDepth}}},
+        {"mask", {&mask, {1, 1, 1, kSeqK}}}};
+    for (auto &input : inputs) {
+        auto mat = std::make_shared<Mat>(DEVICE_NAIVE, NCHW_FLOAT, input.second.second, input.second.first->data());
+        ASSERT_EQ(TNN_OK, (int)instance->SetInputMat(mat, MatConvertParam(), input.first));
+    }
+    ASSERT_EQ(TNN_OK, (int)instance->Forward());
+    std::shared_ptr<Mat> output_mat;
+    ASSERT_EQ(TNN_OK, (int)instance->GetOutputMat(output_mat, MatConvertParam(), "output", DEVICE_NAIVE));
+    ASSERT_EQ(kHeads * kSeqQ * kDepth, DimsVectorUtils::Count(output_mat->GetDims()));
+    float *output = static_cast<float *>(output_mat->GetData());
+
+    for (int h = 0; h < kHeads; ++h) {
+        for (int i = 0; i < kSeqQ; ++i) {
+            std::vector<float> probs(kSeqK);
+            float max_score = -INFINITY, sum = 0;
+            for (int j = 0; j < kSeqK; ++j) {
+                float score = 0;
+                for (int d = 0; d < kDepth; ++d) {
+                    score += q[(h * kSeqQ + i) * kDepth + d] * kt[(h * kDepth + d) * kSeqK + j];
+                }
+                probs[j]  = score * kScale + mask[j];
+                max_score = std::max(max_score, probs[j]);
+            }
+            for (int j = 0; j < kSeqK; ++j) {
+                probs[j] = std::exp(probs[j] - max_score);
+                sum += probs[j];
+            }
+            for (int d = 0; d < kDepth; ++d) {
+                float expect = 0;
+                for (int j = 0; j < kSeqK; ++j) {
+                    expect += probs[j] / sum * v[(h * kSeqK + j) * kDepth + d];
+                }
+                ASSERT_NEAR(expect, output[(h * kSeqQ + i) * kDepth + d], 1e-4f)
+                    << "head " << h << " row " << i << " col " << d;
+            }
+        }
+    }
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,111 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tnn/core/instance.h"
+#include "tnn/core/tnn.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+// four branches of three layers, the branch memory is reused by later branches
+static std::string GenerateMultiBranchProto() {
+    const int branch_count = 4;
+    std::ostringstream blobs;
+    std::ostringstream layers;
+    std::ostringstream concat_inputs;
+    blobs << " input";
+    for (int b = 0; b < branch_count; ++b) {
+        const std::string prefix = "b" + std::to_string(b) + "_";
+        const char *types[3]     = {b % 2 ? "Sigmoid" : "ReLU", "Sigmoid", b % 2 ? "ReLU" : "Sigmoid"};
+        std::string input        = "input";
+        for (int l = 0; l < 3; ++l) {
+            std::string output = prefix + std::to_string(l);
+            layers << "\"" << types[l] << " " << output << " 1 1 " << input << " " << output << " ,\"\n";
+            blobs << " " << output;
+            input = output;
+        }
+        concat_inputs << " " << input;
+    }
+    layers << "\"Concat output " << branch_count << " 1" << concat_inputs.str() << " output 1 ,\"\n";
+    blobs << " output";
+
+    std::ostringstream proto;
+    proto << "\"1 " << (branch_count * 3 + 2) << " 1 4206624770 ,\"\n";
+    proto << "\"input 1 4 8 8 ,\"\n";
+    proto << "\"" << blobs.str() << " ,\"\n";
+    proto << "\"output ,\"\n";
+    proto << "\" " << (branch_count * 3 + 1) << " ,\"\n";
+    proto << layers.str();
+    return proto.str();
+}
+
+static std::vector<float> RunMultiBranchNet(TNN &net, int inter_op_threads, int forward_count) {
+    NetworkConfig network_config;
+    network_config.device_type      = DEVICE_NAIVE;
+    network_config.inter_op_threads = inter_op_threads;
+    Status status;
+    auto instance = net.CreateInst(network_config, status);
+    EXPECT_EQ(TNN_OK, (int)status);
+    if (status != TNN_OK) {
+        return {};
+    }
+
+    BlobMap input_blobs, output_blobs;
+    instance->GetAllInputBlobs(input_blobs);
+    instance->GetAllOutputBlobs(output_blobs);
+    Blob *input  = input_blobs["input"];
+    Blob *output = output_blobs["output"];
+
+    std::vector<float> result;
+    for (int i = 0; i < forward_count; ++i) {
+        float *input_data = static_cast<float *>(input->GetHandle().base);
+        int input_count   = DimsVectorUtils::Count(input->GetBlobDesc().dims);
+        for (int j = 0; j < input_count; ++j) {
+            input_data[j] = (float)((j * 7 + i * 3) % 17) - 8.0f;
+        }
+        EXPECT_EQ(TNN_OK, (int)instance->Forward());
+
+        float *output_data = static_cast<float *>(output->GetHandle().base);
+        int output_count   = DimsVectorUtils::Count(output->GetBlobDesc().dims);
+        result.insert(result.end(), output_data, output_data + output_count);
+    }
+    return result;
+}
+
+TEST(InterOpExecutorTest, MultiBranchSameAsSequential) {
+    ModelConfig model_config;
+    model_config.model_type = MODEL_TYPE_TNN;
+    // empty resource: layer count 0
+    model_config.params = {GenerateMultiBranchProto(), std::string(sizeof(int), '\0')};
+
+    TNN net;
+    ASSERT_EQ(TNN_OK, (int)net.Init(model_config));
+
+    auto expect = RunMultiBranchNet(net, 1, 3);
+    auto actual = RunMultiBranchNet(net, 4, 3);
+    ASSERT_EQ(3 * 1 * 16 * 8 * 8, (int)expect.size());
+    ASSERT_EQ(expect.size(), actual.size());
+    for (size_t i = 0; i < expect.size(); ++i) {
+        EXPECT_FLOAT_EQ(expect[i], actual[i]);
+    }
+}
+
+}  // namespace TNN_NS
@@ -42,6 +42,9 @@ bool LayerTest::CheckDataTypeSkip(DataType data_type) {
     }
 #endif
     DeviceType dev = ConvertDeviceType(FLAGS_dt);
+    if (data_type == DATA_TYPE_INT8 && DEVICE_X86 == dev && x86_int8_implemented_) {
+        return false;
+    }
     if ( (data_type == DATA_TYPE_HALF || data_type == DATA_TYPE_INT8 || data_type == DATA_TYPE_BFP16) && (DEVICE_ARM != dev &&  DEVICE_NAIVE != dev))  {
         return true;
     }
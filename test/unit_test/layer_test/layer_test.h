@@ -54,6 +54,8 @@ private:
 
 protected:
     int ensure_input_positive_ = 0;
+    // layers with an x86 int8 acc set it to run their int8 cases on x86
+    bool x86_int8_implemented_ = false;
 
     static std::shared_ptr<Instance> instance_cpu_;
     static std::shared_ptr<Instance> instance_device_;
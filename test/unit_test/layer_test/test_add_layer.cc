@@ -47,6 +47,7 @@ TEST_P(AddLayerTest, BinaryLayerTest) {
         }
     }
 
+    x86_int8_implemented_ = true;
     RunBinaryTest("Add");
 }
 }  // namespace TNN_NS
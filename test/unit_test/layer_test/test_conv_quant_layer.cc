@@ -59,6 +59,7 @@ TEST_P(ConvQuantLayerTest, ConvLayer) {
     int channel           = group * channel_per_group;
     DeviceType dev        = ConvertDeviceType(FLAGS_dt);
 
+    x86_int8_implemented_ = true;
     if(CheckDataTypeSkip(data_type)) {
         GTEST_SKIP();
     }
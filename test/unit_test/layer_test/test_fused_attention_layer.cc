@@ -0,0 +1,74 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+class FusedAttentionLayerTest : public LayerTest,
+                                public ::testing::WithParamInterface<std::tuple<int, int, int, int, int, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, FusedAttentionLayerTest,
+                         ::testing::Combine(
+                             // batch
+                             testing::Values(1, 2),
+                             // heads
+                             testing::Values(1, 3),
+                             // seq_q
+                             testing::Values(1, 7, 40),
+                             // seq_k, the last one spans several key blocks
+                             testing::Values(1, 9, 300),
+                             // depth
+                             testing::Values(5, 16),
+                             // mask, 0: none, 1: [batch, 1, 1, seq_k], 2: [1, 1, seq_q, seq_k]
+                             testing::Values(0, 1, 2)));
+
+TEST_P(FusedAttentionLayerTest, FusedAttentionLayer) {
+    // get param
+    int batch      = std::get<0>(GetParam());
+    int heads      = std::get<1>(GetParam());
+    int seq_q      = std::get<2>(GetParam());
+    int seq_k      = std::get<3>(GetParam());
+    int depth      = std::get<4>(GetParam());
+    int mask       = std::get<5>(GetParam());
+    DeviceType dev = ConvertDeviceType(FLAGS_dt);
+
+    if (dev != DEVICE_NAIVE && dev != DEVICE_X86) {
+        GTEST_SKIP();
+    }
+
+    // param
+    std::shared_ptr<FusedAttentionLayerParam> param(new FusedAttentionLayerParam());
+    param->name  = "FusedAttention";
+    param->scale = 1.0f / std::sqrt((float)depth);
+
+    // generate interpreter
+    std::vector<std::vector<int>> input_dims = {
+        {batch, heads, seq_q, depth}, {batch, heads, depth, seq_k}, {batch, heads, seq_k, depth + 3}};
+    if (mask == 1) {
+        input_dims.push_back({batch, 1, 1, seq_k});
+    } else if (mask == 2) {
+        input_dims.push_back({1, 1, seq_q, seq_k});
+    }
+    auto interpreter = GenerateInterpreter("FusedAttention", input_dims, param);
+
+    Precision precision = SetPrecision(dev, DATA_TYPE_FLOAT);
+    Run(interpreter, precision);
+}
+
+}  // namespace TNN_NS
@@ -35,6 +35,7 @@ TEST_P(InnerProductInt8LayerTest, InnerProductLayer) {
     int output_channel = std::get<3>(GetParam());
     DeviceType dev     = ConvertDeviceType(FLAGS_dt);
 
+    x86_int8_implemented_ = true;
     if(CheckDataTypeSkip(DATA_TYPE_INT8)) {
         GTEST_SKIP();
     }
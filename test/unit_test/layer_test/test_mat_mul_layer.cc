@@ -0,0 +1,86 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+class MatMulLayerTest : public LayerTest,
+                        public ::testing::WithParamInterface<std::tuple<int, int, int, int, int, DataType>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, MatMulLayerTest,
+                         ::testing::Combine(
+                             // batch
+                             testing::Values(1, 3),
+                             // m
+                             testing::Values(1, 5, 37),
+                             // k
+                             testing::Values(3, 16, 67),
+                             // n
+                             testing::Values(1, 8, 70),
+                             // weight position, -1 for two inputs
+                             testing::Values(-1, 0, 1),
+                             // data_type
+                             testing::Values(DATA_TYPE_FLOAT)));
+
+TEST_P(MatMulLayerTest, MatMulLayer) {
+    // get param
+    int batch           = std::get<0>(GetParam());
+    int m               = std::get<1>(GetParam());
+    int k               = std::get<2>(GetParam());
+    int n               = std::get<3>(GetParam());
+    int weight_position = std::get<4>(GetParam());
+    DataType data_type  = std::get<5>(GetParam());
+    DeviceType dev      = ConvertDeviceType(FLAGS_dt);
+
+    if (CheckDataTypeSkip(data_type)) {
+        GTEST_SKIP();
+    }
+
+    // param
+    std::shared_ptr<MatMulLayerParam> param(new MatMulLayerParam());
+    param->name            = "MatMul";
+    param->weight_position = weight_position;
+
+    std::vector<int> matrix_a_dims = {batch, m, k};
+    std::vector<int> matrix_b_dims = {batch, k, n};
+
+    // generate interpreter
+    std::shared_ptr<AbstractModelInterpreter> interpreter;
+    if (weight_position == -1) {
+        interpreter = GenerateInterpreter("MatMul", {matrix_a_dims, matrix_b_dims}, param);
+    } else {
+        auto weight_dims = weight_position == 0 ? matrix_a_dims : matrix_b_dims;
+        auto input_dims  = weight_position == 0 ? matrix_b_dims : matrix_a_dims;
+
+        std::shared_ptr<MatMulLayerResource> resource(new MatMulLayerResource());
+        int weight_count = DimsVectorUtils::Count(weight_dims);
+        RawBuffer weight(weight_count * sizeof(float));
+        float *weight_data = weight.force_to<float *>();
+        InitRandom(weight_data, weight_count, 1.0f);
+        weight.SetDataType(DATA_TYPE_FLOAT);
+        weight.SetBufferDims(weight_dims);
+        resource->weight = weight;
+
+        interpreter = GenerateInterpreter("MatMul", {input_dims}, param, resource);
+    }
+
+    Precision precision = SetPrecision(dev, data_type);
+    Run(interpreter, precision);
+}
+
+}  // namespace TNN_NS
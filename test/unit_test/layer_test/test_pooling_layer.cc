@@ -42,6 +42,7 @@ TEST_P(PoolingLayerTest, PoolingLayer) {
     int pool_type      = std::get<5>(GetParam());
     DataType data_type = std::get<6>(GetParam());
     DeviceType dev     = ConvertDeviceType(FLAGS_dt);
+    x86_int8_implemented_ = true;
     if(CheckDataTypeSkip(data_type)) {
         GTEST_SKIP();
     }
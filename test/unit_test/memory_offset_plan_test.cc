@@ -0,0 +1,91 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include <limits.h>
+
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "tnn/core/abstract_device.h"
+#include "tnn/memory_manager/blob_1d_memory.h"
+#include "tnn/memory_manager/memory_offset_assign_strategy.h"
+
+namespace TNN_NS {
+
+static std::shared_ptr<BlobMemory> CreatePlanBlobMemory(int count, int first_use, int last_use) {
+    BlobMemorySizeInfo info;
+    info.data_type = DATA_TYPE_FLOAT;
+    info.dims.push_back(count);
+    auto blob_memory = std::make_shared<Blob1DMemory>(GetDevice(DEVICE_NAIVE), info);
+    blob_memory->SetLiveInterval(first_use, last_use);
+    return blob_memory;
+}
+
+TEST(MemoryOffsetPlanTest, ChainReuse) {
+    // a -> b -> c -> d, every blob is only alive between its producer and consumer
+    std::vector<std::shared_ptr<BlobMemory>> blob_memories = {
+        CreatePlanBlobMemory(256, 0, 1), CreatePlanBlobMemory(256, 1, 2),
+        CreatePlanBlobMemory(256, 2, 3), CreatePlanBlobMemory(256, 3, INT_MAX)};
+    std::set<BlobMemory *> library;
+    for (auto blob_memory : blob_memories) {
+        library.insert(blob_memory.get());
+    }
+
+    std::map<BlobMemory *, int> offsets;
+    int arena_size = MemoryOffsetAssignStrategy::PlanBlobMemoryOffset(library, offsets);
+    EXPECT_EQ(arena_size, 2 * 256 * 4);
+    EXPECT_EQ(offsets[blob_memories[0].get()], offsets[blob_memories[2].get()]);
+    EXPECT_EQ(offsets[blob_memories[1].get()], offsets[blob_memories[3].get()]);
+    EXPECT_NE(offsets[blob_memories[0].get()], offsets[blob_memories[1].get()]);
+}
+
+TEST(MemoryOffsetPlanTest, NoOverlapInLiveInterval) {
+    std::vector<std::shared_ptr<BlobMemory>> blob_memories = {
+        CreatePlanBlobMemory(1000, -1, INT_MAX), CreatePlanBlobMemory(300, 0, 2), CreatePlanBlobMemory(700, 1, 3),
+        CreatePlanBlobMemory(500, 2, 4),         CreatePlanBlobMemory(100, 3, 5), CreatePlanBlobMemory(900, 4, 6)};
+    std::set<BlobMemory *> library;
+    for (auto blob_memory : blob_memories) {
+        library.insert(blob_memory.get());
+    }
+
+    std::map<BlobMemory *, int> offsets;
+    int arena_size = MemoryOffsetAssignStrategy::PlanBlobMemoryOffset(library, offsets);
+
+    int total_size = 0;
+    for (auto a : blob_memories) {
+        auto a_info  = a->GetBlobMemorySizeInfo();
+        int a_offset = offsets[a.get()];
+        int a_size   = (int)GetBlobMemoryBytesSize(a_info);
+        total_size += a_size;
+        EXPECT_EQ(a_offset % 64, 0);
+        EXPECT_LE(a_offset + a_size, arena_size);
+        for (auto b : blob_memories) {
+            if (a == b || a->GetFirstUse() > b->GetLastUse() || b->GetFirstUse() > a->GetLastUse()) {
+                continue;
+            }
+            auto b_info  = b->GetBlobMemorySizeInfo();
+            int b_offset = offsets[b.get()];
+            int b_size   = (int)GetBlobMemoryBytesSize(b_info);
+            EXPECT_TRUE(a_offset + a_size <= b_offset || b_offset + b_size <= a_offset);
+        }
+    }
+    EXPECT_LT(arena_size, total_size);
+}
+
+}  // namespace TNN_NS
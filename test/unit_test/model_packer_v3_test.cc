@@ -0,0 +1,139 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tnn/interpreter/layer_resource.h"
+#include "tnn/interpreter/tnn/model_interpreter.h"
+#include "tnn/interpreter/tnn/model_packer.h"
+
+namespace TNN_NS {
+
+static std::string ReadFileContent(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+static RawBuffer CreateFloatBuffer(int count, float base) {
+    RawBuffer buffer(count * sizeof(float));
+    float *data = buffer.force_to<float *>();
+    for (int i = 0; i < count; ++i) {
+        data[i] = base + i;
+    }
+    buffer.SetDataType(DATA_TYPE_FLOAT);
+    buffer.SetBufferDims({count});
+    return buffer;
+}
+
+static void BuildConvNet(NetStructure &net_structure, NetResource &net_resource) {
+    net_structure.inputs_shape_map["input"] = {1, 3, 8, 8};
+    net_structure.blobs                     = {"input", "output"};
+    net_structure.outputs                   = {"output"};
+
+    auto param            = std::make_shared<ConvLayerParam>();
+    param->name           = "conv";
+    param->type           = "Convolution";
+    param->input_channel  = 3;
+    param->output_channel = 5;
+    param->kernels        = {3, 3};
+    param->strides        = {1, 1};
+    param->pads           = {1, 1, 1, 1};
+    param->dialations     = {1, 1};
+    param->bias           = 1;
+
+    auto layer_info      = std::make_shared<LayerInfo>();
+    layer_info->type     = LAYER_CONVOLUTION;
+    layer_info->type_str = "Convolution";
+    layer_info->name     = "conv";
+    layer_info->inputs   = {"input"};
+    layer_info->outputs  = {"output"};
+    layer_info->param    = param;
+    net_structure.layers.push_back(layer_info);
+
+    auto resource                      = std::make_shared<ConvLayerResource>();
+    resource->filter_handle            = CreateFloatBuffer(5 * 3 * 3 * 3, 0.5f);
+    resource->bias_handle              = CreateFloatBuffer(5, -2.0f);
+    net_resource.resource_map["conv"]  = resource;
+    net_resource.constant_map["shape"] = std::make_shared<RawBuffer>(CreateFloatBuffer(7, 3.0f));
+}
+
+static void ExpectSameBuffer(RawBuffer &expect, RawBuffer &actual) {
+    ASSERT_EQ(expect.GetBytesSize(), actual.GetBytesSize());
+    EXPECT_EQ(expect.GetDataType(), actual.GetDataType());
+    EXPECT_EQ(expect.GetBufferDims(), actual.GetBufferDims());
+    EXPECT_EQ(0, memcmp(expect.force_to<char *>(), actual.force_to<char *>(), expect.GetBytesSize()));
+}
+
+TEST(ModelPackerV3Test, RoundTrip) {
+    NetStructure net_structure;
+    NetResource net_resource;
+    BuildConvNet(net_structure, net_resource);
+
+    const std::string proto_path = "model_packer_v3_test.tnnproto";
+    const std::string model_path = "model_packer_v3_test.tnnmodel";
+    ModelPacker packer(&net_structure, &net_resource);
+    packer.SetVersion(3);
+    ASSERT_EQ(TNN_OK, (int)packer.Pack(proto_path, model_path));
+
+    std::string model_content = ReadFileContent(model_path);
+    ASSERT_GE(model_content.size(), sizeof(uint32_t));
+    uint32_t magic_number = 0;
+    memcpy(&magic_number, model_content.data(), sizeof(uint32_t));
+    EXPECT_EQ(g_version_magic_number_v3, magic_number);
+
+    // raw data is 64 bytes aligned to the start of the model file
+    std::istringstream content_stream(model_content);
+    Deserializer deserializer(content_stream);
+    deserializer.GetInt();
+    model_header_v3 header;
+    header.deserialize(deserializer);
+    EXPECT_EQ(0, header.data_offset_ % g_model_v3_section_alignment);
+    content_stream.seekg(header.index_offset_, std::ios::beg);
+    int section_count = deserializer.GetInt();
+    ASSERT_EQ(2, section_count);
+    for (int i = 0; i < section_count; ++i) {
+        section_index index;
+        index.deserialize(deserializer);
+        for (const auto &tensor : index.tensors_) {
+            EXPECT_EQ(0, (header.data_offset_ + tensor.first) % g_model_v3_data_alignment);
+        }
+    }
+
+    std::vector<std::string> params = {ReadFileContent(proto_path), model_content};
+    ModelInterpreter interpreter;
+    ASSERT_EQ(TNN_OK, (int)interpreter.Interpret(params));
+
+    auto loaded_resource = interpreter.GetNetResource();
+    auto expect_conv     = std::dynamic_pointer_cast<ConvLayerResource>(net_resource.resource_map["conv"]);
+    auto actual_conv     = std::dynamic_pointer_cast<ConvLayerResource>(loaded_resource->resource_map["conv"]);
+    ASSERT_TRUE(actual_conv != nullptr);
+    ExpectSameBuffer(expect_conv->filter_handle, actual_conv->filter_handle);
+    ExpectSameBuffer(expect_conv->bias_handle, actual_conv->bias_handle);
+    ASSERT_EQ(1, loaded_resource->constant_map.count("shape"));
+    ExpectSameBuffer(*net_resource.constant_map["shape"], *loaded_resource->constant_map["shape"]);
+
+    remove(proto_path.c_str());
+    remove(model_path.c_str());
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,94 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tnn/core/instance.h"
+#include "tnn/core/tnn.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+// Rsqrt is implemented on naive but not on x86, it sits between two x86 layers
+static std::string GenerateMixedDeviceProto() {
+    std::ostringstream proto;
+    proto << "\"1 5 1 4206624770 ,\"\n";
+    proto << "\"input 1 3 8 8 ,\"\n";
+    proto << "\" input sigmoid rsqrt relu output ,\"\n";
+    proto << "\"output ,\"\n";
+    proto << "\" 4 ,\"\n";
+    proto << "\"Sigmoid sigmoid 1 1 input sigmoid ,\"\n";
+    proto << "\"Rsqrt rsqrt 1 1 sigmoid rsqrt ,\"\n";
+    proto << "\"ReLU relu 1 1 rsqrt relu ,\"\n";
+    proto << "\"Concat output 2 1 relu sigmoid output 1 ,\"\n";
+    return proto.str();
+}
+
+static Status RunMixedDeviceNet(TNN &net, DeviceType device_type, std::vector<float> &result) {
+    NetworkConfig network_config;
+    network_config.device_type = device_type;
+    Status status;
+    auto instance = net.CreateInst(network_config, status);
+    RETURN_ON_NEQ(status, TNN_OK);
+
+    BlobMap input_blobs, output_blobs;
+    instance->GetAllInputBlobs(input_blobs);
+    instance->GetAllOutputBlobs(output_blobs);
+    Blob *input  = input_blobs["input"];
+    Blob *output = output_blobs["output"];
+
+    float *input_data = static_cast<float *>(input->GetHandle().base);
+    int input_count   = DimsVectorUtils::Count(input->GetBlobDesc().dims);
+    for (int i = 0; i < input_count; ++i) {
+        input_data[i] = (float)((i * 7) % 17) - 8.0f;
+    }
+    status = instance->Forward();
+    RETURN_ON_NEQ(status, TNN_OK);
+
+    float *output_data = static_cast<float *>(output->GetHandle().base);
+    int output_count   = DimsVectorUtils::Count(output->GetBlobDesc().dims);
+    result.assign(output_data, output_data + output_count);
+    return TNN_OK;
+}
+
+TEST(NaiveFallbackTest, X86UnsupportedLayerRunsOnNaive) {
+    ModelConfig model_config;
+    model_config.model_type = MODEL_TYPE_TNN;
+    // empty resource: layer count 0
+    model_config.params = {GenerateMixedDeviceProto(), std::string(sizeof(int), '\0')};
+
+    TNN net;
+    ASSERT_EQ(TNN_OK, (int)net.Init(model_config));
+
+    std::vector<float> expect, actual;
+    ASSERT_EQ(TNN_OK, (int)RunMixedDeviceNet(net, DEVICE_NAIVE, expect));
+    Status status = RunMixedDeviceNet(net, DEVICE_X86, actual);
+    if (status == TNNERR_DEVICE_NOT_SUPPORT) {
+        GTEST_SKIP();
+    }
+    ASSERT_EQ(TNN_OK, (int)status);
+
+    ASSERT_EQ(1 * 6 * 8 * 8, (int)expect.size());
+    ASSERT_EQ(expect.size(), actual.size());
+    for (size_t i = 0; i < expect.size(); ++i) {
+        EXPECT_NEAR(expect[i], actual[i], 1e-5f);
+    }
+}
+
+}  // namespace TNN_NS
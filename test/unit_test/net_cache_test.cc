@@ -0,0 +1,231 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tnn/core/instance.h"
+#include "tnn/interpreter/abstract_model_interpreter.h"
+#include "tnn/interpreter/tnn/model_packer.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/weight_cache_file.h"
+
+namespace TNN_NS {
+
+static std::string ReadFileContent(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+static std::vector<std::string> ListFiles(const std::string &dir_path) {
+    std::vector<std::string> files;
+    DIR *dir = opendir(dir_path.c_str());
+    if (!dir) {
+        return files;
+    }
+    while (struct dirent *entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name != "." && name != "..") {
+            files.push_back(name);
+        }
+    }
+    closedir(dir);
+    return files;
+}
+
+static std::string FindFile(const std::string &dir_path, const std::string &suffix) {
+    for (const auto &name : ListFiles(dir_path)) {
+        if (name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0) {
+            return dir_path + "/" + name;
+        }
+    }
+    return "";
+}
+
+static RawBuffer CreateFloatBuffer(int count, float scale) {
+    RawBuffer buffer(count * sizeof(float));
+    float *data = buffer.force_to<float *>();
+    for (int i = 0; i < count; ++i) {
+        data[i] = (float)(i % 11) * scale - 0.5f;
+    }
+    buffer.SetDataType(DATA_TYPE_FLOAT);
+    buffer.SetBufferDims({count});
+    return buffer;
+}
+
+static std::shared_ptr<LayerInfo> CreateConv(const std::string &name, const std::string &input,
+                                             const std::string &output, int channel, int kernel,
+                                             NetResource &net_resource) {
+    auto param            = std::make_shared<ConvLayerParam>();
+    param->name           = name;
+    param->type           = "Convolution";
+    param->group          = 1;
+    param->input_channel  = channel;
+    param->output_channel = channel;
+    param->kernels        = {kernel, kernel};
+    param->strides        = {1, 1};
+    param->pads           = {kernel / 2, kernel / 2, kernel / 2, kernel / 2};
+    param->dialations     = {1, 1};
+    param->bias           = 1;
+
+    auto layer_info      = std::make_shared<LayerInfo>();
+    layer_info->type     = LAYER_CONVOLUTION;
+    layer_info->type_str = "Convolution";
+    layer_info->name     = name;
+    layer_info->inputs   = {input};
+    layer_info->outputs  = {output};
+    layer_info->param    = param;
+
+    auto resource                   = std::make_shared<ConvLayerResource>();
+    resource->filter_handle         = CreateFloatBuffer(channel * channel * kernel * kernel, 0.0625f);
+    resource->bias_handle           = CreateFloatBuffer(channel, 0.125f);
+    net_resource.resource_map[name] = resource;
+    return layer_info;
+}
+
+// conv 3x3 -> relu -> conv 1x1, relu is fused into the conv by the optimizer
+static void PackModel(const std::string &proto_path, const std::string &model_path) {
+    const int channel = 16;
+    NetStructure net_structure;
+    NetResource net_resource;
+    net_structure.inputs_shape_map["input"]    = {1, channel, 10, 10};
+    net_structure.input_data_type_map["input"] = DATA_TYPE_FLOAT;
+    net_structure.blobs                        = {"input", "conv0", "relu", "output"};
+    net_structure.outputs                      = {"output"};
+
+    net_structure.layers.push_back(CreateConv("conv0", "input", "conv0", channel, 3, net_resource));
+    auto relu_param     = std::make_shared<LayerParam>();
+    relu_param->name    = "relu";
+    relu_param->type    = "ReLU";
+    auto relu_info      = std::make_shared<LayerInfo>();
+    relu_info->type     = LAYER_RELU;
+    relu_info->type_str = "ReLU";
+    relu_info->name     = "relu";
+    relu_info->inputs   = {"conv0"};
+    relu_info->outputs  = {"relu"};
+    relu_info->param    = relu_param;
+    net_structure.layers.push_back(relu_info);
+    net_structure.layers.push_back(CreateConv("conv1", "relu", "output", channel, 1, net_resource));
+
+    ModelPacker packer(&net_structure, &net_resource);
+    ASSERT_EQ(TNN_OK, (int)packer.Pack(proto_path, model_path));
+}
+
+static Status RunInstance(const std::vector<std::string> &params, DeviceType device_type,
+                          const std::string &cache_path, std::vector<float> &result) {
+    NetworkConfig network_config;
+    network_config.device_type = device_type;
+    network_config.cache_path  = cache_path;
+    ModelConfig model_config;
+    model_config.params = params;
+
+    std::shared_ptr<AbstractModelInterpreter> interpreter(CreateModelInterpreter(MODEL_TYPE_TNN));
+    RETURN_ON_NEQ(interpreter->Interpret(model_config.params), TNN_OK);
+    auto instance = std::make_shared<Instance>(network_config, model_config);
+    RETURN_ON_NEQ(instance->Init(interpreter, InputShapesMap()), TNN_OK);
+
+    BlobMap input_blobs, output_blobs;
+    instance->GetAllInputBlobs(input_blobs);
+    instance->GetAllOutputBlobs(output_blobs);
+    Blob *input  = input_blobs.begin()->second;
+    Blob *output = output_blobs.begin()->second;
+
+    float *input_data = static_cast<float *>(input->GetHandle().base);
+    int input_count   = DimsVectorUtils::Count(input->GetBlobDesc().dims);
+    for (int i = 0; i < input_count; ++i) {
+        input_data[i] = (float)((i * 7) % 17) * 0.25f - 2.0f;
+    }
+    RETURN_ON_NEQ(instance->Forward(), TNN_OK);
+
+    float *output_data = static_cast<float *>(output->GetHandle().base);
+    int output_count   = DimsVectorUtils::Count(output->GetBlobDesc().dims);
+    result.assign(output_data, output_data + output_count);
+    return TNN_OK;
+}
+
+static void ExpectNear(const std::vector<float> &expect, const std::vector<float> &actual) {
+    ASSERT_EQ(expect.size(), actual.size());
+    for (size_t i = 0; i < expect.size(); ++i) {
+        ASSERT_NEAR(expect[i], actual[i], 1e-4f) << "index " << i;
+    }
+}
+
+class NetCacheTest : public ::testing::TestWithParam<DeviceType> {};
+
+INSTANTIATE_TEST_SUITE_P(NetCacheTest, NetCacheTest, ::testing::Values(DEVICE_NAIVE, DEVICE_X86));
+
+// later instances load the optimized net and the packed weights saved by the first one
+TEST_P(NetCacheTest, LoadsSavedCache) {
+    DeviceType device_type = GetParam();
+    char dir_template[]    = "/tmp/tnn_net_cache_XXXXXX";
+    ASSERT_TRUE(mkdtemp(dir_template) != nullptr);
+    const std::string cache_path = dir_template;
+
+    PackModel(cache_path + "/model.tnnproto", cache_path + "/model.tnnmodel");
+    std::vector<std::string> params = {ReadFileContent(cache_path + "/model.tnnproto"),
+                                       ReadFileContent(cache_path + "/model.tnnmodel")};
+    remove((cache_path + "/model.tnnproto").c_str());
+    remove((cache_path + "/model.tnnmodel").c_str());
+
+    std::vector<float> expect;
+    Status status = RunInstance(params, device_type, "", expect);
+    if (status == TNNERR_DEVICE_NOT_SUPPORT) {
+        rmdir(cache_path.c_str());
+        GTEST_SKIP();
+    }
+    ASSERT_EQ(TNN_OK, (int)status);
+
+    std::vector<float> first, second, fallback;
+    ASSERT_EQ(TNN_OK, (int)RunInstance(params, device_type, cache_path, first));
+    const std::string proto_path   = FindFile(cache_path, ".tnnproto");
+    const std::string model_path   = FindFile(cache_path, ".tnnmodel");
+    const std::string weights_path = FindFile(cache_path, ".weights");
+    EXPECT_FALSE(proto_path.empty());
+    EXPECT_FALSE(model_path.empty());
+    // the relu is fused into the conv in the cached net
+    EXPECT_EQ(std::string::npos, ReadFileContent(proto_path).find("ReLU"));
+    if (device_type == DEVICE_X86) {
+        EXPECT_FALSE(weights_path.empty());
+        EXPECT_LT(0, WeightCacheFile::Open(weights_path)->GetCount());
+    }
+
+    ASSERT_EQ(TNN_OK, (int)RunInstance(params, device_type, cache_path, second));
+
+    // a broken cache is optimized and saved again
+    std::ofstream(model_path, std::ios::binary | std::ios::trunc) << "broken";
+    std::ofstream(weights_path.empty() ? cache_path + "/unused" : weights_path, std::ios::binary | std::ios::trunc)
+        << "broken";
+    ASSERT_EQ(TNN_OK, (int)RunInstance(params, device_type, cache_path, fallback));
+    EXPECT_LT(6, ReadFileContent(model_path).size());
+
+    ExpectNear(expect, first);
+    ExpectNear(expect, second);
+    ExpectNear(expect, fallback);
+
+    for (const auto &name : ListFiles(cache_path)) {
+        remove((cache_path + "/" + name).c_str());
+    }
+    rmdir(cache_path.c_str());
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,177 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/instance.h"
+#include "tnn/core/reshape_plan_cache.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+class CountedLayerAcc : public AbstractLayerAcc {
+public:
+    explicit CountedLayerAcc(int *released) : released_(released) {}
+    virtual ~CountedLayerAcc() {
+        ++(*released_);
+    }
+    virtual Status Init(Context *context, LayerParam *param, LayerResource *resource,
+                        const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+        return TNN_OK;
+    }
+    virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+        return TNN_OK;
+    }
+    virtual Status Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+        return TNN_OK;
+    }
+    virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size, BlobType blob_type) {
+        return {DATA_FORMAT_NCHW};
+    }
+
+private:
+    int *released_;
+};
+
+// plans over the capacity are released least recently used first
+TEST(ReshapePlanCacheTest, EvictsLeastRecentlyUsed) {
+    int released = 0;
+    ReshapePlanCache cache(2);
+    ReshapePlanCache::LayerAccs plan_a = {new CountedLayerAcc(&released)};
+    ReshapePlanCache::LayerAccs plan_b = {new CountedLayerAcc(&released), new CountedLayerAcc(&released)};
+    ReshapePlanCache::LayerAccs plan_c = {new CountedLayerAcc(&released)};
+    cache.Put("a", plan_a);
+    cache.Put("b", plan_b);
+
+    ReshapePlanCache::LayerAccs taken;
+    ASSERT_TRUE(cache.Take("a", taken));
+    EXPECT_EQ(plan_a, taken);
+    EXPECT_FALSE(cache.Take("a", taken));
+    cache.Put("a", taken);
+
+    cache.Put("c", plan_c);
+    EXPECT_EQ(2, cache.GetCount());
+    EXPECT_EQ(2, released);
+    EXPECT_FALSE(cache.Take("b", taken));
+
+    // a plan put again under the same key replaces the old one
+    ReshapePlanCache::LayerAccs plan_d = {new CountedLayerAcc(&released)};
+    cache.Put("c", plan_d);
+    EXPECT_EQ(2, cache.GetCount());
+    EXPECT_EQ(3, released);
+}
+
+static std::shared_ptr<AbstractModelInterpreter> GenerateConvInterpreter(int channel, int input_size) {
+    std::shared_ptr<ConvLayerParam> param(new ConvLayerParam());
+    param->name           = "Conv";
+    param->input_channel  = channel;
+    param->output_channel = channel;
+    param->group          = 1;
+    param->kernels        = {3, 3};
+    param->dialations     = {1, 1};
+    param->strides        = {1, 1};
+    param->pads           = {1, 1, 1, 1};
+    param->bias           = 1;
+
+    std::shared_ptr<ConvLayerResource> resource(new ConvLayerResource());
+    RawBuffer filter(channel * channel * 9 * sizeof(float));
+    float *filter_data = filter.force_to<float *>();
+    for (int i = 0; i < channel * channel * 9; ++i) {
+        filter_data[i] = (float)(i % 5) * 0.125f - 0.25f;
+    }
+    filter.SetDataType(DATA_TYPE_FLOAT);
+    RawBuffer bias(channel * sizeof(float));
+    float *bias_data = bias.force_to<float *>();
+    for (int i = 0; i < channel; ++i) {
+        bias_data[i] = (float)i * 0.5f;
+    }
+    bias.SetDataType(DATA_TYPE_FLOAT);
+    resource->filter_handle = filter;
+    resource->bias_handle   = bias;
+
+    return GenerateInterpreter("Convolution", {{1, channel, input_size, input_size}}, param, resource);
+}
+
+static Status ForwardWithShape(std::shared_ptr<Instance> instance, const DimsVector &dims,
+                               std::vector<float> &result) {
+    RETURN_ON_NEQ(instance->Reshape({{"input0", dims}}), TNN_OK);
+    BlobMap input_blobs, output_blobs;
+    instance->GetAllInputBlobs(input_blobs);
+    instance->GetAllOutputBlobs(output_blobs);
+    Blob *input  = input_blobs["input0"];
+    Blob *output = output_blobs["output0"];
+
+    float *input_data = static_cast<float *>(input->GetHandle().base);
+    int input_count   = DimsVectorUtils::Count(input->GetBlobDesc().dims);
+    for (int i = 0; i < input_count; ++i) {
+        input_data[i] = (float)((i * 3) % 11) * 0.25f - 1.0f;
+    }
+    RETURN_ON_NEQ(instance->Forward(), TNN_OK);
+
+    float *output_data = static_cast<float *>(output->GetHandle().base);
+    result.assign(output_data, output_data + DimsVectorUtils::Count(output->GetBlobDesc().dims));
+    return TNN_OK;
+}
+
+// switching among cached and new shapes gives the same results as reshaping the layers
+TEST(ReshapePlanCacheTest, ReshapeAmongShapes) {
+    DeviceType device_type = ConvertDeviceType(FLAGS_dt);
+    if (device_type != DEVICE_NAIVE && device_type != DEVICE_X86) {
+        GTEST_SKIP();
+    }
+    const int channel = 8;
+    auto interpreter  = GenerateConvInterpreter(channel, 20);
+    ASSERT_TRUE(interpreter != nullptr);
+
+    NetworkConfig config;
+    config.device_type = device_type;
+    ModelConfig model_config;
+    model_config.params = {"", ""};
+
+    NetworkConfig cache_config           = config;
+    cache_config.reshape_plan_cache_size = 2;
+
+    auto instance       = std::make_shared<Instance>(config, model_config);
+    auto cache_instance = std::make_shared<Instance>(cache_config, model_config);
+    ASSERT_EQ(TNN_OK, (int)instance->Init(interpreter, InputShapesMap()));
+    ASSERT_EQ(TNN_OK, (int)cache_instance->Init(interpreter, InputShapesMap()));
+
+    BlobMap input_blobs;
+    instance->GetAllInputBlobs(input_blobs);
+    if (input_blobs["input0"]->GetBlobDesc().data_format != DATA_FORMAT_NCHW) {
+        GTEST_SKIP();
+    }
+
+    // 5x5 is evicted by 9x9, others come back from the cache
+    std::vector<DimsVector> shapes = {{1, channel, 12, 12}, {1, channel, 5, 5},   {1, channel, 12, 12},
+                                      {1, channel, 20, 20}, {1, channel, 9, 17},  {1, channel, 12, 12},
+                                      {1, channel, 5, 5},   {1, channel, 20, 20}, {1, channel, 5, 5}};
+    for (const auto &dims : shapes) {
+        std::vector<float> expect, actual;
+        ASSERT_EQ(TNN_OK, (int)ForwardWithShape(instance, dims, expect));
+        ASSERT_EQ(TNN_OK, (int)ForwardWithShape(cache_instance, dims, actual));
+        ASSERT_EQ(expect.size(), actual.size());
+        for (size_t i = 0; i < expect.size(); ++i) {
+            ASSERT_NEAR(expect[i], actual[i], 1e-4f) << "shape " << dims[2] << "x" << dims[3] << " index " << i;
+        }
+    }
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,127 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/instance.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/shared_weight_cache.h"
+
+namespace TNN_NS {
+
+static std::shared_ptr<AbstractModelInterpreter> GenerateConvInterpreter(int channel, int input_size) {
+    std::shared_ptr<ConvLayerParam> param(new ConvLayerParam());
+    param->name           = "Conv";
+    param->input_channel  = channel;
+    param->output_channel = channel;
+    param->group          = 1;
+    param->kernels        = {1, 1};
+    param->dialations     = {1, 1};
+    param->strides        = {1, 1};
+    param->pads           = {0, 0, 0, 0};
+    param->bias           = 1;
+
+    std::shared_ptr<ConvLayerResource> resource(new ConvLayerResource());
+    RawBuffer filter(channel * channel * sizeof(float));
+    float *filter_data = filter.force_to<float *>();
+    for (int i = 0; i < channel * channel; ++i) {
+        filter_data[i] = (float)(i % 7) * 0.25f - 0.5f;
+    }
+    filter.SetDataType(DATA_TYPE_FLOAT);
+    RawBuffer bias(channel * sizeof(float));
+    float *bias_data = bias.force_to<float *>();
+    for (int i = 0; i < channel; ++i) {
+        bias_data[i] = (float)i * 0.125f;
+    }
+    bias.SetDataType(DATA_TYPE_FLOAT);
+    resource->filter_handle = filter;
+    resource->bias_handle   = bias;
+
+    return GenerateInterpreter("Convolution", {{1, channel, input_size, input_size}}, param, resource);
+}
+
+static Status CreateConvInstance(std::shared_ptr<AbstractModelInterpreter> interpreter, DeviceType device_type,
+                                 std::shared_ptr<Instance> &instance) {
+    NetworkConfig network_config;
+    network_config.device_type = device_type;
+    ModelConfig model_config;
+    model_config.params = {"", ""};
+
+    instance = std::make_shared<Instance>(network_config, model_config);
+    return instance->Init(interpreter, InputShapesMap());
+}
+
+static Status RunConvInstance(std::shared_ptr<Instance> instance, std::vector<float> &result) {
+    BlobMap input_blobs, output_blobs;
+    instance->GetAllInputBlobs(input_blobs);
+    instance->GetAllOutputBlobs(output_blobs);
+    Blob *input  = input_blobs.begin()->second;
+    Blob *output = output_blobs.begin()->second;
+
+    float *input_data = static_cast<float *>(input->GetHandle().base);
+    int input_count   = DimsVectorUtils::Count(input->GetBlobDesc().dims);
+    for (int i = 0; i < input_count; ++i) {
+        input_data[i] = (float)((i * 7) % 17) - 8.0f;
+    }
+    RETURN_ON_NEQ(instance->Forward(), TNN_OK);
+
+    float *output_data = static_cast<float *>(output->GetHandle().base);
+    int output_count   = DimsVectorUtils::Count(output->GetBlobDesc().dims);
+    result.assign(output_data, output_data + output_count);
+    return TNN_OK;
+}
+
+TEST(SharedWeightTest, X86InstancesSharePackedWeights) {
+    auto interpreter = GenerateConvInterpreter(16, 8);
+    ASSERT_TRUE(interpreter != nullptr);
+
+    std::shared_ptr<Instance> naive_instance;
+    std::vector<float> expect;
+    ASSERT_EQ(TNN_OK, (int)CreateConvInstance(interpreter, DEVICE_NAIVE, naive_instance));
+    ASSERT_EQ(TNN_OK, (int)RunConvInstance(naive_instance, expect));
+
+    int count_before = SharedWeightCache::GetCount();
+    std::shared_ptr<Instance> instance0, instance1;
+    Status status = CreateConvInstance(interpreter, DEVICE_X86, instance0);
+    if (status == TNNERR_DEVICE_NOT_SUPPORT) {
+        GTEST_SKIP();
+    }
+    ASSERT_EQ(TNN_OK, (int)status);
+    EXPECT_EQ(count_before + 1, SharedWeightCache::GetCount());
+
+    // the second instance reuses the weights packed by the first one
+    ASSERT_EQ(TNN_OK, (int)CreateConvInstance(interpreter, DEVICE_X86, instance1));
+    EXPECT_EQ(count_before + 1, SharedWeightCache::GetCount());
+
+    std::vector<float> actual0, actual1;
+    ASSERT_EQ(TNN_OK, (int)RunConvInstance(instance0, actual0));
+    instance0.reset();
+    ASSERT_EQ(TNN_OK, (int)RunConvInstance(instance1, actual1));
+    ASSERT_EQ(expect.size(), actual0.size());
+    ASSERT_EQ(expect.size(), actual1.size());
+    for (size_t i = 0; i < expect.size(); ++i) {
+        EXPECT_NEAR(expect[i], actual0[i], 1e-4f);
+        EXPECT_NEAR(expect[i], actual1[i], 1e-4f);
+    }
+
+    // released with the last instance holding them
+    instance1.reset();
+    EXPECT_EQ(count_before, SharedWeightCache::GetCount());
+}
+
+}  // namespace TNN_NS
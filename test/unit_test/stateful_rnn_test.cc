@@ -0,0 +1,137 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/instance.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+static const int kSeqLen     = 8;
+static const int kBatch      = 2;
+static const int kInputSize  = 5;
+static const int kHiddenSize = 7;
+
+static std::shared_ptr<AbstractModelInterpreter> GenerateStatefulInterpreter(const std::string &type) {
+    std::vector<int> input_dims = {kSeqLen, kBatch, kInputSize};
+    if (type == "LSTMONNX") {
+        std::shared_ptr<LSTMONNXLayerParam> param(new LSTMONNXLayerParam());
+        param->name        = "LSTMONNX";
+        param->hidden_size = kHiddenSize;
+        param->direction   = 0;
+        param->stateful    = 1;
+        return GenerateInterpreter(type,
+                                   {input_dims, {1, 4 * kHiddenSize, kInputSize}, {1, 4 * kHiddenSize, kHiddenSize},
+                                    {1, 8 * kHiddenSize}},
+                                   param, nullptr, 3);
+    }
+    std::shared_ptr<GRULayerParam> param(new GRULayerParam());
+    param->name        = "GRU";
+    param->hidden_size = kHiddenSize;
+    param->direction   = 0;
+    param->stateful    = 1;
+    return GenerateInterpreter(type,
+                               {input_dims, {1, 3 * kHiddenSize, kInputSize}, {1, 3 * kHiddenSize, kHiddenSize},
+                                {1, 6 * kHiddenSize}},
+                               param, nullptr, 2);
+}
+
+// forward the steps [begin, end) of the sequence and append y to result
+static Status ForwardSteps(std::shared_ptr<Instance> instance, int begin, int end, std::vector<float> &result) {
+    DimsVector input_dims = {end - begin, kBatch, kInputSize};
+    RETURN_ON_NEQ(instance->Reshape({{"input0", input_dims}}), TNN_OK);
+
+    // the blobs may be packed on device, go through mats
+    auto input_mat    = std::make_shared<Mat>(DEVICE_NAIVE, NCHW_FLOAT, input_dims);
+    float *input_data = static_cast<float *>(input_mat->GetData());
+    const int step    = kBatch * kInputSize;
+    for (int i = begin * step; i < end * step; ++i) {
+        input_data[i - begin * step] = (float)((i * 7) % 13) * 0.125f - 0.75f;
+    }
+    RETURN_ON_NEQ(instance->SetInputMat(input_mat, MatConvertParam(), "input0"), TNN_OK);
+    RETURN_ON_NEQ(instance->Forward(), TNN_OK);
+
+    std::shared_ptr<Mat> output_mat;
+    RETURN_ON_NEQ(instance->GetOutputMat(output_mat, MatConvertParam(), "output0", DEVICE_NAIVE), TNN_OK);
+    float *output_data = static_cast<float *>(output_mat->GetData());
+    result.insert(result.end(), output_data, output_data + DimsVectorUtils::Count(output_mat->GetDims()));
+    return TNN_OK;
+}
+
+static void ExpectNear(const std::vector<float> &expect, const std::vector<float> &actual) {
+    ASSERT_EQ(expect.size(), actual.size());
+    for (size_t i = 0; i < expect.size(); ++i) {
+        ASSERT_NEAR(expect[i], actual[i], 1e-4f) << "index " << i;
+    }
+}
+
+// a sequence forwarded in chunks gives the same output as forwarded at once, reset starts it over
+static void TestStreaming(const std::string &type) {
+    DeviceType device_type = ConvertDeviceType(FLAGS_dt);
+    if (device_type != DEVICE_NAIVE && device_type != DEVICE_X86) {
+        GTEST_SKIP();
+    }
+    auto interpreter = GenerateStatefulInterpreter(type);
+    ASSERT_TRUE(interpreter != nullptr);
+
+    NetworkConfig config;
+    config.device_type = device_type;
+    ModelConfig model_config;
+    model_config.params = {"", ""};
+
+    // the random weights are generated per instance, compare the outputs of one instance
+    auto instance = std::make_shared<Instance>(config, model_config);
+    ASSERT_EQ(TNN_OK, (int)instance->Init(interpreter, InputShapesMap()));
+
+    std::vector<float> expect, actual;
+    ASSERT_EQ(TNN_OK, (int)ForwardSteps(instance, 0, 3, actual));
+    ASSERT_EQ(TNN_OK, (int)ForwardSteps(instance, 3, 6, actual));
+    ASSERT_EQ(TNN_OK, (int)ForwardSteps(instance, 6, kSeqLen, actual));
+    ASSERT_EQ(TNN_OK, (int)instance->ResetLayerStates());
+    ASSERT_EQ(TNN_OK, (int)ForwardSteps(instance, 0, kSeqLen, expect));
+    ExpectNear(expect, actual);
+
+    // the state goes on without reset
+    std::vector<float> head = std::vector<float>(expect.begin(), expect.begin() + 3 * kBatch * kHiddenSize);
+    std::vector<float> resumed;
+    ASSERT_EQ(TNN_OK, (int)ForwardSteps(instance, 0, 3, resumed));
+    bool differ = false;
+    for (size_t i = 0; i < head.size(); ++i) {
+        differ = differ || std::fabs(head[i] - resumed[i]) > 1e-4f;
+    }
+    EXPECT_TRUE(differ);
+
+    std::vector<float> restarted;
+    ASSERT_EQ(TNN_OK, (int)instance->ResetLayerStates());
+    ASSERT_EQ(TNN_OK, (int)ForwardSteps(instance, 0, 3, restarted));
+    ExpectNear(head, restarted);
+}
+
+TEST(StatefulRNNTest, LSTMStreaming) {
+    TestStreaming("LSTMONNX");
+}
+
+TEST(StatefulRNNTest, GRUStreaming) {
+    TestStreaming("Gru");
+}
+
+}  // namespace TNN_NS
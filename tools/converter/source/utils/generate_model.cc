@@ -36,6 +36,7 @@ TNN_NS::Status GenerateModel(TNN_NS::NetStructure& net_structure, TNN_NS::NetRes
     printf("TNN Converter generate TNN proto path %s\n", proto_path.c_str());
     printf("TNN Converter generate TNN model path %s\n", model_path.c_str());
     TNN_NS::ModelPacker model_packer(&net_structure, &net_resource);
+    model_packer.SetVersion(3);
     Status status = model_packer.Pack(proto_path, model_path);
     if (status != TNN_OK) {
         LOGE("generate tnn model failed!\n");
@@ -227,6 +227,7 @@ int onnx2tnn_convert(std::string onnx_model_path, std::string output_dir, std::s
         }
         
         auto packer = std::make_shared<ModelPacker>(opt_structure.get(), opt_resource.get());
+        packer->SetVersion(3);
         if (packer->Pack(tnn_proto, tnn_model) != 0) {
             DLog("ModelPacker Pack failed!\n");
             return -1;
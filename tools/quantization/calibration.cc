@@ -171,6 +171,7 @@ Status Calibration::Serialize(std::string proto_path, std::string model_path) {
     }
 
     TNN_NS::ModelPacker packer(net_struct, net_resource);
+    packer.SetVersion(3);
 
     Status status = packer.Pack(proto_path, model_path);
     if (status != TNN_OK) {